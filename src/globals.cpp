@@ -23,13 +23,14 @@ FlywheelService flywheelService;
 StrokeService strokeService;
 
 SdCardService sdCardService;
+BleNotificationWorker bleNotificationWorker;
 BatteryBleService batteryBleService;
 DeviceInfoBleService deviceInfoBleService;
 OtaBleService otaBleService(otaService);
 SettingsBleService settingsBleService(sdCardService, eepromService);
-BaseMetricsBleService baseMetricsBleService(settingsBleService, eepromService);
-ExtendedMetricBleService extendedMetricsBleService;
-ConnectionManagerCallbacks connectionManagerCallbacks;
+BaseMetricsBleService baseMetricsBleService(settingsBleService, eepromService, bleNotificationWorker);
+ExtendedMetricBleService extendedMetricsBleService(bleNotificationWorker);
+ConnectionManagerCallbacks connectionManagerCallbacks(bleNotificationWorker, settingsBleService);
 
 BluetoothController bleController(eepromService, otaService, settingsBleService, batteryBleService, deviceInfoBleService, otaBleService, baseMetricsBleService, extendedMetricsBleService, connectionManagerCallbacks);
 
@@ -6,6 +6,7 @@
 #include "Arduino.h"
 #include "Preferences.h"
 
+#include "./peripherals/bluetooth/ble-notification.worker.h"
 #include "./peripherals/bluetooth/ble-services/base-metrics.service.h"
 #include "./peripherals/bluetooth/ble-services/battery.service.h"
 #include "./peripherals/bluetooth/ble-services/device-info.service.h"
@@ -17,7 +18,9 @@
 #include "./peripherals/led/led.service.h"
 #include "./peripherals/peripherals.controller.h"
 #include "./peripherals/sd-card/sd-card.service.h"
+#include "./rower/allocation-tracker.h"
 #include "./rower/flywheel.service.h"
+#include "./rower/pipeline-profiler.h"
 #include "./rower/stroke.controller.h"
 #include "./rower/stroke.service.h"
 #include "./utils/EEPROM/EEPROM.service.h"
@@ -43,6 +46,7 @@ extern FlywheelService flywheelService;
 extern StrokeService strokeService;
 extern StrokeController strokeController;
 
+extern BleNotificationWorker bleNotificationWorker;
 extern SettingsBleService settingsBleService;
 extern BatteryBleService batteryBleService;
 extern DeviceInfoBleService deviceInfoBleService;
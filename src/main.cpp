@@ -25,6 +25,7 @@ void setup()
     eepromService.setup();
     Log.setLevel(eepromService.getLogLevel());
 
+    bleNotificationWorker.begin();
     peripheralController.begin();
     powerManagerController.begin();
     strokeController.begin();
@@ -64,7 +65,10 @@ void loop()
 
     if (strokeController.getRawImpulseCount() != strokeController.getPreviousRawImpulseCount())
     {
-        peripheralController.updateDeltaTime(strokeController.getDeltaTime());
+        for (const auto &impulse : strokeController.getLastBatch())
+        {
+            peripheralController.updateDeltaTime(impulse.deltaTime);
+        }
         strokeController.setPreviousRawImpulseCount();
     }
 
@@ -75,6 +79,8 @@ void loop()
         lastUpdateTime = now;
     }
 
+    bleNotificationWorker.reportStatistics(now);
+
     if (strokeController.getStrokeCount() != strokeController.getPreviousStrokeCount())
     {
         Log.traceln("driveDuration: %D", strokeController.getDriveDuration());
@@ -95,10 +101,31 @@ void loop()
             powerManagerController.setPreviousBatteryLevel();
         }
     }
-    // auto stop = micros();
-    // if (stop - start > 10)
-    // {
-    //     Serial.print("Main loop: ");
-    //     Serial.println(stop - start);
-    // }
+
+    if constexpr (Configurations::isPipelineProfilingEnabled || Configurations::isAllocationTrackingEnabled)
+    {
+        // Serial commands: 'p' dumps the pipeline profile, 'r' resets it, 'a' dumps the allocation statistics
+        if (Serial.available() > 0)
+        {
+            const auto command = Serial.read();
+            if constexpr (Configurations::isPipelineProfilingEnabled)
+            {
+                if (command == 'p')
+                {
+                    Serial.print(pipelineProfiler.summary().c_str());
+                }
+                if (command == 'r')
+                {
+                    pipelineProfiler.reset();
+                }
+            }
+            if constexpr (Configurations::isAllocationTrackingEnabled)
+            {
+                if (command == 'a')
+                {
+                    Serial.print(allocationTracker.summary().c_str());
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
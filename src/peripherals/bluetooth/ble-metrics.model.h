@@ -1,11 +1,14 @@
 #pragma once
 
+#include <array>
+
 #include "esp_err.h"
 
 #include "NimBLEDevice.h"
 
 #include "../../utils/configuration.h"
 #include "../../utils/macros.h"
+#include "./ble.enums.h"
 
 namespace BleMetricsModel
 {
@@ -22,6 +25,19 @@ namespace BleMetricsModel
         Configurations::precision avgStrokePower;
         Configurations::precision dragCoefficient;
     };
+
+    // Notification formats chosen by one client via the settings control point
+    struct ClientSettings
+    {
+        unsigned short connectionHandle = BLE_HS_CONN_HANDLE_NONE;
+        DeltaTimeEncoding deltaTimeEncoding = DeltaTimeEncoding::Raw;
+        HandleForcesEncoding handleForcesEncoding = HandleForcesEncoding::Float;
+        unsigned char handleForcesMaxError = 0;
+
+        bool operator==(const ClientSettings &) const = default;
+    };
+
+    using ClientSettingsList = std::array<ClientSettings, Configurations::maxConnectionCount>;
 }
 
 // NOLINTBEGIN(cppcoreguidelines-macro-usage, cppcoreguidelines-pro-type-vararg)
@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "Arduino.h"
+#include "ArduinoLog.h"
+#include "NimBLEDevice.h"
+
+#include "./ble-notification.worker.h"
+
+#include "../../utils/configuration.h"
+
+static_assert(BleNotificationWorker::allClients == BLE_HS_CONN_HANDLE_NONE, "allClients must match the NimBLE handle that notifies every subscribed client");
+
+bool BleNotificationWorker::begin()
+{
+    const auto coreStackSize = 3'072U;
+
+    if (xTaskCreatePinnedToCore(BleNotificationWorker::task, "notifyClients", coreStackSize, this, 1, &taskHandle, 0) != pdPASS)
+    {
+        Log.errorln("Could not start BLE notification task");
+
+        return false;
+    }
+
+    return true;
+}
+
+void BleNotificationWorker::task(void *parameters)
+{
+    auto *const worker = static_cast<BleNotificationWorker *>(parameters);
+
+    // Notifications waiting for the next connection event wake the task up on their own, otherwise it sleeps until something is queued
+    TickType_t timeout = portMAX_DELAY;
+    while (ulTaskNotifyTake(pdTRUE, timeout) != 0 || timeout != portMAX_DELAY)
+    {
+        const auto nextEventDelay = worker->processPending();
+        timeout = nextEventDelay == 0 ? portMAX_DELAY : std::max(pdMS_TO_TICKS(nextEventDelay), static_cast<TickType_t>(1));
+    }
+
+    vTaskDelete(nullptr);
+}
+
+bool BleNotificationWorker::enqueue(const NotificationType type, NimBLECharacteristic *const characteristic, const std::span<const std::byte> payload)
+{
+    return enqueue(type, characteristic, {}, payload);
+}
+
+bool BleNotificationWorker::enqueue(const NotificationType type, NimBLECharacteristic *const characteristic, const std::span<const std::byte> header, const std::span<const std::byte> payload)
+{
+    return enqueue(type, characteristic, allClients, header, payload);
+}
+
+bool BleNotificationWorker::enqueue(const NotificationType type, NimBLECharacteristic *const characteristic, const unsigned short connectionHandle, const std::span<const std::byte> header, const std::span<const std::byte> payload)
+{
+    const auto isQueued = isSnapshot(type) ? snapshots.push(type, characteristic, connectionHandle, header, payload) : bursts.push(type, characteristic, connectionHandle, header, payload);
+    if (!isQueued)
+    {
+        drop();
+
+        return false;
+    }
+
+    if (taskHandle != nullptr)
+    {
+        xTaskNotifyGive(taskHandle);
+    }
+
+    return true;
+}
+
+template <unsigned short QueueCapacity, unsigned short BufferSize>
+bool BleNotificationWorker::NotificationLane<QueueCapacity, BufferSize>::push(const NotificationType type, NimBLECharacteristic *const characteristic, const unsigned short connectionHandle, const std::span<const std::byte> header, const std::span<const std::byte> payload)
+{
+    const auto length = header.size() + payload.size();
+    if (length > BleNotificationLimits::maxPayloadLength)
+    {
+        return false;
+    }
+
+    // Payloads are kept contiguous so they can be sent directly from the buffer, if the rest of the buffer is too short it is skipped
+    auto start = writtenBytes;
+    const auto position = start & bufferIndexMask;
+    if (position + length > BufferSize)
+    {
+        start += BufferSize - position;
+    }
+    const auto end = start + static_cast<unsigned int>(length);
+
+    if (end - releasedBytes.load(std::memory_order_acquire) > BufferSize)
+    {
+        return false;
+    }
+
+    auto destination = payloadBuffer.begin() + static_cast<long>(start & bufferIndexMask);
+    destination = std::copy(cbegin(header), cend(header), destination);
+    std::copy(cbegin(payload), cend(payload), destination);
+
+    if (!jobs.push({.type = type, .characteristic = characteristic, .connectionHandle = connectionHandle, .payloadEnd = end, .length = static_cast<unsigned short>(length)}))
+    {
+        return false;
+    }
+    writtenBytes = end;
+
+    return true;
+}
+
+template <unsigned short QueueCapacity, unsigned short BufferSize>
+bool BleNotificationWorker::NotificationLane<QueueCapacity, BufferSize>::hasRoom(const unsigned int notificationCount, const unsigned int byteCount) const
+{
+    // A payload that does not fit the end of the buffer skips it, which is never more than one max length payload for a run of pushes shorter than the buffer
+    const auto usedBytes = writtenBytes - releasedBytes.load(std::memory_order_acquire);
+
+    return jobs.size() + notificationCount <= QueueCapacity && usedBytes + byteCount + BleNotificationLimits::maxPayloadLength <= BufferSize;
+}
+
+template <unsigned short QueueCapacity, unsigned short BufferSize>
+std::span<const std::byte> BleNotificationWorker::NotificationLane<QueueCapacity, BufferSize>::getPayload(const NotificationJob &job) const
+{
+    const auto start = (job.payloadEnd - job.length) & bufferIndexMask;
+
+    return std::span<const std::byte>(payloadBuffer).subspan(start, job.length);
+}
+
+template <unsigned short QueueCapacity, unsigned short BufferSize>
+void BleNotificationWorker::NotificationLane<QueueCapacity, BufferSize>::release()
+{
+    NotificationJob job;
+    if (jobs.pop(job))
+    {
+        releasedBytes.store(job.payloadEnd, std::memory_order_release);
+    }
+}
+
+bool BleNotificationWorker::reserveBursts(const unsigned int notificationCount, const unsigned int byteCount)
+{
+    if (bursts.hasRoom(notificationCount, byteCount))
+    {
+        return true;
+    }
+
+    droppedCount.store(droppedCount.load(std::memory_order_relaxed) + notificationCount, std::memory_order_relaxed);
+
+    return false;
+}
+
+void BleNotificationWorker::updateConnection(const unsigned short connectionHandle, const unsigned short connectionInterval)
+{
+    auto slot = std::ranges::find_if(connections, [connectionHandle](const Connection &connection)
+                                     { return connection.connectionHandle.load(std::memory_order_relaxed) == connectionHandle; });
+    if (slot == connections.end())
+    {
+        slot = std::ranges::find_if(connections, [](const Connection &connection)
+                                    { return connection.connectionHandle.load(std::memory_order_relaxed) == allClients; });
+        if (slot == connections.end())
+        {
+            return;
+        }
+        slot->notificationsPerSecond.store(0, std::memory_order_relaxed);
+        slot->bytesPerSecond.store(0, std::memory_order_relaxed);
+    }
+
+    slot->connectionInterval.store(connectionInterval, std::memory_order_relaxed);
+    slot->connectionHandle.store(connectionHandle, std::memory_order_release);
+}
+
+void BleNotificationWorker::removeConnection(const unsigned short connectionHandle)
+{
+    for (auto &connection : connections)
+    {
+        if (connection.connectionHandle.load(std::memory_order_relaxed) == connectionHandle)
+        {
+            connection.connectionHandle.store(allClients, std::memory_order_release);
+        }
+    }
+}
+
+unsigned int BleNotificationWorker::processPending()
+{
+    peakQueueDepth.store(std::max(peakQueueDepth.load(std::memory_order_relaxed), getQueueDepth()), std::memory_order_relaxed);
+
+    const auto isAnyConnected = hasConnections();
+    const auto now = isAnyConnected ? micros() : 0UL;
+    refreshConnections(now);
+
+    // Bursts only get the slots of the connection events that are left after every snapshot was sent
+    const auto isDrained = sendPending(snapshots, 0) && sendPending(bursts, reservedSnapshotSlots);
+
+    return isDrained || !isAnyConnected ? 0 : getNextEventDelay(now);
+}
+
+void BleNotificationWorker::reportStatistics(const unsigned long now)
+{
+    const auto currentDroppedCount = droppedCount.load(std::memory_order_relaxed);
+    const auto currentCoalescedCount = coalescedCount.load(std::memory_order_relaxed);
+    const auto currentPeakQueueDepth = peakQueueDepth.load(std::memory_order_relaxed);
+
+    const auto isDropping = currentDroppedCount != reportedDroppedCount;
+    const auto isChanged = isDropping || currentCoalescedCount != reportedCoalescedCount || currentPeakQueueDepth != reportedPeakQueueDepth;
+    if (!isChanged || (!isDropping && now - lastStatisticsReportTime < statisticsReportInterval))
+    {
+        return;
+    }
+
+    reportedDroppedCount = currentDroppedCount;
+    reportedCoalescedCount = currentCoalescedCount;
+    reportedPeakQueueDepth = currentPeakQueueDepth;
+    lastStatisticsReportTime = now;
+
+    if (isDropping)
+    {
+        Log.warningln("BLE notification queue was full, %u notifications were dropped (queue depth: %u, peak: %u, coalesced: %u)", currentDroppedCount, getQueueDepth(), currentPeakQueueDepth, currentCoalescedCount);
+
+        return;
+    }
+
+    Log.infoln("BLE notification queue depth: %u, peak: %u, dropped: %u, coalesced: %u", getQueueDepth(), currentPeakQueueDepth, currentDroppedCount, currentCoalescedCount);
+}
+
+constexpr bool BleNotificationWorker::isSnapshot(const NotificationType type)
+{
+    // Only the latest snapshot matters for these, while a chunked handle force curve or a batch of delta times needs to be sent in full
+    return type == NotificationType::BaseMetrics || type == NotificationType::ExtendedMetrics || type == NotificationType::Diagnostics;
+}
+
+template <typename TLane>
+bool BleNotificationWorker::isQueued(const TLane &lane, const NotificationType type, const unsigned short connectionHandle) const
+{
+    // The job at the head is the one being sent
+    auto i = 1U;
+    while (const auto *const job = lane.jobs.peek(i))
+    {
+        if (job->type == type && job->connectionHandle == connectionHandle)
+        {
+            return true;
+        }
+        ++i;
+    }
+
+    return false;
+}
+
+template <typename TLane>
+bool BleNotificationWorker::sendPending(TLane &lane, const unsigned char reservedSlots)
+{
+    while (const auto *const job = lane.jobs.peek(0))
+    {
+        if (isSnapshot(job->type) && isQueued(lane, job->type, job->connectionHandle))
+        {
+            coalescedCount.store(coalescedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        else
+        {
+            if (!hasFreeSlot(job->connectionHandle, reservedSlots))
+            {
+                return false;
+            }
+
+            job->characteristic->setValue(lane.getPayload(*job));
+            job->characteristic->notify(job->connectionHandle);
+            recordSent(job->connectionHandle, job->length);
+        }
+
+        lane.release();
+    }
+
+    return true;
+}
+
+bool BleNotificationWorker::hasConnections() const
+{
+    return std::ranges::any_of(connections, [](const Connection &connection)
+                               { return connection.connectionHandle.load(std::memory_order_acquire) != allClients; });
+}
+
+void BleNotificationWorker::refreshConnections(const unsigned long now)
+{
+    for (auto &connection : connections)
+    {
+        const auto connectionHandle = connection.connectionHandle.load(std::memory_order_acquire);
+        if (connectionHandle != connection.scheduledHandle)
+        {
+            connection.scheduledHandle = connectionHandle;
+            connection.freeSlots = Configurations::blePacketsPerConnectionEvent;
+            connection.eventStart = now;
+            connection.windowStart = now;
+            connection.windowNotificationCount = 0;
+            connection.windowByteCount = 0;
+
+            continue;
+        }
+
+        if (connectionHandle == allClients)
+        {
+            continue;
+        }
+
+        const auto interval = std::max(static_cast<unsigned int>(connection.connectionInterval.load(std::memory_order_relaxed)), 1U) * connectionIntervalUnit;
+        if (now - connection.eventStart >= interval)
+        {
+            connection.freeSlots = Configurations::blePacketsPerConnectionEvent;
+            connection.eventStart += (now - connection.eventStart) / interval * interval;
+        }
+
+        const auto elapsed = now - connection.windowStart;
+        if (elapsed >= throughputWindow)
+        {
+            connection.notificationsPerSecond.store(static_cast<unsigned short>(static_cast<unsigned long long>(connection.windowNotificationCount) * throughputWindow / elapsed), std::memory_order_relaxed);
+            connection.bytesPerSecond.store(static_cast<unsigned int>(static_cast<unsigned long long>(connection.windowByteCount) * throughputWindow / elapsed), std::memory_order_relaxed);
+            connection.publishTime.store(now, std::memory_order_relaxed);
+
+            connection.windowStart = now;
+            connection.windowNotificationCount = 0;
+            connection.windowByteCount = 0;
+        }
+    }
+}
+
+bool BleNotificationWorker::hasFreeSlot(const unsigned short connectionHandle, const unsigned char reservedSlots) const
+{
+    // A notification to every client needs a slot on every connection
+    return std::ranges::none_of(connections, [connectionHandle, reservedSlots](const Connection &connection)
+                                { return connection.scheduledHandle != allClients && (connectionHandle == allClients || connectionHandle == connection.scheduledHandle) && connection.freeSlots <= reservedSlots; });
+}
+
+void BleNotificationWorker::recordSent(const unsigned short connectionHandle, const unsigned short length)
+{
+    for (auto &connection : connections)
+    {
+        if (connection.scheduledHandle == allClients || (connectionHandle != allClients && connectionHandle != connection.scheduledHandle))
+        {
+            continue;
+        }
+
+        connection.freeSlots = connection.freeSlots > 0 ? connection.freeSlots - 1 : 0;
+        ++connection.windowNotificationCount;
+        connection.windowByteCount += length;
+    }
+}
+
+unsigned int BleNotificationWorker::getNextEventDelay(const unsigned long now) const
+{
+    const auto microsecondsPerMillisecond = 1'000UL;
+
+    auto nextEvent = static_cast<unsigned long>(throughputWindow);
+    for (const auto &connection : connections)
+    {
+        if (connection.scheduledHandle == allClients || connection.freeSlots == Configurations::blePacketsPerConnectionEvent)
+        {
+            continue;
+        }
+
+        const auto interval = std::max(static_cast<unsigned int>(connection.connectionInterval.load(std::memory_order_relaxed)), 1U) * connectionIntervalUnit;
+        const auto elapsed = now - connection.eventStart;
+        nextEvent = std::min(nextEvent, elapsed < interval ? interval - elapsed : 0UL);
+    }
+
+    return static_cast<unsigned int>(std::max((nextEvent + microsecondsPerMillisecond - 1) / microsecondsPerMillisecond, 1UL));
+}
+
+void BleNotificationWorker::drop()
+{
+    droppedCount.store(droppedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+unsigned int BleNotificationWorker::getQueueDepth() const
+{
+    return snapshots.jobs.size() + bursts.jobs.size();
+}
+
+unsigned int BleNotificationWorker::getPeakQueueDepth() const
+{
+    return peakQueueDepth.load(std::memory_order_relaxed);
+}
+
+unsigned int BleNotificationWorker::getDroppedCount() const
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+unsigned int BleNotificationWorker::getCoalescedCount() const
+{
+    return coalescedCount.load(std::memory_order_relaxed);
+}
+
+std::array<BleNotificationWorker::ClientThroughput, Configurations::maxConnectionCount> BleNotificationWorker::getThroughput() const
+{
+    std::array<ClientThroughput, Configurations::maxConnectionCount> throughput{};
+    if (!hasConnections())
+    {
+        return throughput;
+    }
+
+    // The rates are only updated while the task runs, so the ones older than two windows belong to an idle connection
+    const auto now = micros();
+    auto i = 0U;
+    while (i < connections.size())
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        const auto &connection = connections[i];
+        throughput[i].connectionHandle = connection.connectionHandle.load(std::memory_order_acquire);
+        if (throughput[i].connectionHandle != allClients && now - connection.publishTime.load(std::memory_order_relaxed) <= 2UL * throughputWindow)
+        {
+            throughput[i].notificationsPerSecond = connection.notificationsPerSecond.load(std::memory_order_relaxed);
+            throughput[i].bytesPerSecond = connection.bytesPerSecond.load(std::memory_order_relaxed);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        ++i;
+    }
+
+    return throughput;
+}
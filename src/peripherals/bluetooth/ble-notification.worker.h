@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+#include "Arduino.h"
+
+#include "../../utils/configuration.h"
+#include "../../utils/lock-free-queue.h"
+#include "./ble.enums.h"
+
+class NimBLECharacteristic;
+
+// Schedules the BLE notifications and sends them from one long-lived task on the second core. The services encode their payloads on the main loop and queue them (enqueue) into a preallocated payload buffer, the task is woken up and sends them (processPending). A notification goes either to every subscribed client or to one connection only (e.g. when it was sized for that client's MTU). Metrics snapshots (base and extended metrics, diagnostics) and bursts (handle force chunks, delta times) are queued separately and snapshots are always sent first. A snapshot that has a newer one of the same type for the same connection still waiting in the queue is skipped as coalesced, while notifications that do not fit into the queue are dropped, both are counted. Every connection reported by the connection callbacks gets a budget of notifications per connection interval, so the stack is not handed more than the link can send in one connection event. Bursts may not use the last slot of an event, which keeps one free for the next snapshot even while a long handle force curve or delta time backlog is waiting. The host does not see the connection event anchors, so the budget is refilled once per connection interval from when the connection was reported. Notifications for connections that are not known are sent without a budget
+class BleNotificationWorker
+{
+public:
+    enum class NotificationType : unsigned char
+    {
+        BaseMetrics,
+        ExtendedMetrics,
+        HandleForces,
+        DeltaTimes,
+        Diagnostics,
+    };
+
+    // Connection handle that sends the notification to every subscribed client (BLE_HS_CONN_HANDLE_NONE)
+    static constexpr unsigned short allClients = 0xFFFFU;
+
+    // Notifications and payload bytes sent to one client in the last second
+    struct ClientThroughput
+    {
+        unsigned short connectionHandle = allClients;
+        unsigned short notificationsPerSecond = 0;
+        unsigned int bytesPerSecond = 0;
+    };
+
+private:
+    static constexpr unsigned int throughputWindow = 1'000'000U;
+    // The connection interval is reported in units of 1.25 ms
+    static constexpr unsigned int connectionIntervalUnit = 1'250U;
+    static constexpr unsigned char reservedSnapshotSlots = 1U;
+    // Milliseconds between two reports of the queue statistics, drops are reported right away
+    static constexpr unsigned int statisticsReportInterval = 10'000U;
+
+    static_assert(Configurations::blePacketsPerConnectionEvent > reservedSnapshotSlots, "BLE connection events must fit more notifications than the ones reserved for the metrics snapshots");
+    // Forces of the longest curve plus the largest chunk header (split, chunk index and the scale of the int16 encoding) for every chunk
+    static_assert(Configurations::bleNotificationBufferSize >= Configurations::maxConnectionCount * (Configurations::driveHandleForcesCapacity * sizeof(float) + Configurations::bleMaxHandleForcesChunkCount * (2U + sizeof(float))) + BleNotificationLimits::maxPayloadLength, "BLE notification buffer must fit the longest handle force curve for every connection");
+
+    struct NotificationJob
+    {
+        NotificationType type = NotificationType::BaseMetrics;
+        NimBLECharacteristic *characteristic = nullptr;
+        unsigned short connectionHandle = allClients;
+        // Free running end position of the payload in the buffer (the payload is the length bytes before it)
+        unsigned int payloadEnd = 0;
+        unsigned short length = 0;
+    };
+
+    // Payloads are written and released in queue order, so the buffer is a ring as well: the main loop only moves writtenBytes and the task only moves releasedBytes
+    template <unsigned short QueueCapacity, unsigned short BufferSize>
+    struct NotificationLane
+    {
+        static_assert(BufferSize > 0 && (BufferSize & (BufferSize - 1U)) == 0, "BLE notification buffer size must be a power of two");
+        static_assert(BufferSize >= BleNotificationLimits::maxPayloadLength, "BLE notification buffer must fit the largest notification");
+
+        static constexpr unsigned int bufferIndexMask = BufferSize - 1U;
+
+        LockFreeQueue<NotificationJob, QueueCapacity> jobs;
+        std::array<std::byte, BufferSize> payloadBuffer{};
+
+        unsigned int writtenBytes = 0;
+        std::atomic<unsigned int> releasedBytes = 0;
+
+        bool push(NotificationType type, NimBLECharacteristic *characteristic, unsigned short connectionHandle, std::span<const std::byte> header, std::span<const std::byte> payload);
+        [[nodiscard]] bool hasRoom(unsigned int notificationCount, unsigned int byteCount) const;
+        [[nodiscard]] std::span<const std::byte> getPayload(const NotificationJob &job) const;
+        void release();
+    };
+
+    // The handle and the interval are set by the BLE host task, the rest is only used by the notification task
+    struct Connection
+    {
+        std::atomic<unsigned short> connectionHandle = allClients;
+        std::atomic<unsigned short> connectionInterval = 0;
+
+        unsigned short scheduledHandle = allClients;
+        unsigned char freeSlots = 0;
+        unsigned long eventStart = 0;
+
+        unsigned long windowStart = 0;
+        unsigned short windowNotificationCount = 0;
+        unsigned int windowByteCount = 0;
+
+        std::atomic<unsigned short> notificationsPerSecond = 0;
+        std::atomic<unsigned int> bytesPerSecond = 0;
+        std::atomic<unsigned long> publishTime = 0;
+    };
+
+    NotificationLane<Configurations::bleSnapshotQueueCapacity, Configurations::bleSnapshotBufferSize> snapshots;
+    NotificationLane<Configurations::bleNotificationQueueCapacity, Configurations::bleNotificationBufferSize> bursts;
+
+    std::array<Connection, Configurations::maxConnectionCount> connections{};
+
+    std::atomic<unsigned int> droppedCount = 0;
+    std::atomic<unsigned int> coalescedCount = 0;
+    std::atomic<unsigned int> peakQueueDepth = 0;
+    // Only used by the main loop when reporting the statistics
+    unsigned int reportedDroppedCount = 0;
+    unsigned int reportedCoalescedCount = 0;
+    unsigned int reportedPeakQueueDepth = 0;
+    unsigned long lastStatisticsReportTime = 0;
+
+    TaskHandle_t taskHandle = nullptr;
+
+    static void task(void *parameters);
+
+    [[nodiscard]] static constexpr bool isSnapshot(NotificationType type);
+    template <typename TLane>
+    [[nodiscard]] bool isQueued(const TLane &lane, NotificationType type, unsigned short connectionHandle) const;
+    template <typename TLane>
+    bool sendPending(TLane &lane, unsigned char reservedSlots);
+
+    [[nodiscard]] bool hasConnections() const;
+    void refreshConnections(unsigned long now);
+    [[nodiscard]] bool hasFreeSlot(unsigned short connectionHandle, unsigned char reservedSlots) const;
+    void recordSent(unsigned short connectionHandle, unsigned short length);
+    [[nodiscard]] unsigned int getNextEventDelay(unsigned long now) const;
+    void drop();
+
+public:
+    // Starts the notification task pinned to core 0
+    bool begin();
+
+    // Called from the main loop, returns false if the notification did not fit into the queue and was dropped. The header (if any) is sent in front of the payload within the same notification
+    bool enqueue(NotificationType type, NimBLECharacteristic *characteristic, std::span<const std::byte> payload);
+    bool enqueue(NotificationType type, NimBLECharacteristic *characteristic, std::span<const std::byte> header, std::span<const std::byte> payload);
+    // Same as above but the notification is only sent to the given connection
+    bool enqueue(NotificationType type, NimBLECharacteristic *characteristic, unsigned short connectionHandle, std::span<const std::byte> header, std::span<const std::byte> payload);
+
+    // Called from the main loop before queueing the chunks of one handle force curve, returns false and counts them as dropped if they do not all fit into the queue, so a curve is sent whole or not at all. The task only frees up space, so the chunks fit once this returned true
+    bool reserveBursts(unsigned int notificationCount, unsigned int byteCount);
+
+    // Called from the BLE host task when a client connects or its connection parameters change, and when it disconnects
+    void updateConnection(unsigned short connectionHandle, unsigned short connectionInterval);
+    void removeConnection(unsigned short connectionHandle);
+
+    // Called from the notification task, sends what the connection events allow and returns the ms until the next event if notifications are still waiting for one (0 otherwise)
+    unsigned int processPending();
+
+    // Called from the main loop, logs the queue depth, peak, dropped and coalesced counts if they changed since the last report. New drops are logged as a warning right away, other changes at most once per report interval
+    void reportStatistics(unsigned long now);
+
+    [[nodiscard]] unsigned int getQueueDepth() const;
+    [[nodiscard]] unsigned int getPeakQueueDepth() const;
+    [[nodiscard]] unsigned int getDroppedCount() const;
+    [[nodiscard]] unsigned int getCoalescedCount() const;
+    // Throughput of every known connection (slots without a connection have the allClients handle)
+    [[nodiscard]] std::array<ClientThroughput, Configurations::maxConnectionCount> getThroughput() const;
+};
@@ -1,6 +1,7 @@
 #include <array>
 #include <climits>
 #include <cmath>
+#include <span>
 #include <utility>
 
 #include "Arduino.h"
@@ -12,18 +13,15 @@
 #include "../../../utils/enums.h"
 #include "../../../utils/macros.h"
 #include "../ble-metrics.model.h"
+#include "../ble-notification.worker.h"
 #include "../ble.enums.h"
 #include "../callbacks/control-point.callbacks.h"
 #include "../callbacks/subscription-manager.callbacks.h"
 
 using std::array;
 
-BaseMetricsBleService::BaseMetricsBleService(ISettingsBleService &_settingsBleService, IEEPROMService &_eepromService) : controlPointCallbacks(_settingsBleService, _eepromService)
+BaseMetricsBleService::BaseMetricsBleService(ISettingsBleService &_settingsBleService, IEEPROMService &_eepromService, BleNotificationWorker &_notificationWorker) : notificationWorker(_notificationWorker), controlPointCallbacks(_settingsBleService, _eepromService)
 {
-    broadcastTask = [](void *)
-    {
-        ASSERT_SETUP_FAILED(__CLASS_NAME__);
-    };
 }
 
 NimBLEService *BaseMetricsBleService::setup(NimBLEServer *const server, const BleServiceFlag bleServiceFlag)
@@ -32,17 +30,17 @@ NimBLEService *BaseMetricsBleService::setup(NimBLEServer *const server, const Bl
     switch (bleServiceFlag)
     {
     case BleServiceFlag::CscService:
-        broadcastTask = cscTask;
+        broadcastMetrics = &BaseMetricsBleService::broadcastCsc;
 
         return setupCscServices(server);
 
     case BleServiceFlag::CpsService:
-        broadcastTask = pscTask;
+        broadcastMetrics = &BaseMetricsBleService::broadcastPsc;
 
         return setupPscServices(server);
 
     case BleServiceFlag::FtmsService:
-        broadcastTask = ftmsTask;
+        broadcastMetrics = &BaseMetricsBleService::broadcastFtms;
 
         return setupFtmsServices(server);
     }
@@ -52,20 +50,9 @@ NimBLEService *BaseMetricsBleService::setup(NimBLEServer *const server, const Bl
 
 void BaseMetricsBleService::broadcastBaseMetrics(const BleMetricsModel::BleMetricsData &data)
 {
-    ASSERT_SETUP_CALLED(parameters.characteristic);
-
-    parameters.data = data;
+    ASSERT_SETUP_CALLED(characteristic);
 
-    const auto coreStackSize = 2'528U;
-
-    xTaskCreatePinnedToCore(
-        BaseMetricsBleService::broadcastTask,
-        "notifyClients",
-        coreStackSize,
-        &parameters,
-        1,
-        nullptr,
-        0);
+    (this->*broadcastMetrics)(data);
 }
 
 const std::vector<unsigned char> &BaseMetricsBleService::getClientIds() const
@@ -73,124 +60,105 @@ const std::vector<unsigned char> &BaseMetricsBleService::getClientIds() const
     return connectionManager.getClientIds();
 }
 
-void (*BaseMetricsBleService::broadcastTask)(void *);
-
-void BaseMetricsBleService::cscTask(void *parameters)
+void BaseMetricsBleService::broadcastCsc(const BleMetricsModel::BleMetricsData &data)
 {
-    {
-        const auto *const params = static_cast<const BaseMetricsBleService::BaseMetricsParams *>(parameters);
-
-        const auto secInMicroSec = 1e6L;
-        const auto revTime = static_cast<unsigned short>(std::lroundl((params->data.revTime / secInMicroSec) * 1'024) % USHRT_MAX);
-        const auto revCount = static_cast<unsigned int>(std::lround(params->data.distance));
-        const auto strokeTime = static_cast<unsigned short>(std::lroundl((params->data.strokeTime / secInMicroSec) * 1'024) % USHRT_MAX);
-
-        const auto length = 11U;
-        array<unsigned char, length> temp = {
-            CSCSensorBleFlags::cscMeasurementFeaturesFlag,
-
-            static_cast<unsigned char>(revCount),
-            static_cast<unsigned char>(revCount >> 8),
-            static_cast<unsigned char>(revCount >> 16),
-            static_cast<unsigned char>(revCount >> 24),
-
-            static_cast<unsigned char>(revTime),
-            static_cast<unsigned char>(revTime >> 8),
-
-            static_cast<unsigned char>(params->data.strokeCount),
-            static_cast<unsigned char>(params->data.strokeCount >> 8),
-            static_cast<unsigned char>(strokeTime),
-            static_cast<unsigned char>(strokeTime >> 8),
-        };
-        params->characteristic->setValue(temp);
-        params->characteristic->notify();
-    }
-    vTaskDelete(nullptr);
+    const auto secInMicroSec = 1e6L;
+    const auto revTime = static_cast<unsigned short>(std::lroundl((data.revTime / secInMicroSec) * 1'024) % USHRT_MAX);
+    const auto revCount = static_cast<unsigned int>(std::lround(data.distance));
+    const auto strokeTime = static_cast<unsigned short>(std::lroundl((data.strokeTime / secInMicroSec) * 1'024) % USHRT_MAX);
+
+    const auto length = 11U;
+    array<unsigned char, length> temp = {
+        CSCSensorBleFlags::cscMeasurementFeaturesFlag,
+
+        static_cast<unsigned char>(revCount),
+        static_cast<unsigned char>(revCount >> 8),
+        static_cast<unsigned char>(revCount >> 16),
+        static_cast<unsigned char>(revCount >> 24),
+
+        static_cast<unsigned char>(revTime),
+        static_cast<unsigned char>(revTime >> 8),
+
+        static_cast<unsigned char>(data.strokeCount),
+        static_cast<unsigned char>(data.strokeCount >> 8),
+        static_cast<unsigned char>(strokeTime),
+        static_cast<unsigned char>(strokeTime >> 8),
+    };
+
+    notificationWorker.enqueue(BleNotificationWorker::NotificationType::BaseMetrics, characteristic, std::as_bytes(std::span(temp)));
 }
 
-void BaseMetricsBleService::pscTask(void *parameters)
+void BaseMetricsBleService::broadcastPsc(const BleMetricsModel::BleMetricsData &data)
 {
-    {
-        const auto *const params = static_cast<const BaseMetricsBleService::BaseMetricsParams *>(parameters);
-
-        const auto secInMicroSec = 1e6L;
-        const auto revTime = static_cast<unsigned short>(std::lroundl((params->data.revTime / secInMicroSec) * 2'048) % USHRT_MAX);
-        const auto revCount = static_cast<unsigned int>(std::lround(params->data.distance));
-        const auto strokeTime = static_cast<unsigned short>(std::lroundl((params->data.strokeTime / secInMicroSec) * 1'024) % USHRT_MAX);
-        const auto avgStrokePower = static_cast<short>(std::lround(params->data.avgStrokePower));
-
-        const auto length = 14U;
-        array<unsigned char, length> temp = {
-            static_cast<unsigned char>(PSCSensorBleFlags::pscMeasurementFeaturesFlag),
-            static_cast<unsigned char>(PSCSensorBleFlags::pscMeasurementFeaturesFlag >> 8),
-
-            static_cast<unsigned char>(avgStrokePower),
-            static_cast<unsigned char>(avgStrokePower >> 8),
-
-            static_cast<unsigned char>(revCount),
-            static_cast<unsigned char>(revCount >> 8),
-            static_cast<unsigned char>(revCount >> 16),
-            static_cast<unsigned char>(revCount >> 24),
-            static_cast<unsigned char>(revTime),
-            static_cast<unsigned char>(revTime >> 8),
-
-            static_cast<unsigned char>(params->data.strokeCount),
-            static_cast<unsigned char>(params->data.strokeCount >> 8),
-            static_cast<unsigned char>(strokeTime),
-            static_cast<unsigned char>(strokeTime >> 8),
-        };
-
-        params->characteristic->setValue(temp);
-        params->characteristic->notify();
-    }
-    vTaskDelete(nullptr);
+    const auto secInMicroSec = 1e6L;
+    const auto revTime = static_cast<unsigned short>(std::lroundl((data.revTime / secInMicroSec) * 2'048) % USHRT_MAX);
+    const auto revCount = static_cast<unsigned int>(std::lround(data.distance));
+    const auto strokeTime = static_cast<unsigned short>(std::lroundl((data.strokeTime / secInMicroSec) * 1'024) % USHRT_MAX);
+    const auto avgStrokePower = static_cast<short>(std::lround(data.avgStrokePower));
+
+    const auto length = 14U;
+    array<unsigned char, length> temp = {
+        static_cast<unsigned char>(PSCSensorBleFlags::pscMeasurementFeaturesFlag),
+        static_cast<unsigned char>(PSCSensorBleFlags::pscMeasurementFeaturesFlag >> 8),
+
+        static_cast<unsigned char>(avgStrokePower),
+        static_cast<unsigned char>(avgStrokePower >> 8),
+
+        static_cast<unsigned char>(revCount),
+        static_cast<unsigned char>(revCount >> 8),
+        static_cast<unsigned char>(revCount >> 16),
+        static_cast<unsigned char>(revCount >> 24),
+        static_cast<unsigned char>(revTime),
+        static_cast<unsigned char>(revTime >> 8),
+
+        static_cast<unsigned char>(data.strokeCount),
+        static_cast<unsigned char>(data.strokeCount >> 8),
+        static_cast<unsigned char>(strokeTime),
+        static_cast<unsigned char>(strokeTime >> 8),
+    };
+
+    notificationWorker.enqueue(BleNotificationWorker::NotificationType::BaseMetrics, characteristic, std::as_bytes(std::span(temp)));
 }
 
-void BaseMetricsBleService::ftmsTask(void *parameters)
+void BaseMetricsBleService::broadcastFtms(const BleMetricsModel::BleMetricsData &data)
 {
-    {
-        const auto *const params = static_cast<const BaseMetricsBleService::BaseMetricsParams *>(parameters);
-
-        const auto secInMicroSec = 1e6L;
-        const auto dragFactor = static_cast<unsigned short>(std::lround(params->data.dragCoefficient * 1e6));
+    const auto secInMicroSec = 1e6L;
+    const auto dragFactor = static_cast<unsigned short>(std::lround(data.dragCoefficient * 1e6));
 
-        const auto strokeTimeDelta = ((params->data.strokeTime - params->data.previousStrokeTime) / secInMicroSec / 60U);
-        const auto strokeRate = static_cast<unsigned char>(strokeTimeDelta > 0 ? std::lroundl((params->data.strokeCount - params->data.previousStrokeCount) / strokeTimeDelta) : 0);
+    const auto strokeTimeDelta = ((data.strokeTime - data.previousStrokeTime) / secInMicroSec / 60U);
+    const auto strokeRate = static_cast<unsigned char>(strokeTimeDelta > 0 ? std::lroundl((data.strokeCount - data.previousStrokeCount) / strokeTimeDelta) : 0);
 
-        const auto revTimeDelta = ((params->data.revTime - params->data.previousRevTime) / secInMicroSec);
-        const auto distanceDelta = ((params->data.distance - params->data.previousDistance) / 100U);
-        const auto pace500m = static_cast<unsigned short>(distanceDelta > 0 ? std::lroundl(500U * (revTimeDelta / distanceDelta)) : 0);
-        const auto distance = static_cast<unsigned int>(std::lround(params->data.distance / 100U));
-        const auto avgStrokePower = static_cast<short>(std::lround(params->data.avgStrokePower));
+    const auto revTimeDelta = ((data.revTime - data.previousRevTime) / secInMicroSec);
+    const auto distanceDelta = ((data.distance - data.previousDistance) / 100U);
+    const auto pace500m = static_cast<unsigned short>(distanceDelta > 0 ? std::lroundl(500U * (revTimeDelta / distanceDelta)) : 0);
+    const auto distance = static_cast<unsigned int>(std::lround(data.distance / 100U));
+    const auto avgStrokePower = static_cast<short>(std::lround(data.avgStrokePower));
 
-        const auto length = 14U;
-        array<unsigned char, length> temp = {
-            static_cast<unsigned char>(FTMSSensorBleFlags::ftmsMeasurementFeaturesFlag),
-            static_cast<unsigned char>(FTMSSensorBleFlags::ftmsMeasurementFeaturesFlag >> 8),
+    const auto length = 14U;
+    array<unsigned char, length> temp = {
+        static_cast<unsigned char>(FTMSSensorBleFlags::ftmsMeasurementFeaturesFlag),
+        static_cast<unsigned char>(FTMSSensorBleFlags::ftmsMeasurementFeaturesFlag >> 8),
 
-            // Stroke rate is with a resolution of 0.5. While this works for a rower it will not work for a kayak erg in all cases (as kayak stroke rate can be up to 160spm)
-            static_cast<unsigned char>(strokeRate * 2 > UCHAR_MAX ? UCHAR_MAX : strokeRate * 2),
-            static_cast<unsigned char>(params->data.strokeCount),
-            static_cast<unsigned char>(params->data.strokeCount >> 8),
+        // Stroke rate is with a resolution of 0.5. While this works for a rower it will not work for a kayak erg in all cases (as kayak stroke rate can be up to 160spm)
+        static_cast<unsigned char>(strokeRate * 2 > UCHAR_MAX ? UCHAR_MAX : strokeRate * 2),
+        static_cast<unsigned char>(data.strokeCount),
+        static_cast<unsigned char>(data.strokeCount >> 8),
 
-            static_cast<unsigned char>(distance),
-            static_cast<unsigned char>(distance >> 8),
-            static_cast<unsigned char>(distance >> 16),
+        static_cast<unsigned char>(distance),
+        static_cast<unsigned char>(distance >> 8),
+        static_cast<unsigned char>(distance >> 16),
 
-            static_cast<unsigned char>(pace500m),
-            static_cast<unsigned char>(pace500m >> 8),
+        static_cast<unsigned char>(pace500m),
+        static_cast<unsigned char>(pace500m >> 8),
 
-            static_cast<unsigned char>(avgStrokePower),
-            static_cast<unsigned char>(avgStrokePower >> 8),
+        static_cast<unsigned char>(avgStrokePower),
+        static_cast<unsigned char>(avgStrokePower >> 8),
 
-            static_cast<unsigned char>(dragFactor),
-            static_cast<unsigned char>(dragFactor >> 8),
-        };
+        static_cast<unsigned char>(dragFactor),
+        static_cast<unsigned char>(dragFactor >> 8),
+    };
 
-        params->characteristic->setValue(temp);
-        params->characteristic->notify();
-    }
-    vTaskDelete(nullptr);
+    notificationWorker.enqueue(BleNotificationWorker::NotificationType::BaseMetrics, characteristic, std::as_bytes(std::span(temp)));
 }
 
 NimBLEService *BaseMetricsBleService::setupCscServices(NimBLEServer *const server)
@@ -198,8 +166,8 @@ NimBLEService *BaseMetricsBleService::setupCscServices(NimBLEServer *const serve
     Log.infoln("Setting up Cycling Speed and Cadence Profile");
 
     auto *const cscService = server->createService(CSCSensorBleFlags::cyclingSpeedCadenceSvcUuid);
-    parameters.characteristic = cscService->createCharacteristic(CSCSensorBleFlags::cscMeasurementUuid, NIMBLE_PROPERTY::NOTIFY);
-    parameters.characteristic->setCallbacks(&connectionManager);
+    characteristic = cscService->createCharacteristic(CSCSensorBleFlags::cscMeasurementUuid, NIMBLE_PROPERTY::NOTIFY);
+    characteristic->setCallbacks(&connectionManager);
 
     cscService
         ->createCharacteristic(CSCSensorBleFlags::cscFeatureUuid, NIMBLE_PROPERTY::READ)
@@ -218,8 +186,8 @@ NimBLEService *BaseMetricsBleService::setupPscServices(NimBLEServer *const serve
 {
     Log.infoln("Setting up Cycling Power Profile");
     auto *const pscService = server->createService(PSCSensorBleFlags::cyclingPowerSvcUuid);
-    parameters.characteristic = pscService->createCharacteristic(PSCSensorBleFlags::pscMeasurementUuid, NIMBLE_PROPERTY::NOTIFY);
-    parameters.characteristic->setCallbacks(&connectionManager);
+    characteristic = pscService->createCharacteristic(PSCSensorBleFlags::pscMeasurementUuid, NIMBLE_PROPERTY::NOTIFY);
+    characteristic->setCallbacks(&connectionManager);
 
     pscService
         ->createCharacteristic(PSCSensorBleFlags::pscFeatureUuid, NIMBLE_PROPERTY::READ)
@@ -239,8 +207,8 @@ NimBLEService *BaseMetricsBleService::setupFtmsServices(NimBLEServer *const serv
     Log.infoln("Setting up Fitness Machine Profile");
 
     auto *const ftmsService = server->createService(FTMSSensorBleFlags::ftmsSvcUuid);
-    parameters.characteristic = ftmsService->createCharacteristic(FTMSSensorBleFlags::rowerDataUuid, NIMBLE_PROPERTY::NOTIFY);
-    parameters.characteristic->setCallbacks(&connectionManager);
+    characteristic = ftmsService->createCharacteristic(FTMSSensorBleFlags::rowerDataUuid, NIMBLE_PROPERTY::NOTIFY);
+    characteristic->setCallbacks(&connectionManager);
 
     ftmsService->createCharacteristic(FTMSSensorBleFlags::ftmsControlPointUuid, NIMBLE_PROPERTY::WRITE_NR | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::INDICATE)->setCallbacks(&controlPointCallbacks);
 
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "../ble-metrics.model.h"
+#include "../ble-notification.worker.h"
 #include "../callbacks/control-point.callbacks.h"
 #include "../callbacks/subscription-manager.callbacks.h"
 #include "./base-metrics.service.interface.h"
@@ -16,28 +17,24 @@ enum class BleServiceFlag : unsigned char;
 
 class BaseMetricsBleService final : public IBaseMetricsBleService
 {
+    BleNotificationWorker &notificationWorker;
     ControlPointCallbacks controlPointCallbacks;
-    SubscriptionManagerCallbacks connectionManager;
+    SubscriptionManagerCallbacks<> connectionManager;
 
-    struct BaseMetricsParams
-    {
-        NimBLECharacteristic *characteristic = nullptr;
-
-        BleMetricsModel::BleMetricsData data = {};
-    } parameters;
+    NimBLECharacteristic *characteristic = nullptr;
 
     NimBLEService *setupCscServices(NimBLEServer *server);
     NimBLEService *setupPscServices(NimBLEServer *server);
     NimBLEService *setupFtmsServices(NimBLEServer *server);
 
-    static void pscTask(void *parameters);
-    static void cscTask(void *parameters);
-    static void ftmsTask(void *parameters);
+    void broadcastPsc(const BleMetricsModel::BleMetricsData &data);
+    void broadcastCsc(const BleMetricsModel::BleMetricsData &data);
+    void broadcastFtms(const BleMetricsModel::BleMetricsData &data);
 
-    static void (*broadcastTask)(void *);
+    void (BaseMetricsBleService::*broadcastMetrics)(const BleMetricsModel::BleMetricsData &) = nullptr;
 
 public:
-    explicit BaseMetricsBleService(ISettingsBleService &_settingsBleService, IEEPROMService &_eepromService);
+    explicit BaseMetricsBleService(ISettingsBleService &_settingsBleService, IEEPROMService &_eepromService, BleNotificationWorker &_notificationWorker);
 
     NimBLEService *setup(NimBLEServer *server, BleServiceFlag bleServiceFlag) override;
 
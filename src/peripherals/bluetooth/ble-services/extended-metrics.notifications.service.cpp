@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <climits>
 #include <cmath>
 #include <cstddef>
-#include <iterator>
 #include <ranges>
 #include <span>
 #include <vector>
@@ -12,147 +14,278 @@
 
 #include "./extended-metrics.service.h"
 
+#include "../../../rower/pipeline-profiler.h"
 #include "../../../utils/configuration.h"
+#include "../../../utils/enums.h"
+#include "../../../utils/impulse-log/impulse-log.h"
 #include "../ble-metrics.model.h"
+#include "../ble-notification.worker.h"
+#include "../ble.enums.h"
+#include "../handle-forces.encoder.h"
 #include "../callbacks/subscription-manager.callbacks.h"
 
 using std::vector;
 
-void ExtendedMetricBleService::broadcastHandleForces(const vector<float> &handleForces)
+void ExtendedMetricBleService::broadcastHandleForces(const std::span<const float> handleForces, const BleMetricsModel::ClientSettingsList clientSettings)
 {
     ASSERT_SETUP_CALLED(handleForcesParams.characteristic);
 
-    const unsigned short mtu = calculateMtu(handleForcesParams.callbacks.getClientIds());
+    for (const auto &client : handleForcesParams.callbacks.getClients())
+    {
+        const auto mtu = client.isSubscribed ? calculateMtu(client.connectionHandle) : 0U;
+        if (mtu == 0)
+        {
+            continue;
+        }
 
-    handleForcesParams.chunkSize = (mtu - 3U - 2U) / sizeof(float);
-    handleForcesParams.handleForces = handleForces;
+        const auto settings = findClientSettings(clientSettings, client.connectionHandle);
+        if (settings.handleForcesEncoding == HandleForcesEncoding::Int16)
+        {
+            broadcastQuantizedHandleForces(handleForces, settings.handleForcesMaxError, client.connectionHandle, mtu);
 
-    const auto coreStackSize = 2'240U;
-    const auto variableStackSize = mtu > handleForcesParams.handleForces.size() * sizeof(float) ? handleForcesParams.handleForces.size() * sizeof(float) : mtu;
+            continue;
+        }
 
-    xTaskCreatePinnedToCore(
-        ExtendedMetricBleService::HandleForcesParams::task,
-        "notifyHandleForces",
-        coreStackSize + variableStackSize / 3,
-        &handleForcesParams,
-        1,
-        nullptr,
-        0);
+        broadcastFloatHandleForces(handleForces, client.connectionHandle, mtu);
+    }
 }
 
-void ExtendedMetricBleService::broadcastDeltaTimes(const vector<unsigned long> &deltaTimes)
+void ExtendedMetricBleService::broadcastFloatHandleForces(const std::span<const float> handleForces, const unsigned short connectionHandle, const unsigned short mtu)
 {
-    ASSERT_SETUP_CALLED(deltaTimesParams.characteristic);
+    const std::span<const std::byte> byteView = std::as_bytes(handleForces);
 
-    deltaTimesParams.deltaTimes = deltaTimes;
+    const size_t chunkSizeInBytes = (mtu - 3U - 2U) / sizeof(float) * sizeof(float);
+    const size_t totalBytes = byteView.size_bytes();
+    const size_t split = (totalBytes + chunkSizeInBytes - 1) / chunkSizeInBytes;
 
-    const auto coreStackSize = 2'368U;
+    Log.verboseln("Client: %d, chunk size(bytes): %u, number of chunks: %u", connectionHandle, chunkSizeInBytes, split);
 
-    xTaskCreatePinnedToCore(
-        ExtendedMetricBleService::DeltaTimesParams::task,
-        "notifyDeltaTimes",
-        coreStackSize + deltaTimesParams.deltaTimes.size() * sizeof(unsigned long) / 3,
-        &deltaTimesParams,
-        1,
-        nullptr,
-        0);
-}
+    constexpr auto headerSize = 2U;
+    if (!notificationWorker.reserveBursts(split, totalBytes + split * headerSize))
+    {
+        Log.verboseln("Client: %d, handle forces dropped as they do not fit the notification queue", connectionHandle);
 
-void ExtendedMetricBleService::broadcastExtendedMetrics(const Configurations::precision avgStrokePower, const unsigned int recoveryDuration, const unsigned int driveDuration, const Configurations::precision dragCoefficient)
-{
-    ASSERT_SETUP_CALLED(extendedMetricsParams.characteristic);
+        return;
+    }
 
-    extendedMetricsParams.avgStrokePower = avgStrokePower;
-    extendedMetricsParams.recoveryDuration = recoveryDuration;
-    extendedMetricsParams.driveDuration = driveDuration;
-    extendedMetricsParams.dragCoefficient = dragCoefficient;
-
-    const auto coreStackSize = 2'368U;
-
-    xTaskCreatePinnedToCore(
-        ExtendedMetricBleService::ExtendedMetricsParams::task,
-        "notifyExtendedMetrics",
-        coreStackSize,
-        &extendedMetricsParams,
-        1,
-        nullptr,
-        0);
+    size_t chunkIndex = 1;
+    for (const auto &chunk : byteView | std::views::chunk(chunkSizeInBytes))
+    {
+        const std::array<std::byte, headerSize> header = {
+            static_cast<std::byte>(split),
+            static_cast<std::byte>(chunkIndex++),
+        };
+
+        notificationWorker.enqueue(BleNotificationWorker::NotificationType::HandleForces, handleForcesParams.characteristic, connectionHandle, header, chunk);
+    }
 }
 
-void ExtendedMetricBleService::ExtendedMetricsParams::task(void *parameters)
+void ExtendedMetricBleService::broadcastQuantizedHandleForces(const std::span<const float> handleForces, const unsigned char maxError, const unsigned short connectionHandle, const unsigned short mtu)
 {
+    // The worker copies the payload when it is queued, so the encoder buffer can be reused for the next client
+    const auto points = std::as_bytes(handleForcesEncoder.encode(handleForces, maxError));
+    const auto scale = std::bit_cast<unsigned int>(handleForcesEncoder.getScale());
+
+    // Every chunk starts with the split, the chunk index and the scale so it can be decoded on its own
+    constexpr auto headerSize = 2U + sizeof(float);
+    const size_t chunkSizeInBytes = (mtu - 3U - headerSize) / handleForcesEncoder.getPointSize() * handleForcesEncoder.getPointSize();
+    const size_t split = (points.size() + chunkSizeInBytes - 1) / chunkSizeInBytes;
+
+    Log.verboseln("Client: %d, chunk size(bytes): %u, number of chunks: %u", connectionHandle, chunkSizeInBytes, split);
+
+    if (!notificationWorker.reserveBursts(split, points.size() + split * headerSize))
     {
-        const auto *const params = static_cast<const ExtendedMetricBleService::ExtendedMetricsParams *>(parameters);
-
-        const auto secInMicroSec = 1e6;
-        const auto avgStrokePower = static_cast<short>(std::lround(params->avgStrokePower));
-        const auto recoveryDuration = static_cast<unsigned short>(std::lround(params->recoveryDuration / secInMicroSec * 4'096));
-        const auto driveDuration = static_cast<unsigned short>(std::lround(params->driveDuration / secInMicroSec * 4'096));
-        const auto dragFactor = static_cast<unsigned short>(std::lround(params->dragCoefficient * 1e6));
-
-        const auto length = 8U;
-        std::array<unsigned char, length> temp = {
-            static_cast<unsigned char>(avgStrokePower),
-            static_cast<unsigned char>(avgStrokePower >> 8),
-
-            static_cast<unsigned char>(driveDuration),
-            static_cast<unsigned char>(driveDuration >> 8),
-            static_cast<unsigned char>(recoveryDuration),
-            static_cast<unsigned char>(recoveryDuration >> 8),
-
-            static_cast<unsigned char>(dragFactor),
-            static_cast<unsigned char>(dragFactor >> 8),
+        Log.verboseln("Client: %d, handle forces dropped as they do not fit the notification queue", connectionHandle);
+
+        return;
+    }
+
+    size_t chunkIndex = 1;
+    for (const auto &chunk : points | std::views::chunk(chunkSizeInBytes))
+    {
+        const std::array<std::byte, headerSize> header = {
+            static_cast<std::byte>(split),
+            static_cast<std::byte>(chunkIndex++),
+            static_cast<std::byte>(scale),
+            static_cast<std::byte>(scale >> 8),
+            static_cast<std::byte>(scale >> 16),
+            static_cast<std::byte>(scale >> 24),
         };
 
-        params->characteristic->setValue(temp);
-        params->characteristic->notify();
+        notificationWorker.enqueue(BleNotificationWorker::NotificationType::HandleForces, handleForcesParams.characteristic, connectionHandle, header, chunk);
     }
-    vTaskDelete(nullptr);
 }
 
-void ExtendedMetricBleService::HandleForcesParams::task(void *parameters)
+BleMetricsModel::ClientSettings ExtendedMetricBleService::findClientSettings(const BleMetricsModel::ClientSettingsList &clientSettings, const unsigned short connectionHandle)
 {
-    {
-        const auto *const params = static_cast<const ExtendedMetricBleService::HandleForcesParams *>(parameters);
+    const auto client = std::ranges::find(clientSettings, connectionHandle, &BleMetricsModel::ClientSettings::connectionHandle);
 
-        const std::span<const float> handleForces(params->handleForces);
-        const std::span<const std::byte> byteView = std::as_bytes(handleForces);
+    return client == clientSettings.end() ? BleMetricsModel::ClientSettings{.connectionHandle = connectionHandle} : *client;
+}
 
-        const size_t chunkSizeInBytes = params->chunkSize * sizeof(float);
-        const size_t totalBytes = byteView.size_bytes();
-        const size_t split = (totalBytes + chunkSizeInBytes - 1) / chunkSizeInBytes;
+void ExtendedMetricBleService::bufferDeltaTime(const unsigned long deltaTime, const BleMetricsModel::ClientSettingsList clientSettings)
+{
+    ASSERT_SETUP_CALLED(deltaTimesParams.characteristic);
 
-        Log.verboseln("Chunk size(bytes): %u, number of chunks: %u", chunkSizeInBytes, split);
+    for (auto &client : deltaTimesParams.callbacks.getClients())
+    {
+        const auto mtu = client.isSubscribed ? calculateMtu(client.connectionHandle) : 0U;
+        const auto minimumMtu = 100U;
+        if (mtu < minimumMtu)
+        {
+            continue;
+        }
 
-        std::vector<std::byte> buffer;
-        buffer.reserve(chunkSizeInBytes + 2);
+        auto &state = client.state;
+        const auto encoding = findClientSettings(clientSettings, client.connectionHandle).deltaTimeEncoding;
+        if (encoding != state.encoding)
+        {
+            // Delta times collected before the client switched the encoding are sent in their own format first
+            broadcastDeltaTimes(client);
+            state.encoding = encoding;
+        }
 
-        size_t chunkIndex = 1;
-        for (const auto &chunk : byteView | std::views::chunk(chunkSizeInBytes))
+        if (encoding == DeltaTimeEncoding::Varint)
         {
-            buffer.clear();
+            state.deltaTimeStream.push(deltaTime);
+
+            if (state.deltaTimeStream.data().size() + ImpulseLog::maxVarintLength > mtu - 3U)
+            {
+                broadcastDeltaTimes(client);
+            }
 
-            buffer.push_back(static_cast<std::byte>(split));
-            buffer.push_back(static_cast<std::byte>(chunkIndex++));
+            continue;
+        }
 
-            buffer.insert(cend(buffer), cbegin(chunk), cend(chunk));
+        state.deltaTimes[state.deltaTimeCount++] = deltaTime;
 
-            params->characteristic->setValue(buffer);
-            params->characteristic->notify();
+        if ((state.deltaTimeCount + 1U) * sizeof(unsigned long) > mtu - 3U)
+        {
+            broadcastDeltaTimes(client);
         }
     }
-    vTaskDelete(nullptr);
 }
 
-void ExtendedMetricBleService::DeltaTimesParams::task(void *parameters)
+void ExtendedMetricBleService::flushDeltaTimes(const unsigned int interval)
 {
+    ASSERT_SETUP_CALLED(deltaTimesParams.characteristic);
+
+    const auto now = millis();
+    for (auto &client : deltaTimesParams.callbacks.getClients())
+    {
+        const auto hasDeltaTimes = client.state.deltaTimeCount > 0 || !client.state.deltaTimeStream.empty();
+        if (client.isSubscribed && hasDeltaTimes && now - client.state.lastBroadcastTime > interval)
+        {
+            broadcastDeltaTimes(client);
+        }
+    }
+}
+
+void ExtendedMetricBleService::broadcastDeltaTimes(DeltaTimesClient &client)
+{
+    auto &state = client.state;
+
+    if (!state.deltaTimeStream.empty())
     {
-        const auto *const params = static_cast<const ExtendedMetricBleService::DeltaTimesParams *>(parameters);
+        notificationWorker.enqueue(BleNotificationWorker::NotificationType::DeltaTimes, deltaTimesParams.characteristic, client.connectionHandle, {}, std::as_bytes(state.deltaTimeStream.data()));
+        state.deltaTimeStream.next();
+    }
 
-        const std::span<const unsigned long> deltaTimes{params->deltaTimes};
-        const auto bytes = std::as_bytes(deltaTimes);
-        params->characteristic->setValue(bytes);
-        params->characteristic->notify();
+    if (state.deltaTimeCount > 0)
+    {
+        notificationWorker.enqueue(BleNotificationWorker::NotificationType::DeltaTimes, deltaTimesParams.characteristic, client.connectionHandle, {}, std::as_bytes(std::span(state.deltaTimes).first(state.deltaTimeCount)));
+        state.deltaTimeCount = 0;
     }
-    vTaskDelete(nullptr);
-}
\ No newline at end of file
+
+    state.lastBroadcastTime = millis();
+}
+
+void ExtendedMetricBleService::broadcastExtendedMetrics(const Configurations::precision avgStrokePower, const unsigned int recoveryDuration, const unsigned int driveDuration, const Configurations::precision dragCoefficient)
+{
+    ASSERT_SETUP_CALLED(extendedMetricsParams.characteristic);
+
+    const auto secInMicroSec = 1e6;
+    const auto avgStrokePowerValue = static_cast<short>(std::lround(avgStrokePower));
+    const auto recoveryDurationValue = static_cast<unsigned short>(std::lround(recoveryDuration / secInMicroSec * 4'096));
+    const auto driveDurationValue = static_cast<unsigned short>(std::lround(driveDuration / secInMicroSec * 4'096));
+    const auto dragFactor = static_cast<unsigned short>(std::lround(dragCoefficient * 1e6));
+
+    const auto length = 8U;
+    std::array<unsigned char, length> temp = {
+        static_cast<unsigned char>(avgStrokePowerValue),
+        static_cast<unsigned char>(avgStrokePowerValue >> 8),
+
+        static_cast<unsigned char>(driveDurationValue),
+        static_cast<unsigned char>(driveDurationValue >> 8),
+        static_cast<unsigned char>(recoveryDurationValue),
+        static_cast<unsigned char>(recoveryDurationValue >> 8),
+
+        static_cast<unsigned char>(dragFactor),
+        static_cast<unsigned char>(dragFactor >> 8),
+    };
+
+    notificationWorker.enqueue(BleNotificationWorker::NotificationType::ExtendedMetrics, extendedMetricsParams.characteristic, std::as_bytes(std::span(temp)));
+}
+
+void ExtendedMetricBleService::broadcastDiagnostics(const PipelineProfiler *const profiler, const RowingDataModels::RowingMetrics &data)
+{
+    ASSERT_SETUP_CALLED(diagnosticsParams.characteristic);
+
+    // Stage count and impulse count followed by the min, avg, max and p99 of every stage, then the notification throughput of every connection slot and the regression window. Without a profiler (firmware compiled without pipeline profiling) the stage count and the impulse count are zero and the stages are left out
+    const auto throughputLength = 2U * sizeof(unsigned short) + sizeof(unsigned int);
+    const auto regressionWindowStatusLength = sizeof(unsigned char) + sizeof(unsigned short);
+    const auto payloadLength = 5U + PipelineProfiler::stageCount * 4U * sizeof(unsigned short) + Configurations::maxConnectionCount * throughputLength + regressionWindowStatusLength;
+    std::array<unsigned char, payloadLength> payload{};
+    const auto stageCount = profiler == nullptr ? 0U : PipelineProfiler::stageCount;
+    const auto impulseCount = profiler == nullptr ? 0U : profiler->getStatistics(PipelineStage::CyclicFilter).getCount();
+    payload[0] = static_cast<unsigned char>(stageCount);
+    payload[1] = static_cast<unsigned char>(impulseCount);
+    payload[2] = static_cast<unsigned char>(impulseCount >> 8);
+    payload[3] = static_cast<unsigned char>(impulseCount >> 16);
+    payload[4] = static_cast<unsigned char>(impulseCount >> 24);
+
+    const auto ticksPerTenthMicrosecond = PipelineProfiler::ticksPerMicrosecond() / 10.0;
+    auto position = 5U;
+    const auto pushDuration = [&payload, &position, ticksPerTenthMicrosecond](const unsigned int ticks)
+    {
+        const auto tenthMicroseconds = static_cast<unsigned short>(std::min(std::lround(ticks / ticksPerTenthMicrosecond), static_cast<long>(USHRT_MAX)));
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        payload[position++] = static_cast<unsigned char>(tenthMicroseconds);
+        payload[position++] = static_cast<unsigned char>(tenthMicroseconds >> 8);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    };
+
+    auto i = 0U;
+    while (i < stageCount)
+    {
+        const auto &stage = profiler->getStatistics(static_cast<PipelineStage>(i));
+        pushDuration(stage.getMin());
+        pushDuration(stage.getAverage());
+        pushDuration(stage.getMax());
+        pushDuration(stage.getPercentile(99U));
+        ++i;
+    }
+
+    for (const auto &client : notificationWorker.getThroughput())
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        payload[position++] = static_cast<unsigned char>(client.connectionHandle);
+        payload[position++] = static_cast<unsigned char>(client.connectionHandle >> 8);
+        payload[position++] = static_cast<unsigned char>(client.notificationsPerSecond);
+        payload[position++] = static_cast<unsigned char>(client.notificationsPerSecond >> 8);
+        payload[position++] = static_cast<unsigned char>(client.bytesPerSecond);
+        payload[position++] = static_cast<unsigned char>(client.bytesPerSecond >> 8);
+        payload[position++] = static_cast<unsigned char>(client.bytesPerSecond >> 16);
+        payload[position++] = static_cast<unsigned char>(client.bytesPerSecond >> 24);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    const auto switchCount = static_cast<unsigned short>(std::min(data.regressionWindowSwitchCount, static_cast<unsigned int>(USHRT_MAX)));
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+    payload[position++] = data.regressionWindowLength;
+    payload[position++] = static_cast<unsigned char>(switchCount);
+    payload[position++] = static_cast<unsigned char>(switchCount >> 8);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+    notificationWorker.enqueue(BleNotificationWorker::NotificationType::Diagnostics, diagnosticsParams.characteristic, std::as_bytes(std::span(payload).first(position)));
+}
@@ -1,6 +1,4 @@
 #include <algorithm>
-#include <iterator>
-#include <numeric>
 #include <vector>
 
 #include "ArduinoLog.h"
@@ -8,11 +6,16 @@
 
 #include "./extended-metrics.service.h"
 
+#include "../ble-notification.worker.h"
 #include "../ble.enums.h"
 #include "../callbacks/subscription-manager.callbacks.h"
 
 using std::vector;
 
+ExtendedMetricBleService::ExtendedMetricBleService(BleNotificationWorker &_notificationWorker) : notificationWorker(_notificationWorker)
+{
+}
+
 NimBLEService *ExtendedMetricBleService::setup(NimBLEServer *const server)
 {
     Log.infoln("Setting up Extended Metrics Services");
@@ -26,6 +29,9 @@ NimBLEService *ExtendedMetricBleService::setup(NimBLEServer *const server)
     extendedMetricsParams.characteristic = extendedMetricsService->createCharacteristic(CommonBleFlags::extendedMetricsUuid, NIMBLE_PROPERTY::NOTIFY);
     extendedMetricsParams.characteristic->setCallbacks(&extendedMetricsParams.callbacks);
 
+    diagnosticsParams.characteristic = extendedMetricsService->createCharacteristic(CommonBleFlags::diagnosticsUuid, NIMBLE_PROPERTY::NOTIFY);
+    diagnosticsParams.characteristic->setCallbacks(&diagnosticsParams.callbacks);
+
     return extendedMetricsService;
 }
 
@@ -44,17 +50,14 @@ const vector<unsigned char> &ExtendedMetricBleService::getExtendedMetricsClientI
     return extendedMetricsParams.callbacks.getClientIds();
 }
 
-unsigned short ExtendedMetricBleService::calculateMtu(const std::vector<unsigned char> &clientIds) const
+const vector<unsigned char> &ExtendedMetricBleService::getDiagnosticsClientIds() const
 {
-    auto *const server = NimBLEDevice::getServer();
+    return diagnosticsParams.callbacks.getClientIds();
+}
 
-    return std::accumulate(cbegin(clientIds), cend(clientIds), 512, [&](unsigned short previousMtu, unsigned short clientId)
-                           {
-                    const auto currentMTU = server->getPeerMTU(clientId);
-                    if (currentMTU == 0)
-                    {
-                        return previousMtu;
-                    }
+unsigned short ExtendedMetricBleService::calculateMtu(const unsigned short clientId) const
+{
+    const auto maxMtu = 512U;
 
-                    return std::min(previousMtu, currentMTU); });
+    return std::min(NimBLEDevice::getServer()->getPeerMTU(clientId), static_cast<unsigned short>(maxMtu));
 }
\ No newline at end of file
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <array>
+#include <span>
 #include <vector>
 
+#include "../ble-metrics.model.h"
+#include "../ble-notification.worker.h"
+#include "../ble.enums.h"
+#include "../handle-forces.encoder.h"
 #include "../callbacks/subscription-manager.callbacks.h"
 #include "./extended-metrics.service.interface.h"
 #include "../../../utils/configuration.h"
+#include "../../../utils/impulse-log/delta-time-stream.h"
 
 class NimBLECharacteristic;
 class NimBLEServer;
@@ -14,52 +21,57 @@ using std::vector;
 
 class ExtendedMetricBleService final : public IExtendedMetricBleService
 {
-    struct ExtendedMetricsParams
-    {
-        NimBLECharacteristic *characteristic = nullptr;
-        SubscriptionManagerCallbacks callbacks;
-
-        Configurations::precision avgStrokePower = 0;
-        unsigned int recoveryDuration = 0;
-        unsigned int driveDuration = 0;
-        Configurations::precision dragCoefficient = 0;
+    static_assert(DeltaTimeStream::maxPacketSize <= BleNotificationLimits::maxPayloadLength, "Delta time stream packets must fit a BLE notification");
 
-        static void task(void *parameters);
-
-    } extendedMetricsParams;
-
-    struct HandleForcesParams
+    // Delta times waiting for the next notification of one client, so every client gets notifications filled up to its own MTU and paced on its own
+    struct DeltaTimesClientState
+    {
+        std::array<unsigned long, BleNotificationLimits::maxPayloadLength / sizeof(unsigned long)> deltaTimes{};
+        unsigned short deltaTimeCount = 0;
+        DeltaTimeStreamEncoder deltaTimeStream;
+        // Encoding the client chose via the settings control point
+        DeltaTimeEncoding encoding = DeltaTimeEncoding::Raw;
+        unsigned int lastBroadcastTime = 0;
+    };
+
+    template <typename TClientState = NoClientState>
+    struct CharacteristicParams
     {
         NimBLECharacteristic *characteristic = nullptr;
-        SubscriptionManagerCallbacks callbacks;
+        SubscriptionManagerCallbacks<TClientState> callbacks;
+    };
 
-        unsigned short chunkSize = (512U - 3 - 2) / sizeof(float);
-        vector<float> handleForces;
+    using DeltaTimesClient = SubscriptionManagerCallbacks<DeltaTimesClientState>::Client;
 
-        static void task(void *parameters);
+    BleNotificationWorker &notificationWorker;
+    HandleForcesEncoder handleForcesEncoder;
 
-    } handleForcesParams;
+    CharacteristicParams<> extendedMetricsParams;
+    CharacteristicParams<> handleForcesParams;
+    CharacteristicParams<DeltaTimesClientState> deltaTimesParams;
+    CharacteristicParams<> diagnosticsParams;
 
-    struct DeltaTimesParams
-    {
-        SubscriptionManagerCallbacks callbacks;
-        NimBLECharacteristic *characteristic = nullptr;
-        vector<unsigned long> deltaTimes;
-
-        static void task(void *parameters);
-
-    } deltaTimesParams;
+    [[nodiscard]] static BleMetricsModel::ClientSettings findClientSettings(const BleMetricsModel::ClientSettingsList &clientSettings, unsigned short connectionHandle);
+    void broadcastFloatHandleForces(std::span<const float> handleForces, unsigned short connectionHandle, unsigned short mtu);
+    void broadcastQuantizedHandleForces(std::span<const float> handleForces, unsigned char maxError, unsigned short connectionHandle, unsigned short mtu);
+    void broadcastDeltaTimes(DeltaTimesClient &client);
 
 public:
+    explicit ExtendedMetricBleService(BleNotificationWorker &_notificationWorker);
+
     NimBLEService *setup(NimBLEServer *server) override;
 
     [[nodiscard]] const vector<unsigned char> &getHandleForcesClientIds() const override;
     [[nodiscard]] const vector<unsigned char> &getDeltaTimesClientIds() const override;
     [[nodiscard]] const vector<unsigned char> &getExtendedMetricsClientIds() const override;
+    [[nodiscard]] const vector<unsigned char> &getDiagnosticsClientIds() const override;
 
-    [[nodiscard]] unsigned short calculateMtu(const std::vector<unsigned char> &clientIds) const override;
+    // MTU of one client (capped at 512), 0 if the connection is not known
+    [[nodiscard]] unsigned short calculateMtu(unsigned short clientId) const;
 
-    void broadcastHandleForces(const std::vector<float> &handleForces) override;
-    void broadcastDeltaTimes(const std::vector<unsigned long> &deltaTimes) override;
+    void broadcastHandleForces(std::span<const float> handleForces, BleMetricsModel::ClientSettingsList clientSettings) override;
+    void bufferDeltaTime(unsigned long deltaTime, BleMetricsModel::ClientSettingsList clientSettings) override;
+    void flushDeltaTimes(unsigned int interval) override;
     void broadcastExtendedMetrics(Configurations::precision avgStrokePower, unsigned int recoveryDuration, unsigned int driveDuration, Configurations::precision dragCoefficient) override;
+    void broadcastDiagnostics(const PipelineProfiler *profiler, const RowingDataModels::RowingMetrics &data) override;
 };
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "NimBLEDevice.h"
 
+#include "../../../rower/pipeline-profiler.h"
+#include "../../../rower/stroke.model.h"
 #include "../../../utils/configuration.h"
+#include "../ble-metrics.model.h"
+#include "../ble.enums.h"
 
 using std::vector;
 
@@ -19,10 +24,15 @@ public:
     [[nodiscard]] virtual const vector<unsigned char> &getHandleForcesClientIds() const = 0;
     [[nodiscard]] virtual const vector<unsigned char> &getDeltaTimesClientIds() const = 0;
     [[nodiscard]] virtual const vector<unsigned char> &getExtendedMetricsClientIds() const = 0;
-
-    [[nodiscard]] virtual unsigned short calculateMtu(const std::vector<unsigned char> &clientIds) const = 0;
-
-    virtual void broadcastHandleForces(const std::vector<float> &handleForces) = 0;
-    virtual void broadcastDeltaTimes(const std::vector<unsigned long> &deltaTimes) = 0;
+    [[nodiscard]] virtual const vector<unsigned char> &getDiagnosticsClientIds() const = 0;
+
+    // The handle forces are encoded in the format each subscribed client chose and chunked for its MTU separately
+    virtual void broadcastHandleForces(std::span<const float> handleForces, BleMetricsModel::ClientSettingsList clientSettings) = 0;
+    // Adds the delta time to the buffer of every subscribed client (with an MTU of at least 100) in the encoding the client chose, and sends a client's buffer once the next delta time might not fit its MTU
+    virtual void bufferDeltaTime(unsigned long deltaTime, BleMetricsModel::ClientSettingsList clientSettings) = 0;
+    // Sends the buffered delta times of the clients that did not get a notification for longer than the interval (in milliseconds)
+    virtual void flushDeltaTimes(unsigned int interval) = 0;
     virtual void broadcastExtendedMetrics(Configurations::precision avgStrokePower, unsigned int recoveryDuration, unsigned int driveDuration, Configurations::precision dragCoefficient) = 0;
+    // The regression window in use is taken from the metrics
+    virtual void broadcastDiagnostics(const PipelineProfiler *profiler, const RowingDataModels::RowingMetrics &data) = 0;
 };
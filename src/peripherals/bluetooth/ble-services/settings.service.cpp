@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <cmath>
 #include <type_traits>
@@ -18,10 +20,22 @@
 #include "../callbacks/control-point.callbacks.h"
 #include "./settings.service.interface.h"
 
+SettingsBleService::SettingsCallbacks::SettingsCallbacks(const SettingsBleService &_settingsBleService) : settingsBleService(_settingsBleService)
+{
+}
+
+void SettingsBleService::SettingsCallbacks::onRead(NimBLECharacteristic *const pCharacteristic, NimBLEConnInfo &connInfo)
+{
+    auto settings = settingsBleService.getSettings();
+    setClientSettings(settings, settingsBleService.findClientSettings(connInfo.getConnHandle()));
+    pCharacteristic->setValue(settings);
+}
+
 SettingsBleService::SettingsBleService(ISdCardService &_sdCardService, IEEPROMService &_eepromService)
     : sdCardService(_sdCardService),
       eepromService(_eepromService),
-      callbacks(*this, _eepromService)
+      callbacks(*this, _eepromService),
+      settingsCallbacks(*this)
 {
 }
 
@@ -33,6 +47,7 @@ NimBLEService *SettingsBleService::setup(NimBLEServer *const server)
     strokeSettingsCharacteristic = settingsService->createCharacteristic(CommonBleFlags::strokeDetectionSettingsUuid, NIMBLE_PROPERTY::NOTIFY | NIMBLE_PROPERTY::READ);
 
     settingsCharacteristic->setValue(getSettings());
+    settingsCharacteristic->setCallbacks(&settingsCallbacks);
     strokeSettingsCharacteristic->setValue(getStrokeDetectionSettings());
 
     settingsService->createCharacteristic(CommonBleFlags::settingsControlPointUuid, WRITE_NR | NIMBLE_PROPERTY::INDICATE)->setCallbacks(&callbacks);
@@ -44,8 +59,27 @@ void SettingsBleService::broadcastSettings() const
 {
     ASSERT_SETUP_CALLED(settingsCharacteristic);
 
-    settingsCharacteristic->setValue(getSettings());
-    settingsCharacteristic->notify();
+    // Every known connection gets the settings with its own client settings
+    auto settings = getSettings();
+    auto hasConnections = false;
+    for (const auto &client : getClientSettings())
+    {
+        if (client.connectionHandle == BLE_HS_CONN_HANDLE_NONE)
+        {
+            continue;
+        }
+
+        hasConnections = true;
+        setClientSettings(settings, client);
+        settingsCharacteristic->setValue(settings);
+        settingsCharacteristic->notify(client.connectionHandle);
+    }
+
+    if (!hasConnections)
+    {
+        settingsCharacteristic->setValue(settings);
+        settingsCharacteristic->notify();
+    }
 }
 
 void SettingsBleService::broadcastStrokeDetectionSettings() const
@@ -56,6 +90,107 @@ void SettingsBleService::broadcastStrokeDetectionSettings() const
     strokeSettingsCharacteristic->notify();
 }
 
+unsigned int SettingsBleService::packClientSettings(const BleMetricsModel::ClientSettings &settings)
+{
+    return settings.connectionHandle |
+           (static_cast<unsigned int>(std::to_underlying(settings.deltaTimeEncoding)) << deltaTimeEncodingShift) |
+           (static_cast<unsigned int>(std::to_underlying(settings.handleForcesEncoding)) << handleForcesEncodingShift) |
+           (static_cast<unsigned int>(settings.handleForcesMaxError) << handleForcesMaxErrorShift);
+}
+
+BleMetricsModel::ClientSettings SettingsBleService::unpackClientSettings(const unsigned int packedSettings)
+{
+    return BleMetricsModel::ClientSettings{
+        .connectionHandle = static_cast<unsigned short>(packedSettings & connectionHandleMask),
+        .deltaTimeEncoding = DeltaTimeEncoding{static_cast<unsigned char>((packedSettings >> deltaTimeEncodingShift) & encodingMask)},
+        .handleForcesEncoding = HandleForcesEncoding{static_cast<unsigned char>((packedSettings >> handleForcesEncodingShift) & encodingMask)},
+        .handleForcesMaxError = static_cast<unsigned char>(packedSettings >> handleForcesMaxErrorShift),
+    };
+}
+
+BleMetricsModel::ClientSettings SettingsBleService::findClientSettings(const unsigned short connectionHandle) const
+{
+    const auto clients = getClientSettings();
+    const auto client = std::ranges::find(clients, connectionHandle, &BleMetricsModel::ClientSettings::connectionHandle);
+
+    return client == clients.end() ? BleMetricsModel::ClientSettings{.connectionHandle = connectionHandle} : *client;
+}
+
+void SettingsBleService::storeClientSettings(const BleMetricsModel::ClientSettings &settings)
+{
+    auto slot = std::ranges::find_if(clientSettings, [&settings](const ClientSettingsSlot &slot)
+                                     { return (slot.packedSettings.load(std::memory_order_relaxed) & connectionHandleMask) == settings.connectionHandle; });
+    if (slot == clientSettings.end())
+    {
+        slot = std::ranges::find_if(clientSettings, [](const ClientSettingsSlot &slot)
+                                    { return (slot.packedSettings.load(std::memory_order_relaxed) & connectionHandleMask) == BLE_HS_CONN_HANDLE_NONE; });
+    }
+
+    if (slot == clientSettings.end())
+    {
+        Log.warningln("No free slot for the settings of connection %d", settings.connectionHandle);
+
+        return;
+    }
+
+    slot->packedSettings.store(packClientSettings(settings), std::memory_order_release);
+}
+
+void SettingsBleService::addConnection(const unsigned short connectionHandle)
+{
+    storeClientSettings({.connectionHandle = connectionHandle});
+}
+
+void SettingsBleService::removeConnection(const unsigned short connectionHandle)
+{
+    for (auto &slot : clientSettings)
+    {
+        if ((slot.packedSettings.load(std::memory_order_relaxed) & connectionHandleMask) == connectionHandle)
+        {
+            slot.packedSettings.store(BLE_HS_CONN_HANDLE_NONE, std::memory_order_release);
+        }
+    }
+}
+
+void SettingsBleService::setDeltaTimeEncoding(const unsigned short connectionHandle, const DeltaTimeEncoding encoding)
+{
+    auto settings = findClientSettings(connectionHandle);
+    settings.deltaTimeEncoding = encoding;
+    storeClientSettings(settings);
+}
+
+void SettingsBleService::setHandleForcesEncoding(const unsigned short connectionHandle, const HandleForcesEncoding encoding, const unsigned char maxError)
+{
+    auto settings = findClientSettings(connectionHandle);
+    settings.handleForcesEncoding = encoding;
+    settings.handleForcesMaxError = maxError;
+    storeClientSettings(settings);
+}
+
+BleMetricsModel::ClientSettingsList SettingsBleService::getClientSettings() const
+{
+    BleMetricsModel::ClientSettingsList clients{};
+    auto i = 0U;
+    while (i < Configurations::maxConnectionCount)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        clients[i] = unpackClientSettings(clientSettings[i].packedSettings.load(std::memory_order_acquire));
+        ++i;
+    }
+
+    return clients;
+}
+
+void SettingsBleService::setClientSettings(std::array<unsigned char, ISettingsBleService::settingsPayloadSize> &settings, const BleMetricsModel::ClientSettings &client)
+{
+    auto position = ISettingsBleService::settingsPayloadSize - ISettingsBleService::clientSettingsPayloadSize;
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+    settings[position++] = std::to_underlying(client.deltaTimeEncoding);
+    settings[position++] = std::to_underlying(client.handleForcesEncoding);
+    settings[position] = client.handleForcesMaxError;
+    // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
 std::array<unsigned char, ISettingsBleService::settingsPayloadSize> SettingsBleService::getSettings() const
 {
     const unsigned char baseSettings =
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
+#include "NimBLEDevice.h"
+
+#include "../../../utils/configuration.h"
 #include "../callbacks/control-point.callbacks.h"
+#include "../ble-metrics.model.h"
+#include "../ble.enums.h"
 #include "./settings.service.interface.h"
 
 class IEEPROMService;
@@ -13,14 +19,48 @@ class NimBLEService;
 
 class SettingsBleService final : public ISettingsBleService
 {
+    // Sets the value of the settings characteristic before a client reads it, so the client settings in it are the ones of that client
+    class SettingsCallbacks final : public NimBLECharacteristicCallbacks
+    {
+        const SettingsBleService &settingsBleService;
+
+    public:
+        explicit SettingsCallbacks(const SettingsBleService &_settingsBleService);
+
+        void onRead(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo &connInfo) override;
+    };
+
+    // The client settings of one connection are packed into one word (connection handle in the low 16 bits, the encodings and the handle forces max error above them), so the BLE host task can change them while the main loop reads them
+    struct ClientSettingsSlot
+    {
+        std::atomic<unsigned int> packedSettings = BLE_HS_CONN_HANDLE_NONE;
+    };
+
+    static constexpr unsigned int connectionHandleMask = 0xFFFFU;
+    static constexpr unsigned int deltaTimeEncodingShift = 16U;
+    static constexpr unsigned int handleForcesEncodingShift = 20U;
+    static constexpr unsigned int handleForcesMaxErrorShift = 24U;
+    static constexpr unsigned int encodingMask = 0x0FU;
+
     ISdCardService &sdCardService;
     IEEPROMService &eepromService;
 
     ControlPointCallbacks callbacks;
+    SettingsCallbacks settingsCallbacks;
     NimBLECharacteristic *settingsCharacteristic = nullptr;
     NimBLECharacteristic *strokeSettingsCharacteristic = nullptr;
 
+    // Chosen by each client via the control point and not persisted, so after a reconnect or a restart (or with clients that do not know about them) the original formats are used. Only written by the BLE host task
+    std::array<ClientSettingsSlot, Configurations::maxConnectionCount> clientSettings{};
+
+    [[nodiscard]] static unsigned int packClientSettings(const BleMetricsModel::ClientSettings &settings);
+    [[nodiscard]] static BleMetricsModel::ClientSettings unpackClientSettings(unsigned int packedSettings);
+    [[nodiscard]] BleMetricsModel::ClientSettings findClientSettings(unsigned short connectionHandle) const;
+    void storeClientSettings(const BleMetricsModel::ClientSettings &settings);
+
+    // The settings with the default client settings (all zero), setClientSettings replaces them with the ones of a client
     [[nodiscard]] std::array<unsigned char, ISettingsBleService::settingsPayloadSize> getSettings() const;
+    static void setClientSettings(std::array<unsigned char, ISettingsBleService::settingsPayloadSize> &settings, const BleMetricsModel::ClientSettings &client);
     [[nodiscard]] std::array<unsigned char, ISettingsBleService::strokeSettingsPayloadSize> getStrokeDetectionSettings() const;
 
 public:
@@ -29,4 +69,10 @@ public:
     NimBLEService *setup(NimBLEServer *server) override;
     void broadcastSettings() const override;
     void broadcastStrokeDetectionSettings() const override;
+
+    void addConnection(unsigned short connectionHandle) override;
+    void removeConnection(unsigned short connectionHandle) override;
+    void setDeltaTimeEncoding(unsigned short connectionHandle, DeltaTimeEncoding encoding) override;
+    void setHandleForcesEncoding(unsigned short connectionHandle, HandleForcesEncoding encoding, unsigned char maxError) override;
+    [[nodiscard]] BleMetricsModel::ClientSettingsList getClientSettings() const override;
 };
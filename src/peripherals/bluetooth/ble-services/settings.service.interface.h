@@ -5,6 +5,8 @@
 #include "NimBLEDevice.h"
 
 #include "../../../utils/enums.h"
+#include "../ble-metrics.model.h"
+#include "../ble.enums.h"
 
 class ISettingsBleService
 {
@@ -43,7 +45,9 @@ public:
     static constexpr unsigned char dragArrayLengthPayloadSize = 1U;
     static constexpr unsigned char dragFactorSettingsPayloadSize = goodnessOfFitPayloadSize + dragFactorRecoveryPeriodPayloadSize + lowerDragFactorPayloadSize + upperDragFactorPayloadSize + dragArrayLengthPayloadSize;
 
-    static constexpr unsigned char settingsPayloadSize = baseSettingsPayloadSize + machineSettingsPayloadSize + sensorSignalSettingsPayloadSize + dragFactorSettingsPayloadSize;
+    static constexpr unsigned char clientSettingsPayloadSize = 3U;
+
+    static constexpr unsigned char settingsPayloadSize = baseSettingsPayloadSize + machineSettingsPayloadSize + sensorSignalSettingsPayloadSize + dragFactorSettingsPayloadSize + clientSettingsPayloadSize;
 
     static constexpr unsigned char poweredTorquePayloadSize = 2U;
     static constexpr unsigned char dragTorquePayloadSize = 2U;
@@ -52,9 +56,20 @@ public:
     static constexpr unsigned char impulseAndDetectionTypePayloadSize = 1U;
     static constexpr unsigned char forceCapacityPayloadSize = 1U;
 
+    // Largest handle force simplification error (in per mille of the peak force) that can be requested
+    static constexpr unsigned char maxHandleForcesError = 100U;
+
     static constexpr unsigned char strokeSettingsPayloadSize = poweredTorquePayloadSize + dragTorquePayloadSize + recoverySlopePayloadSize + minimumStrokeTimesPayloadSize + impulseAndDetectionTypePayloadSize + forceCapacityPayloadSize;
 
     virtual NimBLEService *setup(NimBLEServer *server) = 0;
     virtual void broadcastSettings() const = 0;
     virtual void broadcastStrokeDetectionSettings() const = 0;
+
+    // Called from the BLE host task when a client connects and disconnects, a new connection starts with the default formats
+    virtual void addConnection(unsigned short connectionHandle) = 0;
+    virtual void removeConnection(unsigned short connectionHandle) = 0;
+    virtual void setDeltaTimeEncoding(unsigned short connectionHandle, DeltaTimeEncoding encoding) = 0;
+    virtual void setHandleForcesEncoding(unsigned short connectionHandle, HandleForcesEncoding encoding, unsigned char maxError) = 0;
+    // Formats of every connection slot (slots without a connection have the BLE_HS_CONN_HANDLE_NONE handle)
+    [[nodiscard]] virtual BleMetricsModel::ClientSettingsList getClientSettings() const = 0;
 };
\ No newline at end of file
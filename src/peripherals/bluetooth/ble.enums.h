@@ -9,6 +9,20 @@ enum class BleSignalStrength : signed char
     MaxPower = 9,
 };
 
+// Format of the delta time notifications, Raw is the array of 32 bit delta times and Varint is the compact encoding of DeltaTimeStream (see utils/impulse-log/delta-time-stream.h)
+enum class DeltaTimeEncoding : unsigned char
+{
+    Raw,
+    Varint,
+};
+
+// Format of the handle force notifications, Float is the array of 32 bit floats and Int16 is the quantized (and optionally simplified) curve of HandleForcesEncoder (see handle-forces.encoder.h)
+enum class HandleForcesEncoding : unsigned char
+{
+    Float,
+    Int16,
+};
+
 enum class SettingsOpCodes : unsigned char
 {
     SetCumulativeValue = 1U,
@@ -35,6 +49,7 @@ enum class SettingsOpCodes : unsigned char
     SetSensorSignalSettings = 22U,
     SetDragFactorSettings = 23U,
     SetStrokeDetectionSettings = 24U,
+    SetHandleForcesEncoding = 25U,
     RestartDevice = 31U,
     ResponseCode = 32U,
     ResponseCodeFtms = 128U,
@@ -89,6 +104,13 @@ public:
     static constexpr unsigned char ChainRing = 16U;
 };
 
+class BleNotificationLimits
+{
+public:
+    // Largest notification payload, i.e. the max MTU minus the ATT header
+    static constexpr unsigned short maxPayloadLength = 512U - 3U;
+};
+
 class CSCFeaturesFlags
 {
 public:
@@ -276,6 +298,7 @@ public:
     inline static const std::string extendedMetricsUuid = "808a0d51-efae-4f0c-b2e0-48bc180d65c3";
     inline static const std::string handleForcesUuid = "3d9c2760-cf91-41ee-87e9-fd99d5f129a4";
     inline static const std::string deltaTimesUuid = "ae5d11ea-62f6-4789-b809-6fc93fee92b9";
+    inline static const std::string diagnosticsUuid = "465ad695-ecb7-4399-83cb-e630e83c85fc";
 
     inline static const std::string otaServiceUuid = "ed249319-32c3-4e9f-83d7-7bb5aa5d5d4b";
     inline static const std::string otaRxUuid = "fbac1540-698b-40ff-a34e-f39e5b78d1cf";
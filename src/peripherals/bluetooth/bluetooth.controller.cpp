@@ -11,6 +11,7 @@
 
 #include "./bluetooth.controller.h"
 
+#include "../../rower/pipeline-profiler.h"
 #include "../../rower/stroke.model.h"
 #include "../../utils/EEPROM/EEPROM.service.interface.h"
 #include "../../utils/configuration.h"
@@ -37,11 +38,6 @@ BluetoothController::BluetoothController(IEEPROMService &_eepromService, IOtaUpd
       extendedMetricsBleService(_extendedMetricsBleService),
       connectionManagerCallbacks(_connectionManagerCallbacks)
 {
-    if constexpr (Configurations::enableBluetoothDeltaTimeLogging)
-    {
-        const auto maxMtu = 512 / sizeof(unsigned long);
-        bleDeltaTimes.reserve(maxMtu);
-    }
 }
 
 void BluetoothController::update()
@@ -56,10 +52,9 @@ void BluetoothController::update()
 
     if constexpr (Configurations::enableBluetoothDeltaTimeLogging)
     {
-        const auto &clientIds = extendedMetricsBleService.getDeltaTimesClientIds();
-        if (now - lastDeltaTimesBroadcastTime > bleUpdateInterval && !bleDeltaTimes.empty() && !clientIds.empty())
+        if (!extendedMetricsBleService.getDeltaTimesClientIds().empty())
         {
-            flushBleDeltaTimes(extendedMetricsBleService.calculateMtu(clientIds));
+            extendedMetricsBleService.flushDeltaTimes(bleUpdateInterval);
         }
     }
 }
@@ -211,26 +206,12 @@ void BluetoothController::notifyBattery(const unsigned char batteryLevel) const
 
 void BluetoothController::notifyNewDeltaTime(unsigned long deltaTime)
 {
-    const auto &clientIds = extendedMetricsBleService.getDeltaTimesClientIds();
-    if (clientIds.empty())
-    {
-        return;
-    }
-
-    const auto mtu = extendedMetricsBleService.calculateMtu(clientIds);
-
-    const auto minimumMtu = 100U;
-    if (mtu < minimumMtu)
+    if (extendedMetricsBleService.getDeltaTimesClientIds().empty())
     {
         return;
     }
 
-    bleDeltaTimes.push_back(deltaTime);
-
-    if ((bleDeltaTimes.size() + 1U) * sizeof(unsigned long) > mtu - 3U)
-    {
-        flushBleDeltaTimes(mtu);
-    }
+    extendedMetricsBleService.bufferDeltaTime(deltaTime, settingsBleService.getClientSettings());
 }
 
 void BluetoothController::notifyNewMetrics(const RowingDataModels::RowingMetrics &data)
@@ -253,7 +234,7 @@ void BluetoothController::notifyNewMetrics(const RowingDataModels::RowingMetrics
         const auto isHandleForcesSubscribed = !extendedMetricsBleService.getHandleForcesClientIds().empty();
         if (isHandleForcesSubscribed && !data.driveHandleForces.empty())
         {
-            extendedMetricsBleService.broadcastHandleForces(data.driveHandleForces);
+            extendedMetricsBleService.broadcastHandleForces(data.driveHandleForces, settingsBleService.getClientSettings());
         }
 
         const auto isExtendedSubscribed = !extendedMetricsBleService.getExtendedMetricsClientIds().empty();
@@ -261,6 +242,19 @@ void BluetoothController::notifyNewMetrics(const RowingDataModels::RowingMetrics
         {
             extendedMetricsBleService.broadcastExtendedMetrics(data.avgStrokePower, data.recoveryDuration, data.driveDuration, data.dragCoefficient);
         }
+
+        const auto isDiagnosticsSubscribed = !extendedMetricsBleService.getDiagnosticsClientIds().empty();
+        if (isDiagnosticsSubscribed)
+        {
+            if constexpr (Configurations::isPipelineProfilingEnabled)
+            {
+                extendedMetricsBleService.broadcastDiagnostics(&pipelineProfiler, data);
+            }
+            else
+            {
+                extendedMetricsBleService.broadcastDiagnostics(nullptr, data);
+            }
+        }
     }
 
     const auto isBaseMetricsSubscribed = !baseMetricsBleService.getClientIds().empty();
@@ -270,15 +264,4 @@ void BluetoothController::notifyNewMetrics(const RowingDataModels::RowingMetrics
     }
 
     lastMetricsBroadcastTime = millis();
-}
-
-void BluetoothController::flushBleDeltaTimes(const unsigned short mtu = 512U)
-{
-    extendedMetricsBleService.broadcastDeltaTimes(bleDeltaTimes);
-
-    vector<unsigned long> clear;
-    clear.reserve(mtu / sizeof(unsigned long) + 1U);
-    bleDeltaTimes.swap(clear);
-
-    lastDeltaTimesBroadcastTime = millis();
 }
\ No newline at end of file
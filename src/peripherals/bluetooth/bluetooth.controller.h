@@ -1,7 +1,6 @@
 #pragma once
 
 #include <string>
-#include <vector>
 
 #include "./ble-metrics.model.h"
 #include "./bluetooth.controller.interface.h"
@@ -16,8 +15,6 @@ class IOtaBleService;
 class IOtaUpdaterService;
 class ISettingsBleService;
 
-using std::vector;
-
 class BluetoothController final : public IBluetoothController
 {
     IEEPROMService &eepromService;
@@ -33,16 +30,12 @@ class BluetoothController final : public IBluetoothController
     IConnectionManagerCallbacks &connectionManagerCallbacks;
 
     unsigned int lastMetricsBroadcastTime = 0UL;
-    unsigned int lastDeltaTimesBroadcastTime = 0UL;
 
     BleMetricsModel::BleMetricsData bleData = {};
 
-    vector<unsigned long> bleDeltaTimes;
-
     void setupBleDevice();
     void setupServices();
     void setupAdvertisement(const std::string &deviceName) const;
-    void flushBleDeltaTimes(unsigned short mtu);
 
 public:
     explicit BluetoothController(IEEPROMService &_eepromService, IOtaUpdaterService &_otaService, ISettingsBleService &_settingsBleService, IBatteryBleService &_batteryBleService, IDeviceInfoBleService &_deviceInfoBleService, IOtaBleService &_otaBleService, IBaseMetricsBleService &_baseMetricsBleService, IExtendedMetricBleService &_extendedMetricsBleService, IConnectionManagerCallbacks &_connectionManagerCallbacks);
@@ -4,12 +4,21 @@
 #include "./connection-manager.callbacks.h"
 
 #include "../../../utils/configuration.h"
+#include "../ble-notification.worker.h"
+#include "../ble-services/settings.service.interface.h"
+
+ConnectionManagerCallbacks::ConnectionManagerCallbacks(BleNotificationWorker &_notificationWorker, ISettingsBleService &_settingsBleService) : notificationWorker(_notificationWorker), settingsBleService(_settingsBleService)
+{
+}
 
 void ConnectionManagerCallbacks::onConnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo)
 {
     connectionCount = pServer->getConnectedCount();
     Log.verboseln("Device connected, handle: %d, total connections: %d", connInfo.getConnHandle(), connectionCount);
 
+    notificationWorker.updateConnection(connInfo.getConnHandle(), connInfo.getConnInterval());
+    settingsBleService.addConnection(connInfo.getConnHandle());
+
     if (connectionCount < Configurations::maxConnectionCount)
     {
         auto *const advertising = NimBLEDevice::getAdvertising();
@@ -23,6 +32,16 @@ void ConnectionManagerCallbacks::onDisconnect(NimBLEServer *pServer, NimBLEConnI
     connectionCount = pServer->getConnectedCount();
 
     Log.verboseln("Device disconnected, handle: %d, remaining connections: %d", connInfo.getConnHandle(), connectionCount);
+
+    notificationWorker.removeConnection(connInfo.getConnHandle());
+    settingsBleService.removeConnection(connInfo.getConnHandle());
+}
+
+void ConnectionManagerCallbacks::onConnParamsUpdate(NimBLEConnInfo &connInfo)
+{
+    Log.verboseln("Connection parameters updated, handle: %d, interval: %d", connInfo.getConnHandle(), connInfo.getConnInterval());
+
+    notificationWorker.updateConnection(connInfo.getConnHandle(), connInfo.getConnInterval());
 }
 
 unsigned char ConnectionManagerCallbacks::getConnectionCount() const
@@ -2,16 +2,24 @@
 
 #include "./connection-manager.callbacks.interface.h"
 
+class BleNotificationWorker;
+class ISettingsBleService;
 class NimBLEConnInfo;
 class NimBLEServer;
 
 class ConnectionManagerCallbacks final : public IConnectionManagerCallbacks
 {
+    BleNotificationWorker &notificationWorker;
+    ISettingsBleService &settingsBleService;
+
     unsigned char connectionCount = 0;
 
 public:
+    explicit ConnectionManagerCallbacks(BleNotificationWorker &_notificationWorker, ISettingsBleService &_settingsBleService);
+
     void onConnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo) override;
     void onDisconnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo, int reason) override;
+    void onConnParamsUpdate(NimBLEConnInfo &connInfo) override;
 
     [[nodiscard]] unsigned char getConnectionCount() const override;
 };
\ No newline at end of file
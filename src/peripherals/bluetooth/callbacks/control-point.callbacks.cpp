@@ -24,7 +24,7 @@ ControlPointCallbacks::ControlPointCallbacks(ISettingsBleService &_settingsBleSe
 {
 }
 
-void ControlPointCallbacks::onWrite(NimBLECharacteristic *const pCharacteristic, [[maybe_unused]] NimBLEConnInfo &connInfo)
+void ControlPointCallbacks::onWrite(NimBLECharacteristic *const pCharacteristic, NimBLEConnInfo &connInfo)
 {
     NimBLEAttValue message = pCharacteristic->getValue();
 
@@ -108,7 +108,7 @@ void ControlPointCallbacks::onWrite(NimBLECharacteristic *const pCharacteristic,
     {
         Log.infoln("Change deltaTime logging");
 
-        const auto response = processDeltaTimeLogging(message);
+        const auto response = processDeltaTimeLogging(message, connInfo.getConnHandle());
 
         array<unsigned char, 3U> temp = {
             std::to_underlying(SettingsOpCodes::ResponseCode),
@@ -240,6 +240,36 @@ void ControlPointCallbacks::onWrite(NimBLECharacteristic *const pCharacteristic,
         break;
     }
 
+    case std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding):
+    {
+        Log.infoln("Change Handle Forces Encoding");
+
+        if constexpr (!Configurations::hasExtendedBleMetrics)
+        {
+            array<unsigned char, 3U> temp = {
+                std::to_underlying(SettingsOpCodes::ResponseCode),
+                message[0],
+                std::to_underlying(ResponseOpCodes::UnsupportedOpCode),
+            };
+
+            pCharacteristic->setValue(temp);
+
+            break;
+        }
+
+        const auto response = processHandleForcesEncoding(message, connInfo.getConnHandle());
+
+        array<unsigned char, 3U> temp = {
+            std::to_underlying(SettingsOpCodes::ResponseCode),
+            message[0],
+            std::to_underlying(response),
+        };
+
+        pCharacteristic->setValue(temp);
+
+        break;
+    }
+
     case std::to_underlying(SettingsOpCodes::RestartDevice):
     {
         Log.verboseln("Restarting device...");
@@ -305,19 +335,56 @@ ResponseOpCodes ControlPointCallbacks::processSdCardLogging(const NimBLEAttValue
     return ResponseOpCodes::Successful;
 }
 
-ResponseOpCodes ControlPointCallbacks::processDeltaTimeLogging(const NimBLEAttValue &message)
+ResponseOpCodes ControlPointCallbacks::processDeltaTimeLogging(const NimBLEAttValue &message, const unsigned short connectionHandle)
 {
-    if (message.size() != 2 || !isInBounds(static_cast<unsigned int>(message[1]), 0U, 1U))
+    if ((message.size() != 2 && message.size() != 3) || !isInBounds(static_cast<unsigned int>(message[1]), 0U, 1U))
     {
         Log.infoln("Invalid OP command for setting deltaTime logging, this should be a bool: %d", message[1]);
 
         return ResponseOpCodes::InvalidParameter;
     }
 
+    // The optional third byte selects the encoding of the delta time notifications of the writing client, clients that omit it get the raw format
+    const auto encoding = message.size() == 3 ? message[2] : std::to_underlying(DeltaTimeEncoding::Raw);
+    if (!isInBounds(static_cast<unsigned int>(encoding), 0U, static_cast<unsigned int>(std::to_underlying(DeltaTimeEncoding::Varint))))
+    {
+        Log.infoln("Invalid deltaTime encoding: %d", encoding);
+
+        return ResponseOpCodes::InvalidParameter;
+    }
+
     const auto shouldEnable = static_cast<bool>(message[1]);
 
-    Log.infoln("%s deltaTime logging", shouldEnable ? "Enable" : "Disable");
+    Log.infoln("%s deltaTime logging (client: %d, encoding: %d)", shouldEnable ? "Enable" : "Disable", connectionHandle, encoding);
     eepromService.setLogToBluetooth(shouldEnable);
+    settingsBleService.setDeltaTimeEncoding(connectionHandle, DeltaTimeEncoding{encoding});
+
+    settingsBleService.broadcastSettings();
+
+    return ResponseOpCodes::Successful;
+}
+
+ResponseOpCodes ControlPointCallbacks::processHandleForcesEncoding(const NimBLEAttValue &message, const unsigned short connectionHandle)
+{
+    // The encoding applies to the handle force notifications of the writing client. The optional third byte is the max error of the curve simplification in per mille of the peak force, clients that omit it get every value
+    if ((message.size() != 2 && message.size() != 3) || !isInBounds(static_cast<unsigned int>(message[1]), 0U, static_cast<unsigned int>(std::to_underlying(HandleForcesEncoding::Int16))))
+    {
+        Log.infoln("Invalid OP command for setting handle forces encoding: %d", message[1]);
+
+        return ResponseOpCodes::InvalidParameter;
+    }
+
+    const auto encoding = HandleForcesEncoding{message[1]};
+    const auto maxError = message.size() == 3 ? message[2] : static_cast<unsigned char>(0);
+    if (maxError > ISettingsBleService::maxHandleForcesError || (encoding == HandleForcesEncoding::Float && maxError != 0))
+    {
+        Log.infoln("Invalid handle forces simplification error: %d", maxError);
+
+        return ResponseOpCodes::InvalidParameter;
+    }
+
+    Log.infoln("Handle forces encoding: %d, max error: %d per mille (client: %d)", message[1], maxError, connectionHandle);
+    settingsBleService.setHandleForcesEncoding(connectionHandle, encoding, maxError);
 
     settingsBleService.broadcastSettings();
 
@@ -14,7 +14,8 @@ class ControlPointCallbacks final : public NimBLECharacteristicCallbacks
 
     ResponseOpCodes processSdCardLogging(const NimBLEAttValue &message);
     ResponseOpCodes processLogLevel(const NimBLEAttValue &message);
-    ResponseOpCodes processDeltaTimeLogging(const NimBLEAttValue &message);
+    ResponseOpCodes processDeltaTimeLogging(const NimBLEAttValue &message, unsigned short connectionHandle);
+    ResponseOpCodes processHandleForcesEncoding(const NimBLEAttValue &message, unsigned short connectionHandle);
     void processBleServiceChange(const NimBLEAttValue &message, NimBLECharacteristic *pCharacteristic);
     ResponseOpCodes processMachineSettingsChange(const NimBLEAttValue &message);
     ResponseOpCodes processSensorSignalSettingsChange(const NimBLEAttValue &message);
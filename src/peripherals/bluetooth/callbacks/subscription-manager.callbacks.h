@@ -1,17 +1,113 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <span>
 #include <vector>
 
 #include "NimBLEDevice.h"
 
+#include "../../../utils/configuration.h"
+
+// For characteristics that only need to know who is subscribed
+struct NoClientState
+{
+};
+
+// Keeps track of the clients subscribed to a characteristic. Every client gets its own slot with a state (e.g. buffered data, time of the last notification) so notifications can be sized and paced for each connection separately instead of for the slowest one. The BLE host task only publishes the subscription of every slot (connection handle, subscribed flag and a generation that changes with every new subscription) as one atomic word, and the main loop applies them to the slots when it asks for the clients. This way the client states are only used by the main loop, and a slot is reset for its new client there when its generation changed
+template <typename TClientState = NoClientState>
 class SubscriptionManagerCallbacks final : public NimBLECharacteristicCallbacks
 {
+public:
+    struct Client
+    {
+        unsigned short connectionHandle = 0;
+        bool isSubscribed = false;
+        TClientState state{};
+    };
+
+private:
+    static constexpr unsigned int connectionHandleMask = 0xFFFFU;
+    static constexpr unsigned int subscribedFlag = 1U << 16U;
+    static constexpr unsigned int generationShift = 17U;
+
     std::vector<unsigned char> clientIds;
+    // Only written by the BLE host task
+    std::array<std::atomic<unsigned int>, Configurations::maxConnectionCount> subscriptions{};
+    // Only used by the main loop
+    std::array<unsigned int, Configurations::maxConnectionCount> appliedSubscriptions{};
+    std::array<Client, Configurations::maxConnectionCount> clients{};
 
 public:
-    SubscriptionManagerCallbacks();
+    SubscriptionManagerCallbacks()
+    {
+        clientIds.reserve(Configurations::maxConnectionCount);
+    }
+
+    void onSubscribe([[maybe_unused]] NimBLECharacteristic *const pCharacteristic, NimBLEConnInfo &connInfo, unsigned short subValue) override
+    {
+        const auto connectionHandle = connInfo.getConnHandle();
+
+        const auto [first, last] = std::ranges::remove_if(clientIds, [&](unsigned char connectionId)
+                                                          { return connectionId == connectionHandle; });
+        clientIds.erase(
+            first,
+            last);
+
+        for (auto &subscription : subscriptions)
+        {
+            const auto current = subscription.load(std::memory_order_relaxed);
+            if ((current & subscribedFlag) != 0U && (current & connectionHandleMask) == connectionHandle)
+            {
+                subscription.store(current & ~subscribedFlag, std::memory_order_release);
+            }
+        }
+
+        if (subValue == 0)
+        {
+            return;
+        }
+
+        clientIds.push_back(connectionHandle);
+
+        const auto slot = std::ranges::find_if(subscriptions, [](const std::atomic<unsigned int> &subscription)
+                                               { return (subscription.load(std::memory_order_relaxed) & subscribedFlag) == 0U; });
+        if (slot != subscriptions.end())
+        {
+            const auto generation = (slot->load(std::memory_order_relaxed) >> generationShift) + 1U;
+            slot->store((generation << generationShift) | subscribedFlag | connectionHandle, std::memory_order_release);
+        }
+    }
+
+    [[nodiscard]] const std::vector<unsigned char> &getClientIds() const
+    {
+        return clientIds;
+    }
 
-    void onSubscribe(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo &connInfo, unsigned short subValue) override;
+    // Main loop only: applies the subscriptions that changed since the last call and returns all slots, only the ones with isSubscribed belong to a client
+    [[nodiscard]] std::span<Client> getClients()
+    {
+        auto i = 0U;
+        while (i < Configurations::maxConnectionCount)
+        {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            const auto subscription = subscriptions[i].load(std::memory_order_acquire);
+            if (subscription != appliedSubscriptions[i])
+            {
+                auto &client = clients[i];
+                if ((subscription >> generationShift) != (appliedSubscriptions[i] >> generationShift))
+                {
+                    client = {};
+                }
+                client.connectionHandle = static_cast<unsigned short>(subscription & connectionHandleMask);
+                client.isSubscribed = (subscription & subscribedFlag) != 0U;
+                appliedSubscriptions[i] = subscription;
+            }
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            ++i;
+        }
 
-    [[nodiscard]] const std::vector<unsigned char> &getClientIds() const;
-};
\ No newline at end of file
+        return clients;
+    }
+};
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "./handle-forces.encoder.h"
+
+#include "../../utils/configuration.h"
+
+std::span<const unsigned char> HandleForcesEncoder::encode(const std::span<const float> handleForces, const unsigned char maxError)
+{
+    const auto count = std::min(handleForces.size(), values.size());
+    quantize(handleForces.first(count));
+
+    pointSize = maxError == 0 ? valueSize : indexedValueSize;
+    if (maxError == 0)
+    {
+        std::ranges::fill(isKept, true);
+    }
+    else
+    {
+        const auto perMille = 1'000.0F;
+        simplify(count, static_cast<float>(maxError) / perMille * SHRT_MAX);
+    }
+
+    auto length = 0U;
+    auto i = 0U;
+    while (i < count)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (isKept[i])
+        {
+            if (pointSize == indexedValueSize)
+            {
+                points[length++] = static_cast<unsigned char>(i);
+            }
+            points[length++] = static_cast<unsigned char>(values[i]);
+            points[length++] = static_cast<unsigned char>(values[i] >> 8);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        ++i;
+    }
+
+    return std::span(points).first(length);
+}
+
+void HandleForcesEncoder::quantize(const std::span<const float> handleForces)
+{
+    auto peak = 0.0F;
+    for (const auto force : handleForces)
+    {
+        peak = std::max(peak, std::abs(force));
+    }
+    scale = peak > 0.0F ? peak / SHRT_MAX : 1.0F;
+
+    auto i = 0U;
+    while (i < handleForces.size())
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        values[i] = static_cast<short>(std::lround(handleForces[i] / scale));
+        ++i;
+    }
+}
+
+void HandleForcesEncoder::simplify(const size_t count, const float maxError)
+{
+    std::ranges::fill(isKept, false);
+    if (count == 0)
+    {
+        return;
+    }
+    isKept.front() = true;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    isKept[count - 1U] = true;
+
+    // Every split keeps a point, so there are never more open segments than points
+    std::array<std::pair<unsigned char, unsigned char>, Configurations::driveHandleForcesCapacity> segments{};
+    auto segmentCount = 0U;
+    if (count > 2U)
+    {
+        segments[segmentCount++] = {0U, static_cast<unsigned char>(count - 1U)};
+    }
+
+    while (segmentCount > 0U)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        const auto [start, end] = segments[--segmentCount];
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        const auto startValue = static_cast<float>(values[start]);
+        const auto slope = (static_cast<float>(values[end]) - startValue) / static_cast<float>(end - start);
+
+        unsigned int furthest = start;
+        auto furthestError = 0.0F;
+        auto i = start + 1U;
+        while (i < end)
+        {
+            const auto error = std::abs(static_cast<float>(values[i]) - (startValue + slope * static_cast<float>(i - start)));
+            if (error > furthestError)
+            {
+                furthest = i;
+                furthestError = error;
+            }
+            ++i;
+        }
+
+        if (furthestError <= maxError)
+        {
+            continue;
+        }
+
+        isKept[furthest] = true;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (furthest - start > 1U)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            segments[segmentCount++] = {start, static_cast<unsigned char>(furthest)};
+        }
+        if (end - furthest > 1U)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            segments[segmentCount++] = {static_cast<unsigned char>(furthest), end};
+        }
+    }
+}
+
+float HandleForcesEncoder::getScale() const
+{
+    return scale;
+}
+
+unsigned char HandleForcesEncoder::getPointSize() const
+{
+    return pointSize;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "../../utils/configuration.h"
+
+// Compact encoding of the handle force curve that clients can opt in to via the settings control point instead of the 32 bit floats. The forces are quantized to int16 with a per stroke scale that maps the largest force to INT16_MAX (so the rounding error stays below 0.002% of the peak), and optionally only the points needed to redraw the curve with straight lines within a given error are kept (Ramer-Douglas-Peucker with the vertical distance as the error)
+class HandleForcesEncoder
+{
+public:
+    // An int16 value (Little Endian) and, when the curve is simplified, the sample index (UInt8) in front of it
+    static constexpr unsigned char valueSize = 2U;
+    static constexpr unsigned char indexedValueSize = 3U;
+
+private:
+    std::array<short, Configurations::driveHandleForcesCapacity> values{};
+    std::array<bool, Configurations::driveHandleForcesCapacity> isKept{};
+    std::array<unsigned char, Configurations::driveHandleForcesCapacity * indexedValueSize> points{};
+    float scale = 1.0F;
+    unsigned char pointSize = valueSize;
+
+    void quantize(std::span<const float> handleForces);
+    void simplify(size_t count, float maxError);
+
+public:
+    // Encodes the curve into points of pointSize bytes, maxError is in per mille of the largest force (0 keeps every value without the sample index)
+    std::span<const unsigned char> encode(std::span<const float> handleForces, unsigned char maxError);
+
+    // Force of one int16 step in N
+    [[nodiscard]] float getScale() const;
+    [[nodiscard]] unsigned char getPointSize() const;
+};
@@ -8,7 +8,6 @@
 #include "../utils/EEPROM/EEPROM.service.interface.h"
 #include "../utils/configuration.h"
 #include "../utils/enums.h"
-#include "../utils/settings.model.h"
 #include "./bluetooth/bluetooth.controller.interface.h"
 #include "./led/led.service.interface.h"
 #include "./sd-card/sd-card.service.interface.h"
@@ -19,10 +18,6 @@ PeripheralsController::PeripheralsController(IBluetoothController &_bluetoothCon
       eepromService(_eepromService),
       ledService(_ledService)
 {
-    if constexpr ((Configurations::supportSdCardLogging && Configurations::sdCardChipSelectPin != GPIO_NUM_NC))
-    {
-        sdDeltaTimes.reserve((RowerProfile::Defaults::minimumRecoveryTime + RowerProfile::Defaults::minimumDriveTime) / RowerProfile::Defaults::rotationDebounceTimeMin);
-    }
 }
 
 void PeripheralsController::update(const unsigned char batteryLevel)
@@ -53,25 +48,12 @@ void PeripheralsController::update(const unsigned char batteryLevel)
 
 void PeripheralsController::begin()
 {
-    if constexpr (Configurations::isRuntimeSettingsEnabled)
-    {
-        rotationDebounceTimeMin = eepromService.getSensorSignalSettings().rotationDebounceTimeMin;
-
-        const auto strokePhaseDetectionSettings = eepromService.getStrokePhaseDetectionSettings();
-        minimumRecoveryTime = strokePhaseDetectionSettings.minimumRecoveryTime;
-        minimumDriveTime = strokePhaseDetectionSettings.minimumDriveTime;
-
-        sdDeltaTimes.clear();
-        sdDeltaTimes.shrink_to_fit();
-        sdDeltaTimes.reserve((minimumRecoveryTime + minimumDriveTime) / rotationDebounceTimeMin);
-    }
-
     Log.infoln("Setting up peripherals");
 
     if constexpr (Configurations::supportSdCardLogging && Configurations::sdCardChipSelectPin != GPIO_NUM_NC)
     {
         Log.infoln("Setting up SDCard service");
-        sdCardService.setup();
+        sdCardService.setup(eepromService.getMachineSettings());
     }
 
     Log.infoln("Setting up BLE service");
@@ -109,7 +91,7 @@ void PeripheralsController::updateDeltaTime(const unsigned long deltaTime)
     {
         if ((eepromService.getLogToSdCard() && sdCardService.isLogFileOpen()))
         {
-            sdDeltaTimes.push_back(deltaTime);
+            sdCardService.saveDeltaTime(deltaTime);
         }
     }
 
@@ -125,19 +107,4 @@ void PeripheralsController::updateDeltaTime(const unsigned long deltaTime)
 void PeripheralsController::updateData(const RowingDataModels::RowingMetrics &data)
 {
     bluetoothController.notifyNewMetrics(data);
-
-    if constexpr (Configurations::supportSdCardLogging && Configurations::sdCardChipSelectPin != GPIO_NUM_NC)
-    {
-        if (eepromService.getLogToSdCard())
-        {
-            sdCardService.saveDeltaTime(sdDeltaTimes);
-        }
-
-        if (!sdDeltaTimes.empty())
-        {
-            vector<unsigned long> clear;
-            clear.reserve((minimumRecoveryTime + minimumDriveTime) / rotationDebounceTimeMin);
-            sdDeltaTimes.swap(clear);
-        }
-    }
 }
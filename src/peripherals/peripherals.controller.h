@@ -1,11 +1,7 @@
 #pragma once
-#include <vector>
 
-#include "../utils/settings.model.h"
 #include "./peripherals.controller.interface.h"
 
-using std::vector;
-
 class IBluetoothController;
 class ISdCardService;
 class IEEPROMService;
@@ -19,14 +15,8 @@ class PeripheralsController final : public IPeripheralsController
     IEEPROMService &eepromService;
     ILedService &ledService;
 
-    unsigned short rotationDebounceTimeMin = RowerProfile::Defaults::rotationDebounceTimeMin;
-    unsigned int minimumRecoveryTime = RowerProfile::Defaults::minimumRecoveryTime;
-    unsigned int minimumDriveTime = RowerProfile::Defaults::minimumDriveTime;
-
     unsigned int lastConnectedDeviceCheckTime = 0;
 
-    vector<unsigned long> sdDeltaTimes;
-
     void updateLed(LedColor newLedColor);
 
 public:
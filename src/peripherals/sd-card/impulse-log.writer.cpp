@@ -0,0 +1,104 @@
+#include "ArduinoLog.h"
+
+#include "./impulse-log.writer.h"
+
+namespace
+{
+    constexpr ImpulseLog::Block endOfLogBlock{};
+}
+
+ImpulseLogWriter::ImpulseLogWriter(File32 &_logFile) : logFile(_logFile)
+{
+}
+
+bool ImpulseLogWriter::begin(const ImpulseLog::FileHeader &header)
+{
+    if (!logFile.preAllocate(Configurations::sdCardPreallocatedSize))
+    {
+        Log.warningln("Could not allocate a contiguous log file, writes may be slower");
+    }
+
+    ImpulseLog::Block headerBlock{};
+    ImpulseLog::writeFileHeader(header, headerBlock);
+
+    encoder.begin(header.logId);
+    blockPosition = 0;
+    const auto isWritten = writeBlock(headerBlock, true);
+    blockPosition = ImpulseLog::blockSize;
+    logFile.flush();
+
+    return isWritten;
+}
+
+bool ImpulseLogWriter::writeBlock(const ImpulseLog::Block &block, const bool withEndOfLog)
+{
+    const auto isWritten = logFile.seekSet(blockPosition) &&
+                           logFile.write(block.data(), block.size()) == block.size() &&
+                           (!withEndOfLog || logFile.write(endOfLogBlock.data(), endOfLogBlock.size()) == endOfLogBlock.size());
+    if (!isWritten)
+    {
+        ++failedWriteCount;
+    }
+
+    return isWritten;
+}
+
+bool ImpulseLogWriter::push(const unsigned long deltaTime)
+{
+    return pendingDeltaTimes.push(deltaTime);
+}
+
+void ImpulseLogWriter::writePending(const unsigned long now)
+{
+    unsigned long deltaTime = 0;
+    while (pendingDeltaTimes.pop(deltaTime))
+    {
+        if (!encoder.push(deltaTime))
+        {
+            writeBlock(encoder.seal(), false);
+            blockPosition += ImpulseLog::blockSize;
+            encoder.reset();
+            encoder.push(deltaTime);
+        }
+        hasUnflushedDeltaTimes = true;
+    }
+
+    if (hasUnflushedDeltaTimes && now - lastFlushTime >= Configurations::sdCardMaxFlushLatency)
+    {
+        flush(now);
+    }
+}
+
+void ImpulseLogWriter::flush(const unsigned long now)
+{
+    if (encoder.empty())
+    {
+        // Nothing is being filled, the end of log marker goes where the next block will be written
+        writeBlock(endOfLogBlock, false);
+    }
+    else
+    {
+        writeBlock(encoder.seal(), true);
+    }
+    logFile.flush();
+
+    lastFlushTime = now;
+    hasUnflushedDeltaTimes = false;
+
+    if (pendingDeltaTimes.overrunCount() != reportedOverrunCount)
+    {
+        reportedOverrunCount = pendingDeltaTimes.overrunCount();
+        Log.warningln("SD card writer could not keep up, %d delta times were dropped", reportedOverrunCount);
+    }
+
+    if (failedWriteCount != reportedFailedWriteCount)
+    {
+        reportedFailedWriteCount = failedWriteCount;
+        Log.errorln("%d writes to the SD card log file failed", reportedFailedWriteCount);
+    }
+}
+
+unsigned int ImpulseLogWriter::getFailedWriteCount() const
+{
+    return failedWriteCount;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Disable SdFat warning about File type when FS.h is present
+#define DISABLE_FS_H_WARNING
+#include "SdFat.h"
+
+#include "../../utils/configuration.h"
+#include "../../utils/impulse-log/impulse-log.h"
+#include "../../utils/lock-free-queue.h"
+
+// Writes delta times to the SD card in the binary impulse log format. The main loop only queues the delta times (push), the writer task takes them off the queue and writes whole 512 byte blocks (writePending). The block being filled is written (and rewritten in place) at the latest every sdCardMaxFlushLatency. Every flush is followed by an empty block that marks the end of the log, so the part of a preallocated file that was not written yet is not read as impulses (full blocks written between two flushes are checked by the block checksum, and the log ID and sequence number of the blocks stop the log at stale blocks of an older log left in the preallocated clusters after a power loss). Failed writes are counted and logged on the next flush
+class ImpulseLogWriter
+{
+    File32 &logFile;
+    LockFreeQueue<unsigned long, Configurations::sdCardQueueCapacity> pendingDeltaTimes;
+    ImpulseLogEncoder encoder;
+    unsigned long blockPosition = ImpulseLog::blockSize;
+    unsigned long lastFlushTime = 0;
+    bool hasUnflushedDeltaTimes = false;
+    unsigned int reportedOverrunCount = 0;
+    unsigned int failedWriteCount = 0;
+    unsigned int reportedFailedWriteCount = 0;
+
+    bool writeBlock(const ImpulseLog::Block &block, bool withEndOfLog);
+
+public:
+    explicit ImpulseLogWriter(File32 &_logFile);
+
+    // Allocates the log file and writes the header block, the file needs to be open and empty. The data blocks carry the log ID of the header
+    bool begin(const ImpulseLog::FileHeader &header);
+    // Called from the main loop, returns false if the queue is full and the delta time was dropped
+    bool push(unsigned long deltaTime);
+    // Called from the writer task
+    void writePending(unsigned long now);
+    // Writes the block being filled followed by the end of log marker
+    void flush(unsigned long now);
+
+    [[nodiscard]] unsigned int getFailedWriteCount() const;
+};
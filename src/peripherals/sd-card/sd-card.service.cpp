@@ -1,4 +1,4 @@
-#include <vector>
+#include "esp_random.h"
 
 #include "Arduino.h"
 #include "ArduinoLog.h"
@@ -7,10 +7,7 @@
 
 #include "../../utils/configuration.h"
 
-SdCardService::SdCardService() : sdCardTaskParameters{
-                                     .logFile = logFile,
-                                     .deltaTimes = {},
-                                 }
+SdCardService::SdCardService() : impulseLogWriter(logFile)
 {
 }
 
@@ -18,17 +15,30 @@ SdCardService::~SdCardService()
 {
     Log.verboseln("Closing SD Card");
 
+    // The writer task flushes the log before it exits, the file may only be closed after that
+    if (isWriterRunning)
+    {
+        xTaskNotifyGive(writerTaskHandle);
+        while (isWriterRunning)
+        {
+            delay(1);
+        }
+    }
+
     logFile.close();
     sd.end();
 }
 
-void SdCardService::setup()
+void SdCardService::setup(const RowerProfile::MachineSettings machineSettings)
 {
     Log.verboseln("Initialize SD card");
-    initSdCard();
+    if (initSdCard(machineSettings))
+    {
+        startWriterTask();
+    }
 }
 
-void SdCardService::initSdCard()
+bool SdCardService::initSdCard(const RowerProfile::MachineSettings &machineSettings)
 {
     if (!sd.begin(SdSpiConfig(Configurations::sdCardChipSelectPin, SHARED_SPI, SD_SCK_MHZ(26))))
     {
@@ -36,7 +46,7 @@ void SdCardService::initSdCard()
 
         sd.end();
 
-        return;
+        return false;
     }
 
     int rootFileCount = 0U;
@@ -48,7 +58,7 @@ void SdCardService::initSdCard()
         root.close();
         sd.end();
 
-        return;
+        return false;
     }
 
     while (logFile.openNext(&root, O_RDONLY))
@@ -61,60 +71,81 @@ void SdCardService::initSdCard()
     Log.verboseln("Number of files in root: %d", rootFileCount);
 
     std::string fileName = std::to_string(rootFileCount);
-    fileName.append(".txt");
+    fileName.append(ImpulseLog::fileExtension);
 
-    if (!logFile.open(fileName.c_str(), O_WRITE | O_CREAT | O_AT_END))
+    if (!logFile.open(fileName.c_str(), O_WRITE | O_CREAT | O_EXCL))
     {
         Log.errorln("Error while creating logfile");
 
         sd.end();
 
-        return;
+        return false;
+    }
+
+    ImpulseLog::FileHeader header;
+    header.impulsesPerRevolution = machineSettings.impulsesPerRevolution;
+    header.setProfile(Configurations::rowerProfileName);
+    header.logId = esp_random();
+    if (!impulseLogWriter.begin(header))
+    {
+        Log.errorln("Error while writing logfile header");
+
+        logFile.close();
+        sd.end();
+
+        return false;
     }
 
-    Log.infoln("Logfile %d.txt was opened", rootFileCount);
+    Log.infoln("Logfile %s was opened", fileName.c_str());
+
+    return true;
 }
 
-void SdCardService::saveDeltaTimeTask(void *parameters)
+// Single long lived task that writes the queued delta times, it exits (after writing everything that is queued) when notified
+void SdCardService::writerTask(void *parameters)
 {
-    {
-        const auto *const params = static_cast<const SdCardService::SdCardTaskParameters *>(parameters);
+    auto *const service = static_cast<SdCardService *>(parameters);
 
-        if (params->logFile)
-        {
-            for (const auto &deltaTime : params->deltaTimes)
-            {
-                params->logFile.println(deltaTime);
-            }
-            const auto safeFlushPeriod = 30'000U;
-            if (params->deltaTimes.back() > safeFlushPeriod)
-            {
-                params->logFile.flush();
-            }
-        }
+    while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Configurations::sdCardWriterPeriod)) == 0)
+    {
+        service->impulseLogWriter.writePending(millis());
     }
+
+    service->impulseLogWriter.writePending(millis());
+    service->impulseLogWriter.flush(millis());
+    service->isWriterRunning = false;
+
     vTaskDelete(nullptr);
 }
 
-void SdCardService::saveDeltaTime(const vector<unsigned long> &deltaTimes)
+void SdCardService::startWriterTask()
 {
-    if (deltaTimes.empty() || !logFile)
+    const auto stackCoreSize = 3'072U;
+
+    isWriterRunning = true;
+    if (xTaskCreatePinnedToCore(
+            writerTask,
+            "sdCardWriterTask",
+            stackCoreSize,
+            this,
+            1,
+            &writerTaskHandle,
+            0) != pdPASS)
     {
-        return;
-    }
+        Log.errorln("Error while starting SD card writer task");
 
-    sdCardTaskParameters.deltaTimes = deltaTimes;
+        isWriterRunning = false;
+    }
+}
 
-    const auto stackCoreSize = 2'048U;
+void SdCardService::saveDeltaTime(const unsigned long deltaTime)
+{
+    if (!isWriterRunning)
+    {
+        return;
+    }
 
-    xTaskCreatePinnedToCore(
-        saveDeltaTimeTask,
-        "saveDeltaTimeTask",
-        stackCoreSize,
-        &sdCardTaskParameters,
-        1,
-        nullptr,
-        0);
+    impulseLogWriter.push(deltaTime);
 }
 
 bool SdCardService::isLogFileOpen() const
@@ -1,28 +1,29 @@
 #pragma once
 
-#include <vector>
+#include <atomic>
+
+#include "Arduino.h"
 
 // Disable SdFat warning about File type when FS.h is present
 #define DISABLE_FS_H_WARNING
 #include "SdFat.h"
 
+#include "../../utils/settings.model.h"
+#include "./impulse-log.writer.h"
 #include "./sd-card.service.interface.h"
 
-using std::vector;
-
 class SdCardService final : public ISdCardService
 {
     SdFat32 sd;
     File32 logFile;
+    ImpulseLogWriter impulseLogWriter;
 
-    struct SdCardTaskParameters
-    {
-        File32 &logFile;
-        vector<unsigned long> deltaTimes;
-    } sdCardTaskParameters;
+    TaskHandle_t writerTaskHandle = nullptr;
+    std::atomic<bool> isWriterRunning = false;
 
-    static void saveDeltaTimeTask(void *parameters);
-    void initSdCard();
+    static void writerTask(void *parameters);
+    bool initSdCard(const RowerProfile::MachineSettings &machineSettings);
+    void startWriterTask();
 
 public:
     SdCardService();
@@ -33,7 +34,7 @@ public:
     SdCardService(SdCardService &&) = delete;
     SdCardService &operator=(SdCardService &&) = delete;
 
-    void setup() override;
-    void saveDeltaTime(const vector<unsigned long> &deltaTime) override;
+    void setup(RowerProfile::MachineSettings machineSettings) override;
+    void saveDeltaTime(unsigned long deltaTime) override;
     [[nodiscard]] bool isLogFileOpen() const override;
-};
\ No newline at end of file
+};
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include "../../utils/settings.model.h"
 
 class ISdCardService
 {
@@ -10,7 +10,9 @@ protected:
 public:
     ISdCardService() = default;
 
-    virtual void setup() = 0;
-    virtual void saveDeltaTime(const std::vector<unsigned long> &deltaTime) = 0;
+    // The machine settings are written to the header of the log file, so the log can be replayed with the impulses per revolution it was recorded with
+    virtual void setup(RowerProfile::MachineSettings machineSettings) = 0;
+    // Called from the main loop for every impulse, only queues the delta time for the writer task
+    virtual void saveDeltaTime(unsigned long deltaTime) = 0;
     [[nodiscard]] virtual bool isLogFileOpen() const = 0;
 };
\ No newline at end of file
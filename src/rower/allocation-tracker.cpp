@@ -0,0 +1,136 @@
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "./allocation-tracker.h"
+
+#include "../utils/configuration.h"
+#include "./pipeline-profiler.h"
+
+#if ENABLE_ALLOCATION_TRACKING
+    #if defined(ESP_PLATFORM)
+        #include "esp_heap_caps.h"
+
+        #include "Arduino.h"
+
+// Defined by the Arduino core, the impulse pipeline runs on this task
+extern TaskHandle_t loopTaskHandle;
+    #endif
+
+AllocationTracker allocationTracker;
+
+namespace
+{
+    // Every block starts with a header that holds its size, so the deallocation can be accounted for too. The header takes the full alignment so the returned pointer is aligned the same way as the one from malloc
+    struct AllocationHeader
+    {
+        std::size_t size;
+        bool isTracked;
+    };
+
+    constexpr std::size_t headerSize = alignof(std::max_align_t);
+    static_assert(sizeof(AllocationHeader) <= headerSize);
+
+    // On the device the BLE and logging tasks allocate concurrently, those are not part of the pipeline so only the loop task is tracked
+    bool isTrackedTask()
+    {
+    #if defined(ESP_PLATFORM)
+        return xTaskGetCurrentTaskHandle() == loopTaskHandle;
+    #else
+        return true;
+    #endif
+    }
+}
+
+void *operator new(const std::size_t size)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+    auto *const block = static_cast<unsigned char *>(std::malloc(size + headerSize));
+    if (block == nullptr)
+    {
+    #if defined(__cpp_exceptions)
+        throw std::bad_alloc();
+    #else
+        std::abort();
+    #endif
+    }
+
+    const AllocationHeader header{.size = size, .isTracked = isTrackedTask()};
+    std::memcpy(block, &header, sizeof(header));
+    if (header.isTracked)
+    {
+        allocationTracker.recordAllocation(size);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return block + headerSize;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto *const block = static_cast<unsigned char *>(pointer) - headerSize;
+    AllocationHeader header{};
+    std::memcpy(&header, block, sizeof(header));
+    if (header.isTracked)
+    {
+        allocationTracker.recordDeallocation(header.size);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+    std::free(block);
+}
+
+void operator delete(void *pointer, std::size_t /* size */) noexcept
+{
+    ::operator delete(pointer);
+}
+#endif
+
+std::string AllocationTracker::summary() const
+{
+    std::array<char, 128> line{};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    snprintf(line.data(), line.size(), "Allocations over %u impulses and %u strokes\n", impulseCount, strokeCount);
+    std::string formatted(line.data());
+
+    const auto appendLine = [&line, &formatted](const char *name, const AllocationStatistics &statistics)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        snprintf(line.data(), line.size(), "%s: %u allocations, %llu bytes\n", name, statistics.count, statistics.bytes);
+        formatted += line.data();
+    };
+
+    auto i = 0U;
+    while (i < stageCount)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        appendLine(PipelineProfiler::stageNames[i].data(), stages[i]);
+        ++i;
+    }
+    appendLine("outsideStages", outsideStages);
+    appendLine("maxPerImpulse", maxPerImpulse);
+    appendLine("maxPerStroke", maxPerStroke);
+    appendLine("steadyState", steadyState);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    snprintf(line.data(), line.size(), "allocatingImpulses: %u, liveBytes: %llu, highWaterMark: %llu\n", allocatingImpulseCount, getLiveBytes(), getHighWaterMark());
+    formatted += line.data();
+
+#if ENABLE_ALLOCATION_TRACKING && defined(ESP_PLATFORM)
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    snprintf(line.data(), line.size(), "heapMinimumFree: %u\n", static_cast<unsigned int>(heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT)));
+    formatted += line.data();
+#endif
+
+    return formatted;
+}
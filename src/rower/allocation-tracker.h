@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "../utils/configuration.h"
+#include "../utils/enums.h"
+
+struct AllocationStatistics
+{
+    unsigned int count = 0U;
+    unsigned long long bytes = 0ULL;
+
+    void add(const AllocationStatistics &other)
+    {
+        count += other.count;
+        bytes += other.bytes;
+    }
+};
+
+// Counts the heap allocations of the impulse pipeline. The allocations are fed in by the replaced global operator new/delete (only compiled in when tracking is enabled) and are attributed to the pipeline stage that was running when they happened via the stage timer. On top of the per stage totals the allocations are also grouped per impulse and per stroke, and everything allocated after the warm-up strokes is counted separately as steady state allocation (which should stay zero)
+class AllocationTracker
+{
+public:
+    static constexpr unsigned char stageCount = std::to_underlying(PipelineStage::PublishData) + 1U;
+    // The first strokes are allowed to allocate as the buffers that are sized by the actual data (e.g. the handle force curve) grow to their working capacity
+    static constexpr unsigned char defaultWarmUpStrokes = 3U;
+
+private:
+    unsigned char warmUpStrokes;
+
+    std::array<AllocationStatistics, stageCount> stages{};
+    AllocationStatistics pending;
+    AllocationStatistics outsideStages;
+
+    // Blocks allocated on the pipeline task may be freed on any other task (e.g. a string handed over to the BLE task), so the live byte counters are atomic. Everything else is only touched by the pipeline task
+    std::atomic<std::size_t> liveBytes = 0U;
+    std::atomic<std::size_t> highWaterMark = 0U;
+
+    static_assert(std::atomic<std::size_t>::is_always_lock_free, "The live byte counters are updated from operator delete so they must not take a lock");
+
+    AllocationStatistics currentImpulse;
+    AllocationStatistics maxPerImpulse;
+    unsigned int impulseCount = 0U;
+    unsigned int allocatingImpulseCount = 0U;
+
+    AllocationStatistics currentStroke;
+    AllocationStatistics maxPerStroke;
+    unsigned int strokeCount = 0U;
+
+    AllocationStatistics steadyState;
+
+public:
+    explicit constexpr AllocationTracker(const unsigned char _warmUpStrokes = defaultWarmUpStrokes) : warmUpStrokes(_warmUpStrokes)
+    {
+    }
+
+    void recordAllocation(const std::size_t bytes)
+    {
+        ++pending.count;
+        pending.bytes += bytes;
+
+        const auto current = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak = highWaterMark.load(std::memory_order_relaxed);
+        while (current > peak && !highWaterMark.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Can be called from any task
+    void recordDeallocation(const std::size_t bytes)
+    {
+        auto current = liveBytes.load(std::memory_order_relaxed);
+        while (!liveBytes.compare_exchange_weak(current, current - std::min(bytes, current), std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Allocations that happened since the last stage ended did not belong to any stage (e.g. logging or setup)
+    void startStage()
+    {
+        outsideStages.add(pending);
+        pending = AllocationStatistics{};
+    }
+
+    void endStage(const PipelineStage stage)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        stages[std::to_underlying(stage)].add(pending);
+        currentImpulse.add(pending);
+        currentStroke.add(pending);
+        if (isWarmUpCompleted())
+        {
+            steadyState.add(pending);
+        }
+
+        pending = AllocationStatistics{};
+    }
+
+    void completeImpulse()
+    {
+        ++impulseCount;
+        if (currentImpulse.count > 0U)
+        {
+            ++allocatingImpulseCount;
+        }
+        maxPerImpulse.count = std::max(maxPerImpulse.count, currentImpulse.count);
+        maxPerImpulse.bytes = std::max(maxPerImpulse.bytes, currentImpulse.bytes);
+
+        currentImpulse = AllocationStatistics{};
+    }
+
+    void completeStroke()
+    {
+        ++strokeCount;
+        maxPerStroke.count = std::max(maxPerStroke.count, currentStroke.count);
+        maxPerStroke.bytes = std::max(maxPerStroke.bytes, currentStroke.bytes);
+
+        currentStroke = AllocationStatistics{};
+    }
+
+    [[nodiscard]] bool isWarmUpCompleted() const
+    {
+        return strokeCount >= warmUpStrokes;
+    }
+
+    [[nodiscard]] const AllocationStatistics &getStatistics(const PipelineStage stage) const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return stages[std::to_underlying(stage)];
+    }
+
+    [[nodiscard]] const AllocationStatistics &getOutsideStages() const
+    {
+        return outsideStages;
+    }
+
+    [[nodiscard]] const AllocationStatistics &getMaxPerImpulse() const
+    {
+        return maxPerImpulse;
+    }
+
+    [[nodiscard]] const AllocationStatistics &getMaxPerStroke() const
+    {
+        return maxPerStroke;
+    }
+
+    [[nodiscard]] const AllocationStatistics &getSteadyState() const
+    {
+        return steadyState;
+    }
+
+    [[nodiscard]] unsigned int getImpulseCount() const
+    {
+        return impulseCount;
+    }
+
+    [[nodiscard]] unsigned int getAllocatingImpulseCount() const
+    {
+        return allocatingImpulseCount;
+    }
+
+    [[nodiscard]] unsigned int getStrokeCount() const
+    {
+        return strokeCount;
+    }
+
+    [[nodiscard]] unsigned long long getLiveBytes() const
+    {
+        return liveBytes.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] unsigned long long getHighWaterMark() const
+    {
+        return highWaterMark.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::string summary() const;
+};
+
+// Only defined when allocation tracking is enabled (together with the replaced operator new and delete)
+extern AllocationTracker allocationTracker;
@@ -28,10 +28,21 @@ void FlywheelService::setup(const RowerProfile::MachineSettings machineSettings,
 
 RowingDataModels::FlywheelData FlywheelService::getData()
 {
-    detachRotationInterrupt();
-    isDataChanged = false;
+    // Impulses are handed over one by one so that none of them is merged into the next one when the processing falls behind
+    unsigned long now = 0;
+    if (impulseQueue.pop(now))
+    {
+        processImpulse(now);
+    }
 
-    RowingDataModels::FlywheelData data = {
+    const auto overrunCount = impulseQueue.overrunCount();
+    if (overrunCount != reportedOverrunCount)
+    {
+        Log.warningln("Impulse queue overrun, total dropped impulses: %u", overrunCount);
+        reportedOverrunCount = overrunCount;
+    }
+
+    return RowingDataModels::FlywheelData{
         .rawImpulseCount = impulseCount,
         .deltaTime = cleanDeltaTime,
         .totalTime = totalTime,
@@ -40,34 +51,38 @@ RowingDataModels::FlywheelData FlywheelService::getData()
         // TODO: These serve debugging purposes, may be deleted
         .rawImpulseTime = lastRawImpulseTime,
     };
-    attachRotationInterrupt();
-
-    return data;
 }
 
 bool FlywheelService::hasDataChanged() const
 {
-    return isDataChanged;
+    return !impulseQueue.empty();
 }
 
-void FlywheelService::processRotation(const unsigned long now)
+unsigned int FlywheelService::getOverrunCount() const
 {
-    const auto currentRawImpulseDeltaTime = now - lastRawImpulseTime;
+    return impulseQueue.overrunCount();
+}
 
-    if (currentRawImpulseDeltaTime < rotationDebounceTimeMin)
+void FlywheelService::processRotation(const unsigned long now)
+{
+    if (now - lastQueuedImpulseTime < rotationDebounceTimeMin)
     {
         return;
     }
 
-    isDataChanged = true;
+    lastQueuedImpulseTime = now;
+    impulseQueue.push(now);
+}
 
+void FlywheelService::processImpulse(const unsigned long now)
+{
     lastRawImpulseTime = now;
 
     const auto currentDeltaTime = now - lastCleanImpulseTime;
 
     if constexpr (Configurations::isDebounceFilterEnabled)
     {
-        auto deltaTimeDiffPair = std::minmax<volatile unsigned long>(currentDeltaTime, lastDeltaTime);
+        auto deltaTimeDiffPair = std::minmax(currentDeltaTime, lastDeltaTime);
         auto deltaImpulseTimeDiff = deltaTimeDiffPair.second - deltaTimeDiffPair.first;
 
         lastDeltaTime = currentDeltaTime;
@@ -79,8 +94,8 @@ void FlywheelService::processRotation(const unsigned long now)
     }
 
     cleanDeltaTime = currentDeltaTime;
-    totalTime = totalTime + cleanDeltaTime;
-    impulseCount = impulseCount + 1;
+    totalTime += cleanDeltaTime;
+    ++impulseCount;
     lastCleanImpulseTime = now;
-    totalAngularDisplacement = totalAngularDisplacement + angularDisplacementPerImpulse;
+    totalAngularDisplacement += angularDisplacementPerImpulse;
 }
\ No newline at end of file
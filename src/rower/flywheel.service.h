@@ -3,6 +3,7 @@
 #include "Arduino.h"
 
 #include "../utils/configuration.h"
+#include "../utils/lock-free-queue.h"
 #include "../utils/settings.model.h"
 #include "./flywheel.service.interface.h"
 
@@ -12,20 +13,27 @@ class FlywheelService final : public IFlywheelService
 
     unsigned short rotationDebounceTimeMin = RowerProfile::Defaults::rotationDebounceTimeMin;
 
-    volatile unsigned long lastDeltaTime = 0;
-    volatile unsigned long cleanDeltaTime = 0;
-    volatile unsigned long lastRawImpulseTime = 0;
-    volatile unsigned long lastCleanImpulseTime = 0;
-    volatile double totalAngularDisplacement = 0;
+    // Only the ISR touches this, it is used to drop bounces before they take up room in the queue
+    unsigned long lastQueuedImpulseTime = 0;
+    LockFreeQueue<unsigned long, Configurations::impulseQueueCapacity> impulseQueue;
 
-    volatile unsigned long impulseCount = 0UL;
-    volatile unsigned long long totalTime = 0ULL;
+    unsigned long lastDeltaTime = 0;
+    unsigned long cleanDeltaTime = 0;
+    unsigned long lastRawImpulseTime = 0;
+    unsigned long lastCleanImpulseTime = 0;
+    double totalAngularDisplacement = 0;
 
-    volatile bool isDataChanged = false;
+    unsigned long impulseCount = 0UL;
+    unsigned long long totalTime = 0ULL;
+
+    unsigned int reportedOverrunCount = 0;
+
+    void processImpulse(unsigned long now);
 
 public:
     void setup(RowerProfile::MachineSettings newMachineSettings, RowerProfile::SensorSignalSettings newSensorSignalSettings) override;
     [[nodiscard]] bool hasDataChanged() const override;
     RowingDataModels::FlywheelData getData() override;
+    [[nodiscard]] unsigned int getOverrunCount() const override;
     void processRotation(unsigned long now) override;
 };
\ No newline at end of file
@@ -12,5 +12,6 @@ public:
     virtual void setup(RowerProfile::MachineSettings newMachineSettings, RowerProfile::SensorSignalSettings newSensorSignalSettings) = 0;
     [[nodiscard]] virtual bool hasDataChanged() const = 0;
     virtual RowingDataModels::FlywheelData getData() = 0;
+    [[nodiscard]] virtual unsigned int getOverrunCount() const = 0;
     virtual void processRotation(unsigned long now) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "./stroke.model.h"
+
+// Double buffered rowing metrics. The stroke processing fills the buffer that is not being read and then flips the version, so readers always get a complete set of metrics (force curve included) by reference instead of a copy. The reference returned by read() is only valid until the next publication, so a reader that keeps the data beyond that (e.g. a task on the other core) has to copy what it needs
+class MetricsSnapshot
+{
+    std::array<RowingDataModels::RowingMetrics, 2> buffers{};
+    std::atomic<unsigned int> version = 0;
+
+public:
+    [[nodiscard]] RowingDataModels::RowingMetrics &writeBuffer()
+    {
+        return buffers[(version.load(std::memory_order_relaxed) + 1U) & 1U];
+    }
+
+    void publish()
+    {
+        version.fetch_add(1U, std::memory_order_release);
+    }
+
+    [[nodiscard]] const RowingDataModels::RowingMetrics &read() const
+    {
+        return buffers[version.load(std::memory_order_acquire) & 1U];
+    }
+};
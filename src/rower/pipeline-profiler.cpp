@@ -0,0 +1,40 @@
+#include <array>
+#include <cstdio>
+#include <string>
+
+#include "./pipeline-profiler.h"
+
+#include "../utils/configuration.h"
+
+#if ENABLE_PIPELINE_PROFILING
+PipelineProfiler pipelineProfiler;
+#endif
+
+std::string PipelineProfiler::summary() const
+{
+    const auto ticksPerMicro = static_cast<double>(ticksPerMicrosecond());
+
+    std::array<char, 128> line{};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    snprintf(line.data(), line.size(), "Pipeline profile (us) over %u impulses\n", stages.front().getCount());
+    std::string formatted(line.data());
+
+    auto i = 0U;
+    while (i < stageCount)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        const auto &stage = stages[i];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        snprintf(line.data(), line.size(), "%s: min %.1f, avg %.1f, max %.1f, p99 %.1f\n",
+                 stageNames[i].data(),
+                 stage.getMin() / ticksPerMicro,
+                 stage.getAverage() / ticksPerMicro,
+                 stage.getMax() / ticksPerMicro,
+                 stage.getPercentile(99U) / ticksPerMicro);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        formatted += line.data();
+        ++i;
+    }
+
+    return formatted;
+}
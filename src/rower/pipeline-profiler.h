@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(ESP_PLATFORM)
+    #include "esp_cpu.h"
+
+    #include "Arduino.h"
+#else
+    #include <chrono>
+#endif
+
+#include "../utils/configuration.h"
+#include "../utils/enums.h"
+#include "./allocation-tracker.h"
+
+// Running min/avg/max and an approximate p99 of the time spent in one stage of the impulse pipeline. The percentile comes from a log-linear histogram (8 sub-buckets per power of two), so it is accurate to within 12.5% while the memory use does not depend on the number of samples
+class StageStatistics
+{
+public:
+    static constexpr unsigned char subBucketBits = 3U;
+    static constexpr unsigned char subBucketCount = 1U << subBucketBits;
+    static constexpr unsigned short bucketCount = (32U - subBucketBits + 1U) * subBucketCount;
+
+private:
+    unsigned int count = 0U;
+    unsigned long long sum = 0ULL;
+    unsigned int min = 0U;
+    unsigned int max = 0U;
+    std::array<unsigned int, bucketCount> buckets{};
+
+public:
+    [[nodiscard]] static constexpr unsigned short bucketIndex(const unsigned int ticks)
+    {
+        if (ticks < subBucketCount)
+        {
+            return static_cast<unsigned short>(ticks);
+        }
+
+        const auto exponent = static_cast<unsigned int>(std::bit_width(ticks)) - 1U;
+        const auto subBucket = (ticks >> (exponent - subBucketBits)) & (subBucketCount - 1U);
+
+        return static_cast<unsigned short>((exponent - subBucketBits + 1U) * subBucketCount + subBucket);
+    }
+
+    [[nodiscard]] static constexpr unsigned int bucketUpperBound(const unsigned short index)
+    {
+        if (index < subBucketCount)
+        {
+            return index;
+        }
+
+        const auto shift = index / subBucketCount - 1U;
+        const auto subBucket = index % subBucketCount;
+
+        return ((subBucketCount + subBucket) << shift) + ((1U << shift) - 1U);
+    }
+
+    void record(const unsigned int ticks)
+    {
+        if (count == 0U || ticks < min)
+        {
+            min = ticks;
+        }
+        if (ticks > max)
+        {
+            max = ticks;
+        }
+
+        ++count;
+        sum += ticks;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        ++buckets[bucketIndex(ticks)];
+    }
+
+    [[nodiscard]] unsigned int getCount() const
+    {
+        return count;
+    }
+
+    [[nodiscard]] unsigned int getMin() const
+    {
+        return min;
+    }
+
+    [[nodiscard]] unsigned int getMax() const
+    {
+        return max;
+    }
+
+    [[nodiscard]] unsigned int getAverage() const
+    {
+        return count == 0U ? 0U : static_cast<unsigned int>(sum / count);
+    }
+
+    // This function returns the upper bound of the histogram bucket that holds the requested percentile (capped at the largest recorded value)
+    [[nodiscard]] unsigned int getPercentile(const unsigned char percentile) const
+    {
+        if (count == 0U)
+        {
+            return 0U;
+        }
+
+        const auto target = (static_cast<unsigned long long>(count) * percentile + 99U) / 100U;
+        auto cumulative = 0ULL;
+        auto i = 0U;
+        while (i < bucketCount)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            cumulative += buckets[i];
+            if (cumulative >= target)
+            {
+                return std::min(bucketUpperBound(static_cast<unsigned short>(i)), max);
+            }
+            ++i;
+        }
+
+        return max;
+    }
+
+    void reset()
+    {
+        count = 0U;
+        sum = 0ULL;
+        min = 0U;
+        max = 0U;
+        buckets.fill(0U);
+    }
+};
+
+class PipelineProfiler
+{
+public:
+    static constexpr unsigned char stageCount = std::to_underlying(PipelineStage::PublishData) + 1U;
+    static constexpr std::array<std::string_view, stageCount> stageNames{"cyclicFilter", "deltaTimes", "angularDistances", "derivativeMatrices", "stateMachine", "publishData"};
+
+private:
+    std::array<StageStatistics, stageCount> stages{};
+
+public:
+    // Timestamps are CPU cycles on the device and nanoseconds on the host, only the difference of two timestamps is meaningful (it wraps around)
+    [[nodiscard]] static unsigned int now()
+    {
+#if defined(ESP_PLATFORM)
+        return esp_cpu_get_cycle_count();
+#else
+        return static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    [[nodiscard]] static unsigned int ticksPerMicrosecond()
+    {
+#if defined(ESP_PLATFORM)
+        return getCpuFrequencyMhz();
+#else
+        return 1'000U;
+#endif
+    }
+
+    void record(const PipelineStage stage, const unsigned int ticks)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        stages[std::to_underlying(stage)].record(ticks);
+    }
+
+    [[nodiscard]] const StageStatistics &getStatistics(const PipelineStage stage) const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return stages[std::to_underlying(stage)];
+    }
+
+    void reset()
+    {
+        for (auto &stage : stages)
+        {
+            stage.reset();
+        }
+    }
+
+    [[nodiscard]] std::string summary() const;
+};
+
+// Only defined when profiling is enabled
+extern PipelineProfiler pipelineProfiler;
+
+// Times consecutive stages of a pipeline run: each lap() records the time since the previous lap, and whatever runs after the last lap until the timer goes out of scope (e.g. on an early return) is recorded as the final stage. With allocation tracking the allocations of each lap are attributed to its stage the same way
+template <bool IsEnabled>
+class BasicPipelineStageTimer
+{
+    PipelineStage finalStage;
+    unsigned int lapStart = PipelineProfiler::now();
+
+    static void record(const PipelineStage stage, [[maybe_unused]] const unsigned int ticks)
+    {
+        if constexpr (Configurations::isPipelineProfilingEnabled)
+        {
+            pipelineProfiler.record(stage, ticks);
+        }
+        if constexpr (Configurations::isAllocationTrackingEnabled)
+        {
+            allocationTracker.endStage(stage);
+        }
+    }
+
+    static void startStage()
+    {
+        if constexpr (Configurations::isAllocationTrackingEnabled)
+        {
+            allocationTracker.startStage();
+        }
+    }
+
+public:
+    explicit BasicPipelineStageTimer(const PipelineStage _finalStage) : finalStage(_finalStage)
+    {
+        startStage();
+    }
+
+    BasicPipelineStageTimer(const BasicPipelineStageTimer &) = delete;
+    BasicPipelineStageTimer &operator=(const BasicPipelineStageTimer &) = delete;
+    BasicPipelineStageTimer(BasicPipelineStageTimer &&) = delete;
+    BasicPipelineStageTimer &operator=(BasicPipelineStageTimer &&) = delete;
+
+    ~BasicPipelineStageTimer()
+    {
+        record(finalStage, PipelineProfiler::now() - lapStart);
+    }
+
+    void lap(const PipelineStage stage)
+    {
+        const auto lapEnd = PipelineProfiler::now();
+        record(stage, lapEnd - lapStart);
+        lapStart = lapEnd;
+    }
+
+    // Drops the time (and allocations) since the last lap (e.g. logging that is not part of the pipeline)
+    void skip()
+    {
+        startStage();
+        lapStart = PipelineProfiler::now();
+    }
+};
+
+// Without profiling and allocation tracking the timer is empty, so it compiles out completely
+template <>
+class BasicPipelineStageTimer<false>
+{
+public:
+    explicit constexpr BasicPipelineStageTimer(const PipelineStage /* finalStage */) {}
+
+    constexpr void lap(const PipelineStage /* stage */) {}
+    constexpr void skip() {}
+};
+
+using PipelineStageTimer = BasicPipelineStageTimer<Configurations::isPipelineProfilingEnabled || Configurations::isAllocationTrackingEnabled>;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../utils/configuration.h"
+#include "../utils/enums.h"
+#include "../utils/settings.model.h"
+
+// Decides when the angular distance regression should run on a shorter window because processing an impulse takes a large share of the time until the next one (e.g. at high stroke rates on machines with many impulses per revolution), and when the full window can be restored. Both switches go through a warm-up of one full window length, during which both windows are fed so the new one is filled by the time it takes over
+class RegressionWindowGovernor
+{
+public:
+    // Share of the clean delta time the average processing time may take before the window is reduced (or a restore is abandoned)
+    static constexpr Configurations::precision shrinkLoad = 0.6;
+    // Share of the clean delta time the processing time of the full window (as measured before it was reduced) has to stay below for restoreDelay consecutive impulses before the full window is restored
+    static constexpr Configurations::precision restoreLoad = 0.3;
+    static constexpr unsigned short restoreDelay = 64U;
+    static constexpr unsigned char averagingWindow = 8U;
+
+private:
+    RegressionWindow window = RegressionWindow::Full;
+    unsigned char warmUpLength;
+    unsigned char warmUpCount = 0U;
+    unsigned short slackCount = 0U;
+    unsigned int switchCount = 0U;
+
+    Configurations::precision averageProcessingTime = 0;
+    Configurations::precision fullWindowProcessingTime = 0;
+
+    bool changeWindow(const RegressionWindow newWindow)
+    {
+        if (newWindow == RegressionWindow::Full || (newWindow == RegressionWindow::Reduced && window == RegressionWindow::Shrinking))
+        {
+            ++switchCount;
+        }
+
+        window = newWindow;
+        warmUpCount = 0U;
+        slackCount = 0U;
+
+        return true;
+    }
+
+    bool isWarmUpCompleted()
+    {
+        ++warmUpCount;
+
+        return warmUpCount >= warmUpLength;
+    }
+
+public:
+    explicit constexpr RegressionWindowGovernor(const unsigned char _warmUpLength = RowerProfile::Defaults::impulseDataArrayLength) : warmUpLength(_warmUpLength)
+    {
+    }
+
+    [[nodiscard]] RegressionWindow getWindow() const
+    {
+        return window;
+    }
+
+    // Reduced window is used for the torque from the end of the shrinking warm-up until the end of the restoring warm-up
+    [[nodiscard]] bool isReducedWindowActive() const
+    {
+        return window == RegressionWindow::Reduced || window == RegressionWindow::Restoring;
+    }
+
+    [[nodiscard]] unsigned int getSwitchCount() const
+    {
+        return switchCount;
+    }
+
+    [[nodiscard]] Configurations::precision getAverageProcessingTime() const
+    {
+        return averageProcessingTime;
+    }
+
+    // This function takes the processing time of the last impulse and its clean delta time (both in microseconds) and returns true if the window state has changed
+    bool update(const Configurations::precision processingTime, const Configurations::precision deltaTime)
+    {
+        averageProcessingTime += (processingTime - averageProcessingTime) / averagingWindow;
+        const auto isOverloaded = averageProcessingTime > shrinkLoad * deltaTime;
+
+        if (window == RegressionWindow::Full)
+        {
+            if (!isOverloaded)
+            {
+                return false;
+            }
+
+            fullWindowProcessingTime = averageProcessingTime;
+
+            return changeWindow(RegressionWindow::Shrinking);
+        }
+
+        if (window == RegressionWindow::Shrinking)
+        {
+            return isWarmUpCompleted() && changeWindow(RegressionWindow::Reduced);
+        }
+
+        if (window == RegressionWindow::Reduced)
+        {
+            slackCount = fullWindowProcessingTime < restoreLoad * deltaTime ? static_cast<unsigned short>(slackCount + 1U) : 0U;
+
+            return slackCount >= restoreDelay && changeWindow(RegressionWindow::Restoring);
+        }
+
+        // While restoring both windows are processed, if even that is too slow the restore is abandoned (the reduced window is still up to date so it can continue right away)
+        if (isOverloaded)
+        {
+            fullWindowProcessingTime = averageProcessingTime;
+
+            return changeWindow(RegressionWindow::Reduced);
+        }
+
+        return isWarmUpCompleted() && changeWindow(RegressionWindow::Full);
+    }
+};
@@ -1,5 +1,7 @@
 #include <cmath>
+#include <span>
 
+#include "Arduino.h"
 #include "ArduinoLog.h"
 
 #include "./stroke.controller.h"
@@ -9,6 +11,7 @@
 #include "../utils/macros.h"
 #include "../utils/settings.model.h"
 #include "./flywheel.service.interface.h"
+#include "./metrics-snapshot.h"
 #include "./stroke.model.h"
 #include "./stroke.service.interface.h"
 
@@ -31,54 +34,85 @@ void StrokeController::begin()
 #endif
 }
 
+void StrokeController::replayFilterBuffer()
+{
+    if constexpr (Configurations::cyclicFilterReplayBudget == 0)
+    {
+        strokeService.processFilterBuffer();
+
+        return;
+    }
+
+    // The recorded datapoints are replayed as long as they fit in the budget, but a new impulse always takes precedence
+    const auto replayStart = micros();
+    while (strokeService.processFilterBuffer() && !flywheelService.hasDataChanged() && micros() - replayStart < Configurations::cyclicFilterReplayBudget)
+    {
+    }
+}
+
 void StrokeController::update()
 {
-    strokeService.processFilterBuffer();
+    replayFilterBuffer();
 
-    if (flywheelService.hasDataChanged())
+    // Collect the impulses that were queued while the previous ones were processed into one batch, so the metrics are only read back once when catching up. The batch is bounded by the queue capacity so the rest of the main loop is not starved under load
+    impulseBatchSize = 0U;
+    auto backlog = Configurations::impulseQueueCapacity;
+    while (backlog > 0 && flywheelService.hasDataChanged())
     {
-        const auto lastFlywheelData = flywheelData;
-        flywheelData = flywheelService.getData();
-        if (lastFlywheelData.rawImpulseTime != flywheelData.rawImpulseTime)
-        {
-            Log.verboseln("rawImpulseTime: %u", flywheelData.rawImpulseTime);
-        }
+        --backlog;
 
-        if (lastFlywheelData.rawImpulseCount == flywheelData.rawImpulseCount)
+        const auto lastRawImpulseCount = flywheelData.rawImpulseCount;
+        flywheelData = flywheelService.getData();
+        if (lastRawImpulseCount == flywheelData.rawImpulseCount)
         {
-            return;
+            continue;
         }
 
+        Log.verboseln("rawImpulseTime: %u", flywheelData.rawImpulseTime);
         Log.traceln("deltaTime: %u", flywheelData.deltaTime);
 
-        strokeService.processData(flywheelData);
-        rowerState = strokeService.getData();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        impulseBatch[impulseBatchSize] = flywheelData;
+        ++impulseBatchSize;
+    }
+
+    if (impulseBatchSize == 0)
+    {
+        return;
     }
+
+    if (impulseBatchSize > 1)
+    {
+        Log.traceln("Catching up with %u queued impulses", impulseBatchSize);
+    }
+
+    strokeService.processBatch(getLastBatch());
+    strokeService.publishData(rowerState);
 }
 
 const RowingDataModels::RowingMetrics &StrokeController::getAllData() const
 {
-    return rowerState;
+    return rowerState.read();
 }
 
 unsigned long long StrokeController::getLastRevTime() const
 {
-    return rowerState.lastRevTime;
+    return rowerState.read().lastRevTime;
 }
 
 unsigned int StrokeController::getRevCount() const
 {
-    return std::lround(rowerState.distance);
+    return std::lround(rowerState.read().distance);
 }
 
 unsigned long long StrokeController::getLastStrokeTime() const
 {
-    return rowerState.lastStrokeTime;
+    return rowerState.read().lastStrokeTime;
 }
 
 unsigned short StrokeController::getStrokeCount() const
 {
-    return rowerState.strokeCount;
+    return rowerState.read().strokeCount;
 }
 
 unsigned long StrokeController::getRawImpulseCount() const
@@ -91,6 +125,11 @@ unsigned long StrokeController::getLastImpulseTime() const
     return flywheelData.cleanImpulseTime;
 }
 
+std::span<const RowingDataModels::FlywheelData> StrokeController::getLastBatch() const
+{
+    return {impulseBatch.data(), impulseBatchSize};
+}
+
 unsigned long StrokeController::getDeltaTime() const
 {
     return flywheelData.deltaTime;
@@ -98,27 +137,27 @@ unsigned long StrokeController::getDeltaTime() const
 
 Configurations::precision StrokeController::getDriveDuration() const
 {
-    return rowerState.driveDuration / 1e6;
+    return rowerState.read().driveDuration / 1e6;
 }
 
 Configurations::precision StrokeController::getRecoveryDuration() const
 {
-    return rowerState.recoveryDuration / 1e6;
+    return rowerState.read().recoveryDuration / 1e6;
 }
 
 short StrokeController::getAvgStrokePower() const
 {
-    return static_cast<short>(std::round(rowerState.avgStrokePower));
+    return static_cast<short>(std::round(rowerState.read().avgStrokePower));
 }
 
 Configurations::precision StrokeController::getDistance() const
 {
-    return rowerState.distance;
+    return rowerState.read().distance;
 }
 
 unsigned short StrokeController::getDragFactor() const
 {
-    return std::lround(rowerState.dragCoefficient * 1e6);
+    return std::lround(rowerState.read().dragCoefficient * 1e6);
 }
 
 unsigned int StrokeController::getPreviousRevCount() const
@@ -138,12 +177,12 @@ unsigned long StrokeController::getPreviousRawImpulseCount() const
 
 void StrokeController::setPreviousRevCount()
 {
-    previousRevCount = std::lround(rowerState.distance);
+    previousRevCount = std::lround(rowerState.read().distance);
 }
 
 void StrokeController::setPreviousStrokeCount()
 {
-    previousStrokeCount = rowerState.strokeCount;
+    previousStrokeCount = rowerState.read().strokeCount;
 }
 
 void StrokeController::setPreviousRawImpulseCount()
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <vector>
+#include <array>
+#include <span>
 
 #include "../utils/configuration.h"
+#include "./metrics-snapshot.h"
 #include "./stroke.controller.interface.h"
 #include "./stroke.model.h"
 
@@ -20,17 +22,7 @@ class StrokeController final : public IStrokeController
     unsigned int previousStrokeCount = 0U;
     unsigned long previousRawImpulseCount = 0U;
 
-    RowingDataModels::RowingMetrics rowerState{
-        .distance = 0.0,
-        .lastRevTime = 0ULL,
-        .lastStrokeTime = 0ULL,
-        .strokeCount = 0U,
-        .driveDuration = 0U,
-        .recoveryDuration = 0U,
-        .avgStrokePower = 0.0,
-        .dragCoefficient = 0.0,
-        .driveHandleForces = std::vector<float>{},
-    };
+    MetricsSnapshot rowerState;
 
     RowingDataModels::FlywheelData flywheelData{
         .rawImpulseCount = 0UL,
@@ -41,6 +33,11 @@ class StrokeController final : public IStrokeController
         .rawImpulseTime = 0UL,
     };
 
+    std::array<RowingDataModels::FlywheelData, Configurations::impulseQueueCapacity> impulseBatch{};
+    unsigned short impulseBatchSize = 0U;
+
+    void replayFilterBuffer();
+
 public:
     StrokeController(IStrokeService &_strokeService, IFlywheelService &_flywheelService, IEEPROMService &eepromService);
 
@@ -57,6 +54,7 @@ public:
     void setPreviousRawImpulseCount() override;
     [[nodiscard]] unsigned long getRawImpulseCount() const override;
     [[nodiscard]] unsigned long getLastImpulseTime() const override;
+    [[nodiscard]] std::span<const RowingDataModels::FlywheelData> getLastBatch() const override;
 
     [[nodiscard]] unsigned long getDeltaTime() const override;
     [[nodiscard]] unsigned long long getLastRevTime() const override;
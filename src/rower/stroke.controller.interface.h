@@ -1,3 +1,5 @@
+#include <span>
+
 #include "../utils/configuration.h"
 #include "./stroke.model.h"
 
@@ -20,6 +22,8 @@ public:
     virtual void setPreviousRawImpulseCount() = 0;
     [[nodiscard]] virtual unsigned long getRawImpulseCount() const = 0;
     [[nodiscard]] virtual unsigned long getLastImpulseTime() const = 0;
+    // Every impulse processed by the last update() in order (empty if there was no new impulse), so consumers that need each delta time (e.g. delta time logging) do not miss the ones of a catch up
+    [[nodiscard]] virtual std::span<const RowingDataModels::FlywheelData> getLastBatch() const = 0;
 
     [[nodiscard]] virtual unsigned long getDeltaTime() const = 0;
     [[nodiscard]] virtual unsigned long long getLastRevTime() const = 0;
@@ -1,18 +1,19 @@
 // NOLINTBEGIN(cppcoreguidelines-pro-type-member-init)
 #pragma once
 
-#include <vector>
-
 #include "../utils/configuration.h"
+#include "../utils/inline-vector.h"
 
 namespace RowingDataModels
 {
+    using HandleForces = InlineVector<float, Configurations::driveHandleForcesCapacity>;
+
     struct FlywheelData
     {
         unsigned long rawImpulseCount;
         unsigned long deltaTime;
         unsigned long long totalTime;
-        Configurations::precision totalAngularDisplacement;
+        double totalAngularDisplacement;
         unsigned long cleanImpulseTime;
         unsigned long rawImpulseTime;
     };
@@ -27,7 +28,12 @@ namespace RowingDataModels
         unsigned int recoveryDuration;
         Configurations::precision avgStrokePower;
         Configurations::precision dragCoefficient;
-        std::vector<float> driveHandleForces;
+        HandleForces driveHandleForces;
+        // Changes every time driveHandleForces is replaced with the curve of a new drive (or cleared), so publishing can tell whether the curve needs to be copied
+        unsigned short handleForcesRevision;
+        // Length of the angular distance regression window in use (shorter than the configured one while the adaptive window is reduced) and the number of times it was reduced or restored
+        unsigned char regressionWindowLength;
+        unsigned int regressionWindowSwitchCount;
     };
 }
 // NOLINTEND(cppcoreguidelines-pro-type-member-init)
\ No newline at end of file
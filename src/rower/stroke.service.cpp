@@ -2,6 +2,7 @@
 #include <cmath>
 #include <cstddef>
 #include <iterator>
+#include <span>
 #include <string>
 
 #include "Arduino.h"
@@ -17,8 +18,11 @@
 #include "../utils/series/series.h"
 #include "../utils/series/ts-linear-series.h"
 #include "../utils/series/ts-quadratic-series.h"
+#include "../utils/series/weighted-average-matrix.h"
 #include "../utils/series/weighted-average-series.h"
 #include "../utils/settings.model.h"
+#include "./allocation-tracker.h"
+#include "./pipeline-profiler.h"
 #include "./stroke.model.h"
 
 using namespace std::string_literals;
@@ -27,10 +31,6 @@ using RowingDataModels::RowingMetrics;
 
 StrokeService::StrokeService()
 {
-    angularVelocityMatrix.reserve(RowerProfile::Defaults::impulseDataArrayLength);
-    angularAccelerationMatrix.reserve(RowerProfile::Defaults::impulseDataArrayLength);
-    driveHandleForces.reserve(RowerProfile::Defaults::driveHandleForcesMaxCapacity);
-
     deltaTimes.push(0, 0);
     angularDistances.push(0, 0);
 }
@@ -45,43 +45,51 @@ void StrokeService::setup(const RowerProfile::MachineSettings newMachineSettings
     rowingStoppedThresholdPeriod = newSensorSignalSettings.rowingStoppedThresholdPeriod;
     angularDisplacementPerImpulse = (2 * PI) / machineSettings.impulsesPerRevolution;
     absoluteMinimumRecoveryDeltaTimesSize = std::max(newStrokeDetectionSettings.impulseDataArrayLength / 2 + 1, 3);
+    // Same as Configurations::defaultAllocationCapacity but from the new settings, the cyclic error filter slot length depends on it so a profile behaves the same whether it is compiled in or set at runtime
+    const auto allocationCapacity = static_cast<unsigned short>(newStrokeDetectionSettings.minimumRecoveryTime / newSensorSignalSettings.rotationDebounceTimeMin);
 
-    dragCoefficients = WeightedAverageSeries(dragFactorSettings.dragCoefficientsArrayLength, Configurations::defaultAllocationCapacity);
+    dragCoefficients = WeightedAverageSeries(dragFactorSettings.dragCoefficientsArrayLength, allocationCapacity);
 
-    deltaTimes = TSLinearSeries(newStrokeDetectionSettings.impulseDataArrayLength, Configurations::defaultAllocationCapacity);
-    deltaTimesSlopes = OLSLinearSeries(newStrokeDetectionSettings.impulseDataArrayLength, Configurations::defaultAllocationCapacity);
-    recoveryDeltaTimes = OLSLinearSeries(0, Configurations::defaultAllocationCapacity, newDragFactorSettings.maxDragFactorRecoveryPeriod / newSensorSignalSettings.rotationDebounceTimeMin / 2);
-    angularDistances = TSQuadraticSeries(newStrokeDetectionSettings.impulseDataArrayLength, Configurations::defaultAllocationCapacity);
+    deltaTimes = TSLinearSeries(newStrokeDetectionSettings.impulseDataArrayLength, allocationCapacity);
+    deltaTimesSlopes = OLSLinearSeries(newStrokeDetectionSettings.impulseDataArrayLength);
+    recoveryDeltaTimes.reset();
+    angularDistances = TSQuadraticSeries(newStrokeDetectionSettings.impulseDataArrayLength, allocationCapacity);
     cyclicFilter = CyclicErrorFilter(
         newMachineSettings.impulsesPerRevolution,
         newStrokeDetectionSettings.impulseDataArrayLength,
         newSensorSignalSettings.cyclicErrorAggressiveness,
-        Configurations::defaultAllocationCapacity,
-        newDragFactorSettings.maxDragFactorRecoveryPeriod / newSensorSignalSettings.rotationDebounceTimeMin / 2);
+        allocationCapacity,
+        newDragFactorSettings.maxDragFactorRecoveryPeriod / newSensorSignalSettings.rotationDebounceTimeMin);
+
+    angularVelocityMatrix = WeightedAverageMatrix(newStrokeDetectionSettings.impulseDataArrayLength);
+    angularAccelerationMatrix = WeightedAverageMatrix(newStrokeDetectionSettings.impulseDataArrayLength);
+
+    #if ENABLE_ADAPTIVE_WINDOW
+    reducedImpulseDataArrayLength = std::max(newStrokeDetectionSettings.impulseDataArrayLength / 2 + 1, 3);
+    windowGovernor = RegressionWindowGovernor(newStrokeDetectionSettings.impulseDataArrayLength);
+    reducedAngularDistances = TSQuadraticSeries(reducedImpulseDataArrayLength, allocationCapacity);
+    reducedAngularVelocityMatrix = WeightedAverageMatrix(reducedImpulseDataArrayLength);
+    reducedAngularAccelerationMatrix = WeightedAverageMatrix(reducedImpulseDataArrayLength);
+    delayedAngularVelocities = ImpulseSeries(newStrokeDetectionSettings.impulseDataArrayLength);
+    delayedAngularAccelerations = ImpulseSeries(newStrokeDetectionSettings.impulseDataArrayLength);
+    #endif
 
-    angularVelocityMatrix.clear();
-    angularVelocityMatrix.shrink_to_fit();
-    angularAccelerationMatrix.clear();
-    angularAccelerationMatrix.shrink_to_fit();
     driveHandleForces.clear();
-    driveHandleForces.shrink_to_fit();
-    angularVelocityMatrix.reserve(strokePhaseDetectionSettings.impulseDataArrayLength);
-    angularAccelerationMatrix.reserve(strokePhaseDetectionSettings.impulseDataArrayLength);
-    driveHandleForces.reserve(strokePhaseDetectionSettings.driveHandleForcesMaxCapacity);
+    ++handleForcesRevision;
 
     deltaTimes.push(0, 0);
     angularDistances.push(0, 0);
 }
 #endif
 
-void StrokeService::processFilterBuffer()
+bool StrokeService::processFilterBuffer()
 {
     if (cyclePhase == CyclePhase::Recovery)
     {
-        return;
+        return false;
     }
 
-    cyclicFilter.processNextRawDatapoint();
+    return cyclicFilter.processNextRawDatapoint();
 }
 
 bool StrokeService::isFlywheelUnpowered()
@@ -173,7 +181,7 @@ void StrokeService::driveStart()
     if (strokePhaseDetectionSettings.strokeDetectionType != StrokeDetectionType::Slope)
     {
         deltaTimesSlopes.reset();
-        deltaTimesSlopes.push(static_cast<Configurations::precision>(rowingTotalTime), deltaTimes.coefficientA());
+        deltaTimesSlopes.push(static_cast<Configurations::precision>(rowingTotalTime - driveStartTime), deltaTimes.coefficientA());
     }
 }
 
@@ -195,7 +203,7 @@ void StrokeService::driveUpdate()
     driveHandleForces.push_back(static_cast<float>(torqueBeforeFlank) / machineSettings.sprocketRadius);
     if (strokePhaseDetectionSettings.strokeDetectionType != StrokeDetectionType::Slope)
     {
-        deltaTimesSlopes.push(static_cast<Configurations::precision>(rowingTotalTime), deltaTimes.coefficientA());
+        deltaTimesSlopes.push(static_cast<Configurations::precision>(rowingTotalTime - driveStartTime), deltaTimes.coefficientA());
     }
 }
 
@@ -207,6 +215,12 @@ void StrokeService::driveEnd()
     driveTotalAngularDisplacement = rowingTotalAngularDisplacement - driveStartAngularDisplacement;
     strokeCount++;
     strokeTime = rowingTotalTime;
+    ++handleForcesRevision;
+
+    if constexpr (Configurations::isAllocationTrackingEnabled)
+    {
+        allocationTracker.completeStroke();
+    }
 
     if constexpr (Configurations::logCalibration)
     {
@@ -246,6 +260,11 @@ void StrokeService::recoveryEnd()
     recoveryDuration = rowingTotalTime - recoveryStartTime;
     recoveryTotalAngularDisplacement = rowingTotalAngularDisplacement - recoveryStartAngularDisplacement;
 
+    if (cyclicFilter.getDroppedDatapointCount() > 0)
+    {
+        Log.warningln("Cyclic error filter recordings are full, %u recovery datapoints were dropped", cyclicFilter.getDroppedDatapointCount());
+    }
+
     const auto goodnessOfFit = calculateRecoveryGoodnessOfFit();
     if (goodnessOfFit >= dragFactorSettings.goodnessOfFitThreshold)
     {
@@ -284,50 +303,162 @@ RowingDataModels::RowingMetrics StrokeService::getData()
         .avgStrokePower = avgStrokePower,
         .dragCoefficient = lastValidDragCoefficient,
         .driveHandleForces = driveHandleForces,
+        .handleForcesRevision = handleForcesRevision,
+        .regressionWindowLength = getRegressionWindowLength(),
+        .regressionWindowSwitchCount = getRegressionWindowSwitchCount(),
     };
 }
 
+unsigned char StrokeService::getRegressionWindowLength() const
+{
+#if ENABLE_ADAPTIVE_WINDOW
+    if (windowGovernor.isReducedWindowActive())
+    {
+        return reducedImpulseDataArrayLength;
+    }
+#endif
+
+    return strokePhaseDetectionSettings.impulseDataArrayLength;
+}
+
+unsigned int StrokeService::getRegressionWindowSwitchCount() const
+{
+#if ENABLE_ADAPTIVE_WINDOW
+    return windowGovernor.getSwitchCount();
+#else
+    return 0U;
+#endif
+}
+
+void StrokeService::publishData(MetricsSnapshot &snapshot)
+{
+    const PipelineStageTimer stageTimer(PipelineStage::PublishData);
+
+    auto &metrics = snapshot.writeBuffer();
+
+    metrics.distance = distance;
+    metrics.lastRevTime = revTime;
+    metrics.lastStrokeTime = strokeTime;
+    metrics.strokeCount = strokeCount;
+    metrics.driveDuration = driveDuration;
+    metrics.recoveryDuration = recoveryDuration;
+    metrics.avgStrokePower = avgStrokePower;
+    metrics.dragCoefficient = lastValidDragCoefficient;
+    metrics.regressionWindowLength = getRegressionWindowLength();
+    metrics.regressionWindowSwitchCount = getRegressionWindowSwitchCount();
+
+    // The force curve is only published once its drive has ended (or when it is dropped), so it is copied into each buffer once per stroke rather than on every impulse
+    if (metrics.handleForcesRevision != handleForcesRevision)
+    {
+        metrics.driveHandleForces = driveHandleForces;
+        metrics.handleForcesRevision = handleForcesRevision;
+    }
+
+    snapshot.publish();
+}
+
 void StrokeService::processData(const RowingDataModels::FlywheelData data)
 {
+    if constexpr (Configurations::isAllocationTrackingEnabled)
+    {
+        // The previous impulse is closed here so its figures include the publishing of the metrics that followed it
+        allocationTracker.completeImpulse();
+    }
+
+#if ENABLE_ADAPTIVE_WINDOW
+    const auto impulseStart = PipelineProfiler::now();
+    processImpulse(data);
+    updateRegressionWindow(static_cast<Configurations::precision>(PipelineProfiler::now() - impulseStart) / static_cast<Configurations::precision>(PipelineProfiler::ticksPerMicrosecond()));
+#else
+    processImpulse(data);
+#endif
+}
+
+template <typename QuadraticSeries>
+void StrokeService::updateDerivativeMatrices(const QuadraticSeries &series, WeightedAverageMatrix &velocityMatrix, WeightedAverageMatrix &accelerationMatrix)
+{
+    velocityMatrix.addRow();
+    accelerationMatrix.addRow();
+
+    const auto goodnessOfFit = series.goodnessOfFit();
+    const auto matrixSize = velocityMatrix.size();
+    unsigned char i = 0;
+    while (i < matrixSize)
+    {
+        velocityMatrix.push(i, series.firstDerivativeAtPosition(i), goodnessOfFit);
+        accelerationMatrix.push(i, series.secondDerivativeAtPosition(i), goodnessOfFit);
+        ++i;
+    }
+}
+
+void StrokeService::processImpulse(const RowingDataModels::FlywheelData data)
+{
+    PipelineStageTimer stageTimer(PipelineStage::StateMachine);
+
     rawImpulseCount = data.rawImpulseCount;
 
     cyclicFilter.applyFilter(data.rawImpulseCount, static_cast<Configurations::precision>(data.deltaTime));
+    stageTimer.lap(PipelineStage::CyclicFilter);
 
     if constexpr (Configurations::logCalibration)
     {
         Log.infoln("%.2f,%.2f", cyclicFilter.rawSeries().back(), cyclicFilter.cleanSeries().back());
+        stageTimer.skip();
+    }
+
+    if constexpr (Configurations::isTimeRebasingEnabled)
+    {
+        // The recovery regression is not shifted, so the origins are only moved outside of the recovery phase
+        if (cyclePhase != CyclePhase::Recovery && deltaTimes.xAtSeriesBegin() > maxRelativeCleanTime)
+        {
+            rebaseOrigins(data.totalAngularDisplacement);
+        }
     }
 
     auto deltaTime = cyclicFilter.cleanSeries().back();
     const auto totalCleanTime = deltaTimes.xAtSeriesEnd() + deltaTime;
 
     deltaTimes.push(static_cast<Configurations::precision>(totalCleanTime), deltaTime);
-    angularDistances.push(static_cast<Configurations::precision>(totalCleanTime) / 1e6, data.totalAngularDisplacement);
+    stageTimer.lap(PipelineStage::DeltaTimes);
 
-    if (angularVelocityMatrix.size() >= strokePhaseDetectionSettings.impulseDataArrayLength)
+    const auto angularTime = static_cast<Configurations::precision>(totalCleanTime) / 1e6;
+    const auto angularDistance = static_cast<Configurations::precision>(data.totalAngularDisplacement - angularDisplacementOrigin);
+#if ENABLE_ADAPTIVE_WINDOW
+    const auto window = windowGovernor.getWindow();
+    if (window != RegressionWindow::Reduced)
     {
-        angularVelocityMatrix.erase(begin(angularVelocityMatrix));
+        angularDistances.push(angularTime, angularDistance);
     }
-    if (angularAccelerationMatrix.size() >= strokePhaseDetectionSettings.impulseDataArrayLength)
+    if (window != RegressionWindow::Full)
     {
-        angularAccelerationMatrix.erase(begin(angularAccelerationMatrix));
+        reducedAngularDistances.push(angularTime, angularDistance);
     }
+    stageTimer.lap(PipelineStage::AngularDistances);
 
-    angularVelocityMatrix.emplace_back(strokePhaseDetectionSettings.impulseDataArrayLength, Configurations::defaultAllocationCapacity);
-    angularAccelerationMatrix.emplace_back(strokePhaseDetectionSettings.impulseDataArrayLength, Configurations::defaultAllocationCapacity);
-
-    const auto angularGoodnessOfFit = angularDistances.goodnessOfFit();
-    const auto angularVelocitySize = angularVelocityMatrix.size();
-    unsigned char i = 0;
-    while (i < angularVelocitySize)
+    if (window != RegressionWindow::Reduced)
     {
-        angularVelocityMatrix[i].push(angularDistances.firstDerivativeAtPosition(i), angularGoodnessOfFit);
-        angularAccelerationMatrix[i].push(angularDistances.secondDerivativeAtPosition(i), angularGoodnessOfFit);
-        ++i;
+        updateDerivativeMatrices(angularDistances, angularVelocityMatrix, angularAccelerationMatrix);
+    }
+    if (window != RegressionWindow::Full)
+    {
+        updateDerivativeMatrices(reducedAngularDistances, reducedAngularVelocityMatrix, reducedAngularAccelerationMatrix);
+        delayedAngularVelocities.push(reducedAngularVelocityMatrix.average());
+        delayedAngularAccelerations.push(reducedAngularAccelerationMatrix.average());
     }
 
-    currentAngularVelocity = angularVelocityMatrix[0].average();
-    currentAngularAcceleration = angularAccelerationMatrix[0].average();
+    // The reduced window settles its oldest point earlier than the full one, so its value from (full - reduced) impulses ago belongs to the impulse at the start of the full window
+    currentAngularVelocity = windowGovernor.isReducedWindowActive() ? delayedAngularVelocities[reducedImpulseDataArrayLength - 1] : angularVelocityMatrix.average();
+    currentAngularAcceleration = windowGovernor.isReducedWindowActive() ? delayedAngularAccelerations[reducedImpulseDataArrayLength - 1] : angularAccelerationMatrix.average();
+#else
+    angularDistances.push(angularTime, angularDistance);
+    stageTimer.lap(PipelineStage::AngularDistances);
+
+    updateDerivativeMatrices(angularDistances, angularVelocityMatrix, angularAccelerationMatrix);
+
+    currentAngularVelocity = angularVelocityMatrix.average();
+    currentAngularAcceleration = angularAccelerationMatrix.average();
+#endif
+    stageTimer.lap(PipelineStage::DerivativeMatrices);
 
     torqueBeforeFlank = currentTorque;
     currentTorque = machineSettings.flywheelInertia * currentAngularAcceleration + dragCoefficient * std::pow(currentAngularVelocity, 2);
@@ -336,6 +467,7 @@ void StrokeService::processData(const RowingDataModels::FlywheelData data)
     if (cyclePhase == CyclePhase::Recovery && rowingTotalTime - recoveryStartTime > rowingStoppedThresholdPeriod)
     {
         driveHandleForces.clear();
+        ++handleForcesRevision;
         recoveryEnd();
         cyclePhase = CyclePhase::Stopped;
         driveDuration = 0;
@@ -356,7 +488,7 @@ void StrokeService::processData(const RowingDataModels::FlywheelData data)
         rowingImpulseCount++;
         rowingTotalTime += static_cast<unsigned long long>(cyclicFilter.cleanSeries().back());
         revTime = rowingTotalTime;
-        rowingTotalAngularDisplacement += angularDisplacementPerImpulse;
+        rowingTotalAngularDisplacement = static_cast<Configurations::precision>(rowingImpulseCount) * angularDisplacementPerImpulse;
 
         // Since we detected power, setting to "Drive" phase and increasing rotation count and registering rotation time
         driveStart();
@@ -366,7 +498,7 @@ void StrokeService::processData(const RowingDataModels::FlywheelData data)
 
     rowingImpulseCount++;
     rowingTotalTime += static_cast<unsigned long long>(cyclicFilter.cleanSeries().back());
-    rowingTotalAngularDisplacement += angularDisplacementPerImpulse;
+    rowingTotalAngularDisplacement = static_cast<Configurations::precision>(rowingImpulseCount) * angularDisplacementPerImpulse;
 
     distance += distancePerAngularDisplacement * (distance == 0 ? rowingTotalAngularDisplacement : angularDisplacementPerImpulse);
     if (distance > 0)
@@ -406,7 +538,71 @@ void StrokeService::processData(const RowingDataModels::FlywheelData data)
     }
 }
 
-void StrokeService::logNewStrokeData() const
+void StrokeService::processBatch(const std::span<const RowingDataModels::FlywheelData> data)
+{
+    for (const auto &flywheelData : data)
+    {
+        processData(flywheelData);
+    }
+}
+
+#if ENABLE_ADAPTIVE_WINDOW
+void StrokeService::updateRegressionWindow(const Configurations::precision processingTime)
+{
+    if (!windowGovernor.update(processingTime, cyclicFilter.cleanSeries().back()))
+    {
+        return;
+    }
+
+    const auto window = windowGovernor.getWindow();
+
+    // The window that is about to take over was not fed while the other one was active, so it is refilled from scratch during the warm-up
+    if (window == RegressionWindow::Shrinking)
+    {
+        reducedAngularDistances.reset();
+        reducedAngularVelocityMatrix.reset();
+        reducedAngularAccelerationMatrix.reset();
+        delayedAngularVelocities.reset();
+        delayedAngularAccelerations.reset();
+
+        return;
+    }
+
+    if (window == RegressionWindow::Restoring)
+    {
+        angularDistances.reset();
+        angularVelocityMatrix.reset();
+        angularAccelerationMatrix.reset();
+
+        return;
+    }
+
+    Log.warningln(
+        "Regression window %s to %d impulses (avg. processing time: %.0fus, delta time: %.0fus, switches: %u)",
+        window == RegressionWindow::Reduced ? "reduced" : "restored",
+        window == RegressionWindow::Reduced ? reducedImpulseDataArrayLength : strokePhaseDetectionSettings.impulseDataArrayLength,
+        windowGovernor.getAverageProcessingTime(),
+        cyclicFilter.cleanSeries().back(),
+        windowGovernor.getSwitchCount());
+}
+#endif
+
+void StrokeService::rebaseOrigins(const double totalAngularDisplacement)
+{
+    const auto cleanTimeOffset = std::floor(deltaTimes.xAtSeriesBegin());
+    const auto angularDisplacementOffset = std::floor(totalAngularDisplacement - angularDisplacementOrigin);
+
+    angularDisplacementOrigin += angularDisplacementOffset;
+
+    deltaTimes.rebase(cleanTimeOffset);
+    angularDistances.rebase(cleanTimeOffset / 1e6, static_cast<Configurations::precision>(angularDisplacementOffset));
+#if ENABLE_ADAPTIVE_WINDOW
+    reducedAngularDistances.rebase(cleanTimeOffset / 1e6, static_cast<Configurations::precision>(angularDisplacementOffset));
+#endif
+    cyclicFilter.rebase(cleanTimeOffset);
+}
+
+void StrokeService::logNewStrokeData()
 {
     Log.infoln("deltaTime: %d", strokeCount);
 
@@ -417,17 +613,19 @@ void StrokeService::logNewStrokeData() const
         return;
     }
 
-    std::string formatted;
+    // The buffer is kept between strokes and sized for the longest possible curve (a force takes up to about 12 characters with the separator), so logging only allocates on the first stroke
+    formattedHandleForces.clear();
+    formattedHandleForces.reserve(strokePhaseDetectionSettings.driveHandleForcesMaxCapacity * 16U + 2U);
+    formattedHandleForces += '[';
     for (size_t i = 0; i < driveHandleForces.size(); ++i)
     {
         if (i != 0)
         {
-            formatted += ',';
+            formattedHandleForces += ',';
         }
-        formatted += std::to_string(driveHandleForces[i]);
+        formattedHandleForces += std::to_string(driveHandleForces[i]);
     }
+    formattedHandleForces += ']';
 
-    string response = "[" + formatted + "]";
-
-    Log.infoln("handleForces: %s", response.c_str());
+    Log.infoln("handleForces: %s", formattedHandleForces.c_str());
 }
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <algorithm>
-#include <vector>
+#include <span>
+#include <string>
 
 #include "Arduino.h"
 
@@ -10,10 +11,17 @@
 #include "../utils/macros.h"
 #include "../utils/series/cyclic-error-filter.h"
 #include "../utils/series/ols-linear-series.h"
+#include "../utils/series/static-ols-linear-series.h"
+#include "../utils/series/static-series.h"
+#include "../utils/series/static-ts-linear-series.h"
+#include "../utils/series/static-ts-quadratic-series.h"
 #include "../utils/series/ts-linear-series.h"
 #include "../utils/series/ts-quadratic-series.h"
+#include "../utils/series/weighted-average-matrix.h"
 #include "../utils/series/weighted-average-series.h"
 #include "../utils/settings.model.h"
+#include "./metrics-snapshot.h"
+#include "./regression-window-governor.h"
 #include "./stroke.service.interface.h"
 
 class StrokeService final : public IStrokeService
@@ -35,6 +43,10 @@ class StrokeService final : public IStrokeService
     unsigned long rawImpulseCount = 0UL;
     Configurations::precision rowingTotalAngularDisplacement = 0;
 
+    // The regression windows get the clean time and the angular displacement relative to these origins, that are moved forward in whole units once the oldest clean time exceeds maxRelativeCleanTime (only when Configurations::isTimeRebasingEnabled)
+    static constexpr Configurations::precision maxRelativeCleanTime = 1'000'000;
+    double angularDisplacementOrigin = 0;
+
     // Drive related
     unsigned long long driveStartTime = 0ULL;
     unsigned int driveDuration = 0;
@@ -66,25 +78,50 @@ class StrokeService final : public IStrokeService
     Configurations::precision currentAngularAcceleration = 0;
     Configurations::precision currentTorque = 0;
     Configurations::precision torqueBeforeFlank = 0;
-    vector<float> driveHandleForces;
+    RowingDataModels::HandleForces driveHandleForces;
+    unsigned short handleForcesRevision = 0;
+    std::string formattedHandleForces;
 
-    vector<WeightedAverageSeries> angularVelocityMatrix;
-    vector<WeightedAverageSeries> angularAccelerationMatrix;
+    WeightedAverageMatrix angularVelocityMatrix = WeightedAverageMatrix(RowerProfile::Defaults::impulseDataArrayLength);
+    WeightedAverageMatrix angularAccelerationMatrix = WeightedAverageMatrix(RowerProfile::Defaults::impulseDataArrayLength);
 
+#if ENABLE_RUNTIME_SETTINGS
     TSLinearSeries deltaTimes = TSLinearSeries(RowerProfile::Defaults::impulseDataArrayLength, Configurations::defaultAllocationCapacity);
-    OLSLinearSeries deltaTimesSlopes = OLSLinearSeries(RowerProfile::Defaults::impulseDataArrayLength, Configurations::defaultAllocationCapacity);
-    OLSLinearSeries recoveryDeltaTimes = OLSLinearSeries(0, Configurations::defaultAllocationCapacity, RowerProfile::Defaults::maxDragFactorRecoveryPeriod / RowerProfile::Defaults::rotationDebounceTimeMin / 2);
+    OLSLinearSeries deltaTimesSlopes = OLSLinearSeries(RowerProfile::Defaults::impulseDataArrayLength);
     TSQuadraticSeries angularDistances = TSQuadraticSeries(RowerProfile::Defaults::impulseDataArrayLength, Configurations::defaultAllocationCapacity);
+#else
+    // Without runtime settings the window length is a compile time constant, so the regressions can use the fixed size kernels with inline storage
+    StaticTSLinearSeries<RowerProfile::Defaults::impulseDataArrayLength> deltaTimes;
+    StaticOLSLinearSeries<RowerProfile::Defaults::impulseDataArrayLength> deltaTimesSlopes;
+    StaticTSQuadraticSeries<RowerProfile::Defaults::impulseDataArrayLength> angularDistances;
+#endif
+#if ENABLE_ADAPTIVE_WINDOW
+    // Shorter angular distance regression that takes over from the full one under CPU pressure. Its derivatives go through a delay line so the torque still refers to the same impulse as the start of the delta times window
+    unsigned char reducedImpulseDataArrayLength = Configurations::reducedImpulseDataArrayLength;
+    RegressionWindowGovernor windowGovernor;
+    #if ENABLE_RUNTIME_SETTINGS
+    TSQuadraticSeries reducedAngularDistances = TSQuadraticSeries(Configurations::reducedImpulseDataArrayLength, Configurations::defaultAllocationCapacity);
+    #else
+    StaticTSQuadraticSeries<Configurations::reducedImpulseDataArrayLength> reducedAngularDistances;
+    #endif
+    WeightedAverageMatrix reducedAngularVelocityMatrix = WeightedAverageMatrix(Configurations::reducedImpulseDataArrayLength);
+    WeightedAverageMatrix reducedAngularAccelerationMatrix = WeightedAverageMatrix(Configurations::reducedImpulseDataArrayLength);
+    ImpulseSeries delayedAngularVelocities = ImpulseSeries(RowerProfile::Defaults::impulseDataArrayLength);
+    ImpulseSeries delayedAngularAccelerations = ImpulseSeries(RowerProfile::Defaults::impulseDataArrayLength);
+#endif
+    OLSLinearSeries recoveryDeltaTimes;
     CyclicErrorFilter cyclicFilter = CyclicErrorFilter(
         RowerProfile::Defaults::impulsesPerRevolution,
         RowerProfile::Defaults::impulseDataArrayLength,
         RowerProfile::Defaults::cyclicErrorAggressiveness,
         Configurations::defaultAllocationCapacity,
-        RowerProfile::Defaults::maxDragFactorRecoveryPeriod / RowerProfile::Defaults::rotationDebounceTimeMin / 2);
+        RowerProfile::Defaults::maxDragFactorRecoveryPeriod / RowerProfile::Defaults::rotationDebounceTimeMin);
 
     bool isFlywheelUnpowered();
     bool isFlywheelPowered();
     [[nodiscard]] Configurations::precision calculateRecoveryGoodnessOfFit() const;
+    [[nodiscard]] unsigned char getRegressionWindowLength() const;
+    [[nodiscard]] unsigned int getRegressionWindowSwitchCount() const;
     void calculateDragCoefficient(Configurations::precision goodnessOfFit);
     void calculateAvgStrokePower();
 
@@ -95,7 +132,15 @@ class StrokeService final : public IStrokeService
     void recoveryUpdate();
     void recoveryEnd();
 
-    void logNewStrokeData() const;
+    template <typename QuadraticSeries>
+    static void updateDerivativeMatrices(const QuadraticSeries &series, WeightedAverageMatrix &velocityMatrix, WeightedAverageMatrix &accelerationMatrix);
+    void processImpulse(RowingDataModels::FlywheelData data);
+#if ENABLE_ADAPTIVE_WINDOW
+    void updateRegressionWindow(Configurations::precision processingTime);
+#endif
+
+    void rebaseOrigins(double totalAngularDisplacement);
+    void logNewStrokeData();
 
 public:
     StrokeService();
@@ -105,6 +150,8 @@ public:
 #endif
 
     RowingDataModels::RowingMetrics getData() override;
+    void publishData(MetricsSnapshot &snapshot) override;
     void processData(RowingDataModels::FlywheelData data) override;
-    void processFilterBuffer() override;
+    void processBatch(std::span<const RowingDataModels::FlywheelData> data) override;
+    bool processFilterBuffer() override;
 };
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <span>
+
 #include "../utils/settings.model.h"
+#include "./metrics-snapshot.h"
 #include "./stroke.model.h"
 
 class IStrokeService
@@ -13,6 +16,9 @@ public:
     virtual void setup(RowerProfile::MachineSettings newMachineSettings, RowerProfile::SensorSignalSettings newSensorSignalSettings, RowerProfile::DragFactorSettings newDragFactorSettings, RowerProfile::StrokePhaseDetectionSettings newStrokeDetectionSettings) = 0;
 #endif
     virtual RowingDataModels::RowingMetrics getData() = 0;
+    virtual void publishData(MetricsSnapshot &snapshot) = 0;
     virtual void processData(RowingDataModels::FlywheelData data) = 0;
-    virtual void processFilterBuffer() = 0;
+    // Processes the impulses in order like processData, the caller keeps the batch so the per impulse delta times remain available to the logging
+    virtual void processBatch(std::span<const RowingDataModels::FlywheelData> data) = 0;
+    virtual bool processFilterBuffer() = 0;
 };
\ No newline at end of file
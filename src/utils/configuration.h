@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <climits>
 #include <string>
+#include <type_traits>
 
 #include "soc/gpio_num.h"
 
@@ -20,6 +23,9 @@ class Configurations
 public:
     using precision = PRECISION;
 
+    // Float only has ~7 significant digits, so the time and angle coordinates of the regression windows are kept relative to an origin that is moved forward as the session goes on. With double the absolute values are precise enough and the origin never moves
+    static constexpr bool isTimeRebasingEnabled = std::is_same_v<precision, float>;
+
     static constexpr unsigned char maxConnectionCount = 2;
     static constexpr unsigned short minBleUpdateInterval = MIN_BLE_UPDATE_INTERVAL;
 
@@ -29,12 +35,35 @@ public:
 
     static constexpr bool isRuntimeSettingsEnabled = ENABLE_RUNTIME_SETTINGS;
     static constexpr bool isDebounceFilterEnabled = ENABLE_DEBOUNCE_FILTER;
+    static constexpr bool isPipelineProfilingEnabled = ENABLE_PIPELINE_PROFILING;
+    static constexpr bool isAllocationTrackingEnabled = ENABLE_ALLOCATION_TRACKING;
+    static constexpr bool isAdaptiveWindowEnabled = ENABLE_ADAPTIVE_WINDOW;
+    // Length of the angular distance regression window while the adaptive window is reduced (with runtime settings this is only the default, the actual length follows the configured impulse data array length)
+    static constexpr unsigned char reducedImpulseDataArrayLength = std::max(RowerProfile::Defaults::impulseDataArrayLength / 2 + 1, 3);
+    // Microseconds per main loop iteration the cyclic error filter may spend replaying the datapoints recorded during the last recovery (0 replays one datapoint per iteration)
+    static constexpr unsigned short cyclicFilterReplayBudget = CYCLIC_FILTER_REPLAY_BUDGET;
+    // Number of pushes after which the power sums behind the R^2 of the quadratic regression are rebuilt from the window instead of being updated incrementally. Lower values bound the rounding drift tighter (mostly relevant with float) at the cost of walking the window more often
+    static constexpr unsigned char quadraticFitMomentsRecalculationInterval = 8;
+    // Number of raw impulses the ISR can queue up before the main loop picks them up (must be a power of two)
+    static constexpr unsigned short impulseQueueCapacity = 32;
+    // Inline capacity of the handle force curves, with runtime settings it has to fit the largest max capacity that can be configured
+    static constexpr unsigned char driveHandleForcesCapacity = ENABLE_RUNTIME_SETTINGS ? UCHAR_MAX : RowerProfile::Defaults::driveHandleForcesMaxCapacity;
 
     // Bluetooth Settings
     static constexpr BleServiceFlag defaultBleServiceFlag = DEFAULT_BLE_SERVICE;
     static constexpr bool hasExtendedBleMetrics = HAS_BLE_EXTENDED_METRICS;
     static constexpr bool enableBluetoothDeltaTimeLogging = ENABLE_BLUETOOTH_DELTA_TIME_LOGGING;
     static constexpr BleSignalStrength bleSignalStrength = BLE_SIGNAL_STRENGTH;
+    // Number of notifications a handle force curve is split into for a client with the default MTU of 23 bytes (4 forces per notification)
+    static constexpr unsigned char bleMaxHandleForcesChunkCount = (driveHandleForcesCapacity + 3U) / 4U;
+    // Number of handle force and delta time notifications and payload bytes that can wait for the BLE notification task (both must be a power of two). The queue fits the longest handle force curve for every connection, a curve that does not fit is dropped as a whole
+    static constexpr unsigned short bleNotificationQueueCapacity = std::bit_ceil(static_cast<unsigned short>(maxConnectionCount * bleMaxHandleForcesChunkCount));
+    static constexpr unsigned short bleNotificationBufferSize = 4'096;
+    // Same for the metrics snapshots (base and extended metrics, diagnostics) that are queued ahead of the handle forces and delta times
+    static constexpr unsigned short bleSnapshotQueueCapacity = 16;
+    static constexpr unsigned short bleSnapshotBufferSize = 512;
+    // Notifications handed to the BLE stack per connection interval of a client. Phones typically send 4-6 packets per connection event, the lower end keeps the controller buffers from filling up
+    static constexpr unsigned char blePacketsPerConnectionEvent = 4;
 
     static constexpr bool addBleServiceStringToName = ADD_BLE_SERVICE_TO_DEVICE_NAME;
     static constexpr bool enableSerialInDeviceName = ADD_SERIAL_TO_DEVICE_NAME;
@@ -44,11 +73,19 @@ public:
     inline static const string serialNumber = SERIAL_NUMBER;
     inline static const string firmwareVersion = string(getCompileDate().data(), getCompileDate().size());
     inline static const string hardwareRevision = string(getHardwareRevision());
+    inline static const string rowerProfileName = string(getRowerProfileName());
 
     // Hardware settings
     static constexpr BaudRates baudRate = BAUD_RATE;
 
     static constexpr gpio_num_t sdCardChipSelectPin = SD_CARD_CHIP_SELECT_PIN;
+    // Number of delta times that can wait for the SD card writer task (must be a power of two)
+    static constexpr unsigned short sdCardQueueCapacity = 512;
+    // Milliseconds between two runs of the SD card writer task, and the longest time written delta times may stay unflushed
+    static constexpr unsigned short sdCardWriterPeriod = 100;
+    static constexpr unsigned short sdCardMaxFlushLatency = 1'000;
+    // Size of the contiguous log file allocated on the SD card up front (the log grows beyond this if needed)
+    static constexpr unsigned long sdCardPreallocatedSize = 8UL * 1'024UL * 1'024UL;
     static constexpr gpio_num_t sensorPinNumber = SENSOR_PIN_NUMBER;
     static constexpr gpio_num_t wakeupPinNumber = WAKEUP_SENSOR_PIN_NUMBER;
     static constexpr bool hasWakeupPinNumber = wakeupPinNumber != GPIO_NUM_NC;
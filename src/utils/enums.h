@@ -40,6 +40,24 @@ enum class CyclePhase : unsigned char
     Drive
 };
 
+enum class PipelineStage : unsigned char
+{
+    CyclicFilter,
+    DeltaTimes,
+    AngularDistances,
+    DerivativeMatrices,
+    StateMachine,
+    PublishData
+};
+
+enum class RegressionWindow : unsigned char
+{
+    Full,
+    Shrinking,
+    Reduced,
+    Restoring
+};
+
 enum class BleServiceFlag : unsigned char
 {
     CpsService,
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <span>
+
+#include "./delta-time-stream.h"
+
+#include "./impulse-log.h"
+
+bool DeltaTimeStreamEncoder::push(const unsigned long deltaTime)
+{
+    const auto value = static_cast<unsigned int>(deltaTime);
+
+    if (impulseCount == 0)
+    {
+        packet[0] = sequenceNumber;
+        packet[1] = static_cast<unsigned char>(value);
+        packet[2] = static_cast<unsigned char>(value >> 8U);
+        packet[3] = static_cast<unsigned char>(value >> 16U);
+        packet[4] = static_cast<unsigned char>(value >> 24U);
+        length = DeltaTimeStream::headerSize;
+    }
+    else
+    {
+        if (length + ImpulseLog::maxVarintLength > packet.size())
+        {
+            return false;
+        }
+
+        length += ImpulseLog::writeDifference(&packet[length], previousDeltaTime, value);
+    }
+
+    previousDeltaTime = value;
+    ++impulseCount;
+
+    return true;
+}
+
+void DeltaTimeStreamEncoder::next()
+{
+    length = 0;
+    impulseCount = 0;
+    ++sequenceNumber;
+}
+
+std::span<const unsigned char> DeltaTimeStreamEncoder::data() const
+{
+    return std::span(packet).first(length);
+}
+
+unsigned short DeltaTimeStreamEncoder::size() const
+{
+    return impulseCount;
+}
+
+bool DeltaTimeStreamEncoder::empty() const
+{
+    return impulseCount == 0;
+}
+
+bool DeltaTimeStreamDecoder::open(const std::span<const unsigned char> packet)
+{
+    payload = {};
+    position = 0;
+    isFirst = true;
+
+    if (packet.size() < DeltaTimeStream::headerSize)
+    {
+        return false;
+    }
+
+    if (hasSequenceNumber)
+    {
+        lostPackets += static_cast<unsigned char>(packet[0] - sequenceNumber - 1U);
+    }
+    hasSequenceNumber = true;
+    sequenceNumber = packet[0];
+
+    previousDeltaTime = static_cast<unsigned int>(packet[1]) | (static_cast<unsigned int>(packet[2]) << 8U) | (static_cast<unsigned int>(packet[3]) << 16U) | (static_cast<unsigned int>(packet[4]) << 24U);
+    payload = packet;
+    position = DeltaTimeStream::headerSize;
+
+    return true;
+}
+
+bool DeltaTimeStreamDecoder::next(unsigned long &deltaTime)
+{
+    if (isFirst && !payload.empty())
+    {
+        isFirst = false;
+        deltaTime = previousDeltaTime;
+
+        return true;
+    }
+
+    if (position >= payload.size())
+    {
+        return false;
+    }
+
+    previousDeltaTime = ImpulseLog::readDifference(payload, position, previousDeltaTime);
+    deltaTime = previousDeltaTime;
+
+    return true;
+}
+
+unsigned char DeltaTimeStreamDecoder::getSequenceNumber() const
+{
+    return sequenceNumber;
+}
+
+unsigned int DeltaTimeStreamDecoder::getLostPacketCount() const
+{
+    return lostPackets;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+// Compact encoding of the delta times sent over BLE, an alternative to the raw array of 32 bit delta times that clients can opt in to via the settings control point. Every notification is self contained: a sequence number (1, wraps around, so the client can detect lost notifications), the first delta time (4, little endian) and the rest of the delta times as zig-zag varint encoded differences to the previous one, the same way as in the data blocks of the impulse log (see impulse-log.h). The impulse count is not sent, the notification is decoded until its end
+namespace DeltaTimeStream
+{
+    inline constexpr size_t headerSize = 5;
+    // Largest packet the encoder fills, i.e. the largest notification payload of BLE (max MTU of 512 minus the ATT header)
+    inline constexpr size_t maxPacketSize = 512U - 3U;
+}
+
+// Packs delta times into a notification payload. The caller decides when to send the packet (e.g. when the next delta time might not fit the MTU of the client), push only returns false if the packet reached the largest notification payload
+class DeltaTimeStreamEncoder
+{
+    std::array<unsigned char, DeltaTimeStream::maxPacketSize> packet{};
+    size_t length = 0;
+    unsigned short impulseCount = 0;
+    unsigned int previousDeltaTime = 0;
+    unsigned char sequenceNumber = 0;
+
+public:
+    bool push(unsigned long deltaTime);
+    // Clears the packet and moves on to the next sequence number
+    void next();
+
+    [[nodiscard]] std::span<const unsigned char> data() const;
+    [[nodiscard]] unsigned short size() const;
+    [[nodiscard]] bool empty() const;
+};
+
+// Reads the delta times of received notifications one by one, the packet needs to stay valid until all delta times are read
+class DeltaTimeStreamDecoder
+{
+    std::span<const unsigned char> payload;
+    size_t position = 0;
+    unsigned int previousDeltaTime = 0;
+    bool isFirst = true;
+    bool hasSequenceNumber = false;
+    unsigned char sequenceNumber = 0;
+    unsigned int lostPackets = 0;
+
+public:
+    // Returns false if the packet is too short to hold a delta time. Gaps in the sequence numbers are counted as lost packets
+    bool open(std::span<const unsigned char> packet);
+    bool next(unsigned long &deltaTime);
+
+    [[nodiscard]] unsigned char getSequenceNumber() const;
+    [[nodiscard]] unsigned int getLostPacketCount() const;
+};
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include "./impulse-log.h"
+
+namespace
+{
+    // CRC-32 (IEEE 802.3, same as zlib) lookup table, generated at compile time
+    constexpr std::array<unsigned int, 256> crcTable = []()
+    {
+        std::array<unsigned int, 256> table{};
+        auto i = 0U;
+        while (i < table.size())
+        {
+            auto crc = i;
+            auto bit = 0U;
+            while (bit < 8U)
+            {
+                crc = (crc & 1U) != 0U ? (crc >> 1U) ^ 0xEDB88320U : crc >> 1U;
+                ++bit;
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            table[i] = crc;
+            ++i;
+        }
+
+        return table;
+    }();
+
+    void writeUnsignedShort(unsigned char *const destination, const unsigned short value)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        destination[0] = static_cast<unsigned char>(value);
+        destination[1] = static_cast<unsigned char>(value >> 8U);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    void writeUnsignedInt(unsigned char *const destination, const unsigned int value)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        destination[0] = static_cast<unsigned char>(value);
+        destination[1] = static_cast<unsigned char>(value >> 8U);
+        destination[2] = static_cast<unsigned char>(value >> 16U);
+        destination[3] = static_cast<unsigned char>(value >> 24U);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    unsigned short readUnsignedShort(const unsigned char *const source)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return static_cast<unsigned short>(source[0] | (source[1] << 8U));
+    }
+
+    unsigned int readUnsignedInt(const unsigned char *const source)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return static_cast<unsigned int>(source[0]) | (static_cast<unsigned int>(source[1]) << 8U) | (static_cast<unsigned int>(source[2]) << 16U) | (static_cast<unsigned int>(source[3]) << 24U);
+    }
+
+    // Checksum of a data block covers its header up to the checksum field and the used part of the payload
+    unsigned int blockChecksum(const std::span<const unsigned char, ImpulseLog::blockSize> block, const unsigned short payloadSize)
+    {
+        const auto checksumOffset = 16U;
+
+        return ImpulseLog::crc32(block.subspan(ImpulseLog::blockHeaderSize, payloadSize), ImpulseLog::crc32(block.first(checksumOffset)));
+    }
+}
+
+namespace ImpulseLog
+{
+    std::string_view FileHeader::profile() const
+    {
+        return {profileName.data(), strnlen(profileName.data(), profileName.size())};
+    }
+
+    void FileHeader::setProfile(const std::string_view name)
+    {
+        profileName.fill('\0');
+        std::ranges::copy(name.substr(0, profileName.size()), begin(profileName));
+    }
+
+    unsigned int crc32(const std::span<const unsigned char> data, unsigned int crc)
+    {
+        crc = ~crc;
+        for (const auto byte : data)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            crc = crcTable[(crc ^ byte) & 0xFFU] ^ (crc >> 8U);
+        }
+
+        return ~crc;
+    }
+
+    size_t writeDifference(unsigned char *const destination, const unsigned int previousDeltaTime, const unsigned int deltaTime)
+    {
+        const auto difference = static_cast<long long>(deltaTime) - static_cast<long long>(previousDeltaTime);
+        auto zigZag = (static_cast<unsigned long long>(difference) << 1U) ^ static_cast<unsigned long long>(difference >> 63U);
+        auto length = 0U;
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        while (zigZag >= 0x80U)
+        {
+            destination[length++] = static_cast<unsigned char>(zigZag | 0x80U);
+            zigZag >>= 7U;
+        }
+        destination[length++] = static_cast<unsigned char>(zigZag);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        return length;
+    }
+
+    unsigned int readDifference(const std::span<const unsigned char> data, size_t &position, const unsigned int previousDeltaTime)
+    {
+        auto zigZag = 0ULL;
+        auto shift = 0U;
+        while (position < data.size())
+        {
+            const auto byte = data[position++];
+            zigZag |= static_cast<unsigned long long>(byte & 0x7FU) << shift;
+            if ((byte & 0x80U) == 0U)
+            {
+                break;
+            }
+            shift += 7U;
+        }
+
+        const auto difference = static_cast<long long>(zigZag >> 1U) ^ -static_cast<long long>(zigZag & 1U);
+
+        return static_cast<unsigned int>(static_cast<long long>(previousDeltaTime) + difference);
+    }
+
+    void writeFileHeader(const FileHeader &header, Block &block)
+    {
+        block.fill(0);
+
+        std::ranges::copy(magic, begin(block));
+        writeUnsignedShort(&block[4], header.version);
+        writeUnsignedShort(&block[6], header.impulsesPerRevolution);
+        writeUnsignedInt(&block[8], header.expectedStrokeCount);
+        std::memcpy(&block[12], header.profileName.data(), profileNameLength);
+        writeUnsignedInt(&block[44], header.logId);
+
+        const auto checksumOffset = fileHeaderSize - 4U;
+        writeUnsignedInt(&block[checksumOffset], crc32(std::span(block).first(checksumOffset)));
+    }
+
+    bool readFileHeader(const std::span<const unsigned char> data, FileHeader &header)
+    {
+        const auto checksumOffset = fileHeaderSize - 4U;
+        if (data.size() < blockSize || !std::ranges::equal(data.first(magic.size()), magic) || readUnsignedInt(&data[checksumOffset]) != crc32(data.first(checksumOffset)))
+        {
+            return false;
+        }
+
+        header.version = readUnsignedShort(&data[4]);
+        header.impulsesPerRevolution = readUnsignedShort(&data[6]);
+        header.expectedStrokeCount = readUnsignedInt(&data[8]);
+        std::memcpy(header.profileName.data(), &data[12], profileNameLength);
+        header.logId = readUnsignedInt(&data[44]);
+
+        return header.version == version;
+    }
+}
+
+void ImpulseLogEncoder::begin(const unsigned int newLogId)
+{
+    reset();
+    logId = newLogId;
+    sequence = 0;
+}
+
+bool ImpulseLogEncoder::push(const unsigned long deltaTime)
+{
+    if (impulseCount == 0)
+    {
+        writeUnsignedInt(&block[4], static_cast<unsigned int>(deltaTime));
+        previousDeltaTime = static_cast<unsigned int>(deltaTime);
+        ++impulseCount;
+
+        return true;
+    }
+
+    if (payloadSize + ImpulseLog::maxVarintLength > ImpulseLog::blockPayloadCapacity)
+    {
+        return false;
+    }
+
+    payloadSize += ImpulseLog::writeDifference(&block[ImpulseLog::blockHeaderSize + payloadSize], static_cast<unsigned int>(previousDeltaTime), static_cast<unsigned int>(deltaTime));
+
+    previousDeltaTime = static_cast<unsigned int>(deltaTime);
+    ++impulseCount;
+
+    return true;
+}
+
+const ImpulseLog::Block &ImpulseLogEncoder::seal()
+{
+    writeUnsignedShort(block.data(), impulseCount);
+    writeUnsignedShort(&block[2], payloadSize);
+    writeUnsignedInt(&block[8], logId);
+    writeUnsignedInt(&block[12], sequence);
+    writeUnsignedInt(&block[16], blockChecksum(block, payloadSize));
+
+    return block;
+}
+
+void ImpulseLogEncoder::reset()
+{
+    block.fill(0);
+    impulseCount = 0;
+    payloadSize = 0;
+    previousDeltaTime = 0;
+    ++sequence;
+}
+
+unsigned short ImpulseLogEncoder::size() const
+{
+    return impulseCount;
+}
+
+bool ImpulseLogEncoder::empty() const
+{
+    return impulseCount == 0;
+}
+
+bool ImpulseLogDecoder::open(const std::span<const unsigned char, ImpulseLog::blockSize> block)
+{
+    remaining = readUnsignedShort(block.data());
+    const auto payloadSize = readUnsignedShort(&block[2]);
+    payload = {};
+    position = 0;
+    isFirst = true;
+    previousDeltaTime = readUnsignedInt(&block[4]);
+
+    if (payloadSize > ImpulseLog::blockPayloadCapacity || readUnsignedInt(&block[16]) != blockChecksum(block, payloadSize))
+    {
+        remaining = 0;
+
+        return false;
+    }
+
+    payload = block.subspan(ImpulseLog::blockHeaderSize, payloadSize);
+
+    return true;
+}
+
+bool ImpulseLogDecoder::next(unsigned long &deltaTime)
+{
+    if (remaining == 0)
+    {
+        return false;
+    }
+
+    --remaining;
+    if (isFirst)
+    {
+        isFirst = false;
+        deltaTime = previousDeltaTime;
+
+        return true;
+    }
+
+    previousDeltaTime = ImpulseLog::readDifference(payload, position, static_cast<unsigned int>(previousDeltaTime));
+    deltaTime = previousDeltaTime;
+
+    return true;
+}
+
+unsigned short ImpulseLogDecoder::impulseCount(const std::span<const unsigned char, ImpulseLog::blockSize> block)
+{
+    return readUnsignedShort(block.data());
+}
+
+bool ImpulseLogDecoder::isPartOf(const std::span<const unsigned char, ImpulseLog::blockSize> block, const unsigned int logId, const unsigned int sequence)
+{
+    return readUnsignedInt(&block[8]) == logId && readUnsignedInt(&block[12]) == sequence;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+// Binary format of impulse (delta time) recordings. The file is a sequence of 512 byte blocks (the sector size of SD cards, so a block can be written and rewritten in place): a header block with the recording details, followed by data blocks of delta times. Every data block is self contained (it starts with a full delta time and has its own checksum) and the rest of the delta times are stored as zig-zag varint encoded differences to the previous delta time (i.e. the delta-of-delta of the impulse times), which typically takes 1-2 bytes per impulse instead of the 5-7 characters of the text format. All numbers are little endian. The log ends at the end of the file, at the first data block that holds no impulses (e.g. the unused part of a preallocated file) or at the first data block that carries another log ID or is out of sequence (e.g. a block of an older, deleted log left in a recycled cluster of a preallocated file)
+namespace ImpulseLog
+{
+    inline constexpr std::array<unsigned char, 4> magic{'E', 'R', 'M', 'I'};
+    inline constexpr unsigned short version = 2;
+    inline constexpr std::string_view fileExtension = ".ilog";
+
+    inline constexpr size_t blockSize = 512;
+    inline constexpr size_t profileNameLength = 32;
+
+    // Header block: magic (4), version (2), impulses per revolution (2), expected stroke count (4), profile name (32, zero padded), log ID (4), CRC-32 of the preceding bytes (4), rest is reserved (zero)
+    inline constexpr size_t fileHeaderSize = 52;
+
+    // Data block: impulse count (2), payload size (2), first delta time (4), log ID (4), sequence number of the block (4, 0 for the first data block), CRC-32 of the preceding header fields and the payload (4), payload
+    inline constexpr size_t blockHeaderSize = 20;
+    inline constexpr size_t blockPayloadCapacity = blockSize - blockHeaderSize;
+    // A delta time difference is at most 33 bits once zig-zag encoded
+    inline constexpr size_t maxVarintLength = 5;
+
+    using Block = std::array<unsigned char, blockSize>;
+
+    struct FileHeader
+    {
+        unsigned short version = ImpulseLog::version;
+        unsigned short impulsesPerRevolution = 0;
+        // 0 if not known (e.g. a log recorded on the device)
+        unsigned int expectedStrokeCount = 0;
+        std::array<char, profileNameLength> profileName{};
+        // Random on every new file, every data block carries it so blocks of another log are not read as part of this one
+        unsigned int logId = 0;
+
+        [[nodiscard]] std::string_view profile() const;
+        void setProfile(std::string_view name);
+    };
+
+    unsigned int crc32(std::span<const unsigned char> data, unsigned int crc = 0);
+
+    // Writes the zig-zag varint encoded difference of two delta times (destination needs room for maxVarintLength bytes) and returns the number of bytes written
+    size_t writeDifference(unsigned char *destination, unsigned int previousDeltaTime, unsigned int deltaTime);
+    // Reads a difference written by writeDifference from position (which is moved past it) and returns the delta time it encodes
+    unsigned int readDifference(std::span<const unsigned char> data, size_t &position, unsigned int previousDeltaTime);
+
+    void writeFileHeader(const FileHeader &header, Block &block);
+    // Returns false if the data does not start with a valid header of a supported version
+    bool readFileHeader(std::span<const unsigned char> data, FileHeader &header);
+}
+
+// Packs delta times into a data block. When the block is full push returns false, the block needs to be written out and reset before continuing (the rejected delta time is not stored)
+class ImpulseLogEncoder
+{
+    ImpulseLog::Block block{};
+    unsigned short impulseCount = 0;
+    unsigned short payloadSize = 0;
+    unsigned long previousDeltaTime = 0;
+    unsigned int logId = 0;
+    unsigned int sequence = 0;
+
+public:
+    // Starts the first data block of the log with the given ID
+    void begin(unsigned int newLogId);
+    bool push(unsigned long deltaTime);
+    // Fills in the block header and checksum, the block stays open so it can be sealed again after further pushes (e.g. to flush a partial block and later rewrite it in place)
+    const ImpulseLog::Block &seal();
+    // Starts the next data block of the log (the sequence number is incremented)
+    void reset();
+
+    [[nodiscard]] unsigned short size() const;
+    [[nodiscard]] bool empty() const;
+};
+
+// Reads the delta times of a data block one by one, the block needs to stay valid (e.g. mapped) until all delta times are read
+class ImpulseLogDecoder
+{
+    std::span<const unsigned char> payload;
+    size_t position = 0;
+    unsigned short remaining = 0;
+    unsigned long previousDeltaTime = 0;
+    bool isFirst = true;
+
+public:
+    // Returns false if the block is corrupt (checksum or size mismatch). A block with no impulses marks the end of the log and should not be opened (see impulseCount)
+    bool open(std::span<const unsigned char, ImpulseLog::blockSize> block);
+    bool next(unsigned long &deltaTime);
+
+    // Number of impulses in a data block according to its header (without validating it)
+    [[nodiscard]] static unsigned short impulseCount(std::span<const unsigned char, ImpulseLog::blockSize> block);
+    // Whether the header of a data block carries the given log ID and sequence number (without validating it), the log ends at the first block that does not
+    [[nodiscard]] static bool isPartOf(std::span<const unsigned char, ImpulseLog::blockSize> block, unsigned int logId, unsigned int sequence);
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+
+// Vector like container with its storage inline, so copying it never allocates (and only copies the used part). Values pushed beyond the capacity are dropped
+template <typename T, unsigned short Capacity>
+class InlineVector
+{
+    std::array<T, Capacity> values{};
+    unsigned short count = 0;
+
+public:
+    constexpr InlineVector() = default;
+
+    constexpr InlineVector(std::initializer_list<T> initialValues)
+    {
+        for (const auto &value : initialValues)
+        {
+            push_back(value);
+        }
+    }
+
+    InlineVector(const InlineVector &other)
+    {
+        assign(other);
+    }
+
+    InlineVector &operator=(const InlineVector &other)
+    {
+        if (this != &other)
+        {
+            assign(other);
+        }
+
+        return *this;
+    }
+
+    // Moving inline storage is not cheaper than copying it, so both only copy the used part
+    InlineVector(InlineVector &&other) noexcept
+    {
+        assign(other);
+    }
+
+    InlineVector &operator=(InlineVector &&other) noexcept
+    {
+        assign(other);
+
+        return *this;
+    }
+
+    ~InlineVector() = default;
+
+    void assign(const std::span<const T> newValues)
+    {
+        count = static_cast<unsigned short>(std::min<size_t>(newValues.size(), Capacity));
+        std::copy_n(newValues.begin(), count, values.begin());
+    }
+
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    constexpr void push_back(const T &value)
+    {
+        if (count >= Capacity)
+        {
+            return;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        values[count] = value;
+        ++count;
+    }
+
+    void clear()
+    {
+        count = 0;
+    }
+
+    [[nodiscard]] constexpr unsigned short size() const
+    {
+        return count;
+    }
+
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return count == 0;
+    }
+
+    [[nodiscard]] static constexpr unsigned short capacity()
+    {
+        return Capacity;
+    }
+
+    [[nodiscard]] const T *data() const
+    {
+        return values.data();
+    }
+
+    [[nodiscard]] const T *begin() const
+    {
+        return values.data();
+    }
+
+    [[nodiscard]] const T *end() const
+    {
+        return values.data() + count;
+    }
+
+    const T &operator[](const unsigned short index) const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return values[index];
+    }
+
+    friend bool operator==(const InlineVector &lhs, const InlineVector &rhs)
+    {
+        return std::ranges::equal(lhs, rhs);
+    }
+
+    friend bool operator==(const InlineVector &lhs, const std::span<const T> rhs)
+    {
+        return std::ranges::equal(lhs, rhs);
+    }
+};
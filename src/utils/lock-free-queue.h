@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Single producer single consumer ring buffer. The producer (e.g. an ISR) only writes the tail and the consumer only writes the head, so neither side needs to disable interrupts or take a lock. When the ring is full new values are dropped and counted as overruns
+template <typename T, unsigned short Capacity>
+class LockFreeQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1U)) == 0, "LockFreeQueue capacity must be a power of two");
+    static_assert(std::atomic<unsigned int>::is_always_lock_free, "LockFreeQueue requires lock free atomic counters");
+
+    static constexpr unsigned int indexMask = Capacity - 1U;
+
+    std::array<T, Capacity> buffer{};
+
+    // Both counters run freely and are only masked when indexing, so tail - head is always the number of queued values
+    std::atomic<unsigned int> head = 0;
+    std::atomic<unsigned int> tail = 0;
+    std::atomic<unsigned int> overruns = 0;
+
+public:
+    bool push(const T &value)
+    {
+        const auto currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) >= Capacity)
+        {
+            overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            return false;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        buffer[currentTail & indexMask] = value;
+        tail.store(currentTail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        const auto currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        value = buffer[currentHead & indexMask];
+        head.store(currentHead + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side only: returns the value offset places behind the head without removing it, or nullptr if fewer values are queued
+    [[nodiscard]] const T *peek(const unsigned int offset) const
+    {
+        const auto currentHead = head.load(std::memory_order_relaxed);
+        if (tail.load(std::memory_order_acquire) - currentHead <= offset)
+        {
+            return nullptr;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return &buffer[(currentHead + offset) & indexMask];
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] unsigned int size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] unsigned int overrunCount() const
+    {
+        return overruns.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static constexpr unsigned short capacity()
+    {
+        return Capacity;
+    }
+};
@@ -60,13 +60,9 @@ consteval std::string_view extractClassName(const std::string_view className)
     return className.substr(start, end - start);
 }
 
-consteval std::string_view getHardwareRevision()
+// Returns the file name of a profile header (e.g. "genericAir" from "profiles/genericAir.rower-profile.h"), or "Custom" if it is not one of the profiles of the repository
+consteval std::string_view extractProfileName(const std::string_view profile, const std::string_view profileSuffix)
 {
-#if defined(HARDWARE_REVISION)
-    return {HARDWARE_REVISION};
-#elif defined(BOARD_PROFILE)
-    constexpr auto profile = std::string_view(BOARD_PROFILE);
-
     std::string_view profileSearchTerm = "profiles/";
     auto filenameStart = profile.find(profileSearchTerm);
     if (filenameStart == std::string_view::npos)
@@ -78,14 +74,30 @@ consteval std::string_view getHardwareRevision()
 
     auto filename = profile.substr(filenameStart);
 
-    std::string_view boardSearchTerm = ".board-profile.h";
-    auto end = filename.find(boardSearchTerm);
+    auto end = filename.find(profileSuffix);
     if (end == std::string_view::npos)
     {
         return {"Custom"};
     }
 
     return filename.substr(0, end);
+}
+
+consteval std::string_view getHardwareRevision()
+{
+#if defined(HARDWARE_REVISION)
+    return {HARDWARE_REVISION};
+#elif defined(BOARD_PROFILE)
+    return extractProfileName(BOARD_PROFILE, ".board-profile.h");
+#else
+    return {"Custom"};
+#endif
+}
+
+consteval std::string_view getRowerProfileName()
+{
+#if defined(ROWER_PROFILE)
+    return extractProfileName(ROWER_PROFILE, ".rower-profile.h");
 #else
     return {"Custom"};
 #endif
@@ -122,6 +134,18 @@ consteval std::string_view getHardwareRevision()
     #define ENABLE_DEBOUNCE_FILTER false
 #endif
 
+#if !defined(ENABLE_PIPELINE_PROFILING)
+    #define ENABLE_PIPELINE_PROFILING false
+#endif
+
+#if !defined(ENABLE_ALLOCATION_TRACKING)
+    #define ENABLE_ALLOCATION_TRACKING false
+#endif
+
+#if !defined(ENABLE_ADAPTIVE_WINDOW)
+    #define ENABLE_ADAPTIVE_WINDOW false
+#endif
+
 #if !defined(DEFAULT_CPS_LOGGING_LEVEL)
     #define DEFAULT_CPS_LOGGING_LEVEL ArduinoLogLevel::LogLevelTrace
 #endif
@@ -130,6 +154,10 @@ consteval std::string_view getHardwareRevision()
     #define DEFAULT_BLE_SERVICE BleServiceFlag::CpsService
 #endif
 
+#if !defined(CYCLIC_FILTER_REPLAY_BUDGET)
+    #define CYCLIC_FILTER_REPLAY_BUDGET 0
+#endif
+
 #if !defined(MIN_BLE_UPDATE_INTERVAL)
     #define MIN_BLE_UPDATE_INTERVAL 4'000
 #endif
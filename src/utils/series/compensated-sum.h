@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "../configuration.h"
+
+// Running sum that applies Neumaier compensation when precision is float, where long unbounded or rolling sums visibly drift. With double the plain sum is accurate enough and keeps results identical to summing the stored values
+class CompensatedSum
+{
+    static constexpr bool isCompensated = std::is_same_v<Configurations::precision, float>;
+
+    Configurations::precision sum = 0;
+    Configurations::precision compensation = 0;
+
+public:
+    [[nodiscard]] Configurations::precision value() const
+    {
+        if constexpr (isCompensated)
+        {
+            return sum + compensation;
+        }
+
+        return sum;
+    }
+
+    void add(const Configurations::precision value)
+    {
+        if constexpr (isCompensated)
+        {
+            const auto newSum = sum + value;
+
+            if (std::abs(sum) >= std::abs(value))
+            {
+                compensation += (sum - newSum) + value;
+            }
+            else
+            {
+                compensation += (value - newSum) + sum;
+            }
+
+            sum = newSum;
+
+            return;
+        }
+
+        sum += value;
+    }
+
+    void reset()
+    {
+        sum = 0;
+        compensation = 0;
+    }
+};
@@ -8,6 +8,7 @@
 #include "./exponential-weighted-average.h"
 #include "./ols-linear-series.h"
 #include "./series.h"
+#include "./static-series.h"
 
 void CyclicErrorFilter::SlotErrorTracker::push(const Configurations::precision deviation)
 {
@@ -80,16 +81,84 @@ void CyclicErrorFilter::SlotErrorTracker::reset()
     signSum = 0;
 }
 
-const Series &CyclicErrorFilter::rawSeries() const
+unsigned short CyclicErrorFilter::RecordingArena::size() const
+{
+    return count;
+}
+
+bool CyclicErrorFilter::RecordingArena::empty() const
+{
+    return count == 0;
+}
+
+unsigned short CyclicErrorFilter::RecordingArena::dropped() const
+{
+    return droppedCount;
+}
+
+unsigned long CyclicErrorFilter::RecordingArena::relativePosition(const unsigned short index) const
+{
+    return relativePositions[index];
+}
+
+Configurations::precision CyclicErrorFilter::RecordingArena::absolutePosition(const unsigned short index) const
+{
+    return absolutePositions[index];
+}
+
+Configurations::precision CyclicErrorFilter::RecordingArena::rawValue(const unsigned short index) const
+{
+    return rawValues[index];
+}
+
+bool CyclicErrorFilter::RecordingArena::push(const unsigned long relativePosition, const Configurations::precision absolutePosition, const Configurations::precision rawValue)
+{
+    if (count >= capacity)
+    {
+        ++droppedCount;
+
+        return false;
+    }
+
+    relativePositions[count] = relativePosition;
+    absolutePositions[count] = absolutePosition;
+    rawValues[count] = rawValue;
+    ++count;
+
+    return true;
+}
+
+void CyclicErrorFilter::RecordingArena::rebase(const Configurations::precision offset)
+{
+    auto i = 0U;
+    while (i < count)
+    {
+        absolutePositions[i] -= offset;
+        ++i;
+    }
+}
+
+void CyclicErrorFilter::RecordingArena::clear()
+{
+    count = 0;
+    droppedCount = 0;
+}
+
+const ImpulseSeries &CyclicErrorFilter::rawSeries() const
 {
     return raw;
 }
 
-const Series &CyclicErrorFilter::cleanSeries() const
+const ImpulseSeries &CyclicErrorFilter::cleanSeries() const
 {
     return clean;
 }
 
+unsigned short CyclicErrorFilter::getDroppedDatapointCount() const
+{
+    return recordings.dropped();
+}
+
 void CyclicErrorFilter::applyFilter(const unsigned long position, const Configurations::precision rawValue)
 {
     raw.push(rawValue);
@@ -103,11 +172,7 @@ void CyclicErrorFilter::recordRawDatapoint(const unsigned long relativePosition,
         return;
     }
 
-    recordedRelativePosition.push_back(relativePosition);
-    recordedAbsolutePosition.push_back(absolutePosition);
-    recordedRawValue.push_back(rawValue);
-
-    if (!isStabilized())
+    if (!recordings.push(relativePosition, absolutePosition, rawValue) || !isStabilized())
     {
         return;
     }
@@ -118,23 +183,25 @@ void CyclicErrorFilter::recordRawDatapoint(const unsigned long relativePosition,
     cleanOlsSeries.push((cleanOlsSeries.size() > 0 ? cleanOlsSeries.xAtSeriesEnd() : 0) + cleanValue, cleanValue);
 }
 
-void CyclicErrorFilter::processNextRawDatapoint()
+bool CyclicErrorFilter::processNextRawDatapoint()
 {
-    if (recordedRawValue.empty())
+    if (recordings.empty())
     {
-        return;
+        return false;
     }
 
-    if (cursor >= recordedRawValue.size())
+    if (cursor >= recordings.size())
     {
         restart();
 
-        return;
+        return false;
     }
 
-    const auto perfectCurrentDt = regressionSlope * static_cast<Configurations::precision>(recordedAbsolutePosition[cursor]) + regressionIntercept;
-    updateFilter(recordedRelativePosition[cursor], recordedRawValue[cursor], perfectCurrentDt);
+    const auto perfectCurrentDt = regressionSlope * recordings.absolutePosition(cursor) + regressionIntercept;
+    updateFilter(recordings.relativePosition(cursor), recordings.rawValue(cursor), perfectCurrentDt);
     cursor++;
+
+    return true;
 }
 
 void CyclicErrorFilter::updateRegressionCoefficients(const Configurations::precision slope, const Configurations::precision intercept, const Configurations::precision _goodnessOfFit)
@@ -149,26 +216,22 @@ bool CyclicErrorFilter::isStabilized() const
     return dataPointCount >= recordingBufferCapacity;
 }
 
+void CyclicErrorFilter::rebase(const Configurations::precision offset)
+{
+    recordings.rebase(offset);
+
+    // Keep the recovery regression line pointing at the same delta times in the new coordinates
+    regressionIntercept += regressionSlope * offset;
+}
+
 void CyclicErrorFilter::restart()
 {
-    if (recordedRawValue.empty() && rawOlsSeries.size() == 0)
+    if (recordings.empty() && recordings.dropped() == 0 && rawOlsSeries.size() == 0)
     {
         return;
     }
 
-    vector<unsigned long> clearRelativePosition;
-    vector<Configurations::precision> clearAbsolutePosition;
-    vector<Configurations::precision> clearRawValue;
-
-    const auto optimalCapacity = std::min<unsigned int>(recordedRelativePosition.size(), maxAllocationCapacity);
-
-    clearRelativePosition.reserve(optimalCapacity);
-    clearAbsolutePosition.reserve(optimalCapacity);
-    clearRawValue.reserve(optimalCapacity);
-
-    recordedRelativePosition.swap(clearRelativePosition);
-    recordedAbsolutePosition.swap(clearAbsolutePosition);
-    recordedRawValue.swap(clearRawValue);
+    recordings.clear();
 
     rawOlsSeries.reset();
     cleanOlsSeries.reset();
@@ -203,7 +266,7 @@ void CyclicErrorFilter::updateFilter(const unsigned long position, const Configu
     const auto absoluteMaxDeviation = 0.02;
     const auto minCorrectionFactor = filterConfig[slot] * (1.0 - absoluteMaxDeviation);
     const auto maxCorrectionFactor = filterConfig[slot] * (1.0 + absoluteMaxDeviation);
-    const auto clampedCorrectionFactor = std::clamp(correctionFactor, minCorrectionFactor, maxCorrectionFactor);
+    const auto clampedCorrectionFactor = std::clamp<Configurations::precision>(correctionFactor, minCorrectionFactor, maxCorrectionFactor);
 
     const auto weightCorrectedCorrectionFactor = ((clampedCorrectionFactor - 1) * aggressiveness) + 1;
 
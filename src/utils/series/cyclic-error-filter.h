@@ -8,6 +8,7 @@
 #include "./exponential-weighted-average.h"
 #include "./ols-linear-series.h"
 #include "./series.h"
+#include "./static-series.h"
 
 using std::vector;
 
@@ -37,7 +38,39 @@ class CyclicErrorFilter
         void reset();
     };
 
-    unsigned short maxAllocationCapacity;
+    // Fixed capacity structure of arrays storage of the datapoints recorded during a recovery. It is allocated once and reused for every stroke, datapoints beyond the capacity are dropped and counted until the next clear
+    class RecordingArena
+    {
+    private:
+        unsigned short capacity;
+        unsigned short count = 0;
+        unsigned short droppedCount = 0;
+
+        vector<unsigned long> relativePositions;
+        vector<Configurations::precision> absolutePositions;
+        vector<Configurations::precision> rawValues;
+
+    public:
+        constexpr explicit RecordingArena(const unsigned short _capacity)
+            : capacity(_capacity),
+              relativePositions(_capacity, 0),
+              absolutePositions(_capacity, 0),
+              rawValues(_capacity, 0)
+        {
+        }
+
+        [[nodiscard]] unsigned short size() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] unsigned short dropped() const;
+        [[nodiscard]] unsigned long relativePosition(unsigned short index) const;
+        [[nodiscard]] Configurations::precision absolutePosition(unsigned short index) const;
+        [[nodiscard]] Configurations::precision rawValue(unsigned short index) const;
+
+        bool push(unsigned long relativePosition, Configurations::precision absolutePosition, Configurations::precision rawValue);
+        void rebase(Configurations::precision offset);
+        void clear();
+    };
+
     unsigned short recordingBufferCapacity;
 
     unsigned char numberOfSlots;
@@ -51,16 +84,14 @@ class CyclicErrorFilter
     vector<Configurations::precision> filterConfig;
     vector<SlotErrorTracker> slotErrorTrackers;
 
-    vector<unsigned long> recordedRelativePosition;
-    vector<Configurations::precision> recordedAbsolutePosition;
-    vector<Configurations::precision> recordedRawValue;
+    RecordingArena recordings;
 
-    Series raw;
-    Series clean;
+    ImpulseSeries raw;
+    ImpulseSeries clean;
     OLSLinearSeries rawOlsSeries;
     OLSLinearSeries cleanOlsSeries;
 
-    unsigned int cursor = 0;
+    unsigned short cursor = 0;
     Configurations::precision filterSum = 0;
     Configurations::precision weightCorrection = 1;
     unsigned short dataPointCount = 0;
@@ -73,23 +104,20 @@ public:
         const unsigned char _impulseDataArrayLength,
         const Configurations::precision _aggressiveness,
         const unsigned short _recordingBufferCapacity,
-        const unsigned short _maxAllocationCapacity = 1'000)
-        : maxAllocationCapacity(_maxAllocationCapacity),
-          recordingBufferCapacity(_recordingBufferCapacity),
+        const unsigned short _maxRecordedDatapoints = 1'000)
+        : recordingBufferCapacity(_recordingBufferCapacity),
           numberOfSlots(_numberOfSlots),
           aggressiveness(_aggressiveness),
+          recordings(_maxRecordedDatapoints),
           raw(_impulseDataArrayLength),
           clean(_impulseDataArrayLength),
-          rawOlsSeries(0, _recordingBufferCapacity, _maxAllocationCapacity),
-          cleanOlsSeries(0, _recordingBufferCapacity, _maxAllocationCapacity),
+          rawOlsSeries(0),
+          cleanOlsSeries(0),
           filterSum(_numberOfSlots)
     {
         filterArray.reserve(_numberOfSlots);
         filterConfig.reserve(_numberOfSlots);
         slotErrorTrackers.reserve(_numberOfSlots);
-        recordedRelativePosition.reserve(_recordingBufferCapacity);
-        recordedAbsolutePosition.reserve(_recordingBufferCapacity);
-        recordedRawValue.reserve(_recordingBufferCapacity);
 
         for (unsigned char i = 0; i < _numberOfSlots; i++)
         {
@@ -100,15 +128,18 @@ public:
         }
     }
 
-    [[nodiscard]] const Series &rawSeries() const;
-    [[nodiscard]] const Series &cleanSeries() const;
+    [[nodiscard]] const ImpulseSeries &rawSeries() const;
+    [[nodiscard]] const ImpulseSeries &cleanSeries() const;
+    // Number of datapoints of the current recovery that did not fit into the recordings
+    [[nodiscard]] unsigned short getDroppedDatapointCount() const;
 
     void applyFilter(unsigned long position, Configurations::precision rawValue);
     void recordRawDatapoint(unsigned long relativePosition, Configurations::precision absolutePosition, Configurations::precision rawValue);
-    void processNextRawDatapoint();
+    bool processNextRawDatapoint();
     void updateRegressionCoefficients(Configurations::precision slope, Configurations::precision intercept, Configurations::precision _goodnessOfFit);
     [[nodiscard]] bool isPotentiallyMisaligned();
     [[nodiscard]] bool isStabilized() const;
+    void rebase(Configurations::precision offset);
     void restart();
     void reset();
 };
@@ -5,85 +5,126 @@
 
 void OLSLinearSeries::reset()
 {
+    seriesSize = 0;
+    xOrigin = 0;
+    firstX = 0;
+    firstY = 0;
+    lastX = 0;
+
+    sumX.reset();
+    sumXSquare.reset();
+    sumY.reset();
+    sumYSquare.reset();
+    sumXY.reset();
+
     seriesX.reset();
-    seriesXSquare.reset();
     seriesY.reset();
-    seriesYSquare.reset();
-    seriesXY.reset();
 }
 
 void OLSLinearSeries::push(const Configurations::precision pointX, const Configurations::precision pointY)
 {
-    seriesX.push(pointX);
-    seriesXSquare.push(pointX * pointX);
-    seriesY.push(pointY);
-    seriesYSquare.push(pointY * pointY);
-    seriesXY.push(pointX * pointY);
+    if (maxSeriesLength > 0)
+    {
+        if (seriesSize >= maxSeriesLength)
+        {
+            // The maximum of the window has been reached, the oldest point is removed from the sums before the ring overwrites it
+            const auto evictedX = seriesX.front() - xOrigin;
+            const auto evictedY = seriesY.front();
+
+            sumX.add(-evictedX);
+            sumXSquare.add(-(evictedX * evictedX));
+            sumY.add(-evictedY);
+            sumYSquare.add(-(evictedY * evictedY));
+            sumXY.add(-(evictedX * evictedY));
+            --seriesSize;
+        }
+
+        seriesX.push(pointX);
+        seriesY.push(pointY);
+    }
+
+    if (seriesSize == 0)
+    {
+        firstX = pointX;
+        firstY = pointY;
+
+        if constexpr (Configurations::isTimeRebasingEnabled)
+        {
+            xOrigin = pointX;
+        }
+    }
+    lastX = pointX;
+
+    const auto relativeX = pointX - xOrigin;
+    sumX.add(relativeX);
+    sumXSquare.add(relativeX * relativeX);
+    sumY.add(pointY);
+    sumYSquare.add(pointY * pointY);
+    sumXY.add(relativeX * pointY);
+    ++seriesSize;
 }
 
 Configurations::precision OLSLinearSeries::yAtSeriesBegin() const
 {
-    return seriesY[0];
+    return maxSeriesLength > 0 ? seriesY[0] : firstY;
 }
 
 Configurations::precision OLSLinearSeries::xAtSeriesBegin() const
 {
-    return seriesX[0];
+    return maxSeriesLength > 0 ? seriesX[0] : firstX;
 }
 
 Configurations::precision OLSLinearSeries::xAtSeriesEnd() const
 {
-    return seriesX.back();
+    return lastX;
 }
 
 Configurations::precision OLSLinearSeries::slope() const
 {
-    const auto seriesXSize = seriesX.size();
-    const auto seriesXSum = seriesX.sum();
+    const auto seriesXSum = sumX.value();
 
-    if (seriesXSize < 2 || seriesXSum == 0)
+    if (seriesSize < 2 || seriesXSum == 0)
     {
         return 0.0;
     }
 
-    return ((Configurations::precision)seriesXSize * seriesXY.sum() - seriesXSum * seriesY.sum()) / ((Configurations::precision)seriesXSize * seriesXSquare.sum() - seriesXSum * seriesXSum);
+    return ((Configurations::precision)seriesSize * sumXY.value() - seriesXSum * sumY.value()) / ((Configurations::precision)seriesSize * sumXSquare.value() - seriesXSum * seriesXSum);
 }
 
 Configurations::precision OLSLinearSeries::intercept() const
 {
-    const auto seriesXSize = seriesX.size();
-
-    if (seriesXSize < 2)
+    if (seriesSize < 2)
     {
         return 0.0;
     }
 
-    return (seriesY.sum() - (slope() * seriesX.sum())) / (Configurations::precision)seriesXSize;
+    const auto currentSlope = slope();
+
+    return (sumY.value() - (currentSlope * sumX.value())) / (Configurations::precision)seriesSize - currentSlope * xOrigin;
 }
 
 Configurations::precision OLSLinearSeries::goodnessOfFit() const
 {
-    const auto seriesXSize = seriesX.size();
-    const auto seriesXSum = seriesX.sum();
+    const auto seriesXSum = sumX.value();
 
     // This function returns the R^2 as a goodness of fit indicator
-    if (seriesXSize < 2 || seriesXSum == 0)
+    if (seriesSize < 2 || seriesXSum == 0)
     {
         return 0;
     }
 
-    const auto seriesYSum = seriesY.sum();
-    const auto seriesXYSum = seriesXY.sum();
-    const auto seriesYSquareSum = seriesYSquare.sum();
+    const auto seriesYSum = sumY.value();
+    const auto seriesXYSum = sumXY.value();
+    const auto seriesYSquareSum = sumYSquare.value();
 
-    const auto slope = ((Configurations::precision)seriesXSize * seriesXYSum - seriesXSum * seriesYSum) / ((Configurations::precision)seriesXSize * seriesXSquare.sum() - seriesXSum * seriesXSum);
-    const auto intercept = (seriesYSum - (slope * seriesXSum)) / (Configurations::precision)seriesXSize;
+    const auto slope = ((Configurations::precision)seriesSize * seriesXYSum - seriesXSum * seriesYSum) / ((Configurations::precision)seriesSize * sumXSquare.value() - seriesXSum * seriesXSum);
+    const auto intercept = (seriesYSum - (slope * seriesXSum)) / (Configurations::precision)seriesSize;
     const auto sse = seriesYSquareSum - (intercept * seriesYSum) - (slope * seriesXYSum);
-    const auto sst = seriesYSquareSum - (seriesYSum * seriesYSum) / (Configurations::precision)seriesXSize;
+    const auto sst = seriesYSquareSum - (seriesYSum * seriesYSum) / (Configurations::precision)seriesSize;
     return 1 - (sse / sst);
 }
 
 size_t OLSLinearSeries::size() const
 {
-    return seriesY.size();
-}
\ No newline at end of file
+    return seriesSize;
+}
@@ -3,26 +3,35 @@
 #include <cstddef>
 
 #include "../configuration.h"
+#include "./compensated-sum.h"
 #include "./series.h"
 
+// Only the sufficient statistics of the regression are kept as running sums. When maxSeriesLength is 0 the series is unbounded and no points are stored at all, otherwise the X and Y of the window are kept so the evicted point can be subtracted from the sums
 class OLSLinearSeries
 {
+    unsigned char maxSeriesLength;
+    size_t seriesSize = 0;
+
+    // With Configurations::isTimeRebasingEnabled the sums are kept relative to the X of the first point so the squares stay well conditioned
+    Configurations::precision xOrigin = 0;
+    Configurations::precision firstX = 0;
+    Configurations::precision firstY = 0;
+    Configurations::precision lastX = 0;
+
+    CompensatedSum sumX;
+    CompensatedSum sumXSquare;
+    CompensatedSum sumY;
+    CompensatedSum sumYSquare;
+    CompensatedSum sumXY;
+
     Series seriesX;
-    Series seriesXSquare;
     Series seriesY;
-    Series seriesYSquare;
-    Series seriesXY;
 
 public:
-    constexpr explicit OLSLinearSeries(
-        const unsigned char _maxSeriesLength = 0,
-        const unsigned short _initialCapacity = Configurations::defaultAllocationCapacity,
-        const unsigned short _maxAllocationCapacity = 1'000)
-        : seriesX(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity),
-          seriesXSquare(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity),
-          seriesY(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity),
-          seriesYSquare(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity),
-          seriesXY(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity)
+    constexpr explicit OLSLinearSeries(const unsigned char _maxSeriesLength = 0)
+        : maxSeriesLength(_maxSeriesLength),
+          seriesX(_maxSeriesLength, 0),
+          seriesY(_maxSeriesLength, 0)
     {
     }
 
@@ -36,4 +45,4 @@ public:
 
     void push(Configurations::precision pointX, Configurations::precision pointY);
     void reset();
-};
\ No newline at end of file
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../configuration.h"
+
+// Power sums of a window of points (relative to an origin close to the window) from which the R^2 of any quadratic fit can be evaluated in constant time. Points are added and removed as the window rolls and the sums can be rebuilt from the window to move the origin and to drop the accumulated rounding error. The precision is a template parameter only so the float behaviour can be tested on a double build
+template <typename Precision>
+class BasicQuadraticFitMoments
+{
+    Precision originX = 0;
+    Precision originY = 0;
+
+    unsigned short count = 0;
+    Precision sumX = 0;
+    Precision sumX2 = 0;
+    Precision sumX3 = 0;
+    Precision sumX4 = 0;
+    Precision sumY = 0;
+    Precision sumY2 = 0;
+    Precision sumXY = 0;
+    Precision sumX2Y = 0;
+
+    void accumulate(const Precision pointX, const Precision pointY, const Precision sign)
+    {
+        const auto x = pointX - originX;
+        const auto y = pointY - originY;
+        const auto x2 = x * x;
+
+        sumX += sign * x;
+        sumX2 += sign * x2;
+        sumX3 += sign * x2 * x;
+        sumX4 += sign * x2 * x2;
+        sumY += sign * y;
+        sumY2 += sign * y * y;
+        sumXY += sign * x * y;
+        sumX2Y += sign * x2 * y;
+    }
+
+public:
+    void push(const Precision pointX, const Precision pointY)
+    {
+        if (count == 0)
+        {
+            originX = pointX;
+            originY = pointY;
+        }
+
+        accumulate(pointX, pointY, 1);
+        ++count;
+    }
+
+    void remove(const Precision pointX, const Precision pointY)
+    {
+        accumulate(pointX, pointY, -1);
+        --count;
+    }
+
+    // Rebuilds the sums from the window with the origin moved to its most recent point
+    template <typename SeriesType>
+    void recalculate(const SeriesType &seriesX, const SeriesType &seriesY)
+    {
+        reset();
+
+        const auto seriesXSize = seriesX.size();
+        if (seriesXSize == 0)
+        {
+            return;
+        }
+
+        // The most recent point is used as origin as the upcoming points will be as close to it as the ones already in the window
+        originX = seriesX.back();
+        originY = seriesY.back();
+
+        auto i = 0U;
+        while (i < seriesXSize)
+        {
+            accumulate(seriesX[i], seriesY[i], 1);
+            ++i;
+        }
+        count = static_cast<unsigned short>(seriesXSize);
+    }
+
+    // This function returns the R^2 of y = a * x^2 + b * x + c over the window by expanding the sum of squared errors into the power sums
+    [[nodiscard]] Precision goodnessOfFit(const Precision a, const Precision b, const Precision c) const
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        // Same polynomial expressed in the coordinates relative to the origin
+        const auto shiftedB = 2 * a * originX + b;
+        const auto shiftedC = (a * originX + b) * originX + c - originY;
+
+        const Precision n = count;
+        const auto sse = sumY2 + a * a * sumX4 + shiftedB * shiftedB * sumX2 + n * shiftedC * shiftedC -
+                         2 * (a * sumX2Y + shiftedB * sumXY + shiftedC * sumY) +
+                         2 * (a * shiftedB * sumX3 + a * shiftedC * sumX2 + shiftedB * shiftedC * sumX);
+        const auto sst = sumY2 - (sumY * sumY) / n;
+
+        if (sst <= 0 || sse > sst)
+        {
+            return 0;
+        }
+
+        if (sse <= 0)
+        {
+            return 1;
+        }
+
+        return 1 - (sse / sst);
+    }
+
+    void reset()
+    {
+        originX = 0;
+        originY = 0;
+        count = 0;
+        sumX = 0;
+        sumX2 = 0;
+        sumX3 = 0;
+        sumX4 = 0;
+        sumY = 0;
+        sumY2 = 0;
+        sumXY = 0;
+        sumX2Y = 0;
+    }
+};
+
+using QuadraticFitMoments = BasicQuadraticFitMoments<Configurations::precision>;
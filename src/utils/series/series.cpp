@@ -9,17 +9,21 @@ using std::vector;
 
 const Configurations::precision &Series::operator[](size_t index) const
 {
-    return seriesArray[index];
+    // Once a bounded series is full the storage is used as a ring where head points to the oldest value
+    const auto position = head + index;
+    const auto seriesArraySize = seriesArray.size();
+
+    return seriesArray[position < seriesArraySize ? position : position - seriesArraySize];
 };
 
 Configurations::precision Series::front() const
 {
-    return seriesArray[0];
+    return seriesArray[head];
 }
 
 Configurations::precision Series::back() const
 {
-    return seriesArray.back();
+    return head == 0 ? seriesArray.back() : seriesArray[head - 1];
 }
 
 size_t Series::size() const
@@ -66,9 +70,18 @@ void Series::push(const Configurations::precision value)
 {
     if (maxSeriesLength > 0 && seriesArray.size() >= maxSeriesLength)
     {
-        // The maximum of the array has been reached, we have to create room by removing the first value from the array
-        seriesSum -= seriesArray[0];
-        seriesArray.erase(begin(seriesArray));
+        // The maximum of the array has been reached, we overwrite the oldest value in place and move the head of the ring to the next oldest instead of shifting the whole array
+        seriesSum -= seriesArray[head];
+        seriesArray[head] = value;
+        seriesSum += value;
+
+        ++head;
+        if (head >= seriesArray.size())
+        {
+            head = 0;
+        }
+
+        return;
     }
 
     // Do manual memory reallocation via reserve if size is not known for better memory management
@@ -86,14 +99,33 @@ void Series::push(const Configurations::precision value)
     seriesSum += value;
 }
 
+void Series::rebase(const Configurations::precision offset)
+{
+    seriesSum = 0;
+    for (auto &value : seriesArray)
+    {
+        value -= offset;
+        seriesSum += value;
+    }
+}
+
 void Series::reset()
 {
+    head = 0;
+    seriesSum = 0;
+
+    // A bounded series never grows beyond its maximum length, so its storage is kept for the next run instead of being reallocated. Only an unbounded series is shrunk back
+    if (maxSeriesLength > 0)
+    {
+        seriesArray.clear();
+
+        return;
+    }
+
     vector<Configurations::precision> clear;
 
-    clear.reserve(maxSeriesLength > 0 ? maxSeriesLength : std::min<unsigned int>(seriesArray.size(), maxAllocationCapacity));
+    clear.reserve(std::min<unsigned int>(seriesArray.size(), maxAllocationCapacity));
     seriesArray.swap(clear);
-
-    seriesSum = 0;
 }
 
 Configurations::precision Series::sum() const
@@ -11,6 +11,7 @@ class Series
 {
     unsigned char maxSeriesLength;
     unsigned short maxAllocationCapacity;
+    unsigned char head = 0;
     Configurations::precision seriesSum = 0;
     std::vector<Configurations::precision> seriesArray;
 
@@ -36,5 +37,6 @@ public:
     [[nodiscard]] Configurations::precision sum() const;
 
     void push(Configurations::precision value);
+    void rebase(Configurations::precision offset);
     void reset();
 };
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+#include "../configuration.h"
+
+using std::size_t;
+
+// Sorted fixed capacity table of regression coefficients where every value is tagged with the ring slot of the point that owns it, so the coefficients of an evicted point can be dropped in one pass and the median is read in O(1)
+template <unsigned short Capacity, unsigned short BatchCapacity>
+class StaticMedianTable
+{
+    struct Entry
+    {
+        Configurations::precision value;
+        unsigned char origin;
+    };
+
+    unsigned short tableSize = 0;
+    unsigned short batchSize = 0;
+    std::array<Configurations::precision, Capacity> values{};
+    std::array<unsigned char, Capacity> origins{};
+    std::array<Entry, BatchCapacity> batch{};
+
+public:
+    [[nodiscard]] size_t size() const
+    {
+        return tableSize;
+    }
+
+    [[nodiscard]] Configurations::precision median() const
+    {
+        if (tableSize == 0)
+        {
+            return 0.0;
+        }
+
+        const unsigned int mid = tableSize / 2;
+
+        if ((tableSize & 1) != 0)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            return values[mid];
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return (values[mid] + values[mid - 1]) / 2;
+    }
+
+    void stage(const Configurations::precision value, const unsigned char origin)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        batch[batchSize] = {.value = value, .origin = origin};
+        ++batchSize;
+    }
+
+    void commit()
+    {
+        std::ranges::sort(begin(batch), std::next(begin(batch), batchSize), {}, &Entry::value);
+
+        // Merge from the back so the already sorted values can be shifted in place without a temporary buffer
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        auto existing = tableSize;
+        auto inserted = batchSize;
+        tableSize += batchSize;
+        auto target = tableSize;
+
+        while (inserted > 0)
+        {
+            --target;
+            if (existing > 0 && values[existing - 1] > batch[inserted - 1].value)
+            {
+                --existing;
+                values[target] = values[existing];
+                origins[target] = origins[existing];
+
+                continue;
+            }
+
+            --inserted;
+            values[target] = batch[inserted].value;
+            origins[target] = batch[inserted].origin;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+        batchSize = 0;
+    }
+
+    void remove(const unsigned char origin)
+    {
+        unsigned short write = 0;
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        for (unsigned short read = 0; read < tableSize; ++read)
+        {
+            if (origins[read] == origin)
+            {
+                continue;
+            }
+
+            values[write] = values[read];
+            origins[write] = origins[read];
+            ++write;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+        tableSize = write;
+    }
+
+    void reset()
+    {
+        tableSize = 0;
+        batchSize = 0;
+    }
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../configuration.h"
+#include "./compensated-sum.h"
+#include "./static-series.h"
+
+using std::size_t;
+
+// Compile time sized variant of the windowed OLSLinearSeries that keeps the window in inline storage
+template <unsigned char Capacity>
+class StaticOLSLinearSeries
+{
+    CompensatedSum sumX;
+    CompensatedSum sumXSquare;
+    CompensatedSum sumY;
+    CompensatedSum sumYSquare;
+    CompensatedSum sumXY;
+
+    StaticSeries<Capacity> seriesX;
+    StaticSeries<Capacity> seriesY;
+
+public:
+    [[nodiscard]] Configurations::precision yAtSeriesBegin() const
+    {
+        return seriesY[0];
+    }
+
+    [[nodiscard]] Configurations::precision xAtSeriesBegin() const
+    {
+        return seriesX[0];
+    }
+
+    [[nodiscard]] Configurations::precision xAtSeriesEnd() const
+    {
+        return seriesX.back();
+    }
+
+    [[nodiscard]] Configurations::precision slope() const
+    {
+        const auto seriesXSize = seriesX.size();
+        const auto seriesXSum = sumX.value();
+
+        if (seriesXSize < 2 || seriesXSum == 0)
+        {
+            return 0.0;
+        }
+
+        return ((Configurations::precision)seriesXSize * sumXY.value() - seriesXSum * sumY.value()) / ((Configurations::precision)seriesXSize * sumXSquare.value() - seriesXSum * seriesXSum);
+    }
+
+    [[nodiscard]] Configurations::precision intercept() const
+    {
+        const auto seriesXSize = seriesX.size();
+
+        if (seriesXSize < 2)
+        {
+            return 0.0;
+        }
+
+        return (sumY.value() - (slope() * sumX.value())) / (Configurations::precision)seriesXSize;
+    }
+
+    [[nodiscard]] Configurations::precision goodnessOfFit() const
+    {
+        const auto seriesXSize = seriesX.size();
+        const auto seriesXSum = sumX.value();
+
+        // This function returns the R^2 as a goodness of fit indicator
+        if (seriesXSize < 2 || seriesXSum == 0)
+        {
+            return 0;
+        }
+
+        const auto seriesYSum = sumY.value();
+        const auto seriesXYSum = sumXY.value();
+        const auto seriesYSquareSum = sumYSquare.value();
+
+        const auto slope = ((Configurations::precision)seriesXSize * seriesXYSum - seriesXSum * seriesYSum) / ((Configurations::precision)seriesXSize * sumXSquare.value() - seriesXSum * seriesXSum);
+        const auto intercept = (seriesYSum - (slope * seriesXSum)) / (Configurations::precision)seriesXSize;
+        const auto sse = seriesYSquareSum - (intercept * seriesYSum) - (slope * seriesXYSum);
+        const auto sst = seriesYSquareSum - (seriesYSum * seriesYSum) / (Configurations::precision)seriesXSize;
+        return 1 - (sse / sst);
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return seriesY.size();
+    }
+
+    void push(const Configurations::precision pointX, const Configurations::precision pointY)
+    {
+        if (seriesX.size() >= Capacity)
+        {
+            // The maximum of the window has been reached, the oldest point is removed from the sums before the ring overwrites it
+            const auto evictedX = seriesX.front();
+            const auto evictedY = seriesY.front();
+
+            sumX.add(-evictedX);
+            sumXSquare.add(-(evictedX * evictedX));
+            sumY.add(-evictedY);
+            sumYSquare.add(-(evictedY * evictedY));
+            sumXY.add(-(evictedX * evictedY));
+        }
+
+        seriesX.push(pointX);
+        seriesY.push(pointY);
+
+        sumX.add(pointX);
+        sumXSquare.add(pointX * pointX);
+        sumY.add(pointY);
+        sumYSquare.add(pointY * pointY);
+        sumXY.add(pointX * pointY);
+    }
+
+    void reset()
+    {
+        sumX.reset();
+        sumXSquare.reset();
+        sumY.reset();
+        sumYSquare.reset();
+        sumXY.reset();
+
+        seriesX.reset();
+        seriesY.reset();
+    }
+};
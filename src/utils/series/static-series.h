@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+#include "../configuration.h"
+#include "../settings.model.h"
+#include "./series.h"
+
+using std::size_t;
+
+template <unsigned char Capacity>
+class StaticSeries
+{
+    static_assert(Capacity > 0, "StaticSeries requires a non-zero capacity");
+
+    unsigned char maxSeriesLength;
+    unsigned char head = 0;
+    unsigned char seriesSize = 0;
+    Configurations::precision seriesSum = 0;
+    std::array<Configurations::precision, Capacity> seriesArray{};
+
+public:
+    constexpr explicit StaticSeries(const unsigned char _maxSeriesLength = Capacity)
+        : maxSeriesLength(_maxSeriesLength == 0 ? Capacity : std::min(_maxSeriesLength, Capacity))
+    {
+    }
+
+    const Configurations::precision &operator[](const size_t index) const
+    {
+        // Once the series is full the storage is used as a ring where head points to the oldest value
+        const auto position = head + index;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return seriesArray[position < maxSeriesLength ? position : position - maxSeriesLength];
+    }
+
+    [[nodiscard]] Configurations::precision front() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return seriesArray[head];
+    }
+
+    [[nodiscard]] Configurations::precision back() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return seriesArray[head == 0 ? seriesSize - 1 : head - 1];
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return seriesSize;
+    }
+
+    [[nodiscard]] size_t capacity() const
+    {
+        return maxSeriesLength;
+    }
+
+    [[nodiscard]] Configurations::precision average() const
+    {
+        if (seriesSize == 0)
+        {
+            return 0.0;
+        }
+
+        return seriesSum / static_cast<Configurations::precision>(seriesSize);
+    }
+
+    [[nodiscard]] Configurations::precision median() const
+    {
+        if (seriesSize == 0)
+        {
+            return 0.0;
+        }
+
+        const unsigned int mid = seriesSize / 2;
+        std::array<Configurations::precision, Capacity> sortedArray(seriesArray);
+        const auto sortedEnd = std::next(begin(sortedArray), seriesSize);
+        std::ranges::nth_element(begin(sortedArray), std::next(begin(sortedArray), mid), sortedEnd);
+
+        if ((seriesSize & 1) != 0)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            return sortedArray[mid];
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return (sortedArray[mid] + *std::ranges::max_element(begin(sortedArray), std::next(begin(sortedArray), mid))) / 2;
+    }
+
+    [[nodiscard]] Configurations::precision sum() const
+    {
+        return seriesSum;
+    }
+
+    void push(const Configurations::precision value)
+    {
+        if (seriesSize < maxSeriesLength)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            seriesArray[seriesSize] = value;
+            seriesSum += value;
+            ++seriesSize;
+
+            return;
+        }
+
+        // The maximum of the array has been reached, we overwrite the oldest value in place and move the head of the ring to the next oldest
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        seriesSum -= seriesArray[head];
+        seriesArray[head] = value;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        seriesSum += value;
+
+        ++head;
+        if (head >= maxSeriesLength)
+        {
+            head = 0;
+        }
+    }
+
+    void rebase(const Configurations::precision offset)
+    {
+        seriesSum = 0;
+        auto i = 0U;
+        while (i < seriesSize)
+        {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+            seriesArray[i] -= offset;
+            seriesSum += seriesArray[i];
+            // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+            ++i;
+        }
+    }
+
+    void reset()
+    {
+        head = 0;
+        seriesSize = 0;
+        seriesSum = 0;
+    }
+};
+
+// The impulse pipeline windows have a compile time length unless runtime settings are enabled, so they can use inline storage
+#if ENABLE_RUNTIME_SETTINGS
+using ImpulseSeries = Series;
+#else
+using ImpulseSeries = StaticSeries<RowerProfile::Defaults::impulseDataArrayLength>;
+#endif
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../configuration.h"
+#include "./static-median-table.h"
+#include "./static-series.h"
+
+using std::size_t;
+
+// Compile time sized variant of TSLinearSeries, the slope table lives in inline storage and every slope is tagged with its first point so eviction does not need the 2D slope rows
+template <unsigned char Capacity>
+class StaticTSLinearSeries
+{
+    static_assert(Capacity > 1, "StaticTSLinearSeries requires at least two points");
+
+    static constexpr unsigned short maxSlopeSeriesLength = (Capacity * (Capacity - 1U)) / 2U;
+
+    bool shouldRecalculateB = true;
+    bool shouldRecalculateA = true;
+    Configurations::precision a = 0;
+    Configurations::precision b = 0;
+
+    // Ring slot of the oldest point, the slot of the point at index i is headOrigin + i (wrapping)
+    unsigned char headOrigin = 0;
+    StaticSeries<Capacity> seriesX;
+    StaticSeries<Capacity> seriesY;
+    StaticMedianTable<maxSlopeSeriesLength, Capacity - 1U> slopes;
+
+    [[nodiscard]] Configurations::precision calculateSlope(const unsigned char pointOne, const unsigned char pointTwo) const
+    {
+        const auto seriesXPointOne = seriesX[pointOne];
+        const auto seriesXPointTwo = seriesX[pointTwo];
+
+        if (pointOne == pointTwo || seriesXPointOne == seriesXPointTwo)
+        {
+            return 0.0;
+        }
+
+        return (seriesY[pointTwo] - seriesY[pointOne]) /
+               (seriesXPointTwo - seriesXPointOne);
+    }
+
+public:
+    [[nodiscard]] Configurations::precision yAtSeriesBegin() const
+    {
+        return seriesY[0];
+    }
+
+    [[nodiscard]] Configurations::precision xAtSeriesEnd() const
+    {
+        return seriesX.back();
+    }
+
+    [[nodiscard]] Configurations::precision xAtSeriesBegin() const
+    {
+        return seriesX.front();
+    }
+
+    [[nodiscard]] Configurations::precision median() const
+    {
+        return slopes.median();
+    }
+
+    Configurations::precision coefficientA()
+    {
+        if (shouldRecalculateA)
+        {
+            a = median();
+            shouldRecalculateA = false;
+        }
+
+        return a;
+    }
+
+    Configurations::precision coefficientB()
+    {
+        if (seriesX.size() < 2)
+        {
+            return 0.0;
+        }
+
+        if (shouldRecalculateB)
+        {
+            a = median();
+
+            const auto seriesXSize = seriesX.size() - 1;
+            StaticSeries<Capacity> intercepts;
+
+            auto i = 0U;
+            while (i < seriesXSize)
+            {
+                intercepts.push((seriesY[i] - (a * seriesX[i])));
+                ++i;
+            }
+            b = intercepts.median();
+            shouldRecalculateB = false;
+        }
+
+        return b;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return seriesY.size();
+    }
+
+    void push(const Configurations::precision pointX, const Configurations::precision pointY)
+    {
+        if (seriesX.size() >= Capacity)
+        {
+            // The maximum of the array has been reached, the slopes of the evicted point are the ones it opened as the first point
+            slopes.remove(headOrigin);
+            ++headOrigin;
+        }
+
+        seriesX.push(pointX);
+        seriesY.push(pointY);
+        shouldRecalculateA = true;
+        shouldRecalculateB = true;
+
+        const auto lastPoint = static_cast<unsigned char>(seriesX.size() - 1);
+        auto i = 0U;
+        while (i < lastPoint)
+        {
+            slopes.stage(calculateSlope(i, lastPoint), static_cast<unsigned char>(headOrigin + i));
+            ++i;
+        }
+
+        slopes.commit();
+    }
+
+    void rebase(const Configurations::precision offsetX)
+    {
+        // Slopes do not depend on the origin of X, only the intercept needs to be recalculated
+        seriesX.rebase(offsetX);
+        shouldRecalculateB = true;
+    }
+
+    void reset()
+    {
+        seriesX.reset();
+        seriesY.reset();
+        slopes.reset();
+        headOrigin = 0;
+
+        a = 0;
+    }
+};
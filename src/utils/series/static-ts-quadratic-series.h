@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+#include "../configuration.h"
+#include "./quadratic-fit-moments.h"
+#include "./static-median-table.h"
+#include "./static-series.h"
+
+// Compile time sized variant of TSQuadraticSeries. The window is copied into contiguous arrays once per push and the pair/triple loops walk a constexpr index table, so in the steady state (full window) every loop has a compile time trip count
+template <unsigned char Capacity>
+class StaticTSQuadraticSeries
+{
+    static_assert(Capacity > 2, "StaticTSQuadraticSeries requires at least three points");
+
+    using IndexPair = std::pair<unsigned char, unsigned char>;
+
+    static constexpr unsigned short maxPairCount = (Capacity * (Capacity - 1U)) / 2U;
+    static constexpr unsigned short maxSeriesAInnerLength = ((Capacity - 1U) * (Capacity - 2U)) / 2U;
+    static constexpr unsigned short maxSeriesALength = (Capacity * (Capacity - 1U) * (Capacity - 2U)) / 6U;
+
+    // All (i, j) pairs with i < j ordered by j first, so the pairs of the first n points are always the first n * (n - 1) / 2 entries of the table
+    static constexpr std::array<IndexPair, maxPairCount> pairIndices = []()
+    {
+        std::array<IndexPair, maxPairCount> table{};
+        auto k = 0U;
+        for (unsigned char j = 1; j < Capacity; ++j)
+        {
+            for (unsigned char i = 0; i < j; ++i)
+            {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                table[k] = {i, j};
+                ++k;
+            }
+        }
+
+        return table;
+    }();
+
+    Configurations::precision a = 0;
+    Configurations::precision b = 0;
+    Configurations::precision c = 0;
+
+    // Ring slot of the oldest point, the slot of the point at index i is headOrigin + i (wrapping)
+    unsigned char headOrigin = 0;
+    StaticMedianTable<maxSeriesALength, maxSeriesAInnerLength> seriesA;
+
+    StaticSeries<Capacity> seriesX;
+    StaticSeries<Capacity> seriesY;
+
+    // Same as TSQuadraticSeries, the power sums behind the R^2 are rebuilt from the window once every Configurations::quadraticFitMomentsRecalculationInterval pushes
+    unsigned char pushesSinceMomentsRecalculation = 0;
+    QuadraticFitMoments fitMoments;
+
+    std::array<Configurations::precision, Capacity> windowX{};
+    std::array<Configurations::precision, Capacity> windowY{};
+    std::array<Configurations::precision, Capacity> residualSeriesY{};
+    std::array<Configurations::precision, maxPairCount> residualSlopes{};
+    std::array<Configurations::precision, Capacity> residualIntercepts{};
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+    [[nodiscard]] Configurations::precision calculateA(const unsigned char pointOne, const unsigned char pointTwo, const unsigned char pointThree) const
+    {
+        const auto xPointOne = windowX[pointOne];
+        const auto xPointTwo = windowX[pointTwo];
+        const auto xPointThree = windowX[pointThree];
+
+        if (xPointOne == xPointTwo || xPointOne == xPointThree || xPointTwo == xPointThree)
+        {
+            return 0.0;
+        }
+
+        const auto yPointThree = windowY[pointThree];
+        const auto yPointTwo = windowY[pointTwo];
+
+        return (xPointOne * (yPointThree - yPointTwo) +
+                windowY[pointOne] * (xPointTwo - xPointThree) +
+                (xPointThree * yPointTwo - xPointTwo * yPointThree)) /
+               ((xPointOne - xPointTwo) * (xPointOne - xPointThree) * (xPointTwo - xPointThree));
+    }
+
+    void loadWindow(const unsigned char seriesXSize)
+    {
+        auto i = 0U;
+        while (i < seriesXSize)
+        {
+            windowX[i] = seriesX[i];
+            windowY[i] = seriesY[i];
+            ++i;
+        }
+    }
+
+    void stageSeriesA(const unsigned short pairCount, const unsigned char lastPoint)
+    {
+        auto k = 0U;
+        while (k < pairCount)
+        {
+            const auto [i, j] = pairIndices[k];
+            seriesA.stage(calculateA(i, j, lastPoint), static_cast<unsigned char>(headOrigin + i));
+            ++k;
+        }
+    }
+
+    void calculateResidualSlopes(const unsigned short pairCount)
+    {
+        auto k = 0U;
+        while (k < pairCount)
+        {
+            const auto [i, j] = pairIndices[k];
+            const auto windowXPointI = windowX[i];
+            const auto windowXPointJ = windowX[j];
+            residualSlopes[k] = windowXPointI == windowXPointJ ? 0.0 : (residualSeriesY[j] - residualSeriesY[i]) / (windowXPointJ - windowXPointI);
+            ++k;
+        }
+    }
+
+    void calculateResidualCoefficients(const unsigned char seriesXSize)
+    {
+        // This is a Theil-Sen linear regression on the residue (i.e. y - a * x^2) over the contiguous copy of the window
+        auto i = 0U;
+        while (i < seriesXSize)
+        {
+            const auto windowXPointI = windowX[i];
+            residualSeriesY[i] = windowY[i] - a * (windowXPointI * windowXPointI);
+            ++i;
+        }
+
+        if (seriesXSize == Capacity)
+        {
+            calculateResidualSlopes(maxPairCount);
+            b = selectMedian(residualSlopes, maxPairCount);
+        }
+        else
+        {
+            const auto pairCount = static_cast<unsigned short>((seriesXSize * (seriesXSize - 1U)) / 2U);
+            calculateResidualSlopes(pairCount);
+            b = selectMedian(residualSlopes, pairCount);
+        }
+
+        // Same as TSLinearSeries, the intercept of the most recent point is not part of the median
+        const auto seriesXPoints = seriesXSize - 1U;
+        i = 0;
+        while (i < seriesXPoints)
+        {
+            residualIntercepts[i] = residualSeriesY[i] - (b * windowX[i]);
+            ++i;
+        }
+        c = selectMedian(residualIntercepts, seriesXPoints);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
+    template <size_t Length>
+    static Configurations::precision selectMedian(std::array<Configurations::precision, Length> &values, const unsigned short valuesSize)
+    {
+        const unsigned int mid = valuesSize / 2;
+        const auto valuesBegin = begin(values);
+
+        std::ranges::nth_element(valuesBegin, std::next(valuesBegin, mid), std::next(valuesBegin, valuesSize));
+
+        if ((valuesSize & 1) != 0)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            return values[mid];
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return (values[mid] + *std::ranges::max_element(valuesBegin, std::next(valuesBegin, mid))) / 2;
+    }
+
+    void updateFitMoments(const Configurations::precision pointX, const Configurations::precision pointY)
+    {
+        ++pushesSinceMomentsRecalculation;
+        if (pushesSinceMomentsRecalculation < Configurations::quadraticFitMomentsRecalculationInterval)
+        {
+            fitMoments.push(pointX, pointY);
+
+            return;
+        }
+
+        fitMoments.recalculate(seriesX, seriesY);
+        pushesSinceMomentsRecalculation = 0;
+    }
+
+public:
+    [[nodiscard]] Configurations::precision firstDerivativeAtPosition(const unsigned char position) const
+    {
+        const auto seriesXSize = seriesX.size();
+        if (seriesXSize < 3 || position >= seriesXSize)
+        {
+            return 0;
+        }
+
+        return a * 2 * seriesX[position] + b;
+    }
+
+    [[nodiscard]] Configurations::precision secondDerivativeAtPosition(const unsigned char position) const
+    {
+        const auto seriesXSize = seriesX.size();
+        if (seriesXSize < 3 || position >= seriesXSize)
+        {
+            return 0;
+        }
+
+        return a * 2;
+    }
+
+    // This function returns the R^2 as a goodness of fit indicator
+    [[nodiscard]] Configurations::precision goodnessOfFit() const
+    {
+        if (seriesX.size() < 3)
+        {
+            return 0.0;
+        }
+
+        return fitMoments.goodnessOfFit(a, b, c);
+    }
+
+    void push(const Configurations::precision pointX, const Configurations::precision pointY)
+    {
+        if (seriesX.size() >= Capacity)
+        {
+            // The maximum of the array has been reached, we have to create room in the A-table by removing the coefficients of the oldest point (i.e. every triple where it is the first point)
+            seriesA.remove(headOrigin);
+            ++headOrigin;
+            fitMoments.remove(seriesX.front(), seriesY.front());
+        }
+
+        seriesX.push(pointX);
+        seriesY.push(pointY);
+        updateFitMoments(pointX, pointY);
+
+        const auto seriesXSize = static_cast<unsigned char>(seriesX.size());
+        if (seriesXSize < 3)
+        {
+            a = 0;
+            b = 0;
+            c = 0;
+
+            return;
+        }
+
+        loadWindow(seriesXSize);
+
+        // The triples closed by the new point are the pairs of the points before it
+        const auto lastPoint = static_cast<unsigned char>(seriesXSize - 1);
+        if (seriesXSize == Capacity)
+        {
+            stageSeriesA(maxSeriesAInnerLength, lastPoint);
+        }
+        else
+        {
+            stageSeriesA(static_cast<unsigned short>((lastPoint * (lastPoint - 1U)) / 2U), lastPoint);
+        }
+
+        seriesA.commit();
+        a = seriesA.median();
+
+        calculateResidualCoefficients(seriesXSize);
+    }
+
+    void rebase(const Configurations::precision offsetX, const Configurations::precision offsetY)
+    {
+        seriesX.rebase(offsetX);
+        seriesY.rebase(offsetY);
+        fitMoments.recalculate(seriesX, seriesY);
+        pushesSinceMomentsRecalculation = 0;
+
+        const auto seriesXSize = static_cast<unsigned char>(seriesX.size());
+        if (seriesXSize < 3)
+        {
+            return;
+        }
+
+        // The coefficients of the quadratic term do not depend on the origin, but the linear and constant terms of the residue do
+        loadWindow(seriesXSize);
+        calculateResidualCoefficients(seriesXSize);
+    }
+
+    void reset()
+    {
+        seriesX.reset();
+        seriesY.reset();
+        seriesA.reset();
+        fitMoments.reset();
+        pushesSinceMomentsRecalculation = 0;
+        headOrigin = 0;
+
+        a = 0;
+        b = 0;
+        c = 0;
+    }
+};
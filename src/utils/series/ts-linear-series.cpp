@@ -1,6 +1,6 @@
 #include <algorithm>
 #include <iterator>
-#include <ranges>
+#include <utility>
 #include <vector>
 
 #include "./ts-linear-series.h"
@@ -62,15 +62,15 @@ Configurations::precision TSLinearSeries::coefficientB()
         a = median();
 
         const auto seriesXSize = seriesX.size() - 1;
-        Series intercepts(maxSeriesLength, initialCapacity, seriesXSize);
+        intercepts.clear();
 
         auto i = 0U;
         while (i < seriesXSize)
         {
-            intercepts.push((seriesY[i] - (a * seriesX[i])));
+            intercepts.push_back((seriesY[i] - (a * seriesX[i])));
             ++i;
         }
-        b = intercepts.median();
+        b = selectMedian(intercepts);
         shouldRecalculateB = false;
     }
 
@@ -79,29 +79,83 @@ Configurations::precision TSLinearSeries::coefficientB()
 
 Configurations::precision TSLinearSeries::median() const
 {
-    if (slopes.empty())
+    if (sortedSlopes.empty())
     {
         return 0.0;
     }
 
-    vector<Configurations::precision> flattened;
-    if (maxSlopeSeriesLength > 0)
+    const auto sortedSlopesSize = sortedSlopes.size();
+    const unsigned int mid = sortedSlopesSize / 2;
+
+    if ((sortedSlopesSize & 1) != 0)
+    {
+        return sortedSlopes[mid];
+    }
+
+    return (sortedSlopes[mid] + sortedSlopes[mid - 1]) / 2;
+}
+
+Configurations::precision TSLinearSeries::selectMedian(vector<Configurations::precision> &values)
+{
+    const auto valuesSize = values.size();
+    const unsigned int mid = valuesSize / 2;
+
+    std::ranges::nth_element(values, begin(values) + mid);
+
+    if ((valuesSize & 1) != 0)
     {
-        flattened.reserve(maxSlopeSeriesLength);
+        return values[mid];
+    }
+
+    return (values[mid] + *std::ranges::max_element(cbegin(values), cbegin(values) + mid)) / 2;
+}
+
+void TSLinearSeries::removeSortedSlopes(vector<Configurations::precision> &evictedSlopes)
+{
+    // The evicted row is dropped right after this call so it can be sorted in place, then both sorted ranges are walked together and the matching slopes are skipped while compacting
+    std::ranges::sort(evictedSlopes);
+
+    auto evicted = cbegin(evictedSlopes);
+    auto write = begin(sortedSlopes);
+    for (auto read = begin(sortedSlopes); read != end(sortedSlopes); ++read)
+    {
+        if (evicted != cend(evictedSlopes) && *read == *evicted)
+        {
+            ++evicted;
+            continue;
+        }
+
+        *write = *read;
+        ++write;
     }
 
-    std::ranges::copy(slopes | std::views::join, std::back_inserter(flattened));
+    sortedSlopes.erase(write, end(sortedSlopes));
+}
 
-    const auto flattenedSize = flattened.size();
-    const unsigned int mid = flattenedSize / 2;
+void TSLinearSeries::insertSortedSlopes()
+{
+    std::ranges::sort(newSlopes);
 
-    std::ranges::nth_element(flattened, begin(flattened) + mid);
+    // Merge from the back so the already sorted slopes can be shifted in place without a temporary buffer
+    auto existing = sortedSlopes.size();
+    auto inserted = newSlopes.size();
+    sortedSlopes.resize(existing + inserted);
+    auto target = sortedSlopes.size();
 
-    if ((flattenedSize & 1) != 0)
+    while (inserted > 0)
     {
-        return flattened[mid];
+        --target;
+        if (existing > 0 && sortedSlopes[existing - 1] > newSlopes[inserted - 1])
+        {
+            --existing;
+            sortedSlopes[target] = sortedSlopes[existing];
+
+            continue;
+        }
+
+        --inserted;
+        sortedSlopes[target] = newSlopes[inserted];
     }
-    return (flattened[mid] + *std::ranges::max_element(cbegin(flattened), cbegin(flattened) + mid)) / 2;
 }
 
 void TSLinearSeries::push(const Configurations::precision pointX, const Configurations::precision pointY)
@@ -111,11 +165,19 @@ void TSLinearSeries::push(const Configurations::precision pointX, const Configur
     shouldRecalculateA = true;
     shouldRecalculateB = true;
 
+    vector<Configurations::precision> recycledRow;
     if (maxSeriesLength > 0 && slopes.size() >= maxSeriesLength)
     {
-        // The maximum of the array has been reached, we have to create room in the 2D array by removing the first row from the table
+        // The maximum of the array has been reached, we have to create room in the 2D array by removing the first row from the table. The slopes in this row belong to the evicted point so they are removed from the sorted slopes too
+        removeSortedSlopes(slopes[0]);
+        recycledRow = std::move(slopes[0]);
         slopes.erase(begin(slopes));
     }
+    else if (!spareSlopeRows.empty())
+    {
+        recycledRow = std::move(spareSlopeRows.back());
+        spareSlopeRows.pop_back();
+    }
 
     // Invariant: the indices of the X and Y array now match up with the row numbers of the slopes array. So, the slope of (X[0],Y[0]) and (X[1],Y[1] will be stored in slopes[0][.].
 
@@ -125,31 +187,46 @@ void TSLinearSeries::push(const Configurations::precision pointX, const Configur
         // There are at least two points in the X and Y arrays, so let's add the new datapoint
         const auto seriesXPoints = seriesX.size() - 1;
         const auto slopesSize = slopes.size();
+        newSlopes.clear();
         auto i = 0U;
         while (i < seriesXPoints)
         {
             const auto result = calculateSlope(i, slopesSize);
             slopes[i].push_back(result);
+            newSlopes.push_back(result);
             ++i;
         }
+
+        insertSortedSlopes();
     }
 
-    // Add an empty array at the end to store future results for the most recent points
-    slopes.emplace_back();
+    // Add an empty array at the end to store future results for the most recent points. This reuses the storage of the evicted row once the series is full (or of a row released by reset), so pushing does not allocate
+    recycledRow.clear();
+    slopes.push_back(std::move(recycledRow));
     if (maxSeriesLength > 0)
     {
-        slopes[slopes.size() - 1].reserve(maxSeriesLength - 2);
+        slopes[slopes.size() - 1].reserve(maxSeriesLength - 1);
     }
 }
 
+void TSLinearSeries::rebase(const Configurations::precision offsetX)
+{
+    // Slopes do not depend on the origin of X, only the intercept needs to be recalculated
+    seriesX.rebase(offsetX);
+    shouldRecalculateB = true;
+}
+
 void TSLinearSeries::reset()
 {
     seriesX.reset();
     seriesY.reset();
 
-    vector<vector<Configurations::precision>> clear;
-    clear.reserve(maxSeriesLength > 0 ? maxSeriesLength : slopes.size());
-    slopes.swap(clear);
+    for (auto &row : slopes)
+    {
+        spareSlopeRows.push_back(std::move(row));
+    }
+    slopes.clear();
+    sortedSlopes.clear();
 
     a = 0;
 }
@@ -12,7 +12,6 @@ class TSLinearSeries
 {
     unsigned char maxSeriesLength;
     unsigned short maxSlopeSeriesLength = (maxSeriesLength * (maxSeriesLength - 1)) / 2;
-    unsigned short initialCapacity;
     bool shouldRecalculateB = true;
     bool shouldRecalculateA = true;
     Configurations::precision a = 0;
@@ -21,8 +20,17 @@ class TSLinearSeries
     Series seriesX;
     Series seriesY;
     vector<vector<Configurations::precision>> slopes;
+    // Rows of the slopes table released by reset, these are handed out again by push so refilling the series does not allocate
+    vector<vector<Configurations::precision>> spareSlopeRows;
+    vector<Configurations::precision> sortedSlopes;
+    vector<Configurations::precision> newSlopes;
+    vector<Configurations::precision> intercepts;
 
     [[nodiscard]] Configurations::precision calculateSlope(unsigned char pointOne, unsigned char pointTwo) const;
+    void removeSortedSlopes(vector<Configurations::precision> &evictedSlopes);
+    void insertSortedSlopes();
+
+    static Configurations::precision selectMedian(vector<Configurations::precision> &values);
 
 public:
     constexpr explicit TSLinearSeries(
@@ -30,13 +38,16 @@ public:
         const unsigned short _initialCapacity = Configurations::defaultAllocationCapacity,
         const unsigned short _maxAllocationCapacity = 1'000)
         : maxSeriesLength(_maxSeriesLength),
-          initialCapacity(_initialCapacity),
           seriesX(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity),
           seriesY(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity)
     {
         if (_maxSeriesLength > 0)
         {
             slopes.reserve(_maxSeriesLength);
+            spareSlopeRows.reserve(_maxSeriesLength);
+            sortedSlopes.reserve(maxSlopeSeriesLength);
+            newSlopes.reserve(_maxSeriesLength);
+            intercepts.reserve(_maxSeriesLength);
         }
     }
 
@@ -49,5 +60,6 @@ public:
     [[nodiscard]] size_t size() const;
 
     void push(Configurations::precision pointX, Configurations::precision pointY);
+    void rebase(Configurations::precision offsetX);
     void reset();
 };
\ No newline at end of file
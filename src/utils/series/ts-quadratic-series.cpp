@@ -1,12 +1,12 @@
 #include <algorithm>
+#include <functional>
 #include <iterator>
-#include <ranges>
+#include <vector>
 
 #include "./ts-quadratic-series.h"
 
 #include "../configuration.h"
 #include "./series.h"
-#include "./ts-linear-series.h"
 
 using std::vector;
 
@@ -36,14 +36,15 @@ void TSQuadraticSeries::push(const Configurations::precision pointX, const Confi
 {
     if (maxSeriesLength > 0 && seriesX.size() >= maxSeriesLength)
     {
-        // The maximum of the array has been reached, we have to create room in the 2D array by removing the first row from the A-table
-        seriesA.erase(begin(seriesA));
+        // The maximum of the array has been reached, we have to create room in the A-table by removing the coefficients of the oldest point (i.e. every triple where it is the first point)
+        removeSeriesA(headOrigin);
+        ++headOrigin;
+        fitMoments.remove(seriesX.front(), seriesY.front());
     }
 
     seriesX.push(pointX);
     seriesY.push(pointY);
-
-    // Invariant: the indices of the X and Y array now match up with the row numbers of the A array. So, the A of (X[0],Y[0]) and (X[1],Y[1] will be stored in A[0][.].
+    updateFitMoments(pointX, pointY);
 
     const auto seriesXSize = seriesX.size();
     if (seriesXSize < 3)
@@ -55,44 +56,163 @@ void TSQuadraticSeries::push(const Configurations::precision pointX, const Confi
         return;
     }
 
-    // Calculate the coefficients of this new point if we have three or more points in the series
-
-    seriesA.emplace_back();
-    if (maxSeriesAInnerLength > 0)
-    {
-        seriesA[seriesA.size() - 1].reserve(maxSeriesAInnerLength);
-    }
+    // Calculate the coefficients of the triples closed by this new point if we have three or more points in the series
+    newSeriesA.clear();
 
-    // There are at least two points in the X and Y arrays, so let's add the new datapoint
     const auto seriesXInnerLength = seriesXSize - 2;
+    const auto seriesXIndexLength = seriesXSize - 1;
     auto i = 0U;
     auto j = 0U;
     while (i < seriesXInnerLength)
     {
+        const auto origin = static_cast<unsigned char>(headOrigin + i);
         j = i + 1;
-        const auto seriesXIndexLength = seriesXSize - 1;
         while (j < seriesXIndexLength)
         {
-            seriesA[i].push_back(calculateA(i, j, seriesXIndexLength));
+            newSeriesA.push_back({.value = calculateA(i, j, seriesXIndexLength), .origin = origin});
             j++;
         }
         ++i;
     }
+
+    insertSeriesA();
     a = seriesAMedian();
 
-    TSLinearSeries linearResidue(maxSeriesLength, seriesXSize, maxAllocationCapacity);
-    i = 0;
+    calculateResidualCoefficients();
+}
+
+void TSQuadraticSeries::rebase(const Configurations::precision offsetX, const Configurations::precision offsetY)
+{
+    seriesX.rebase(offsetX);
+    seriesY.rebase(offsetY);
+    fitMoments.recalculate(seriesX, seriesY);
+    pushesSinceMomentsRecalculation = 0;
+
+    // The coefficients of the quadratic term do not depend on the origin, but the linear and constant terms of the residue do
+    if (seriesX.size() >= 3)
+    {
+        calculateResidualCoefficients();
+    }
+}
+
+void TSQuadraticSeries::reset()
+{
+    seriesX.reset();
+    seriesY.reset();
+    seriesA.clear();
+    seriesAOrigins.clear();
+    fitMoments.reset();
+    pushesSinceMomentsRecalculation = 0;
+    headOrigin = 0;
+
+    a = 0;
+    b = 0;
+    c = 0;
+}
+
+void TSQuadraticSeries::updateFitMoments(const Configurations::precision pointX, const Configurations::precision pointY)
+{
+    ++pushesSinceMomentsRecalculation;
+    if (pushesSinceMomentsRecalculation < Configurations::quadraticFitMomentsRecalculationInterval)
+    {
+        fitMoments.push(pointX, pointY);
+
+        return;
+    }
+
+    fitMoments.recalculate(seriesX, seriesY);
+    pushesSinceMomentsRecalculation = 0;
+}
+
+void TSQuadraticSeries::removeSeriesA(const unsigned char origin)
+{
+    auto write = 0U;
+    const auto seriesASize = seriesA.size();
+    for (auto read = 0U; read < seriesASize; ++read)
+    {
+        if (seriesAOrigins[read] == origin)
+        {
+            continue;
+        }
+
+        seriesA[write] = seriesA[read];
+        seriesAOrigins[write] = seriesAOrigins[read];
+        ++write;
+    }
+
+    seriesA.resize(write);
+    seriesAOrigins.resize(write);
+}
+
+void TSQuadraticSeries::insertSeriesA()
+{
+    std::ranges::sort(newSeriesA, {}, &SeriesAEntry::value);
+
+    // Merge from the back so the already sorted coefficients can be shifted in place without a temporary buffer
+    auto existing = seriesA.size();
+    auto inserted = newSeriesA.size();
+    seriesA.resize(existing + inserted);
+    seriesAOrigins.resize(existing + inserted);
+    auto target = seriesA.size();
+
+    while (inserted > 0)
+    {
+        --target;
+        if (existing > 0 && seriesA[existing - 1] > newSeriesA[inserted - 1].value)
+        {
+            --existing;
+            seriesA[target] = seriesA[existing];
+            seriesAOrigins[target] = seriesAOrigins[existing];
+
+            continue;
+        }
+
+        --inserted;
+        seriesA[target] = newSeriesA[inserted].value;
+        seriesAOrigins[target] = newSeriesA[inserted].origin;
+    }
+}
+
+void TSQuadraticSeries::calculateResidualCoefficients()
+{
+    // This is a Theil-Sen linear regression on the residue (i.e. y - a * x^2) that reuses preallocated buffers instead of building a TSLinearSeries on every push
+    const auto seriesXSize = seriesX.size();
+
+    residualSeriesY.clear();
+    auto i = 0U;
     while (i < seriesXSize)
     {
         const auto seriesXPointI = seriesX[i];
+        residualSeriesY.push_back(seriesY[i] - a * (seriesXPointI * seriesXPointI));
+        ++i;
+    }
+
+    residualSlopes.clear();
+    const auto seriesXPoints = seriesXSize - 1;
+    i = 0;
+    while (i < seriesXPoints)
+    {
+        const auto seriesXPointI = seriesX[i];
+        auto j = i + 1;
+        while (j < seriesXSize)
+        {
+            const auto seriesXPointJ = seriesX[j];
+            residualSlopes.push_back(seriesXPointI == seriesXPointJ ? 0.0 : (residualSeriesY[j] - residualSeriesY[i]) / (seriesXPointJ - seriesXPointI));
+            ++j;
+        }
+        ++i;
+    }
+    b = selectMedian(residualSlopes);
 
-        linearResidue.push(
-            seriesXPointI,
-            seriesY[i] - a * (seriesXPointI * seriesXPointI));
+    // Same as TSLinearSeries, the intercept of the most recent point is not part of the median
+    residualIntercepts.clear();
+    i = 0;
+    while (i < seriesXPoints)
+    {
+        residualIntercepts.push_back(residualSeriesY[i] - (b * seriesX[i]));
         ++i;
     }
-    b = linearResidue.coefficientA();
-    c = linearResidue.coefficientB();
+    c = selectMedian(residualIntercepts);
 }
 
 Configurations::precision TSQuadraticSeries::calculateA(const unsigned char pointOne, const unsigned char pointTwo, const unsigned char pointThree) const
@@ -117,74 +237,39 @@ Configurations::precision TSQuadraticSeries::calculateA(const unsigned char poin
 
 Configurations::precision TSQuadraticSeries::seriesAMedian() const
 {
-    vector<Configurations::precision> flattened;
-    if (maxSeriesALength > 0)
-    {
-        flattened.reserve(maxSeriesALength);
-    }
-
-    std::ranges::copy(seriesA | std::views::join, std::back_inserter(flattened));
-
-    const auto flattenedSize = flattened.size();
-    const unsigned int mid = flattenedSize / 2;
+    const auto seriesASize = seriesA.size();
+    const unsigned int mid = seriesASize / 2;
 
-    std::ranges::nth_element(flattened, begin(flattened) + mid);
-
-    if ((flattenedSize & 1) != 0)
+    if ((seriesASize & 1) != 0)
     {
-        return flattened[mid];
+        return seriesA[mid];
     }
 
-    return (flattened[mid] + *std::ranges::max_element(cbegin(flattened), cbegin(flattened) + mid)) / 2;
+    return (seriesA[mid] + seriesA[mid - 1]) / 2;
 }
 
-// This function returns the R^2 as a goodness of fit indicator
-Configurations::precision TSQuadraticSeries::goodnessOfFit() const
+Configurations::precision TSQuadraticSeries::selectMedian(vector<Configurations::precision> &values)
 {
-    const auto seriesXSize = seriesX.size();
-    if (seriesXSize < 3)
-    {
-        return 0.0;
-    }
-
-    Configurations::precision sse = 0.0;
-    Configurations::precision sst = 0.0;
-
-    const auto averageY = seriesY.average();
-
-    auto i = 0U;
-    while (i < seriesXSize)
-    {
-        const auto seriesYI = seriesY[i];
-        const auto projectedX = projectX(seriesX[i]);
-
-        const auto seriesYProjectedXDiff = seriesYI - projectedX;
-        const auto seriesYIAverageYDiff = seriesYI - averageY;
+    const auto valuesSize = values.size();
+    const unsigned int mid = valuesSize / 2;
 
-        sse += seriesYProjectedXDiff * seriesYProjectedXDiff;
-        sst += seriesYIAverageYDiff * seriesYIAverageYDiff;
-        ++i;
-    }
+    std::ranges::nth_element(values, begin(values) + mid);
 
-    if (sst == 0 || sse > sst)
+    if ((valuesSize & 1) != 0)
     {
-        return 0;
+        return values[mid];
     }
 
-    if (sse == 0)
-    {
-        return 1;
-    }
-
-    return 1 - (sse / sst);
+    return (values[mid] + *std::ranges::max_element(cbegin(values), cbegin(values) + mid)) / 2;
 }
 
-Configurations::precision TSQuadraticSeries::projectX(Configurations::precision pointX) const
+// This function returns the R^2 as a goodness of fit indicator
+Configurations::precision TSQuadraticSeries::goodnessOfFit() const
 {
     if (seriesX.size() < 3)
     {
         return 0.0;
     }
 
-    return ((a * pointX * pointX) + (b * pointX) + c);
-}
\ No newline at end of file
+    return fitMoments.goodnessOfFit(a, b, c);
+}
@@ -3,26 +3,52 @@
 #include <vector>
 
 #include "../configuration.h"
+#include "./quadratic-fit-moments.h"
 #include "./series.h"
 
 using std::vector;
 
 class TSQuadraticSeries
 {
+    struct SeriesAEntry
+    {
+        Configurations::precision value;
+        unsigned char origin;
+    };
+
     unsigned char maxSeriesLength;
     unsigned short maxSeriesAInnerLength = ((maxSeriesLength - 2U) * (maxSeriesLength - 1U)) / 2U;
     unsigned short maxSeriesALength;
-    unsigned short maxAllocationCapacity;
 
     Configurations::precision a = 0;
     Configurations::precision b = 0;
     Configurations::precision c = 0;
-    vector<vector<Configurations::precision>> seriesA;
+
+    // Ring slot of the oldest point, the slot of the point at index i is headOrigin + i (wrapping)
+    unsigned char headOrigin = 0;
+    vector<Configurations::precision> seriesA;
+    vector<unsigned char> seriesAOrigins;
+    vector<SeriesAEntry> newSeriesA;
+
+    vector<Configurations::precision> residualSeriesY;
+    vector<Configurations::precision> residualSlopes;
+    vector<Configurations::precision> residualIntercepts;
+
     Series seriesX;
     Series seriesY;
 
+    // The R^2 is evaluated from the power sums of the window, these are rebuilt from the window once every Configurations::quadraticFitMomentsRecalculationInterval pushes to bound the drift of the add/remove updates
+    unsigned char pushesSinceMomentsRecalculation = 0;
+    QuadraticFitMoments fitMoments;
+
     [[nodiscard]] Configurations::precision calculateA(unsigned char pointOne, unsigned char pointTwo, unsigned char pointThree) const;
     [[nodiscard]] Configurations::precision seriesAMedian() const;
+    void removeSeriesA(unsigned char origin);
+    void insertSeriesA();
+    void calculateResidualCoefficients();
+    void updateFitMoments(Configurations::precision pointX, Configurations::precision pointY);
+
+    static Configurations::precision selectMedian(vector<Configurations::precision> &values);
 
     static constexpr unsigned short calculateMaxSeriesALength(const unsigned short seriesLength, const unsigned short seriesAInnerLength)
     {
@@ -36,8 +62,6 @@ class TSQuadraticSeries
         return sum;
     }
 
-    [[nodiscard]] Configurations::precision projectX(Configurations::precision pointX) const;
-
 public:
     constexpr explicit TSQuadraticSeries(
         const unsigned char _maxSeriesLength = 0,
@@ -45,13 +69,17 @@ public:
         const unsigned short _maxAllocationCapacity = 1'000)
         : maxSeriesLength(_maxSeriesLength),
           maxSeriesALength(calculateMaxSeriesALength(_maxSeriesLength, maxSeriesAInnerLength)),
-          maxAllocationCapacity(_maxAllocationCapacity),
           seriesX(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity),
           seriesY(_maxSeriesLength, _initialCapacity, _maxAllocationCapacity)
     {
         if (_maxSeriesLength > 0)
         {
-            seriesA.reserve(_maxSeriesLength - 3);
+            seriesA.reserve(maxSeriesALength);
+            seriesAOrigins.reserve(maxSeriesALength);
+            newSeriesA.reserve(maxSeriesAInnerLength);
+            residualSeriesY.reserve(_maxSeriesLength);
+            residualSlopes.reserve((_maxSeriesLength * (_maxSeriesLength - 1U)) / 2U);
+            residualIntercepts.reserve(_maxSeriesLength);
         }
     }
 
@@ -59,4 +87,6 @@ public:
     [[nodiscard]] Configurations::precision secondDerivativeAtPosition(unsigned char position) const;
     [[nodiscard]] Configurations::precision goodnessOfFit() const;
     void push(Configurations::precision pointX, Configurations::precision pointY);
+    void rebase(Configurations::precision offsetX, Configurations::precision offsetY);
+    void reset();
 };
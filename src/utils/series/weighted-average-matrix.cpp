@@ -0,0 +1,57 @@
+#include "./weighted-average-matrix.h"
+
+#include "../configuration.h"
+
+size_t WeightedAverageMatrix::size() const
+{
+    return rowCount;
+}
+
+Configurations::precision WeightedAverageMatrix::average() const
+{
+    const auto weightSum = weightSums[head];
+
+    if (rowCount == 0 || weightSum == 0)
+    {
+        return 0.0;
+    }
+
+    return weightedSums[head] / weightSum;
+}
+
+void WeightedAverageMatrix::addRow()
+{
+    if (rowCount < maxSeriesLength)
+    {
+        weightedSums[rowCount] = 0;
+        weightSums[rowCount] = 0;
+        ++rowCount;
+
+        return;
+    }
+
+    // The window is full, the oldest row is complete and its slot is reused for the newest point
+    weightedSums[head] = 0;
+    weightSums[head] = 0;
+
+    ++head;
+    if (head >= maxSeriesLength)
+    {
+        head = 0;
+    }
+}
+
+void WeightedAverageMatrix::push(const unsigned char position, const Configurations::precision value, const Configurations::precision weight)
+{
+    const auto slot = head + position;
+    const auto index = slot < maxSeriesLength ? slot : slot - maxSeriesLength;
+
+    weightedSums[index] += value * weight;
+    weightSums[index] += weight;
+}
+
+void WeightedAverageMatrix::reset()
+{
+    head = 0;
+    rowCount = 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../configuration.h"
+
+using std::size_t;
+using std::vector;
+
+// Fixed size ring of running weighted sums, one row per point of the regression window. Every row collects the estimates of the same point across consecutive windows (i.e. the diagonal of the window history) and the oldest row holds the fully smoothed value
+class WeightedAverageMatrix
+{
+    unsigned char maxSeriesLength;
+    unsigned char head = 0;
+    unsigned char rowCount = 0;
+    vector<Configurations::precision> weightedSums;
+    vector<Configurations::precision> weightSums;
+
+public:
+    explicit WeightedAverageMatrix(const unsigned char _maxSeriesLength = 1)
+        : maxSeriesLength(_maxSeriesLength == 0 ? 1 : _maxSeriesLength),
+          weightedSums(maxSeriesLength, 0),
+          weightSums(maxSeriesLength, 0)
+    {
+    }
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] Configurations::precision average() const;
+
+    void addRow();
+    void push(unsigned char position, Configurations::precision value, Configurations::precision weight);
+    void reset();
+};
@@ -0,0 +1,422 @@
+// Measures the time per push and per query of the series and regression kernels for window lengths 3-18, feeding them the delta times of the calibration recordings. The precision is a compile time setting so there is one executable per precision. Usage:
+// series_bench_<precision> [--data calibration directory] [--impulses N] [--repeat N] [--output path] [--baseline path] [--max-regression percent]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../../src/utils/configuration.h"
+#include "../../src/utils/series/cyclic-error-filter.h"
+#include "../../src/utils/series/exponential-weighted-average.h"
+#include "../../src/utils/series/ols-linear-series.h"
+#include "../../src/utils/series/series.h"
+#include "../../src/utils/series/ts-linear-series.h"
+#include "../../src/utils/series/ts-quadratic-series.h"
+#include "../../src/utils/series/weighted-average-series.h"
+
+namespace fs = std::filesystem;
+
+using std::string;
+using std::vector;
+
+using precision = Configurations::precision;
+
+constexpr std::string_view precisionName = std::is_same_v<precision, float> ? "float" : "double";
+constexpr unsigned char minWindowLength = 3U;
+constexpr unsigned char maxWindowLength = 18U;
+// The cyclic error filter recordings are cleared as at the end of a recovery, roughly every stroke
+constexpr unsigned short impulsesPerStroke = 200U;
+constexpr unsigned char impulsesPerRevolution = 3U;
+constexpr double noiseFloorNs = 1.0;
+
+struct BenchmarkResult
+{
+    string kernel;
+    unsigned char window = 0;
+    double pushNs = 0;
+    double queryNs = 0;
+};
+
+// Keeps the query results alive so the compiler cannot drop the calls
+volatile precision sink = 0;
+
+// Every calibration recording contributes the same share of impulses, so all rower profiles are represented
+vector<unsigned long> loadDeltaTimes(const fs::path &calibrationDirectory, const size_t impulseCount)
+{
+    vector<fs::path> recordings;
+    for (const auto &entry : fs::recursive_directory_iterator(calibrationDirectory))
+    {
+        if (entry.is_regular_file() && entry.path().filename().string().ends_with("test.txt"))
+        {
+            recordings.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(recordings);
+
+    vector<unsigned long> deltaTimes;
+    if (recordings.empty())
+    {
+        return deltaTimes;
+    }
+
+    deltaTimes.reserve(impulseCount);
+    const auto impulsesPerRecording = std::max<size_t>(impulseCount / recordings.size(), 1U);
+    for (const auto &recording : recordings)
+    {
+        std::ifstream deltaTimeStream(recording);
+        unsigned long deltaTime = 0;
+        auto count = 0UL;
+        while (count < impulsesPerRecording && deltaTimes.size() < impulseCount && deltaTimeStream >> deltaTime)
+        {
+            deltaTimes.push_back(deltaTime);
+            ++count;
+        }
+    }
+
+    return deltaTimes;
+}
+
+// The kernel is run over the whole stream twice: once only pushing and once pushing and querying after every push (like the impulse pipeline does), the query time is the difference. The fastest of the repeats is kept
+template <typename Kernel, typename Push, typename Query>
+BenchmarkResult measure(const string &kernel, const unsigned char window, const unsigned int repeat, const std::function<Kernel()> &create, const Push &push, const Query &query, const size_t impulseCount)
+{
+    const auto run = [&](const bool shouldQuery)
+    {
+        auto kernelUnderTest = create();
+        precision result = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto i = 0UL;
+        while (i < impulseCount)
+        {
+            push(kernelUnderTest, i);
+            if (shouldQuery)
+            {
+                result += query(kernelUnderTest);
+            }
+            ++i;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        sink = sink + result;
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(impulseCount);
+    };
+
+    auto pushNs = std::numeric_limits<double>::max();
+    auto pushAndQueryNs = std::numeric_limits<double>::max();
+    auto i = 0U;
+    while (i < repeat)
+    {
+        pushNs = std::min(pushNs, run(false));
+        pushAndQueryNs = std::min(pushAndQueryNs, run(true));
+        ++i;
+    }
+
+    return BenchmarkResult{
+        .kernel = kernel,
+        .window = window,
+        .pushNs = pushNs,
+        .queryNs = std::max(pushAndQueryNs - pushNs, 0.0),
+    };
+}
+
+vector<BenchmarkResult> runBenchmarks(const vector<unsigned long> &deltaTimes, const unsigned int repeat)
+{
+    // Same inputs as in the impulse pipeline: clean time in microseconds against delta time for the linear regressions and time in seconds against angular displacement for the quadratic one
+    vector<precision> deltaTimeValues;
+    vector<precision> times;
+    vector<precision> angularTimes;
+    vector<precision> angularDistances;
+    const auto angularDisplacementPerImpulse = (2 * PI) / impulsesPerRevolution;
+    auto totalTime = 0.0;
+    auto totalAngularDisplacement = 0.0;
+    for (const auto deltaTime : deltaTimes)
+    {
+        totalTime += static_cast<double>(deltaTime);
+        totalAngularDisplacement += angularDisplacementPerImpulse;
+        deltaTimeValues.push_back(static_cast<precision>(deltaTime));
+        times.push_back(static_cast<precision>(totalTime));
+        angularTimes.push_back(static_cast<precision>(totalTime / 1e6));
+        angularDistances.push_back(static_cast<precision>(totalAngularDisplacement));
+    }
+    const auto averageDeltaTime = static_cast<precision>(totalTime / static_cast<double>(deltaTimes.size()));
+    const auto impulseCount = deltaTimes.size();
+
+    vector<BenchmarkResult> results;
+    const auto add = [&results](const BenchmarkResult &result)
+    {
+        printf("%-28s %2u %10.1f ns/push %10.1f ns/query\n", result.kernel.c_str(), result.window, result.pushNs, result.queryNs);
+        results.push_back(result);
+    };
+
+    unsigned char window = minWindowLength;
+    while (window <= maxWindowLength)
+    {
+        add(measure<Series>(
+            "Series", window, repeat, [window]()
+            { return Series(window); },
+            [&](Series &series, const size_t i)
+            { series.push(deltaTimeValues[i]); },
+            [](const Series &series)
+            { return series.median() + series.average(); },
+            impulseCount));
+
+        add(measure<TSLinearSeries>(
+            "TSLinearSeries", window, repeat, [window]()
+            { return TSLinearSeries(window); },
+            [&](TSLinearSeries &series, const size_t i)
+            { series.push(times[i], deltaTimeValues[i]); },
+            [](TSLinearSeries &series)
+            { return series.coefficientA() + series.coefficientB(); },
+            impulseCount));
+
+        add(measure<TSQuadraticSeries>(
+            "TSQuadraticSeries", window, repeat, [window]()
+            { return TSQuadraticSeries(window); },
+            [&](TSQuadraticSeries &series, const size_t i)
+            { series.push(angularTimes[i], angularDistances[i]); },
+            [](const TSQuadraticSeries &series)
+            { return series.firstDerivativeAtPosition(0) + series.secondDerivativeAtPosition(0) + series.goodnessOfFit(); },
+            impulseCount));
+
+        add(measure<OLSLinearSeries>(
+            "OLSLinearSeries", window, repeat, [window]()
+            { return OLSLinearSeries(window); },
+            [&](OLSLinearSeries &series, const size_t i)
+            { series.push(times[i], deltaTimeValues[i]); },
+            [](const OLSLinearSeries &series)
+            { return series.slope() + series.intercept() + series.goodnessOfFit(); },
+            impulseCount));
+
+        add(measure<WeightedAverageSeries>(
+            "WeightedAverageSeries", window, repeat, [window]()
+            { return WeightedAverageSeries(window); },
+            [&](WeightedAverageSeries &series, const size_t i)
+            { series.push(deltaTimeValues[i], angularDistances[i]); },
+            [](const WeightedAverageSeries &series)
+            { return series.average(); },
+            impulseCount));
+
+        add(measure<ExponentialWeightedAverage>(
+            "ExponentialWeightedAverage", window, repeat, [window]()
+            { return ExponentialWeightedAverage(window); },
+            [&](ExponentialWeightedAverage &average, const size_t i)
+            { average.push(deltaTimeValues[i], 1); },
+            [](const ExponentialWeightedAverage &average)
+            { return average.average(); },
+            impulseCount));
+
+        // A push is filtering the impulse and recording it as during a recovery, a query is replaying one recorded impulse into the filter
+        add(measure<CyclicErrorFilter>(
+            "CyclicErrorFilter", window, repeat, [window, averageDeltaTime]()
+            {
+                auto filter = CyclicErrorFilter(impulsesPerRevolution, window, 1, Configurations::defaultAllocationCapacity);
+                filter.updateRegressionCoefficients(0, averageDeltaTime, 1);
+
+                return filter; },
+            [&](CyclicErrorFilter &filter, const size_t i)
+            {
+                if (i % impulsesPerStroke == 0)
+                {
+                    filter.restart();
+                }
+                filter.applyFilter(i, deltaTimeValues[i]);
+                filter.recordRawDatapoint(i, times[i], deltaTimeValues[i]);
+            },
+            [](CyclicErrorFilter &filter)
+            {
+                filter.processNextRawDatapoint();
+
+                return filter.cleanSeries().back();
+            },
+            impulseCount));
+
+        ++window;
+    }
+
+    return results;
+}
+
+void writeReport(const fs::path &reportPath, const vector<BenchmarkResult> &results, const size_t impulseCount)
+{
+    std::ofstream report(reportPath);
+    report << "{\n"
+           << "  \"precision\": \"" << precisionName << "\",\n"
+           << "  \"impulses\": " << impulseCount << ",\n"
+           << "  \"results\": [\n";
+
+    auto i = 0U;
+    while (i < results.size())
+    {
+        const auto &result = results[i];
+        // One result per line, the baseline comparison relies on this
+        report << "    {\"kernel\": \"" << result.kernel
+               << "\", \"window\": " << static_cast<unsigned int>(result.window)
+               << ", \"pushNs\": " << result.pushNs
+               << ", \"queryNs\": " << result.queryNs
+               << "}" << (i + 1U < results.size() ? "," : "") << "\n";
+        ++i;
+    }
+
+    report << "  ]\n"
+           << "}\n";
+}
+
+double parseNumber(const string &line, const std::string_view key)
+{
+    const auto position = line.find(string("\"") + string(key) + "\": ");
+    if (position == string::npos)
+    {
+        return 0;
+    }
+
+    return std::strtod(line.c_str() + position + key.size() + 4, nullptr);
+}
+
+vector<BenchmarkResult> readReport(const fs::path &reportPath)
+{
+    vector<BenchmarkResult> results;
+    std::ifstream report(reportPath);
+    string line;
+    while (std::getline(report, line))
+    {
+        const std::string_view kernelKey = "\"kernel\": \"";
+        const auto kernelStart = line.find(kernelKey);
+        if (kernelStart == string::npos)
+        {
+            continue;
+        }
+
+        const auto nameStart = kernelStart + kernelKey.size();
+        results.push_back(BenchmarkResult{
+            .kernel = line.substr(nameStart, line.find('"', nameStart) - nameStart),
+            .window = static_cast<unsigned char>(parseNumber(line, "window")),
+            .pushNs = parseNumber(line, "pushNs"),
+            .queryNs = parseNumber(line, "queryNs"),
+        });
+    }
+
+    return results;
+}
+
+// Prints the speedup (baseline time / current time) of every kernel and window, returns the number of results that got slower than the allowed regression
+unsigned int compareWithBaseline(const vector<BenchmarkResult> &results, const vector<BenchmarkResult> &baseline, const double maxRegression)
+{
+    // Timings below a nanosecond are noise (e.g. a query that only returns a value cached by the push)
+    const auto speedup = [](const double baselineNs, const double currentNs)
+    { return std::max(baselineNs, noiseFloorNs) / std::max(currentNs, noiseFloorNs); };
+
+    printf("\nSpeedup against the baseline (>1 is faster)\n");
+
+    auto regressionCount = 0U;
+    for (const auto &result : results)
+    {
+        const auto baselineResult = std::ranges::find_if(baseline, [&result](const BenchmarkResult &candidate)
+                                                         { return candidate.kernel == result.kernel && candidate.window == result.window; });
+        if (baselineResult == baseline.end())
+        {
+            continue;
+        }
+
+        const auto pushSpeedup = speedup(baselineResult->pushNs, result.pushNs);
+        const auto querySpeedup = speedup(baselineResult->queryNs, result.queryNs);
+        const auto isRegression = maxRegression > 0 && std::min(pushSpeedup, querySpeedup) < 1.0 / (1.0 + maxRegression / 100.0);
+        if (isRegression)
+        {
+            ++regressionCount;
+        }
+
+        printf("%-28s %2u push %5.2fx query %5.2fx%s\n", result.kernel.c_str(), result.window, pushSpeedup, querySpeedup, isRegression ? " REGRESSION" : "");
+    }
+
+    return regressionCount;
+}
+
+int main(int argc, const char *argv[])
+{
+    const auto args = std::span(argv + 1, size_t(argc - 1));
+
+    fs::path calibrationDirectory = "test/calibration";
+    size_t impulseCount = 100'000;
+    auto repeat = 3U;
+    fs::path reportPath;
+    fs::path baselinePath;
+    auto maxRegression = 0.0;
+
+    auto argIndex = 0U;
+    while (argIndex + 1U < args.size())
+    {
+        const std::string_view option(args[argIndex]);
+        const auto *const value = args[argIndex + 1U];
+        if (option == "--data")
+        {
+            calibrationDirectory = value;
+        }
+        if (option == "--impulses")
+        {
+            impulseCount = std::strtoul(value, nullptr, 10);
+        }
+        if (option == "--repeat")
+        {
+            repeat = std::max(static_cast<unsigned int>(std::strtoul(value, nullptr, 10)), 1U);
+        }
+        if (option == "--output")
+        {
+            reportPath = value;
+        }
+        if (option == "--baseline")
+        {
+            baselinePath = value;
+        }
+        if (option == "--max-regression")
+        {
+            maxRegression = std::strtod(value, nullptr);
+        }
+        argIndex += 2U;
+    }
+
+#if !defined(__OPTIMIZE__)
+    printf("Warning: this is not an optimized build, the results are not representative (configure with -DCMAKE_BUILD_TYPE=Release)\n");
+#endif
+
+    const auto deltaTimes = loadDeltaTimes(calibrationDirectory, impulseCount);
+    if (deltaTimes.empty())
+    {
+        printf("No calibration recordings found in %s\n", calibrationDirectory.c_str());
+
+        return 1;
+    }
+
+    printf("Series kernels, %.*s precision, %zu impulses, best of %u runs\n", static_cast<int>(precisionName.size()), precisionName.data(), deltaTimes.size(), repeat);
+
+    const auto results = runBenchmarks(deltaTimes, repeat);
+
+    if (!reportPath.empty())
+    {
+        writeReport(reportPath, results, deltaTimes.size());
+    }
+
+    if (baselinePath.empty())
+    {
+        return 0;
+    }
+
+    if (!fs::exists(baselinePath))
+    {
+        printf("\nNo baseline at %s, skipping the comparison\n", baselinePath.c_str());
+
+        return 0;
+    }
+
+    return compareWithBaseline(results, readReport(baselinePath), maxRegression) > 0 ? 1 : 0;
+}
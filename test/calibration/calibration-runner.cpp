@@ -0,0 +1,353 @@
+// Runs every calibration recording (test/calibration/<rower profile>/*test.txt, or *test.ilog for binary impulse logs) through the e2e binary of its rower profile on a pool of worker threads and checks the detected stroke count against the one in the file name. With --replay all recordings are run by the given replay binary instead, which selects the rower profile at runtime. Usage:
+// calibration-runner <calibration directory> <e2e binary directory> [--jobs N] [--summary path] [--replay path]
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../impulse-log/impulse-log.reader.h"
+
+extern char **environ;
+
+namespace fs = std::filesystem;
+
+using std::string;
+using std::vector;
+
+struct CalibrationJob
+{
+    string profile;
+    fs::path recording;
+    fs::path binary;
+    bool isReplay = false;
+    fs::path output;
+    unsigned int expectedStrokeCount = 0;
+
+    unsigned long impulseCount = 0;
+    unsigned int strokeCount = 0;
+    int exitCode = 0;
+    double runtime = 0;
+
+    [[nodiscard]] bool isPassed() const
+    {
+        return exitCode == 0 && strokeCount == expectedStrokeCount;
+    }
+};
+
+// The expected number of strokes is the third dash separated part of the file name (e.g. steady-real-635-test.txt)
+unsigned int parseExpectedStrokeCount(const string &fileName)
+{
+    auto start = 0UL;
+    auto field = 0U;
+    while (field < 2U && start != string::npos)
+    {
+        start = fileName.find('-', start);
+        if (start != string::npos)
+        {
+            ++start;
+        }
+        ++field;
+    }
+
+    if (start == string::npos)
+    {
+        return 0U;
+    }
+
+    return static_cast<unsigned int>(std::strtoul(fileName.c_str() + start, nullptr, 10));
+}
+
+vector<CalibrationJob> collectJobs(const fs::path &calibrationDirectory, const fs::path &binaryDirectory, const fs::path &replayBinary)
+{
+    vector<CalibrationJob> jobs;
+
+    for (const auto &profileEntry : fs::directory_iterator(calibrationDirectory))
+    {
+        if (!profileEntry.is_directory())
+        {
+            continue;
+        }
+
+        const auto profile = profileEntry.path().filename().string();
+        const auto isReplay = !replayBinary.empty();
+        const auto binary = isReplay ? replayBinary : binaryDirectory / ("e2e_test_" + profile + ".out");
+        if (!fs::exists(binary))
+        {
+            printf("No e2e binary for rower profile \"%s\" (%s), skipping\n", profile.c_str(), binary.c_str());
+            continue;
+        }
+
+        for (const auto &recordingEntry : fs::directory_iterator(profileEntry.path()))
+        {
+            const auto fileName = recordingEntry.path().filename().string();
+            const auto isImpulseLog = fileName.ends_with("test" + string(ImpulseLog::fileExtension));
+            if (!recordingEntry.is_regular_file() || (!fileName.ends_with("test.txt") && !isImpulseLog))
+            {
+                continue;
+            }
+
+            // Impulse logs may carry the expected number of strokes in their header
+            auto expectedStrokeCount = 0U;
+            if (isImpulseLog)
+            {
+                const ImpulseLogReader impulseLog(recordingEntry.path());
+                expectedStrokeCount = impulseLog.header().expectedStrokeCount;
+            }
+
+            jobs.push_back(CalibrationJob{
+                .profile = profile,
+                .recording = recordingEntry.path(),
+                .binary = binary,
+                .isReplay = isReplay,
+                .output = profileEntry.path() / "output" / (fileName + "-output.txt"),
+                .expectedStrokeCount = expectedStrokeCount > 0 ? expectedStrokeCount : parseExpectedStrokeCount(fileName),
+            });
+        }
+    }
+
+    // Longest recordings go first so a long file does not end up running alone at the end
+    std::ranges::sort(jobs, [](const CalibrationJob &left, const CalibrationJob &right)
+                      { return fs::file_size(left.recording) > fs::file_size(right.recording); });
+
+    return jobs;
+}
+
+unsigned long countImpulses(const fs::path &recording)
+{
+    if (ImpulseLogReader::isImpulseLog(recording))
+    {
+        const ImpulseLogReader impulseLog(recording);
+
+        return impulseLog.impulseCount();
+    }
+
+    std::ifstream deltaTimeStream(recording);
+    auto impulseCount = 0UL;
+    unsigned long deltaTime = 0;
+    while (deltaTimeStream >> deltaTime)
+    {
+        ++impulseCount;
+    }
+
+    return impulseCount;
+}
+
+// A stroke is counted for every line that contains "power" (case insensitive), same as the grep of the calibration script
+unsigned int countStrokes(const fs::path &output)
+{
+    std::ifstream outputStream(output);
+    auto strokeCount = 0U;
+    string line;
+    while (std::getline(outputStream, line))
+    {
+        std::ranges::transform(line, begin(line), [](const unsigned char character)
+                               { return static_cast<char>(std::tolower(character)); });
+        if (line.find("power") != string::npos)
+        {
+            ++strokeCount;
+        }
+    }
+
+    return strokeCount;
+}
+
+// The e2e binary is started directly (without a shell, as some recordings have quotes in their names) with its output redirected to the output file
+int runE2e(const CalibrationJob &job)
+{
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, job.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    string binary = job.binary.string();
+    string profileOption = "--profile";
+    string profile = job.profile;
+    string recording = job.recording.string();
+    std::array<char *, 3> arguments{binary.data(), recording.data(), nullptr};
+    std::array<char *, 5> replayArguments{binary.data(), profileOption.data(), profile.data(), recording.data(), nullptr};
+
+    pid_t pid = 0;
+    const auto spawnResult = posix_spawn(&pid, binary.c_str(), &fileActions, nullptr, job.isReplay ? replayArguments.data() : arguments.data(), environ);
+    posix_spawn_file_actions_destroy(&fileActions);
+    if (spawnResult != 0)
+    {
+        return -1;
+    }
+
+    auto status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status))
+    {
+        return -1;
+    }
+
+    return WEXITSTATUS(status);
+}
+
+void runJob(CalibrationJob &job)
+{
+    job.impulseCount = countImpulses(job.recording);
+
+    const auto start = std::chrono::steady_clock::now();
+    job.exitCode = runE2e(job);
+    job.runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    job.strokeCount = countStrokes(job.output);
+}
+
+string escapeJson(const string &text)
+{
+    string escaped;
+    escaped.reserve(text.size());
+    for (const auto character : text)
+    {
+        if (character == '"' || character == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += character;
+    }
+
+    return escaped;
+}
+
+void writeSummary(const fs::path &summaryPath, const vector<CalibrationJob> &jobs, const unsigned int jobCount, const double wallTime)
+{
+    std::ofstream summary(summaryPath);
+    summary << "{\n"
+            << "  \"jobs\": " << jobCount << ",\n"
+            << "  \"wallTime\": " << wallTime << ",\n"
+            << "  \"passed\": " << (std::ranges::all_of(jobs, &CalibrationJob::isPassed) ? "true" : "false") << ",\n"
+            << "  \"recordings\": [\n";
+
+    auto i = 0U;
+    while (i < jobs.size())
+    {
+        const auto &job = jobs[i];
+        summary << "    {\"profile\": \"" << escapeJson(job.profile)
+                << "\", \"file\": \"" << escapeJson(job.recording.filename().string())
+                << "\", \"expectedStrokes\": " << job.expectedStrokeCount
+                << ", \"strokes\": " << job.strokeCount
+                << ", \"passed\": " << (job.isPassed() ? "true" : "false")
+                << ", \"exitCode\": " << job.exitCode
+                << ", \"impulses\": " << job.impulseCount
+                << ", \"runtime\": " << job.runtime
+                << ", \"impulsesPerSecond\": " << (job.runtime > 0 ? static_cast<double>(job.impulseCount) / job.runtime : 0)
+                << "}" << (i + 1U < jobs.size() ? "," : "") << "\n";
+        ++i;
+    }
+
+    summary << "  ]\n"
+            << "}\n";
+}
+
+int main(int argc, const char *argv[])
+{
+    const auto args = std::span(argv + 1, size_t(argc - 1));
+    if (args.size() < 2)
+    {
+        printf("Usage: calibration-runner <calibration directory> <e2e binary directory> [--jobs N] [--summary path] [--replay path]\n");
+
+        return 1;
+    }
+
+    const fs::path calibrationDirectory(args[0]);
+    const fs::path binaryDirectory(args[1]);
+    auto jobCount = std::max(std::thread::hardware_concurrency(), 1U);
+    fs::path summaryPath;
+    fs::path replayBinary;
+
+    auto argIndex = 2U;
+    while (argIndex + 1U < args.size())
+    {
+        const std::string_view option(args[argIndex]);
+        if (option == "--jobs")
+        {
+            jobCount = std::max(static_cast<unsigned int>(std::strtoul(args[argIndex + 1U], nullptr, 10)), 1U);
+        }
+        if (option == "--summary")
+        {
+            summaryPath = args[argIndex + 1U];
+        }
+        if (option == "--replay")
+        {
+            replayBinary = args[argIndex + 1U];
+        }
+        argIndex += 2U;
+    }
+
+    auto jobs = collectJobs(calibrationDirectory, binaryDirectory, replayBinary);
+    if (jobs.empty())
+    {
+        printf("No calibration recordings found in %s\n", calibrationDirectory.c_str());
+
+        return 1;
+    }
+
+    for (const auto &job : jobs)
+    {
+        fs::create_directories(job.output.parent_path());
+    }
+
+    printf("Running %zu recordings on %u threads\n", jobs.size(), jobCount);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextJob = 0;
+    vector<std::jthread> workers;
+    workers.reserve(jobCount);
+    auto i = 0U;
+    while (i < jobCount)
+    {
+        workers.emplace_back([&jobs, &nextJob]()
+                             {
+                                 auto jobIndex = nextJob.fetch_add(1);
+                                 while (jobIndex < jobs.size())
+                                 {
+                                     runJob(jobs[jobIndex]);
+                                     jobIndex = nextJob.fetch_add(1);
+                                 } });
+        ++i;
+    }
+    workers.clear();
+    const auto wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ranges::sort(jobs, [](const CalibrationJob &left, const CalibrationJob &right)
+                      { return left.profile == right.profile ? left.recording.filename() < right.recording.filename() : left.profile < right.profile; });
+
+    auto runtimeSum = 0.0;
+    for (const auto &job : jobs)
+    {
+        runtimeSum += job.runtime;
+        printf("%s %s: %u/%u strokes, %.2f s, %.0f impulses/s %s%s\033[0m\n",
+               job.profile.c_str(),
+               job.recording.filename().c_str(),
+               job.strokeCount,
+               job.expectedStrokeCount,
+               job.runtime,
+               job.runtime > 0 ? static_cast<double>(job.impulseCount) / job.runtime : 0,
+               job.isPassed() ? "\033[32m" : "\033[31m",
+               job.isPassed() ? "PASSED" : (job.exitCode == 0 ? "FAILED" : "FAILED (exit code)"));
+    }
+
+    printf("Wall time %.2f s for %.2f s of runs (%.1fx)\n", wallTime, runtimeSum, wallTime > 0 ? runtimeSum / wallTime : 0);
+
+    if (!summaryPath.empty())
+    {
+        writeSummary(summaryPath, jobs, jobCount, wallTime);
+    }
+
+    return std::ranges::all_of(jobs, &CalibrationJob::isPassed) ? 0 : 1;
+}
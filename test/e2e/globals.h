@@ -1,6 +1,8 @@
 #pragma once
 
+#include "../../src/rower/allocation-tracker.h"
 #include "../../src/rower/flywheel.service.h"
+#include "../../src/rower/pipeline-profiler.h"
 #include "../../src/rower/stroke.controller.h"
 #include "../../src/rower/stroke.service.h"
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <numeric>
 #include <span>
@@ -9,15 +10,28 @@
 
 #include "./test.array.h"
 
-void loop(const unsigned long now)
-{
-    simulateRotation(now);
+#include "../impulse-log/impulse-log.reader.h"
+
+#if defined(ROWER_PROFILE_TABLE)
+    #include "./replay/rower-profile-table.h"
+#endif
+
+// Number of impulses that are queued before the main loop runs (--batch N), more than one simulates a main loop that is busy for several impulses so the controller processes them as one batch
+unsigned short batchSize = 1U;
+unsigned short queuedImpulseCount = 0U;
+// Impulses handed to the delta time logging the same way the main loop does, every processed impulse has to be there regardless of the batch size
+unsigned long loggedImpulseCount = 0UL;
 
-    // Simulate free loop cycle and process 10 points for cyclic error filter
-    for (int i = 0; i < 10; ++i)
+void update()
+{
+    // Simulate free loop cycle and process 10 points for cyclic error filter per queued impulse, so a batch gets as many replay cycles as the impulses fed one by one
+    for (auto i = 0U; i < 10U * queuedImpulseCount; ++i)
     {
         strokeController.update();
+        loggedImpulseCount += strokeController.getLastBatch().size();
     }
+    queuedImpulseCount = 0U;
+
     if (strokeController.getRevCount() != strokeController.getPreviousRevCount())
     {
         Log.infoln("distance: %f", strokeController.getDistance() / 100.0);
@@ -35,11 +49,82 @@ void loop(const unsigned long now)
     }
 }
 
+void loop(const unsigned long now)
+{
+    simulateRotation(now);
+
+    ++queuedImpulseCount;
+    if (queuedImpulseCount >= batchSize)
+    {
+        update();
+    }
+}
+
+// Prints the diagnostics that are compiled in, the exit code is non-zero if an impulse did not reach the delta time logging or the impulse pipeline allocated after the warm-up
+int finish()
+{
+    if (queuedImpulseCount > 0U)
+    {
+        update();
+    }
+
+    if (loggedImpulseCount != strokeController.getRawImpulseCount())
+    {
+        printf("Delta time logging missed impulses: %lu of %lu\n", strokeController.getRawImpulseCount() - loggedImpulseCount, strokeController.getRawImpulseCount());
+
+        return 1;
+    }
+
+    if constexpr (Configurations::isPipelineProfilingEnabled)
+    {
+        printf("%s", pipelineProfiler.summary().c_str());
+    }
+
+    if constexpr (Configurations::isAllocationTrackingEnabled)
+    {
+        printf("%s", allocationTracker.summary().c_str());
+
+        if (allocationTracker.getSteadyState().count > 0U)
+        {
+            printf("Impulse pipeline allocated after the warm-up\n");
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 int main(int argc, const char *argv[])
 {
-    const auto args = std::span(argv + 1, size_t(argc - 1));
+    auto args = std::span(argv + 1, size_t(argc - 1));
     unsigned long now = 0;
 
+#if defined(ROWER_PROFILE_TABLE)
+    if (args.size() > 1 && args[0] == std::string("--profile"))
+    {
+        if (!selectRowerProfile(args[1]))
+        {
+            printf("Unknown rower profile: %s, available profiles:", args[1]);
+            for (const auto &profile : getRowerProfileTable())
+            {
+                printf(" %.*s", static_cast<int>(profile.name.size()), profile.name.data());
+            }
+            printf("\n");
+
+            return 1;
+        }
+
+        args = args.subspan(2);
+    }
+#endif
+
+    if (args.size() > 1 && args[0] == std::string("--batch"))
+    {
+        batchSize = static_cast<unsigned short>(std::clamp(std::stoul(args[1]), 1UL, static_cast<unsigned long>(Configurations::impulseQueueCapacity)));
+        args = args.subspan(2);
+    }
+
     if (args.empty())
     {
         for (const auto &deltaTime : testDeltaTimes)
@@ -48,7 +133,7 @@ int main(int argc, const char *argv[])
             loop(now);
         }
 
-        return 0;
+        return finish();
     }
 
     if (args[0] == std::string("simulate"))
@@ -83,18 +168,44 @@ int main(int argc, const char *argv[])
             }
         }
 
-        return 0;
+        return finish();
     }
 
     unsigned long deltaTime = 0;
 
-    std::ifstream deltaTimeStream(args[0]);
     printf("Running external file: %s\n", args[0]);
+    if (ImpulseLogReader::isImpulseLog(args[0]))
+    {
+        ImpulseLogReader impulseLog(args[0]);
+        if (!impulseLog.isOpen())
+        {
+            printf("Invalid impulse log header\n");
+
+            return 1;
+        }
+
+        while (impulseLog.next(deltaTime))
+        {
+            now += deltaTime;
+            loop(now);
+        }
+
+        if (impulseLog.isCorrupt())
+        {
+            printf("Impulse log is corrupt, stopped at the first invalid block\n");
+
+            return 1;
+        }
+
+        return finish();
+    }
+
+    std::ifstream deltaTimeStream(args[0]);
     while (deltaTimeStream >> deltaTime)
     {
         now += deltaTime;
         loop(now);
     }
 
-    return 0;
+    return finish();
 }
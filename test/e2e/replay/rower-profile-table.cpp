@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <span>
+#include <string_view>
+
+#include "fakeit.hpp"
+
+#include "./rower-profile-table.h"
+
+#include "../../../src/utils/EEPROM/EEPROM.service.interface.h"
+#include "../../../src/utils/enums.h"
+#include "../../../src/utils/macros.h"
+#include "../globals.h"
+
+using namespace fakeit;
+
+extern Mock<IEEPROMService> mockEEPROMService;
+
+namespace
+{
+    // Every rower profile header is included one after the other by the generated file, each adding its entry to the table. As this undefines the macros of the rower profile the binary was compiled with, nothing below may use them
+    const std::array rowerProfileTable{
+#include "rower-profile-table.generated.h"
+    };
+}
+
+std::span<const RowerProfileTableEntry> getRowerProfileTable()
+{
+    return rowerProfileTable;
+}
+
+const RowerProfileTableEntry *findRowerProfile(const std::string_view name)
+{
+    const auto *const profile = std::ranges::find(rowerProfileTable, name, &RowerProfileTableEntry::name);
+
+    return profile == rowerProfileTable.end() ? nullptr : profile;
+}
+
+bool selectRowerProfile(const std::string_view name)
+{
+    const auto *const profile = findRowerProfile(name);
+    if (profile == nullptr)
+    {
+        return false;
+    }
+
+    When(Method(mockEEPROMService, getMachineSettings)).AlwaysReturn(profile->machineSettings);
+    When(Method(mockEEPROMService, getSensorSignalSettings)).AlwaysReturn(profile->sensorSignalSettings);
+    When(Method(mockEEPROMService, getDragFactorSettings)).AlwaysReturn(profile->dragFactorSettings);
+    When(Method(mockEEPROMService, getStrokePhaseDetectionSettings)).AlwaysReturn(profile->strokePhaseDetectionSettings);
+
+    strokeController.begin();
+
+    return true;
+}
@@ -0,0 +1,76 @@
+// No include guard on purpose: this is included once for every rower profile of the table (see rower-profile-table.generated.h), right after the profile header defined its macros. It adds the table entry of the profile then undefines the macros so the next profile header can define them again
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+
+// Defaults that macros.h applies to the compiled-in profile only
+#if !defined(CYCLIC_ERROR_AGGRESSIVENESS)
+    #define CYCLIC_ERROR_AGGRESSIVENESS 1
+#endif
+#if !defined(DRIVE_HANDLE_FORCES_MAX_CAPACITY)
+    #define DRIVE_HANDLE_FORCES_MAX_CAPACITY UCHAR_MAX
+#endif
+
+// Same conversions as RowerProfile::Defaults
+RowerProfileTableEntry{
+    .name = TOSTRING(ROWER_PROFILE_NAME),
+    .machineSettings = {
+        .impulsesPerRevolution = IMPULSES_PER_REVOLUTION,
+        .flywheelInertia = FLYWHEEL_INERTIA,
+        .concept2MagicNumber = CONCEPT_2_MAGIC_NUMBER,
+        .sprocketRadius = SPROCKET_RADIUS / 100.0F,
+    },
+    .sensorSignalSettings = {
+        .rotationDebounceTimeMin = ROTATION_DEBOUNCE_TIME_MIN * 1'000,
+        .rowingStoppedThresholdPeriod = ROWING_STOPPED_THRESHOLD_PERIOD * 1'000,
+        .cyclicErrorAggressiveness = IMPULSES_PER_REVOLUTION < 3 ? 0.0F : CYCLIC_ERROR_AGGRESSIVENESS,
+    },
+    .dragFactorSettings = {
+        .goodnessOfFitThreshold = GOODNESS_OF_FIT_THRESHOLD,
+        .maxDragFactorRecoveryPeriod = MAX_DRAG_FACTOR_RECOVERY_PERIOD * 1'000,
+        .lowerDragFactorThreshold = static_cast<float>(LOWER_DRAG_FACTOR_THRESHOLD) / 1e6F,
+        .upperDragFactorThreshold = static_cast<float>(UPPER_DRAG_FACTOR_THRESHOLD) / 1e6F,
+        .dragCoefficientsArrayLength = DRAG_COEFFICIENTS_ARRAY_LENGTH,
+    },
+    .strokePhaseDetectionSettings = {
+        .strokeDetectionType = static_cast<StrokeDetectionType>(STROKE_DETECTION_TYPE),
+        .minimumPoweredTorque = MINIMUM_POWERED_TORQUE,
+        .minimumDragTorque = MINIMUM_DRAG_TORQUE,
+        .minimumRecoverySlope = MINIMUM_RECOVERY_SLOPE,
+        .minimumRecoveryTime = MINIMUM_RECOVERY_TIME * 1'000,
+        .minimumDriveTime = MINIMUM_DRIVE_TIME * 1'000,
+        .impulseDataArrayLength = IMPULSE_DATA_ARRAY_LENGTH,
+        .driveHandleForcesMaxCapacity = DRIVE_HANDLE_FORCES_MAX_CAPACITY,
+    },
+},
+
+// Every macro that any of the rower profiles defines
+#undef ROWER_PROFILE_NAME
+#undef ENABLE_RUNTIME_SETTINGS
+#undef DEVICE_NAME
+#undef MODEL_NUMBER
+#undef SERIAL_NUMBER
+#undef ADD_BLE_SERVICE_TO_DEVICE_NAME
+#undef ADD_SERIAL_TO_DEVICE_NAME
+#undef MIN_BLE_UPDATE_INTERVAL
+#undef IMPULSES_PER_REVOLUTION
+#undef FLYWHEEL_INERTIA
+#undef SPROCKET_RADIUS
+#undef CONCEPT_2_MAGIC_NUMBER
+#undef ENABLE_DEBOUNCE_FILTER
+#undef ROTATION_DEBOUNCE_TIME_MIN
+#undef ROWING_STOPPED_THRESHOLD_PERIOD
+#undef CYCLIC_ERROR_AGGRESSIVENESS
+#undef GOODNESS_OF_FIT_THRESHOLD
+#undef MAX_DRAG_FACTOR_RECOVERY_PERIOD
+#undef LOWER_DRAG_FACTOR_THRESHOLD
+#undef UPPER_DRAG_FACTOR_THRESHOLD
+#undef DRAG_COEFFICIENTS_ARRAY_LENGTH
+#undef MINIMUM_POWERED_TORQUE
+#undef MINIMUM_DRAG_TORQUE
+#undef STROKE_DETECTION_TYPE
+#undef MINIMUM_RECOVERY_SLOPE
+#undef MINIMUM_RECOVERY_TIME
+#undef MINIMUM_DRIVE_TIME
+#undef IMPULSE_DATA_ARRAY_LENGTH
+#undef DRIVE_HANDLE_FORCES_MAX_CAPACITY
+
+// NOLINTEND(cppcoreguidelines-macro-usage)
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+
+#include "../../../src/utils/settings.model.h"
+
+// Settings of a rower profile as they would come from the EEPROM with runtime settings enabled, so the replay binary can run a recording with any profile without being rebuilt for it
+struct RowerProfileTableEntry
+{
+    std::string_view name;
+    RowerProfile::MachineSettings machineSettings;
+    RowerProfile::SensorSignalSettings sensorSignalSettings;
+    RowerProfile::DragFactorSettings dragFactorSettings;
+    RowerProfile::StrokePhaseDetectionSettings strokePhaseDetectionSettings;
+};
+
+std::span<const RowerProfileTableEntry> getRowerProfileTable();
+const RowerProfileTableEntry *findRowerProfile(std::string_view name);
+
+// Sets up the flywheel and stroke services with the settings of the profile (through the same path as the EEPROM settings on the device), returns false if there is no such profile
+bool selectRowerProfile(std::string_view name);
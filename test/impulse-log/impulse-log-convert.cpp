@@ -0,0 +1,384 @@
+// Converts impulse recordings between the text format (one delta time per line) and the binary impulse log format, and prints the details of a binary log. Usage:
+// impulse-log-convert to-binary <text input> <binary output> [--profile name] [--impulses-per-revolution N] [--strokes N]
+// impulse-log-convert to-text <binary input> <text output>
+// impulse-log-convert info <binary input>
+// impulse-log-convert ble-stream <text or binary input> [--mtu N]
+// impulse-log-convert decode-ble <notification capture> <text output>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "./impulse-log.reader.h"
+
+#include "../../src/utils/impulse-log/delta-time-stream.h"
+#include "../../src/utils/impulse-log/impulse-log.h"
+
+namespace fs = std::filesystem;
+
+void writeBlock(std::ofstream &output, const ImpulseLog::Block &block)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    output.write(reinterpret_cast<const char *>(block.data()), block.size());
+}
+
+int toBinary(const fs::path &inputPath, const fs::path &outputPath, const std::span<const char *> options)
+{
+    ImpulseLog::FileHeader header;
+
+    auto argIndex = 0U;
+    while (argIndex + 1U < options.size())
+    {
+        const std::string_view option(options[argIndex]);
+        if (option == "--profile")
+        {
+            header.setProfile(options[argIndex + 1U]);
+        }
+        if (option == "--impulses-per-revolution")
+        {
+            header.impulsesPerRevolution = static_cast<unsigned short>(std::strtoul(options[argIndex + 1U], nullptr, 10));
+        }
+        if (option == "--strokes")
+        {
+            header.expectedStrokeCount = static_cast<unsigned int>(std::strtoul(options[argIndex + 1U], nullptr, 10));
+        }
+        argIndex += 2U;
+    }
+
+    std::ifstream input(inputPath);
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!input || !output)
+    {
+        printf("Could not open %s or %s\n", inputPath.c_str(), outputPath.c_str());
+
+        return 1;
+    }
+
+    header.logId = std::random_device{}();
+
+    ImpulseLog::Block headerBlock{};
+    ImpulseLog::writeFileHeader(header, headerBlock);
+    writeBlock(output, headerBlock);
+
+    ImpulseLogEncoder encoder;
+    encoder.begin(header.logId);
+    auto impulseCount = 0UL;
+    unsigned long deltaTime = 0;
+    while (input >> deltaTime)
+    {
+        if (!encoder.push(deltaTime))
+        {
+            writeBlock(output, encoder.seal());
+            encoder.reset();
+            encoder.push(deltaTime);
+        }
+        ++impulseCount;
+    }
+    if (!encoder.empty())
+    {
+        writeBlock(output, encoder.seal());
+    }
+    output.close();
+
+    const auto inputSize = fs::file_size(inputPath);
+    const auto outputSize = fs::file_size(outputPath);
+    printf("%lu impulses, %ju -> %ju bytes (%.1fx smaller)\n", impulseCount, static_cast<uintmax_t>(inputSize), static_cast<uintmax_t>(outputSize), outputSize > 0 ? static_cast<double>(inputSize) / static_cast<double>(outputSize) : 0);
+
+    return 0;
+}
+
+int toText(const fs::path &inputPath, const fs::path &outputPath)
+{
+    ImpulseLogReader reader(inputPath);
+    std::ofstream output(outputPath, std::ios::trunc);
+    if (!reader.isOpen() || !output)
+    {
+        printf("Could not open %s as an impulse log or %s for writing\n", inputPath.c_str(), outputPath.c_str());
+
+        return 1;
+    }
+
+    unsigned long deltaTime = 0;
+    while (reader.next(deltaTime))
+    {
+        output << deltaTime << '\n';
+    }
+
+    if (reader.isCorrupt())
+    {
+        printf("Impulse log is corrupt, converted up to the first invalid block\n");
+
+        return 1;
+    }
+
+    return 0;
+}
+
+int info(const fs::path &inputPath)
+{
+    ImpulseLogReader reader(inputPath);
+    if (!reader.isOpen())
+    {
+        printf("Could not open %s as an impulse log\n", inputPath.c_str());
+
+        return 1;
+    }
+
+    const auto &header = reader.header();
+    printf("Version: %u\nLog ID: %08X\nProfile: %.*s\nImpulses per revolution: %u\nExpected strokes: %u\n",
+           header.version,
+           header.logId,
+           static_cast<int>(header.profile().size()),
+           header.profile().data(),
+           header.impulsesPerRevolution,
+           header.expectedStrokeCount);
+
+    // Decoding every delta time (with checksum validation) shows the load speed of the format
+    const auto start = std::chrono::steady_clock::now();
+    auto impulseCount = 0UL;
+    auto totalTime = 0ULL;
+    unsigned long deltaTime = 0;
+    while (reader.next(deltaTime))
+    {
+        totalTime += deltaTime;
+        ++impulseCount;
+    }
+    const auto runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto fileSize = fs::file_size(inputPath);
+    printf("Impulses: %lu (%.2f bytes per impulse)\nDuration: %.1f s\nDecoded in %.2f ms (%.0f MB/s, %.0f M impulses/s)\n",
+           impulseCount,
+           impulseCount > 0 ? static_cast<double>(fileSize) / static_cast<double>(impulseCount) : 0,
+           static_cast<double>(totalTime) / 1e6,
+           runtime * 1e3,
+           runtime > 0 ? static_cast<double>(fileSize) / runtime / 1e6 : 0,
+           runtime > 0 ? static_cast<double>(impulseCount) / runtime / 1e6 : 0);
+
+    if (reader.isCorrupt())
+    {
+        printf("Impulse log is corrupt, stopped at the first invalid block\n");
+
+        return 1;
+    }
+
+    return 0;
+}
+
+// Calls the callback with every delta time of a recording in either format
+bool readRecording(const fs::path &inputPath, const std::function<void(unsigned long)> &callback)
+{
+    unsigned long deltaTime = 0;
+    if (ImpulseLogReader::isImpulseLog(inputPath))
+    {
+        ImpulseLogReader reader(inputPath);
+        if (!reader.isOpen())
+        {
+            return false;
+        }
+        while (reader.next(deltaTime))
+        {
+            callback(deltaTime);
+        }
+
+        return !reader.isCorrupt();
+    }
+
+    std::ifstream input(inputPath);
+    if (!input)
+    {
+        return false;
+    }
+    while (input >> deltaTime)
+    {
+        callback(deltaTime);
+    }
+
+    return true;
+}
+
+// Sends a recording through the delta time notifications the same way the BluetoothController does (flushing once the next delta time might not fit the MTU) in both encodings, decodes the compressed notifications and reports how many impulses fit into one notification
+int bleStream(const fs::path &inputPath, const std::span<const char *> options)
+{
+    unsigned short mtu = 247U;
+    if (options.size() >= 2 && std::string_view(options[0]) == "--mtu")
+    {
+        mtu = static_cast<unsigned short>(std::strtoul(options[1], nullptr, 10));
+    }
+    const auto minimumMtu = 100U;
+    const auto maximumMtu = static_cast<unsigned int>(DeltaTimeStream::maxPacketSize + 3U);
+    if (mtu < minimumMtu || mtu > maximumMtu)
+    {
+        printf("MTU should be between %u and %u\n", minimumMtu, maximumMtu);
+
+        return 1;
+    }
+    const auto payloadSize = mtu - 3U;
+
+    std::vector<unsigned long> deltaTimes;
+    if (!readRecording(inputPath, [&deltaTimes](const unsigned long deltaTime)
+                       { deltaTimes.push_back(deltaTime); }))
+    {
+        printf("Could not read %s\n", inputPath.c_str());
+
+        return 1;
+    }
+
+    const auto rawDeltaTimeSize = 4U;
+    auto rawNotifications = 0UL;
+    auto rawCount = 0U;
+    for ([[maybe_unused]] const auto deltaTime : deltaTimes)
+    {
+        ++rawCount;
+        if ((rawCount + 1U) * rawDeltaTimeSize > payloadSize)
+        {
+            ++rawNotifications;
+            rawCount = 0;
+        }
+    }
+    rawNotifications += rawCount > 0 ? 1 : 0;
+
+    DeltaTimeStreamEncoder encoder;
+    DeltaTimeStreamDecoder decoder;
+    std::vector<unsigned long> decoded;
+    decoded.reserve(deltaTimes.size());
+    auto notifications = 0UL;
+    auto bytes = 0ULL;
+    const auto send = [&]()
+    {
+        decoder.open(encoder.data());
+        unsigned long deltaTime = 0;
+        while (decoder.next(deltaTime))
+        {
+            decoded.push_back(deltaTime);
+        }
+        bytes += encoder.data().size();
+        ++notifications;
+        encoder.next();
+    };
+    for (const auto deltaTime : deltaTimes)
+    {
+        encoder.push(deltaTime);
+        if (encoder.data().size() + ImpulseLog::maxVarintLength > payloadSize)
+        {
+            send();
+        }
+    }
+    if (!encoder.empty())
+    {
+        send();
+    }
+
+    const auto impulseCount = static_cast<double>(deltaTimes.size());
+    printf("Impulses: %zu, MTU: %u\n", deltaTimes.size(), mtu);
+    printf("Raw: %lu notifications (%.1f impulses per notification)\n", rawNotifications, rawNotifications > 0 ? impulseCount / static_cast<double>(rawNotifications) : 0);
+    printf("Varint: %lu notifications (%.1f impulses per notification, %.2f bytes per impulse)\n", notifications, notifications > 0 ? impulseCount / static_cast<double>(notifications) : 0, impulseCount > 0 ? static_cast<double>(bytes) / impulseCount : 0);
+    printf("Lost notifications: %u, round trip %s\n", decoder.getLostPacketCount(), decoded == deltaTimes ? "ok" : "FAILED");
+
+    return decoded == deltaTimes ? 0 : 1;
+}
+
+// Decodes the compressed delta time notifications captured from the device (one notification per line as hex, e.g. copied from a BLE sniffer or client log) into the text format
+int decodeBle(const fs::path &inputPath, const fs::path &outputPath)
+{
+    std::ifstream input(inputPath);
+    std::ofstream output(outputPath, std::ios::trunc);
+    if (!input || !output)
+    {
+        printf("Could not open %s or %s\n", inputPath.c_str(), outputPath.c_str());
+
+        return 1;
+    }
+
+    DeltaTimeStreamDecoder decoder;
+    std::vector<unsigned char> packet;
+    auto notifications = 0UL;
+    auto impulseCount = 0UL;
+    auto invalidCount = 0UL;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        packet.clear();
+        std::string digits;
+        for (const auto character : line)
+        {
+            if (std::isxdigit(static_cast<unsigned char>(character)) != 0)
+            {
+                digits.push_back(character);
+            }
+        }
+        if (digits.empty())
+        {
+            continue;
+        }
+
+        auto position = 0U;
+        while (position + 1U < digits.size())
+        {
+            packet.push_back(static_cast<unsigned char>(std::stoul(digits.substr(position, 2), nullptr, 16)));
+            position += 2U;
+        }
+
+        if (!decoder.open(packet))
+        {
+            ++invalidCount;
+
+            continue;
+        }
+
+        unsigned long deltaTime = 0;
+        while (decoder.next(deltaTime))
+        {
+            output << deltaTime << '\n';
+            ++impulseCount;
+        }
+        ++notifications;
+    }
+
+    printf("%lu notifications, %lu impulses, %u lost and %lu invalid notifications\n", notifications, impulseCount, decoder.getLostPacketCount(), invalidCount);
+
+    return invalidCount == 0 ? 0 : 1;
+}
+
+int main(int argc, const char *argv[])
+{
+    const auto args = std::span(argv + 1, size_t(argc - 1));
+    const std::string_view command = args.empty() ? "" : args[0];
+
+    if (command == "to-binary" && args.size() >= 3)
+    {
+        return toBinary(args[1], args[2], args.subspan(3));
+    }
+    if (command == "to-text" && args.size() >= 3)
+    {
+        return toText(args[1], args[2]);
+    }
+    if (command == "info" && args.size() >= 2)
+    {
+        return info(args[1]);
+    }
+    if (command == "ble-stream" && args.size() >= 2)
+    {
+        return bleStream(args[1], args.subspan(2));
+    }
+    if (command == "decode-ble" && args.size() >= 3)
+    {
+        return decodeBle(args[1], args[2]);
+    }
+
+    printf("Usage:\n"
+           "impulse-log-convert to-binary <text input> <binary output> [--profile name] [--impulses-per-revolution N] [--strokes N]\n"
+           "impulse-log-convert to-text <binary input> <text output>\n"
+           "impulse-log-convert info <binary input>\n"
+           "impulse-log-convert ble-stream <text or binary input> [--mtu N]\n"
+           "impulse-log-convert decode-ble <notification capture> <text output>\n");
+
+    return 1;
+}
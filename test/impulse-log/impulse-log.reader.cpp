@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <span>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "./impulse-log.reader.h"
+
+ImpulseLogReader::ImpulseLogReader(const std::filesystem::path &path)
+{
+    const auto fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        return;
+    }
+
+    std::error_code error;
+    fileSize = std::filesystem::file_size(path, error);
+    if (!error && fileSize >= ImpulseLog::blockSize)
+    {
+        auto *const mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping != MAP_FAILED)
+        {
+            madvise(mapping, fileSize, MADV_SEQUENTIAL);
+            data = static_cast<const unsigned char *>(mapping);
+        }
+    }
+    // The mapping stays valid after the file is closed
+    close(fileDescriptor);
+
+    if (data == nullptr)
+    {
+        return;
+    }
+
+    isValid = ImpulseLog::readFileHeader(mapped(), fileHeader);
+    blockOffset = ImpulseLog::blockSize;
+}
+
+ImpulseLogReader::~ImpulseLogReader()
+{
+    if (data != nullptr)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        munmap(const_cast<unsigned char *>(data), fileSize);
+    }
+}
+
+bool ImpulseLogReader::isImpulseLog(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, ImpulseLog::magic.size()> magic{};
+    file.read(magic.data(), magic.size());
+
+    return file.gcount() == static_cast<std::streamsize>(magic.size()) && std::ranges::equal(magic, ImpulseLog::magic, [](const char left, const unsigned char right)
+                                                                                              { return static_cast<unsigned char>(left) == right; });
+}
+
+std::span<const unsigned char> ImpulseLogReader::mapped() const
+{
+    return {data, fileSize};
+}
+
+bool ImpulseLogReader::isOpen() const
+{
+    return isValid;
+}
+
+bool ImpulseLogReader::isCorrupt() const
+{
+    return isCorrupted;
+}
+
+const ImpulseLog::FileHeader &ImpulseLogReader::header() const
+{
+    return fileHeader;
+}
+
+unsigned long ImpulseLogReader::impulseCount() const
+{
+    auto count = 0UL;
+    if (!isValid)
+    {
+        return count;
+    }
+
+    auto offset = ImpulseLog::blockSize;
+    auto sequence = 0U;
+    while (offset + ImpulseLog::blockSize <= fileSize)
+    {
+        const auto block = mapped().subspan(offset).first<ImpulseLog::blockSize>();
+        const auto blockImpulseCount = ImpulseLogDecoder::impulseCount(block);
+        if (blockImpulseCount == 0 || !ImpulseLogDecoder::isPartOf(block, fileHeader.logId, sequence))
+        {
+            break;
+        }
+        count += blockImpulseCount;
+        offset += ImpulseLog::blockSize;
+        ++sequence;
+    }
+
+    return count;
+}
+
+bool ImpulseLogReader::openNextBlock()
+{
+    if (!isValid || isCorrupted || blockOffset + ImpulseLog::blockSize > fileSize)
+    {
+        return false;
+    }
+
+    const auto block = mapped().subspan(blockOffset).first<ImpulseLog::blockSize>();
+    if (ImpulseLogDecoder::impulseCount(block) == 0 || !ImpulseLogDecoder::isPartOf(block, fileHeader.logId, blockSequence))
+    {
+        return false;
+    }
+
+    blockOffset += ImpulseLog::blockSize;
+    ++blockSequence;
+    if (!decoder.open(block))
+    {
+        isCorrupted = true;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool ImpulseLogReader::next(unsigned long &deltaTime)
+{
+    while (!decoder.next(deltaTime))
+    {
+        if (!openNextBlock())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
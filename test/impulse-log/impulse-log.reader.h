@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+#include "../../src/utils/impulse-log/impulse-log.h"
+
+// Streams the delta times of a binary impulse log (see src/utils/impulse-log/impulse-log.h) straight from a read only memory mapping of the file, so nothing is copied or parsed up front and the kernel can read ahead
+class ImpulseLogReader
+{
+    const unsigned char *data = nullptr;
+    size_t fileSize = 0;
+    size_t blockOffset = 0;
+    unsigned int blockSequence = 0;
+    bool isValid = false;
+    bool isCorrupted = false;
+    ImpulseLog::FileHeader fileHeader;
+    ImpulseLogDecoder decoder;
+
+    [[nodiscard]] std::span<const unsigned char> mapped() const;
+    bool openNextBlock();
+
+public:
+    explicit ImpulseLogReader(const std::filesystem::path &path);
+    ~ImpulseLogReader();
+
+    ImpulseLogReader(const ImpulseLogReader &) = delete;
+    ImpulseLogReader &operator=(const ImpulseLogReader &) = delete;
+    ImpulseLogReader(ImpulseLogReader &&) = delete;
+    ImpulseLogReader &operator=(ImpulseLogReader &&) = delete;
+
+    // Checks only the magic at the start of the file, so text recordings can be told apart without mapping them
+    static bool isImpulseLog(const std::filesystem::path &path);
+
+    // False if the file could not be mapped or its header is invalid
+    [[nodiscard]] bool isOpen() const;
+    // True if reading stopped at a block of this log with a wrong checksum (a block of another log or out of sequence ends the log)
+    [[nodiscard]] bool isCorrupt() const;
+    [[nodiscard]] const ImpulseLog::FileHeader &header() const;
+    // Sum of the impulse counts of the block headers (without decoding or validating the blocks)
+    [[nodiscard]] unsigned long impulseCount() const;
+
+    bool next(unsigned long &deltaTime);
+};
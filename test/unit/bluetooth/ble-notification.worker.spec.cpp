@@ -0,0 +1,438 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "fakeit.hpp"
+
+#include "../include/Arduino.h"
+#include "../include/NimBLEDevice.h"
+
+#include "../../../src/peripherals/bluetooth/ble-notification.worker.h"
+#include "../../../src/utils/configuration.h"
+
+using namespace fakeit;
+using std::vector;
+
+using NotificationType = BleNotificationWorker::NotificationType;
+
+TEST_CASE("BleNotificationWorker", "[peripheral]")
+{
+    mockArduino.Reset();
+
+    Mock<NimBLECharacteristic> mockMetricsCharacteristic;
+    Mock<NimBLECharacteristic> mockChunkCharacteristic;
+
+    vector<vector<std::byte>> sentMetrics;
+    vector<vector<std::byte>> sentChunks;
+    When(OverloadedMethod(mockMetricsCharacteristic, setValue, void(const std::span<const std::byte>))).AlwaysDo([&sentMetrics](const std::span<const std::byte> data)
+                                                                                                                 { sentMetrics.emplace_back(data.begin(), data.end()); });
+    When(OverloadedMethod(mockChunkCharacteristic, setValue, void(const std::span<const std::byte>))).AlwaysDo([&sentChunks](const std::span<const std::byte> data)
+                                                                                                               { sentChunks.emplace_back(data.begin(), data.end()); });
+    Fake(Method(mockMetricsCharacteristic, notify));
+    Fake(Method(mockChunkCharacteristic, notify));
+
+    BleNotificationWorker notificationWorker;
+
+    std::array<std::byte, 4> payload{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}};
+
+    SECTION("begin method should start one notification task pinned to core 0")
+    {
+        Fake(Method(mockArduino, xTaskCreatePinnedToCore));
+        Fake(Method(mockArduino, vTaskDelete));
+        When(Method(mockArduino, ulTaskNotifyTake)).Return(1, 0);
+
+        REQUIRE(notificationWorker.begin());
+
+        Verify(Method(mockArduino, xTaskCreatePinnedToCore).Using(Ne(nullptr), StrEq("notifyClients"), Any(), Ne(nullptr), Eq(1U), Ne(nullptr), Eq(0))).Once();
+        Verify(Method(mockArduino, ulTaskNotifyTake).Using(pdTRUE, portMAX_DELAY)).Twice();
+    }
+
+    SECTION("begin method should wake the task up for the next connection event while notifications are waiting for one")
+    {
+        When(Method(mockArduino, xTaskCreatePinnedToCore)).Return(pdPASS);
+        Fake(Method(mockArduino, vTaskDelete));
+        When(Method(mockArduino, ulTaskNotifyTake)).Return(1, 0, 0);
+        When(Method(mockArduino, micros)).Return(0, 30'000);
+        const std::array<std::byte, 0> header{};
+
+        notificationWorker.updateConnection(1, 24);
+        auto i = 0U;
+        while (i < 6)
+        {
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 1, header, payload);
+            ++i;
+        }
+
+        REQUIRE(notificationWorker.begin());
+
+        REQUIRE(sentChunks.size() == 6);
+        Verify(Method(mockArduino, ulTaskNotifyTake).Using(pdTRUE, portMAX_DELAY), Method(mockArduino, ulTaskNotifyTake).Using(pdTRUE, 30U), Method(mockArduino, ulTaskNotifyTake).Using(pdTRUE, portMAX_DELAY)).Once();
+    }
+
+    SECTION("enqueue method should")
+    {
+        SECTION("queue the notification without sending it")
+        {
+            REQUIRE(notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), payload));
+
+            REQUIRE(notificationWorker.getQueueDepth() == 1);
+            Verify(Method(mockChunkCharacteristic, notify)).Never();
+        }
+
+        SECTION("drop notifications that are longer than the max payload")
+        {
+            const std::array<std::byte, BleNotificationLimits::maxPayloadLength + 1> longPayload{};
+
+            REQUIRE_FALSE(notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), longPayload));
+            REQUIRE(notificationWorker.getDroppedCount() == 1);
+        }
+
+        SECTION("drop notifications when the queue is full")
+        {
+            auto i = 0U;
+            while (i < Configurations::bleNotificationQueueCapacity)
+            {
+                REQUIRE(notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload));
+                ++i;
+            }
+
+            REQUIRE_FALSE(notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload));
+            REQUIRE(notificationWorker.getDroppedCount() == 1);
+        }
+
+        SECTION("drop notifications when the payload buffer is full and accept them again once sent")
+        {
+            const std::array<std::byte, BleNotificationLimits::maxPayloadLength> longPayload{};
+            const auto fittingCount = Configurations::bleNotificationBufferSize / BleNotificationLimits::maxPayloadLength;
+
+            auto i = 0U;
+            while (i < fittingCount)
+            {
+                REQUIRE(notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), longPayload));
+                ++i;
+            }
+
+            REQUIRE_FALSE(notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), longPayload));
+
+            notificationWorker.processPending();
+
+            REQUIRE(notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), longPayload));
+            REQUIRE(notificationWorker.getDroppedCount() == 1);
+        }
+
+        SECTION("wake up the notification task once it is started")
+        {
+            When(Method(mockArduino, xTaskCreatePinnedToCore)).Do([](TaskFunction_t, const char *, const unsigned int, void *, UBaseType_t, TaskHandle_t *const pvCreatedTask, const BaseType_t)
+                                                                   {
+                                                                       static int task = 0;
+                                                                       *pvCreatedTask = &task;
+
+                                                                       return pdPASS; });
+            When(Method(mockArduino, ulTaskNotifyTake)).Return(0);
+            Fake(Method(mockArduino, vTaskDelete));
+            Fake(Method(mockArduino, xTaskNotifyGive));
+            notificationWorker.begin();
+
+            notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), payload);
+
+            Verify(Method(mockArduino, xTaskNotifyGive).Using(Ne(nullptr))).Once();
+        }
+    }
+
+    SECTION("reserveBursts method should")
+    {
+        const auto curveByteCount = Configurations::driveHandleForcesCapacity * sizeof(float);
+
+        SECTION("fit the longest handle force curve for every connection")
+        {
+            auto i = 0U;
+            while (i < Configurations::maxConnectionCount)
+            {
+                REQUIRE(notificationWorker.reserveBursts(Configurations::bleMaxHandleForcesChunkCount, curveByteCount));
+
+                auto chunk = 0U;
+                while (chunk < Configurations::bleMaxHandleForcesChunkCount)
+                {
+                    REQUIRE(notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload));
+                    ++chunk;
+                }
+                ++i;
+            }
+
+            REQUIRE(notificationWorker.getDroppedCount() == 0);
+        }
+
+        SECTION("count every notification that does not fit as dropped")
+        {
+            auto i = 0U;
+            while (i < Configurations::bleNotificationQueueCapacity - 1U)
+            {
+                notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), payload);
+                ++i;
+            }
+
+            REQUIRE(notificationWorker.reserveBursts(1, payload.size()));
+            REQUIRE_FALSE(notificationWorker.reserveBursts(2, 2 * payload.size()));
+            REQUIRE(notificationWorker.getDroppedCount() == 2);
+        }
+
+        SECTION("not fit more bytes than the payload buffer can take")
+        {
+            REQUIRE_FALSE(notificationWorker.reserveBursts(1, Configurations::bleNotificationBufferSize));
+        }
+    }
+
+    SECTION("processPending method should")
+    {
+        SECTION("send the header and the payload in one notification")
+        {
+            const std::array<std::byte, 2> header{std::byte{3}, std::byte{1}};
+
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), header, payload);
+            notificationWorker.processPending();
+
+            REQUIRE(sentChunks == vector<vector<std::byte>>{{std::byte{3}, std::byte{1}, std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}}});
+            Verify(Method(mockChunkCharacteristic, notify)).Once();
+            REQUIRE(notificationWorker.getQueueDepth() == 0);
+        }
+
+        SECTION("send chunked notifications in order")
+        {
+            auto i = 0U;
+            while (i < 5)
+            {
+                payload[0] = static_cast<std::byte>(i);
+                notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+                ++i;
+            }
+            notificationWorker.processPending();
+
+            REQUIRE(sentChunks.size() == 5);
+            i = 0U;
+            while (i < 5)
+            {
+                REQUIRE(sentChunks[i][0] == static_cast<std::byte>(i));
+                ++i;
+            }
+            REQUIRE(notificationWorker.getCoalescedCount() == 0);
+        }
+
+        SECTION("only send the latest of the metrics snapshots waiting in the queue")
+        {
+            payload[0] = std::byte{1};
+            notificationWorker.enqueue(NotificationType::BaseMetrics, &mockMetricsCharacteristic.get(), payload);
+            notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), payload);
+            payload[0] = std::byte{2};
+            notificationWorker.enqueue(NotificationType::BaseMetrics, &mockMetricsCharacteristic.get(), payload);
+
+            notificationWorker.processPending();
+
+            REQUIRE(sentMetrics.size() == 1);
+            REQUIRE(sentMetrics[0][0] == std::byte{2});
+            REQUIRE(sentChunks.size() == 1);
+            REQUIRE(notificationWorker.getCoalescedCount() == 1);
+        }
+
+        SECTION("notify every subscribed client unless a connection is given")
+        {
+            const std::array<std::byte, 0> header{};
+
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 2, header, payload);
+            notificationWorker.processPending();
+
+            Verify(Method(mockChunkCharacteristic, notify).Using(BLE_HS_CONN_HANDLE_NONE), Method(mockChunkCharacteristic, notify).Using(2)).Once();
+        }
+
+        SECTION("not coalesce the metrics snapshots of different connections")
+        {
+            const std::array<std::byte, 0> header{};
+
+            notificationWorker.enqueue(NotificationType::ExtendedMetrics, &mockMetricsCharacteristic.get(), 1, header, payload);
+            notificationWorker.enqueue(NotificationType::ExtendedMetrics, &mockMetricsCharacteristic.get(), 2, header, payload);
+
+            notificationWorker.processPending();
+
+            REQUIRE(sentMetrics.size() == 2);
+            REQUIRE(notificationWorker.getCoalescedCount() == 0);
+        }
+
+        SECTION("keep payloads intact when the payload buffer wraps around")
+        {
+            std::array<std::byte, 300> longPayload{};
+
+            auto i = 0U;
+            while (i < 50)
+            {
+                longPayload.front() = static_cast<std::byte>(i);
+                longPayload.back() = static_cast<std::byte>(i);
+                REQUIRE(notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), longPayload));
+                notificationWorker.processPending();
+
+                REQUIRE(sentChunks.back().size() == longPayload.size());
+                REQUIRE(sentChunks.back().front() == static_cast<std::byte>(i));
+                REQUIRE(sentChunks.back().back() == static_cast<std::byte>(i));
+                ++i;
+            }
+        }
+
+        SECTION("send the metrics snapshots before the handle forces and delta times queued earlier")
+        {
+            When(Method(mockArduino, micros)).AlwaysReturn(0);
+
+            notificationWorker.updateConnection(1, 24);
+            auto i = 0U;
+            while (i < 6)
+            {
+                notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+                ++i;
+            }
+            notificationWorker.enqueue(NotificationType::BaseMetrics, &mockMetricsCharacteristic.get(), payload);
+
+            notificationWorker.processPending();
+
+            REQUIRE(sentMetrics.size() == 1);
+            REQUIRE(sentChunks.size() == Configurations::blePacketsPerConnectionEvent - 2U);
+            Verify(Method(mockMetricsCharacteristic, notify), Method(mockChunkCharacteristic, notify)).Once();
+        }
+
+        SECTION("not hand more notifications to the stack than fit into the connection event of the client")
+        {
+            When(Method(mockArduino, micros)).Return(0, 10'000, 30'000);
+            const std::array<std::byte, 0> header{};
+
+            notificationWorker.updateConnection(1, 24);
+            auto i = 0U;
+            while (i < 6)
+            {
+                notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 1, header, payload);
+                ++i;
+            }
+
+            REQUIRE(notificationWorker.processPending() == 30);
+            REQUIRE(sentChunks.size() == 3);
+
+            REQUIRE(notificationWorker.processPending() == 20);
+            REQUIRE(sentChunks.size() == 3);
+
+            REQUIRE(notificationWorker.processPending() == 0);
+            REQUIRE(sentChunks.size() == 6);
+        }
+
+        SECTION("keep a slot of every connection event free for the metrics snapshots")
+        {
+            When(Method(mockArduino, micros)).AlwaysReturn(0);
+            const std::array<std::byte, 0> header{};
+
+            notificationWorker.updateConnection(1, 24);
+            auto i = 0U;
+            while (i < 6)
+            {
+                notificationWorker.enqueue(NotificationType::DeltaTimes, &mockChunkCharacteristic.get(), 1, header, payload);
+                ++i;
+            }
+            notificationWorker.processPending();
+            notificationWorker.enqueue(NotificationType::BaseMetrics, &mockMetricsCharacteristic.get(), payload);
+            notificationWorker.processPending();
+
+            REQUIRE(sentMetrics.size() == 1);
+            REQUIRE(sentChunks.size() == 3);
+        }
+
+        SECTION("need a free slot on every connection for the notifications sent to every client")
+        {
+            When(Method(mockArduino, micros)).AlwaysReturn(0);
+            const std::array<std::byte, 0> header{};
+
+            notificationWorker.updateConnection(1, 24);
+            notificationWorker.updateConnection(2, 24);
+            auto i = 0U;
+            while (i < 3)
+            {
+                notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 2, header, payload);
+                ++i;
+            }
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+
+            notificationWorker.processPending();
+
+            REQUIRE(sentChunks.size() == 3);
+            Verify(Method(mockChunkCharacteristic, notify).Using(BLE_HS_CONN_HANDLE_NONE)).Never();
+        }
+
+        SECTION("send without a budget once the client disconnected")
+        {
+            When(Method(mockArduino, micros)).AlwaysReturn(0);
+            const std::array<std::byte, 0> header{};
+
+            notificationWorker.updateConnection(1, 24);
+            auto i = 0U;
+            while (i < 6)
+            {
+                notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 1, header, payload);
+                ++i;
+            }
+            notificationWorker.processPending();
+            notificationWorker.removeConnection(1);
+
+            REQUIRE(notificationWorker.processPending() == 0);
+            REQUIRE(sentChunks.size() == 6);
+        }
+
+        SECTION("record the peak queue depth")
+        {
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+            notificationWorker.processPending();
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), payload);
+            notificationWorker.processPending();
+
+            REQUIRE(notificationWorker.getPeakQueueDepth() == 3);
+        }
+    }
+
+    SECTION("getThroughput method should")
+    {
+        const std::array<std::byte, 0> header{};
+
+        SECTION("report the notifications and bytes per second sent to every client")
+        {
+            When(Method(mockArduino, micros)).Return(0, 1'000'000, 1'500'000);
+
+            notificationWorker.updateConnection(1, 6);
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 1, header, payload);
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 1, header, payload);
+            notificationWorker.enqueue(NotificationType::BaseMetrics, &mockMetricsCharacteristic.get(), payload);
+            notificationWorker.processPending();
+            notificationWorker.processPending();
+
+            const auto throughput = notificationWorker.getThroughput();
+
+            REQUIRE(throughput[0].connectionHandle == 1);
+            REQUIRE(throughput[0].notificationsPerSecond == 3);
+            REQUIRE(throughput[0].bytesPerSecond == 3 * payload.size());
+            REQUIRE(throughput[1].connectionHandle == BleNotificationWorker::allClients);
+        }
+
+        SECTION("not report the last rate of a client that was idle for longer than two seconds")
+        {
+            When(Method(mockArduino, micros)).Return(0, 1'000'000, 3'500'000);
+
+            notificationWorker.updateConnection(1, 6);
+            notificationWorker.enqueue(NotificationType::HandleForces, &mockChunkCharacteristic.get(), 1, header, payload);
+            notificationWorker.processPending();
+            notificationWorker.processPending();
+
+            const auto throughput = notificationWorker.getThroughput();
+
+            REQUIRE(throughput[0].connectionHandle == 1);
+            REQUIRE(throughput[0].notificationsPerSecond == 0);
+            REQUIRE(throughput[0].bytesPerSecond == 0);
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -2,7 +2,9 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <iterator>
+#include <span>
 #include <vector>
 
 #include "catch2/catch_test_macros.hpp"
@@ -14,6 +16,7 @@
 #include "../../include/NimBLEDevice.h"
 
 #include "../../../../src/peripherals/bluetooth/ble-metrics.model.h"
+#include "../../../../src/peripherals/bluetooth/ble-notification.worker.h"
 #include "../../../../src/peripherals/bluetooth/ble-services/base-metrics.service.h"
 #include "../../../../src/peripherals/bluetooth/ble-services/settings.service.interface.h"
 #include "../../../../src/peripherals/bluetooth/ble.enums.h"
@@ -22,6 +25,17 @@
 
 using namespace fakeit;
 
+namespace
+{
+    template <size_t N>
+    std::vector<std::byte> toBytes(const std::array<unsigned char, N> &data)
+    {
+        const auto bytes = std::as_bytes(std::span(data));
+
+        return {cbegin(bytes), cend(bytes)};
+    }
+}
+
 TEST_CASE("BaseMetricsBleService", "[ble-service]")
 {
     mockNimBLEServer.Reset();
@@ -32,6 +46,7 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
     Mock<NimBLECharacteristic> mockBaseMetricsCharacteristic;
     Mock<NimBLECharacteristic> mockControlPointCharacteristic;
     Mock<NimBLEService> mockBaseMetricService;
+    BleNotificationWorker notificationWorker;
 
     When(OverloadedMethod(mockNimBLEServer, createService, NimBLEService * (const unsigned short))).AlwaysReturn(&mockBaseMetricService.get());
 
@@ -43,7 +58,7 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
 
     SECTION("setup method")
     {
-        BaseMetricsBleService baseMetricsBleService(mockMockSettingsBleService.get(), mockEEPROMService.get());
+        BaseMetricsBleService baseMetricsBleService(mockMockSettingsBleService.get(), mockEEPROMService.get(), notificationWorker);
 
         SECTION("when BleServiceFlag::CpsService is passed should")
         {
@@ -125,11 +140,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                 REQUIRE(mockControlPointCharacteristic.get().callbacks != nullptr);
             }
 
-            SECTION("set pscTask to the broadcastTask")
+            SECTION("use the PSC encoding when broadcasting")
             {
-                Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-                Fake(Method(mockArduino, vTaskDelete));
-                Fake(OverloadedMethod(mockCpsCharacteristic, setValue, void(const std::array<unsigned char, 14U>)));
+                Fake(OverloadedMethod(mockCpsCharacteristic, setValue, void(const std::span<const std::byte>)));
                 Fake(Method(mockCpsCharacteristic, notify));
                 baseMetricsBleService.setup(&mockNimBLEServer.get(), BleServiceFlag::CpsService);
 
@@ -146,7 +159,11 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                     .dragCoefficient = 0.0,
                 });
 
-                Verify(OverloadedMethod(mockCpsCharacteristic, setValue, void(const std::array<unsigned char, 14U>))).Once();
+                notificationWorker.processPending();
+
+                Verify(OverloadedMethod(mockCpsCharacteristic, setValue, void(const std::span<const std::byte>)).Matching([](const std::span<const std::byte> data)
+                                                                                                             { return data.size() == 14U; }))
+                    .Once();
             }
         }
 
@@ -239,11 +256,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                 REQUIRE(service == &mockCscService.get());
             }
 
-            SECTION("set cscTask to the broadcastTask")
+            SECTION("use the CSC encoding when broadcasting")
             {
-                Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-                Fake(Method(mockArduino, vTaskDelete));
-                Fake(OverloadedMethod(mockCscCharacteristic, setValue, void(const std::array<unsigned char, 11U>)));
+                Fake(OverloadedMethod(mockCscCharacteristic, setValue, void(const std::span<const std::byte>)));
                 Fake(Method(mockCscCharacteristic, notify));
                 baseMetricsBleService.setup(&mockNimBLEServer.get(), BleServiceFlag::CscService);
 
@@ -260,7 +275,11 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                     .dragCoefficient = 0.0,
                 });
 
-                Verify(OverloadedMethod(mockCscCharacteristic, setValue, void(const std::array<unsigned char, 11U>))).Once();
+                notificationWorker.processPending();
+
+                Verify(OverloadedMethod(mockCscCharacteristic, setValue, void(const std::span<const std::byte>)).Matching([](const std::span<const std::byte> data)
+                                                                                                             { return data.size() == 11U; }))
+                    .Once();
             }
         }
 
@@ -338,11 +357,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                 REQUIRE(service == &mockFtmsService.get());
             }
 
-            SECTION("set ftmsTask to the broadcastTask")
+            SECTION("use the FTMS encoding when broadcasting")
             {
-                Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-                Fake(Method(mockArduino, vTaskDelete));
-                Fake(OverloadedMethod(mockFtmsCharacteristic, setValue, void(const std::array<unsigned char, 14U>)));
+                Fake(OverloadedMethod(mockFtmsCharacteristic, setValue, void(const std::span<const std::byte>)));
                 Fake(Method(mockFtmsCharacteristic, notify));
                 baseMetricsBleService.setup(&mockNimBLEServer.get(), BleServiceFlag::FtmsService);
 
@@ -359,7 +376,11 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                     .dragCoefficient = 0.0,
                 });
 
-                Verify(OverloadedMethod(mockFtmsCharacteristic, setValue, void(const std::array<unsigned char, 14U>))).Once();
+                notificationWorker.processPending();
+
+                Verify(OverloadedMethod(mockFtmsCharacteristic, setValue, void(const std::span<const std::byte>)).Matching([](const std::span<const std::byte> data)
+                                                                                                             { return data.size() == 14U; }))
+                    .Once();
             }
         }
     }
@@ -370,7 +391,7 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
                                                                      { mockBaseMetricsCharacteristic.get().callbacks = callbacks; })
             .Do([](NimBLECharacteristicCallbacks *) {});
 
-        BaseMetricsBleService baseMetricsBleService(mockMockSettingsBleService.get(), mockEEPROMService.get());
+        BaseMetricsBleService baseMetricsBleService(mockMockSettingsBleService.get(), mockEEPROMService.get(), notificationWorker);
         baseMetricsBleService.setup(&mockNimBLEServer.get(), BleServiceFlag::CscService);
 
         const std::vector<unsigned char> expectedClientIds{0, 1};
@@ -398,24 +419,24 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
             .dragCoefficient = 110 / 1e6,
         };
 
-        const auto expectedStackSize = 2'528U;
-
-        BaseMetricsBleService baseMetricsBleService(mockMockSettingsBleService.get(), mockEEPROMService.get());
+        BaseMetricsBleService baseMetricsBleService(mockMockSettingsBleService.get(), mockEEPROMService.get(), notificationWorker);
 
-        Fake(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, 11U>)));
-        Fake(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, 14U>)));
+        std::vector<std::byte> sentData;
+        When(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::span<const std::byte>))).AlwaysDo([&sentData](const std::span<const std::byte> data)
+                                                                                                                        { sentData.assign(cbegin(data), cend(data)); });
         Fake(Method(mockBaseMetricsCharacteristic, notify));
 
         Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-        Fake(Method(mockArduino, vTaskDelete));
 
-        SECTION("setup task pinned to core 0 with the correct stack size")
+        SECTION("queue the notification for the notification task instead of starting a task")
         {
             baseMetricsBleService.setup(&mockNimBLEServer.get(), BleServiceFlag::CscService);
 
             baseMetricsBleService.broadcastBaseMetrics(metrics);
 
-            Verify(Method(mockArduino, xTaskCreatePinnedToCore).Using(Ne(nullptr), StrEq("notifyClients"), Eq(expectedStackSize), Ne(nullptr), Eq(1U), Any(), Eq(0))).Once();
+            REQUIRE(notificationWorker.getQueueDepth() == 1);
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
+            Verify(Method(mockBaseMetricsCharacteristic, notify)).Never();
         }
 
         SECTION("notify PSC with the correct binary data")
@@ -450,7 +471,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
 
             baseMetricsBleService.broadcastBaseMetrics(metrics);
 
-            Verify(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, length>)).Using(Eq(expectedData))).Once();
+            notificationWorker.processPending();
+
+            REQUIRE(sentData == toBytes(expectedData));
             Verify(Method(mockBaseMetricsCharacteristic, notify)).Once();
         }
 
@@ -482,7 +505,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
 
             baseMetricsBleService.broadcastBaseMetrics(metrics);
 
-            Verify(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, length>)).Using(Eq(expectedData))).Once();
+            notificationWorker.processPending();
+
+            REQUIRE(sentData == toBytes(expectedData));
             Verify(Method(mockBaseMetricsCharacteristic, notify)).Once();
         }
 
@@ -523,7 +548,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
 
                 baseMetricsBleService.broadcastBaseMetrics(metrics);
 
-                Verify(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, length>)).Using(Eq(expectedData))).Once();
+                notificationWorker.processPending();
+
+                REQUIRE(sentData == toBytes(expectedData));
                 Verify(Method(mockBaseMetricsCharacteristic, notify)).Once();
             }
 
@@ -574,7 +601,9 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
 
                 baseMetricsBleService.broadcastBaseMetrics(metricsMaxStroke);
 
-                Verify(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, length>)).Using(Eq(expectedData))).Once();
+                notificationWorker.processPending();
+
+                REQUIRE(sentData == toBytes(expectedData));
                 Verify(Method(mockBaseMetricsCharacteristic, notify)).Once();
             }
 
@@ -625,18 +654,23 @@ TEST_CASE("BaseMetricsBleService", "[ble-service]")
 
                 baseMetricsBleService.broadcastBaseMetrics(metricsStopped);
 
-                Verify(OverloadedMethod(mockBaseMetricsCharacteristic, setValue, void(const std::array<unsigned char, length>)).Using(Eq(expectedData))).Once();
+                notificationWorker.processPending();
+
+                REQUIRE(sentData == toBytes(expectedData));
                 Verify(Method(mockBaseMetricsCharacteristic, notify)).Once();
             }
         }
 
-        SECTION("delete task")
+        SECTION("send only the latest metrics when the notification task falls behind")
         {
             baseMetricsBleService.setup(&mockNimBLEServer.get(), BleServiceFlag::CscService);
 
             baseMetricsBleService.broadcastBaseMetrics(metrics);
+            baseMetricsBleService.broadcastBaseMetrics(metrics);
+            notificationWorker.processPending();
 
-            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+            Verify(Method(mockBaseMetricsCharacteristic, notify)).Once();
+            REQUIRE(notificationWorker.getCoalescedCount() == 1);
         }
     }
 }
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstring>
@@ -25,8 +26,14 @@
 #include "../../include/Arduino.h"
 #include "../../include/NimBLEDevice.h"
 
+#include "../../../../src/peripherals/bluetooth/ble-metrics.model.h"
+#include "../../../../src/peripherals/bluetooth/ble-notification.worker.h"
 #include "../../../../src/peripherals/bluetooth/ble-services/extended-metrics.service.h"
 #include "../../../../src/peripherals/bluetooth/ble.enums.h"
+#include "../../../../src/peripherals/bluetooth/handle-forces.encoder.h"
+#include "../../../../src/rower/pipeline-profiler.h"
+#include "../../../../src/rower/stroke.model.h"
+#include "../../../../src/utils/impulse-log/delta-time-stream.h"
 #include "../../../../src/utils/configuration.h"
 
 using namespace fakeit;
@@ -38,6 +45,7 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
 
     Mock<NimBLECharacteristic> mockExtendedMetricsCharacteristic;
     Mock<NimBLEService> mockExtendedMetricService;
+    BleNotificationWorker notificationWorker;
 
     When(OverloadedMethod(mockNimBLEServer, createService, NimBLEService * (const std::string))).AlwaysReturn(&mockExtendedMetricService.get());
 
@@ -58,14 +66,15 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
         const unsigned short expectedDriveDuration = std::lroundl(driveDuration / secInMicroSec * 4'096);
         const auto expectedAvgStrokePower = static_cast<short>(std::lround(avgStrokePower));
         const auto expectedDragFactor = static_cast<unsigned short>(std::lround(dragCoefficient * 1e6));
-        const auto expectedStackSize = 2'368U;
 
-        Fake(OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::array<unsigned char, 8U>)));
+        std::vector<std::byte> results;
+        When(OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::span<const std::byte> data)))
+            .AlwaysDo([&results](const std::span<const std::byte> data)
+                      { results.assign(data.begin(), data.end()); });
         Fake(Method(mockExtendedMetricsCharacteristic, notify));
         Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-        Fake(Method(mockArduino, vTaskDelete));
 
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
         extendedMetricBleService.setup(&mockNimBLEServer.get());
 
         SECTION("convert recovery and drive duration to a 16bit unsigned short in seconds with a resolution of 4096")
@@ -85,8 +94,10 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
             };
 
             extendedMetricBleService.broadcastExtendedMetrics(avgStrokePower, recoveryDuration, driveDuration, dragCoefficient);
+            notificationWorker.processPending();
 
-            Verify(OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::array<unsigned char, 8U>)).Using(Eq(expectedData))).Once();
+            const auto expectedBytes = std::as_bytes(std::span(expectedData));
+            REQUIRE_THAT(results, Catch::Matchers::RangeEquals(expectedBytes));
         }
 
         SECTION("notify ExtendedMetrics with the correct binary data")
@@ -106,31 +117,27 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
             };
 
             extendedMetricBleService.broadcastExtendedMetrics(avgStrokePower, recoveryDuration, driveDuration, dragCoefficient);
+            notificationWorker.processPending();
 
-            Verify(
-                Method(mockArduino, xTaskCreatePinnedToCore)
-                    .Using(Ne(nullptr), StrEq("notifyExtendedMetrics"), Eq(expectedStackSize), Ne(nullptr), Eq(1U), Any(), Eq(0)))
-                .Once();
-            Verify(
-                OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::array<unsigned char, 8U>))
-                    .Using(Eq(expectedData)))
-                .Once();
+            const auto expectedBytes = std::as_bytes(std::span(expectedData));
+            REQUIRE_THAT(results, Catch::Matchers::RangeEquals(expectedBytes));
+            Verify(Method(mockExtendedMetricsCharacteristic, notify)).Once();
         }
 
-        SECTION("delete task")
+        SECTION("queue the notification for the notification task instead of starting a task")
         {
-            mockArduino.ClearInvocationHistory();
-
             extendedMetricBleService.broadcastExtendedMetrics(avgStrokePower, recoveryDuration, driveDuration, dragCoefficient);
 
-            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+            REQUIRE(notificationWorker.getQueueDepth() == 1);
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
+            Verify(Method(mockExtendedMetricsCharacteristic, notify)).Never();
         }
 
         SECTION("trigger ESP_ERR_NOT_FOUND if ExtendedMetricBleService setup() method was not called")
         {
             mockArduino.ClearInvocationHistory();
 
-            ExtendedMetricBleService extendedMetricBleServiceNoSetup;
+            ExtendedMetricBleService extendedMetricBleServiceNoSetup(notificationWorker);
             Fake(Method(mockArduino, abort));
 
             REQUIRE_THROWS(extendedMetricBleServiceNoSetup.broadcastExtendedMetrics(avgStrokePower, recoveryDuration, driveDuration, dragCoefficient));
@@ -141,10 +148,18 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
 
     SECTION("HandleForces method should")
     {
-        const auto coreStackSize = 2'240U;
         const std::vector<float> expectedHandleForces{1.1, 3.3, 500.4, 300.4};
         const std::vector<float> expectedBigHandleForces{1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 1.1, 3.3, 10.4, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12, 30.999, 80.323, 500.4, 300.4, 200.8474, 100.12};
 
+        const BleMetricsModel::ClientSettingsList floatClientSettings{};
+        const auto quantizedClientSettings = [](const unsigned char maxError)
+        {
+            BleMetricsModel::ClientSettingsList clientSettings{};
+            clientSettings[0] = {.connectionHandle = 0, .handleForcesEncoding = HandleForcesEncoding::Int16, .handleForcesMaxError = maxError};
+
+            return clientSettings;
+        };
+
         Mock<NimBLECharacteristic> mockHandleForcesCharacteristic;
 
         When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(100);
@@ -157,53 +172,24 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
         Fake(Method(mockHandleForcesCharacteristic, notify));
 
         Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-        Fake(Method(mockArduino, vTaskDelete));
 
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
         extendedMetricBleService.setup(&mockNimBLEServer.get());
         mockHandleForcesCharacteristic.get().subscribe(0, 1);
 
-        SECTION("calculate stack size for the task")
+        SECTION("queue one notification per chunk instead of starting a task")
         {
-            SECTION("when MTU is less than handleForces vector size")
-            {
-                const auto expectedMTU = 100U;
-                const auto expectedStackSize = coreStackSize + expectedMTU / 3;
-
-                When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(expectedMTU);
-
-                extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces);
-
-                Verify(
-                    Method(mockArduino, xTaskCreatePinnedToCore)
-                        .Using(Any(), Any(), Eq(expectedStackSize), Any(), Any(), Any(), Any()))
-                    .Once();
-            }
-
-            SECTION("when MTU is greater than handleForces vector size")
-            {
-                const auto expectedMTU = 100U;
-                const auto expectedStackSize = coreStackSize + (expectedHandleForces.size() * sizeof(float)) / 3;
+            const auto expectedMTU = 100U;
+            const unsigned short expectedChunkSize = (expectedMTU - 3U - 2U) / sizeof(float);
+            const auto expectedNumberOfNotifies = expectedBigHandleForces.size() / expectedChunkSize + (expectedBigHandleForces.size() % expectedChunkSize == 0 ? 0 : 1);
 
-                When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(expectedMTU);
+            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(expectedMTU);
 
-                extendedMetricBleService.broadcastHandleForces(expectedHandleForces);
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, floatClientSettings);
 
-                Verify(
-                    Method(mockArduino, xTaskCreatePinnedToCore)
-                        .Using(Any(), Any(), Eq(expectedStackSize), Any(), Any(), Any(), Any()))
-                    .Once();
-            }
-        }
-
-        SECTION("should start a task")
-        {
-            extendedMetricBleService.broadcastHandleForces(expectedHandleForces);
-
-            Verify(
-                Method(mockArduino, xTaskCreatePinnedToCore)
-                    .Using(Ne(nullptr), StrEq("notifyHandleForces"), Any(), Ne(nullptr), Eq(1U), Any(), Eq(0)))
-                .Once();
+            REQUIRE(notificationWorker.getQueueDepth() == expectedNumberOfNotifies);
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
+            Verify(Method(mockHandleForcesCharacteristic, notify)).Never();
         }
 
         SECTION("send")
@@ -214,7 +200,9 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
             {
                 When(Method(mockNimBLEServer, getPeerMTU)).Return(expectedMTU);
 
-                extendedMetricBleService.broadcastHandleForces(expectedHandleForces);
+                extendedMetricBleService.broadcastHandleForces(expectedHandleForces, floatClientSettings);
+
+                notificationWorker.processPending();
 
                 Verify(
                     OverloadedMethod(mockHandleForcesCharacteristic, setValue, void(const std::span<const std::byte> data)).Matching([expectedSize = 2U + expectedHandleForces.size() * sizeof(float)](const std::span<const std::byte> data)
@@ -235,7 +223,9 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
                     mockHandleForcesCharacteristic.ClearInvocationHistory();
                     When(Method(mockNimBLEServer, getPeerMTU)).Return(expectedMTU - i);
 
-                    extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces);
+                    extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, floatClientSettings);
+
+                    notificationWorker.processPending();
 
                     Verify(
                         OverloadedMethod(mockHandleForcesCharacteristic, setValue, void(const std::span<const std::byte> data)).Matching([expectedSize = 2U + expectedChunkSize * sizeof(float)](const std::span<const std::byte> data)
@@ -266,7 +256,9 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
 
                     return true; }));
 
-            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces);
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, floatClientSettings);
+
+            notificationWorker.processPending();
 
             for (unsigned char i = 0; i < expectedNumberOfNotifies; ++i)
             {
@@ -292,7 +284,9 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
                         results.emplace_back(data.begin(), data.end());
                         return true; }));
 
-            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces);
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, floatClientSettings);
+
+            notificationWorker.processPending();
 
             Verify(Method(mockHandleForcesCharacteristic, notify)).Exactly(expectedNumberOfNotifies);
 
@@ -320,23 +314,220 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
             }
         }
 
-        SECTION("delete task")
+        SECTION("send the quantized curve with the split, chunk id and scale as header")
+        {
+            const auto expectedMTU = 100U;
+            const auto expectedHeaderSize = 2U + sizeof(float);
+            std::vector<std::vector<std::byte>> results{};
+
+            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(expectedMTU);
+            Fake(
+                OverloadedMethod(mockHandleForcesCharacteristic, setValue, void(const std::span<const std::byte> data)).Matching([&results](const std::span<const std::byte> data)
+                                                                                                                                 {
+                    results.emplace_back(data.begin(), data.end());
+
+                    return true; }));
+
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, quantizedClientSettings(0));
+
+            notificationWorker.processPending();
+
+            const auto expectedScale = std::ranges::max(expectedBigHandleForces) / SHRT_MAX;
+            const size_t expectedChunkSize = (expectedMTU - 3U - expectedHeaderSize) / HandleForcesEncoder::valueSize;
+            const auto expectedNumberOfNotifies = (expectedBigHandleForces.size() + expectedChunkSize - 1U) / expectedChunkSize;
+
+            REQUIRE(results.size() == expectedNumberOfNotifies);
+
+            size_t numberOfValues = 0;
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                INFO("Current notify: " << i + 1U);
+                REQUIRE(results[i].size() <= expectedMTU - 3U);
+                REQUIRE(results[i][0] == std::byte(expectedNumberOfNotifies));
+                REQUIRE(results[i][1] == std::byte(i + 1));
+
+                float scale = 0;
+                std::memcpy(&scale, &results[i][2], sizeof(float));
+                REQUIRE(scale == expectedScale);
+
+                numberOfValues += (results[i].size() - expectedHeaderSize) / HandleForcesEncoder::valueSize;
+            }
+            REQUIRE(numberOfValues == expectedBigHandleForces.size());
+
+            short firstValue = 0;
+            std::memcpy(&firstValue, &results[0][expectedHeaderSize], sizeof(short));
+            REQUIRE(std::abs(static_cast<float>(firstValue) * expectedScale - expectedBigHandleForces[0]) <= expectedScale);
+        }
+
+        SECTION("send fewer points when the quantized curve is simplified")
+        {
+            std::vector<std::byte> results{};
+
+            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(512);
+            When(OverloadedMethod(mockHandleForcesCharacteristic, setValue, void(const std::span<const std::byte> data)))
+                .AlwaysDo([&results](const std::span<const std::byte> data)
+                          { std::ranges::copy(data, std::back_inserter(results)); });
+
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, quantizedClientSettings(20));
+
+            notificationWorker.processPending();
+
+            Verify(Method(mockHandleForcesCharacteristic, notify)).Once();
+            REQUIRE((results.size() - 2U - sizeof(float)) % HandleForcesEncoder::indexedValueSize == 0);
+            REQUIRE((results.size() - 2U - sizeof(float)) / HandleForcesEncoder::indexedValueSize < expectedBigHandleForces.size());
+        }
+
+        SECTION("chunk the handleForces for the MTU of each client separately")
+        {
+            const auto expectedSmallMtu = 100U;
+            const auto expectedLargeMtu = 512U;
+            const auto numberOfNotifies = [&expectedBigHandleForces](const unsigned int mtu)
+            {
+                const auto chunkSize = (mtu - 3U - 2U) / sizeof(float);
+
+                return static_cast<unsigned int>((expectedBigHandleForces.size() + chunkSize - 1U) / chunkSize);
+            };
+
+            When(Method(mockNimBLEServer, getPeerMTU).Using(0)).AlwaysReturn(expectedSmallMtu);
+            When(Method(mockNimBLEServer, getPeerMTU).Using(1)).AlwaysReturn(expectedLargeMtu);
+            mockHandleForcesCharacteristic.get().subscribe(1, 1);
+
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, floatClientSettings);
+
+            notificationWorker.processPending();
+
+            Verify(Method(mockHandleForcesCharacteristic, notify).Using(0)).Exactly(numberOfNotifies(expectedSmallMtu));
+            Verify(Method(mockHandleForcesCharacteristic, notify).Using(1)).Exactly(numberOfNotifies(expectedLargeMtu));
+        }
+
+        SECTION("encode the handleForces in the format each client chose")
+        {
+            const auto expectedMtu = 512U;
+            const auto expectedQuantizedHeaderSize = 2U + sizeof(float);
+            std::vector<std::vector<std::byte>> results{};
+
+            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(expectedMtu);
+            When(OverloadedMethod(mockHandleForcesCharacteristic, setValue, void(const std::span<const std::byte> data)))
+                .AlwaysDo([&results](const std::span<const std::byte> data)
+                          { results.emplace_back(data.begin(), data.end()); });
+            mockHandleForcesCharacteristic.get().subscribe(1, 1);
+
+            extendedMetricBleService.broadcastHandleForces(expectedHandleForces, quantizedClientSettings(0));
+
+            notificationWorker.processPending();
+
+            Verify(Method(mockHandleForcesCharacteristic, notify).Using(0)).Once();
+            Verify(Method(mockHandleForcesCharacteristic, notify).Using(1)).Once();
+            REQUIRE_THAT(results, Catch::Matchers::SizeIs(2));
+            REQUIRE(results[0].size() == expectedQuantizedHeaderSize + expectedHandleForces.size() * HandleForcesEncoder::valueSize);
+            REQUIRE(results[1].size() == 2U + expectedHandleForces.size() * sizeof(float));
+        }
+
+        SECTION("drop the curve as a whole when not all of its chunks fit into the queue")
+        {
+            const auto expectedMTU = 100U;
+            const auto expectedChunkSize = (expectedMTU - 3U - 2U) / sizeof(float);
+            const auto expectedNumberOfNotifies = (expectedBigHandleForces.size() + expectedChunkSize - 1U) / expectedChunkSize;
+            const std::array<std::byte, sizeof(unsigned long)> deltaTime{};
+
+            auto i = 0U;
+            while (i < Configurations::bleNotificationQueueCapacity - expectedNumberOfNotifies + 1U)
+            {
+                notificationWorker.enqueue(BleNotificationWorker::NotificationType::DeltaTimes, &mockHandleForcesCharacteristic.get(), deltaTime);
+                ++i;
+            }
+            const auto queueDepth = notificationWorker.getQueueDepth();
+
+            extendedMetricBleService.broadcastHandleForces(expectedBigHandleForces, floatClientSettings);
+
+            REQUIRE(notificationWorker.getQueueDepth() == queueDepth);
+            REQUIRE(notificationWorker.getDroppedCount() == expectedNumberOfNotifies);
+        }
+
+        SECTION("skip clients whose connection is not known")
+        {
+            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(0);
+
+            extendedMetricBleService.broadcastHandleForces(expectedHandleForces, floatClientSettings);
+
+            REQUIRE(notificationWorker.getQueueDepth() == 0);
+        }
+
+        SECTION("trigger ESP_ERR_NOT_FOUND if ExtendedMetricBleService setup() method was not called")
         {
             mockArduino.ClearInvocationHistory();
 
-            extendedMetricBleService.broadcastHandleForces(expectedHandleForces);
+            ExtendedMetricBleService extendedMetricBleServiceNoSetup(notificationWorker);
+            Fake(Method(mockArduino, abort));
+
+            REQUIRE_THROWS(extendedMetricBleServiceNoSetup.broadcastHandleForces(expectedHandleForces, floatClientSettings));
 
-            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+            Verify(Method(mockArduino, abort).Using(ESP_ERR_NOT_FOUND)).Once();
+        }
+    }
+
+    SECTION("Diagnostics method should")
+    {
+        const RowingDataModels::RowingMetrics data{
+            .regressionWindowLength = 4U,
+            .regressionWindowSwitchCount = 300U,
+        };
+
+        std::vector<std::byte> results;
+        When(OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::span<const std::byte> data)))
+            .AlwaysDo([&results](const std::span<const std::byte> data)
+                      { results.assign(data.begin(), data.end()); });
+        Fake(Method(mockExtendedMetricsCharacteristic, notify));
+
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
+        extendedMetricBleService.setup(&mockNimBLEServer.get());
+
+        SECTION("send the throughput of every connection slot and the regression window without a profiler")
+        {
+            const std::array<unsigned char, 24U> expectedData = {
+                0,
+                0, 0, 0, 0,
+
+                0xFF, 0xFF, 0, 0, 0, 0, 0, 0,
+                0xFF, 0xFF, 0, 0, 0, 0, 0, 0,
+
+                4,
+                static_cast<unsigned char>(300U),
+                static_cast<unsigned char>(300U >> 8),
+            };
+
+            extendedMetricBleService.broadcastDiagnostics(nullptr, data);
+            notificationWorker.processPending();
+
+            REQUIRE_THAT(results, Catch::Matchers::RangeEquals(std::as_bytes(std::span(expectedData))));
+            Verify(Method(mockExtendedMetricsCharacteristic, notify)).Once();
+        }
+
+        SECTION("send the statistics of every stage in front of the throughput with a profiler")
+        {
+            PipelineProfiler profiler;
+            profiler.record(PipelineStage::CyclicFilter, 2U * PipelineProfiler::ticksPerMicrosecond());
+            const unsigned short expectedDuration = 20U;
+
+            extendedMetricBleService.broadcastDiagnostics(&profiler, data);
+            notificationWorker.processPending();
+
+            REQUIRE(results.size() == 24U + PipelineProfiler::stageCount * 4U * sizeof(unsigned short));
+            REQUIRE(results[0] == std::byte{PipelineProfiler::stageCount});
+            REQUIRE(results[1] == std::byte{1});
+            REQUIRE(results[5] == std::byte{static_cast<unsigned char>(expectedDuration)});
+            REQUIRE(results[6] == std::byte{static_cast<unsigned char>(expectedDuration >> 8)});
+            REQUIRE(results.back() == std::byte{static_cast<unsigned char>(300U >> 8)});
         }
 
         SECTION("trigger ESP_ERR_NOT_FOUND if ExtendedMetricBleService setup() method was not called")
         {
             mockArduino.ClearInvocationHistory();
 
-            ExtendedMetricBleService extendedMetricBleServiceNoSetup;
+            ExtendedMetricBleService extendedMetricBleServiceNoSetup(notificationWorker);
             Fake(Method(mockArduino, abort));
 
-            REQUIRE_THROWS(extendedMetricBleServiceNoSetup.broadcastHandleForces(expectedHandleForces));
+            REQUIRE_THROWS(extendedMetricBleServiceNoSetup.broadcastDiagnostics(nullptr, data));
 
             Verify(Method(mockArduino, abort).Using(ESP_ERR_NOT_FOUND)).Once();
         }
@@ -344,67 +535,180 @@ TEST_CASE("ExtendedMetricBleService broadcast", "[ble-service]")
 
     SECTION("DeltaTimes method should")
     {
-        const auto coreStackSize = 2'368U;
-        std::vector<unsigned long> expectedDeltaTimes{10000, 11000, 12000, 11000};
-        const auto expectedStackSize = coreStackSize + expectedDeltaTimes.size() * sizeof(unsigned long) / 3;
-
-        Fake(OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::span<const std::byte> data)));
-        Fake(Method(mockExtendedMetricsCharacteristic, notify));
+        const auto minimumDeltaTimeMtu = 100U;
+        const auto interval = 1'000U;
+        const std::vector<unsigned long> expectedDeltaTimes{10'000, 11'000, 12'000, 11'000};
+        const BleMetricsModel::ClientSettingsList rawClientSettings{};
+        BleMetricsModel::ClientSettingsList varintClientSettings{};
+        varintClientSettings[0] = {.connectionHandle = 0, .deltaTimeEncoding = DeltaTimeEncoding::Varint};
+        std::vector<std::vector<std::byte>> results;
+
+        Mock<NimBLECharacteristic> mockDeltaTimesCharacteristic;
+
+        When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(minimumDeltaTimeMtu);
+        When(Method(mockArduino, millis)).AlwaysReturn(interval + 1U);
+
+        When(OverloadedMethod(mockExtendedMetricService, createCharacteristic, NimBLECharacteristic * (const std::string, const unsigned int)).Using(CommonBleFlags::deltaTimesUuid, Any())).AlwaysReturn(&mockDeltaTimesCharacteristic.get());
+        When(Method(mockDeltaTimesCharacteristic, setCallbacks)).Do([&mockDeltaTimesCharacteristic](NimBLECharacteristicCallbacks *callbacks)
+                                                                    { mockDeltaTimesCharacteristic.get().callbacks = callbacks; });
+        When(OverloadedMethod(mockDeltaTimesCharacteristic, setValue, void(const std::span<const std::byte> data)))
+            .AlwaysDo([&results](const std::span<const std::byte> data)
+                      { results.emplace_back(data.begin(), data.end()); });
+        Fake(Method(mockDeltaTimesCharacteristic, notify));
 
         Fake(Method(mockArduino, xTaskCreatePinnedToCore));
-        Fake(Method(mockArduino, vTaskDelete));
 
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
         extendedMetricBleService.setup(&mockNimBLEServer.get());
+        mockDeltaTimesCharacteristic.get().subscribe(0, 1);
 
-        SECTION("calculate core stack size for the task")
+        SECTION("buffer the delta times instead of sending them one by one")
         {
-            extendedMetricBleService.broadcastDeltaTimes(expectedDeltaTimes);
+            extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0], rawClientSettings);
 
-            Verify(
-                Method(mockArduino, xTaskCreatePinnedToCore)
-                    .Using(Any(), Any(), Eq(expectedStackSize), Any(), Any(), Any(), Any()))
-                .Once();
+            REQUIRE(notificationWorker.getQueueDepth() == 0);
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
         }
 
-        SECTION("start task and notify broadcastDeltaTimes with the correct binary data")
+        SECTION("ignore clients with an MTU below 100")
         {
-            std::vector<std::byte> results;
-            When(OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::span<const std::byte> data)))
-                .Do([&results](const std::span<const std::byte> data)
-                    { std::ranges::copy(data, std::back_inserter(results)); });
-
-            extendedMetricBleService.broadcastDeltaTimes(expectedDeltaTimes);
-
-            Verify(
-                Method(mockArduino, xTaskCreatePinnedToCore)
-                    .Using(Ne(nullptr), StrEq("notifyDeltaTimes"), Eq(expectedStackSize), Ne(nullptr), Eq(1U), Any(), Eq(0)))
-                .Once();
-            Verify(
-                OverloadedMethod(mockExtendedMetricsCharacteristic, setValue, void(const std::span<const std::byte> data))
-                    .Using(Any()))
-                .Once();
+            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(minimumDeltaTimeMtu - 1U);
+
+            extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0], rawClientSettings);
+            extendedMetricBleService.flushDeltaTimes(interval);
+            notificationWorker.processPending();
+
+            REQUIRE_THAT(results, Catch::Matchers::IsEmpty());
+        }
+
+        SECTION("send the buffered delta times with the correct binary data once the interval passed")
+        {
+            for (const auto deltaTime : expectedDeltaTimes)
+            {
+                extendedMetricBleService.bufferDeltaTime(deltaTime, rawClientSettings);
+            }
+            extendedMetricBleService.flushDeltaTimes(interval);
+            notificationWorker.processPending();
 
             std::vector<std::byte> expectedData;
             std::ranges::copy(std::as_bytes(std::span(expectedDeltaTimes)), std::back_inserter(expectedData));
-            REQUIRE_THAT(results, Catch::Matchers::Equals(expectedData));
+            REQUIRE_THAT(results, Catch::Matchers::SizeIs(1));
+            REQUIRE_THAT(results[0], Catch::Matchers::Equals(expectedData));
+            Verify(Method(mockDeltaTimesCharacteristic, notify).Using(0)).Once();
+        }
+
+        SECTION("not send the buffered delta times again before the interval passed")
+        {
+            extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0], rawClientSettings);
+            extendedMetricBleService.flushDeltaTimes(interval);
+
+            When(Method(mockArduino, millis)).AlwaysReturn(interval * 2U);
+            extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[1], rawClientSettings);
+            extendedMetricBleService.flushDeltaTimes(interval);
+            notificationWorker.processPending();
+
+            REQUIRE_THAT(results, Catch::Matchers::SizeIs(1));
+        }
+
+        SECTION("send the delta times once the MTU of the client is full")
+        {
+            auto i = 0U;
+            while ((i + 1) * sizeof(unsigned long) < minimumDeltaTimeMtu - 3)
+            {
+                extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0] + i, rawClientSettings);
+                ++i;
+            }
+            notificationWorker.processPending();
+
+            REQUIRE_THAT(results, Catch::Matchers::SizeIs(1));
+            REQUIRE(results[0].size() == i * sizeof(unsigned long));
+        }
+
+        SECTION("fill the notifications up to the MTU of each client separately")
+        {
+            const auto expectedLargeMtu = 512U;
+            When(Method(mockNimBLEServer, getPeerMTU).Using(1)).AlwaysReturn(expectedLargeMtu);
+            mockDeltaTimesCharacteristic.get().subscribe(1, 1);
+
+            auto i = 0U;
+            while ((i + 1) * sizeof(unsigned long) < minimumDeltaTimeMtu - 3)
+            {
+                extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0] + i, rawClientSettings);
+                ++i;
+            }
+            notificationWorker.processPending();
+
+            Verify(Method(mockDeltaTimesCharacteristic, notify).Using(0)).Once();
+            Verify(Method(mockDeltaTimesCharacteristic, notify).Using(1)).Never();
+
+            while ((i + 1) * sizeof(unsigned long) < expectedLargeMtu - 3)
+            {
+                extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0] + i, rawClientSettings);
+                ++i;
+            }
+            notificationWorker.processPending();
+
+            Verify(Method(mockDeltaTimesCharacteristic, notify).Using(1)).Once();
+            REQUIRE(results.back().size() == i * sizeof(unsigned long));
         }
 
-        SECTION("delete task")
+        SECTION("when the client opted in to the compressed encoding")
         {
-            extendedMetricBleService.broadcastDeltaTimes(expectedDeltaTimes);
+            SECTION("fit more delta times into a notification than the raw format")
+            {
+                std::vector<unsigned long> sentDeltaTimes;
+                auto i = 0U;
+                while (notificationWorker.getQueueDepth() == 0)
+                {
+                    sentDeltaTimes.push_back(expectedDeltaTimes[0] + (i % 7) * 10U);
+                    extendedMetricBleService.bufferDeltaTime(sentDeltaTimes.back(), varintClientSettings);
+                    ++i;
+                }
+                notificationWorker.processPending();
+
+                DeltaTimeStreamDecoder decoder;
+                std::vector<unsigned long> decodedDeltaTimes;
+                std::vector<unsigned char> packet;
+                std::ranges::transform(results[0], std::back_inserter(packet), [](const std::byte value)
+                                       { return std::to_integer<unsigned char>(value); });
+                REQUIRE(decoder.open(packet));
+                unsigned long deltaTime = 0;
+                while (decoder.next(deltaTime))
+                {
+                    decodedDeltaTimes.push_back(deltaTime);
+                }
 
-            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+                REQUIRE(decodedDeltaTimes == sentDeltaTimes);
+                REQUIRE(results[0].size() <= minimumDeltaTimeMtu - 3U);
+                REQUIRE(decodedDeltaTimes.size() > (minimumDeltaTimeMtu - 3U) / sizeof(unsigned int));
+            }
+
+            SECTION("send the delta times collected in the raw format before the switch first")
+            {
+                extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[0], rawClientSettings);
+                extendedMetricBleService.bufferDeltaTime(expectedDeltaTimes[1], varintClientSettings);
+                notificationWorker.processPending();
+
+                REQUIRE_THAT(results, Catch::Matchers::SizeIs(1));
+                REQUIRE(results[0].size() == sizeof(unsigned long));
+
+                When(Method(mockArduino, millis)).AlwaysReturn(interval * 3U);
+                extendedMetricBleService.flushDeltaTimes(interval);
+                notificationWorker.processPending();
+
+                REQUIRE_THAT(results, Catch::Matchers::SizeIs(2));
+                REQUIRE(results[1].size() == DeltaTimeStream::headerSize);
+            }
         }
 
         SECTION("trigger ESP_ERR_NOT_FOUND if ExtendedMetricBleService setup() method was not called")
         {
             mockArduino.ClearInvocationHistory();
 
-            ExtendedMetricBleService extendedMetricBleServiceNoSetup;
+            ExtendedMetricBleService extendedMetricBleServiceNoSetup(notificationWorker);
             Fake(Method(mockArduino, abort));
 
-            REQUIRE_THROWS(extendedMetricBleServiceNoSetup.broadcastDeltaTimes(expectedDeltaTimes));
+            REQUIRE_THROWS(extendedMetricBleServiceNoSetup.bufferDeltaTime(expectedDeltaTimes[0], rawClientSettings));
 
             Verify(Method(mockArduino, abort).Using(ESP_ERR_NOT_FOUND)).Once();
         }
@@ -13,6 +13,7 @@
 
 #include "../include/globals.h"
 
+#include "../../../../src/peripherals/bluetooth/ble-notification.worker.h"
 #include "../../../../src/peripherals/bluetooth/ble-services/extended-metrics.service.h"
 #include "../../../../src/peripherals/bluetooth/ble.enums.h"
 
@@ -25,6 +26,7 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
 
     Mock<NimBLECharacteristic> mockExtendedMetricsCharacteristic;
     Mock<NimBLEService> mockExtendedMetricService;
+    BleNotificationWorker notificationWorker;
 
     When(OverloadedMethod(mockNimBLEServer, createService, NimBLEService * (const std::string))).AlwaysReturn(&mockExtendedMetricService.get());
 
@@ -35,7 +37,7 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
 
     SECTION("setup method should")
     {
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
 
         SECTION("create extended BLE metrics service")
         {
@@ -96,6 +98,24 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
                 .Once();
             Verify(Method(mockExtendedMetricsCharacteristicWithCorrectParams, setCallbacks)).Once();
         }
+
+        SECTION("setup diagnostics characteristic with correct parameters")
+        {
+            Mock<NimBLECharacteristic> mockDiagnosticsCharacteristic;
+
+            const unsigned int expectedMeasurementProperty = NIMBLE_PROPERTY::NOTIFY;
+
+            When(OverloadedMethod(mockExtendedMetricService, createCharacteristic, NimBLECharacteristic * (const std::string, const unsigned int)).Using(CommonBleFlags::diagnosticsUuid, Any())).AlwaysReturn(&mockDiagnosticsCharacteristic.get());
+            Fake(Method(mockDiagnosticsCharacteristic, setCallbacks));
+
+            extendedMetricBleService.setup(&mockNimBLEServer.get());
+
+            Verify(
+                OverloadedMethod(mockExtendedMetricService, createCharacteristic, NimBLECharacteristic * (const std::string, const unsigned int))
+                    .Using(CommonBleFlags::diagnosticsUuid, expectedMeasurementProperty))
+                .Once();
+            Verify(Method(mockDiagnosticsCharacteristic, setCallbacks)).Once();
+        }
     }
 
     SECTION("getExtendedMetricsClientId method should get extendedMetrics client ID list")
@@ -106,7 +126,7 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
         When(Method(mockCharacteristic, setCallbacks)).Do([&mockCharacteristic](NimBLECharacteristicCallbacks *callbacks)
                                                           { mockCharacteristic.get().callbacks = callbacks; });
 
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
         extendedMetricBleService.setup(&mockNimBLEServer.get());
 
         const std::vector<unsigned char> expectedClientIds{0, 1};
@@ -126,7 +146,7 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
         When(Method(mockCharacteristic, setCallbacks)).Do([&mockCharacteristic](NimBLECharacteristicCallbacks *callbacks)
                                                           { mockCharacteristic.get().callbacks = callbacks; });
 
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
         extendedMetricBleService.setup(&mockNimBLEServer.get());
 
         const std::vector<unsigned char> expectedClientIds{0, 1};
@@ -146,7 +166,7 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
         When(Method(mockCharacteristic, setCallbacks)).Do([&mockCharacteristic](NimBLECharacteristicCallbacks *callbacks)
                                                           { mockCharacteristic.get().callbacks = callbacks; });
 
-        ExtendedMetricBleService extendedMetricBleService;
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
         extendedMetricBleService.setup(&mockNimBLEServer.get());
 
         const std::vector<unsigned char> expectedClientIds{0, 1};
@@ -158,59 +178,58 @@ TEST_CASE("ExtendedMetricBleService", "[ble-service]")
         REQUIRE_THAT(clientIds, Catch::Matchers::Equals(expectedClientIds));
     }
 
-    SECTION("calculateMtu method should")
+    SECTION("getDiagnosticsClientId method should get diagnostics client ID list")
     {
-        ExtendedMetricBleService extendedMetricBleService;
-
-        const std::vector<unsigned char> clientIds{0, 1};
+        Mock<NimBLECharacteristic> mockCharacteristic;
 
-        SECTION("return the mtu for the given client ID list")
-        {
-            const auto expectedMtu = 99;
-            When(Method(mockNimBLEServer, getPeerMTU)).AlwaysReturn(99);
+        When(OverloadedMethod(mockExtendedMetricService, createCharacteristic, NimBLECharacteristic * (const std::string, const unsigned int)).Using(CommonBleFlags::diagnosticsUuid, Any())).AlwaysReturn(&mockCharacteristic.get());
+        When(Method(mockCharacteristic, setCallbacks)).Do([&mockCharacteristic](NimBLECharacteristicCallbacks *callbacks)
+                                                          { mockCharacteristic.get().callbacks = callbacks; });
 
-            const auto mtu = extendedMetricBleService.calculateMtu(clientIds);
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
+        extendedMetricBleService.setup(&mockNimBLEServer.get());
 
-            REQUIRE(mtu == expectedMtu);
-        }
+        const std::vector<unsigned char> expectedClientIds{0, 1};
+        std::ranges::for_each(cbegin(expectedClientIds), cend(expectedClientIds), [&mockCharacteristic](unsigned char clientId)
+                              { mockCharacteristic.get().subscribe(clientId, 1); });
 
-        SECTION("return the lowest MTU")
-        {
-            const auto expectedMtu = 23U;
-            When(Method(mockNimBLEServer, getPeerMTU)).Return(expectedMtu, 100);
+        const auto clientIds = extendedMetricBleService.getDiagnosticsClientIds();
 
-            const auto mtu = extendedMetricBleService.calculateMtu(clientIds);
+        REQUIRE_THAT(clientIds, Catch::Matchers::Equals(expectedClientIds));
+    }
 
-            REQUIRE(mtu == expectedMtu);
-        }
+    SECTION("calculateMtu method should")
+    {
+        ExtendedMetricBleService extendedMetricBleService(notificationWorker);
 
-        SECTION("return 512 as MTU even if device reports higher")
+        SECTION("return the mtu of the given client")
         {
-            const auto expectedMtu = 512U;
-            When(Method(mockNimBLEServer, getPeerMTU)).Return(1'200, 1'000);
+            const auto expectedMtu = 99;
+            When(Method(mockNimBLEServer, getPeerMTU).Using(1)).AlwaysReturn(expectedMtu);
+            When(Method(mockNimBLEServer, getPeerMTU).Using(0)).AlwaysReturn(23);
 
-            const auto mtu = extendedMetricBleService.calculateMtu(clientIds);
+            const auto mtu = extendedMetricBleService.calculateMtu(1);
 
             REQUIRE(mtu == expectedMtu);
         }
 
-        SECTION("ignore zero MTU when calculating minimum")
+        SECTION("return 512 as MTU even if device reports higher")
         {
-            const auto expectedMtu = 23U;
-            When(Method(mockNimBLEServer, getPeerMTU)).Return(0, expectedMtu);
+            const auto expectedMtu = 512U;
+            When(Method(mockNimBLEServer, getPeerMTU)).Return(1'200);
 
-            const auto mtu = extendedMetricBleService.calculateMtu(clientIds);
+            const auto mtu = extendedMetricBleService.calculateMtu(0);
 
             REQUIRE(mtu == expectedMtu);
         }
 
-        SECTION("return max MTU when clientId list is empty")
+        SECTION("return zero MTU when the connection is not known")
         {
-            const auto expectedMaxMtu = 512U;
+            When(Method(mockNimBLEServer, getPeerMTU)).Return(0);
 
-            const auto mtu = extendedMetricBleService.calculateMtu({});
+            const auto mtu = extendedMetricBleService.calculateMtu(0);
 
-            REQUIRE(mtu == expectedMaxMtu);
+            REQUIRE(mtu == 0);
         }
     }
 }
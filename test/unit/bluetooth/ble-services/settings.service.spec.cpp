@@ -1,4 +1,5 @@
 // NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while, modernize-type-traits)
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cmath>
@@ -13,6 +14,7 @@
 #include "../../include/ArduinoLog.h"
 #include "../../include/NimBLEDevice.h"
 
+#include "../../../../src/peripherals/bluetooth/ble-metrics.model.h"
 #include "../../../../src/peripherals/bluetooth/ble-services/settings.service.h"
 #include "../../../../src/peripherals/bluetooth/ble-services/settings.service.interface.h"
 #include "../../../../src/peripherals/bluetooth/ble.enums.h"
@@ -75,6 +77,9 @@ TEST_CASE("SettingsBleService", "[ble-service]")
         static_cast<unsigned char>(dragFactorUpperThreshold),
         static_cast<unsigned char>(dragFactorUpperThreshold >> 8),
         RowerProfile::Defaults::dragCoefficientsArrayLength,
+        std::to_underlying(DeltaTimeEncoding::Raw),
+        std::to_underlying(HandleForcesEncoding::Float),
+        0,
     };
 
     const auto strokeDetectionAndImpulseEncoded = (std::to_underlying(RowerProfile::Defaults::strokeDetectionType) & 0x03) |
@@ -183,7 +188,7 @@ TEST_CASE("SettingsBleService", "[ble-service]")
                     .Using(CommonBleFlags::settingsControlPointUuid, expectedControlPointProperty))
                 .Once();
 
-            Verify(Method(mockSettingsCharacteristic, setCallbacks).Using(Ne(nullptr))).Once();
+            Verify(Method(mockSettingsCharacteristic, setCallbacks).Using(Ne(nullptr))).Exactly(2);
         }
 
         SECTION("should return the created settings NimBLEService")
@@ -397,6 +402,69 @@ TEST_CASE("SettingsBleService", "[ble-service]")
 
             Verify(Method(mockSettingsCharacteristic, notify));
         }
+
+        SECTION("notify every connection with its own client settings")
+        {
+            const unsigned short rawConnectionHandle = 1;
+            const unsigned short varintConnectionHandle = 2;
+            auto expectedVarintSettings = expectedInitialSettings;
+            expectedVarintSettings[18] = std::to_underlying(DeltaTimeEncoding::Varint);
+
+            settingsBleService.addConnection(rawConnectionHandle);
+            settingsBleService.addConnection(varintConnectionHandle);
+            settingsBleService.setDeltaTimeEncoding(varintConnectionHandle, DeltaTimeEncoding::Varint);
+
+            settingsBleService.broadcastSettings();
+
+            Verify(OverloadedMethod(mockSettingsCharacteristic, setValue, void(const std::array<unsigned char, ISettingsBleService::settingsPayloadSize>)).Using(Eq(expectedInitialSettings)),
+                   Method(mockSettingsCharacteristic, notify).Using(rawConnectionHandle),
+                   OverloadedMethod(mockSettingsCharacteristic, setValue, void(const std::array<unsigned char, ISettingsBleService::settingsPayloadSize>)).Using(Eq(expectedVarintSettings)),
+                   Method(mockSettingsCharacteristic, notify).Using(varintConnectionHandle));
+            Verify(Method(mockSettingsCharacteristic, notify).Using(BLE_HS_CONN_HANDLE_NONE)).Never();
+        }
+    }
+
+    SECTION("settings characteristic read callback should")
+    {
+        const unsigned short connectionHandle = 1;
+        Mock<NimBLEConnInfo> mockConnectionInfo;
+        When(Method(mockConnectionInfo, getConnHandle)).AlwaysReturn(connectionHandle);
+
+        NimBLECharacteristicCallbacks *settingsCallbacks = nullptr;
+        When(Method(mockSettingsCharacteristic, setCallbacks))
+            .Do([&settingsCallbacks](NimBLECharacteristicCallbacks *callbacks)
+                { settingsCallbacks = callbacks; })
+            .AlwaysDo([](NimBLECharacteristicCallbacks *) {});
+
+        settingsBleService.setup(&mockNimBLEServer.get());
+        mockSettingsCharacteristic.ClearInvocationHistory();
+
+        SECTION("set the settings with the client settings of the reading connection")
+        {
+            auto expectedSettings = expectedInitialSettings;
+            expectedSettings[18] = std::to_underlying(DeltaTimeEncoding::Varint);
+            expectedSettings[19] = std::to_underlying(HandleForcesEncoding::Int16);
+            expectedSettings[20] = 5;
+
+            settingsBleService.addConnection(connectionHandle);
+            settingsBleService.setDeltaTimeEncoding(connectionHandle, DeltaTimeEncoding::Varint);
+            settingsBleService.setHandleForcesEncoding(connectionHandle, HandleForcesEncoding::Int16, 5);
+
+            settingsCallbacks->onRead(&mockSettingsCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockSettingsCharacteristic, setValue, void(const std::array<unsigned char, ISettingsBleService::settingsPayloadSize>))
+                       .Using(Eq(expectedSettings)))
+                .Once();
+        }
+
+        SECTION("set the default client settings for an unknown connection")
+        {
+            settingsCallbacks->onRead(&mockSettingsCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockSettingsCharacteristic, setValue, void(const std::array<unsigned char, ISettingsBleService::settingsPayloadSize>))
+                       .Using(Eq(expectedInitialSettings)))
+                .Once();
+        }
     }
 
     SECTION("broadcastStrokeDetectionSettings method should")
@@ -467,5 +535,75 @@ TEST_CASE("SettingsBleService", "[ble-service]")
             Verify(Method(mockStrokeSettingsCharacteristic, notify)).Once();
         }
     }
+    SECTION("getClientSettings method should")
+    {
+        const unsigned short connectionHandle = 1;
+        const unsigned short otherConnectionHandle = 2;
+
+        SECTION("return empty slots when no client is connected")
+        {
+            const auto clients = settingsBleService.getClientSettings();
+
+            REQUIRE(std::ranges::all_of(clients, [](const BleMetricsModel::ClientSettings &client)
+                                        { return client == BleMetricsModel::ClientSettings{}; }));
+        }
+
+        SECTION("start a new connection with the raw delta time and the float handle forces encoding without simplification")
+        {
+            settingsBleService.addConnection(connectionHandle);
+
+            const auto clients = settingsBleService.getClientSettings();
+
+            REQUIRE(clients[0] == BleMetricsModel::ClientSettings{
+                                      .connectionHandle = connectionHandle,
+                                      .deltaTimeEncoding = DeltaTimeEncoding::Raw,
+                                      .handleForcesEncoding = HandleForcesEncoding::Float,
+                                      .handleForcesMaxError = 0,
+                                  });
+        }
+
+        SECTION("return the encoding requested by each client separately")
+        {
+            settingsBleService.addConnection(connectionHandle);
+            settingsBleService.addConnection(otherConnectionHandle);
+
+            settingsBleService.setDeltaTimeEncoding(otherConnectionHandle, DeltaTimeEncoding::Varint);
+
+            const auto clients = settingsBleService.getClientSettings();
+
+            REQUIRE(clients[0] == BleMetricsModel::ClientSettings{.connectionHandle = connectionHandle, .deltaTimeEncoding = DeltaTimeEncoding::Raw});
+            REQUIRE(clients[1] == BleMetricsModel::ClientSettings{.connectionHandle = otherConnectionHandle, .deltaTimeEncoding = DeltaTimeEncoding::Varint});
+        }
+
+        SECTION("return the handle forces encoding and max error requested by each client separately")
+        {
+            settingsBleService.addConnection(connectionHandle);
+            settingsBleService.addConnection(otherConnectionHandle);
+
+            settingsBleService.setHandleForcesEncoding(connectionHandle, HandleForcesEncoding::Int16, 5);
+            settingsBleService.setDeltaTimeEncoding(connectionHandle, DeltaTimeEncoding::Varint);
+
+            const auto clients = settingsBleService.getClientSettings();
+
+            REQUIRE(clients[0].handleForcesEncoding == HandleForcesEncoding::Int16);
+            REQUIRE(clients[0].handleForcesMaxError == 5);
+            REQUIRE(clients[0].deltaTimeEncoding == DeltaTimeEncoding::Varint);
+            REQUIRE(clients[1].handleForcesEncoding == HandleForcesEncoding::Float);
+            REQUIRE(clients[1].handleForcesMaxError == 0);
+        }
+
+        SECTION("reset the encoding once the client disconnects")
+        {
+            settingsBleService.addConnection(connectionHandle);
+            settingsBleService.setDeltaTimeEncoding(connectionHandle, DeltaTimeEncoding::Varint);
+
+            settingsBleService.removeConnection(connectionHandle);
+            settingsBleService.addConnection(connectionHandle);
+
+            const auto clients = settingsBleService.getClientSettings();
+
+            REQUIRE(clients[0].deltaTimeEncoding == DeltaTimeEncoding::Raw);
+        }
+    }
 }
 // NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while, modernize-type-traits)
\ No newline at end of file
@@ -2,8 +2,11 @@
 #include "catch2/catch_test_macros.hpp"
 #include "fakeit.hpp"
 
+#include "../include/Arduino.h"
 #include "../include/NimBLEDevice.h"
 
+#include "../../../src/peripherals/bluetooth/ble-notification.worker.h"
+#include "../../../src/peripherals/bluetooth/ble-services/settings.service.interface.h"
 #include "../../../src/peripherals/bluetooth/callbacks/connection-manager.callbacks.h"
 
 using namespace fakeit;
@@ -13,15 +16,22 @@ TEST_CASE("ConnectionManagerCallbacks", "[callbacks]")
     mockNimBLEServer.Reset();
     mockNimBLEAdvertising.Reset();
     mockNimBLEService.Reset();
+    mockArduino.Reset();
 
     Mock<NimBLEConnInfo> mockConnectionInfo;
+    Mock<ISettingsBleService> mockSettingsBleService;
 
     When(Method(mockConnectionInfo, getConnHandle)).AlwaysReturn(0);
+    When(Method(mockConnectionInfo, getConnInterval)).AlwaysReturn(24);
+    When(Method(mockArduino, micros)).AlwaysReturn(0);
 
     Fake(Method(mockNimBLEAdvertising, start));
     Fake(Method(mockNimBLEAdvertising, stop));
+    Fake(Method(mockSettingsBleService, addConnection));
+    Fake(Method(mockSettingsBleService, removeConnection));
 
-    ConnectionManagerCallbacks connectionManagerCallbacks;
+    BleNotificationWorker notificationWorker;
+    ConnectionManagerCallbacks connectionManagerCallbacks(notificationWorker, mockSettingsBleService.get());
 
     SECTION("onConnect method should")
     {
@@ -45,6 +55,36 @@ TEST_CASE("ConnectionManagerCallbacks", "[callbacks]")
             Verify(Method(mockNimBLEAdvertising, stop)).Never();
             Verify(Method(mockNimBLEAdvertising, start)).Never();
         }
+
+        SECTION("register the connection with the notification scheduler")
+        {
+            When(Method(mockNimBLEServer, getConnectedCount)).AlwaysReturn(1);
+
+            connectionManagerCallbacks.onConnect(&mockNimBLEServer.get(), mockConnectionInfo.get());
+
+            REQUIRE(notificationWorker.getThroughput()[0].connectionHandle == 0);
+            Verify(Method(mockConnectionInfo, getConnInterval)).Once();
+        }
+
+        SECTION("start the connection with the default client settings")
+        {
+            When(Method(mockNimBLEServer, getConnectedCount)).AlwaysReturn(1);
+
+            connectionManagerCallbacks.onConnect(&mockNimBLEServer.get(), mockConnectionInfo.get());
+
+            Verify(Method(mockSettingsBleService, addConnection).Using(0)).Once();
+        }
+    }
+
+    SECTION("onConnParamsUpdate method should pass the new connection interval to the notification scheduler")
+    {
+        When(Method(mockNimBLEServer, getConnectedCount)).AlwaysReturn(1);
+
+        connectionManagerCallbacks.onConnect(&mockNimBLEServer.get(), mockConnectionInfo.get());
+        connectionManagerCallbacks.onConnParamsUpdate(mockConnectionInfo.get());
+
+        REQUIRE(notificationWorker.getThroughput()[0].connectionHandle == 0);
+        REQUIRE(notificationWorker.getThroughput()[1].connectionHandle == BleNotificationWorker::allClients);
     }
 
     SECTION("onDisconnect method should")
@@ -61,6 +101,26 @@ TEST_CASE("ConnectionManagerCallbacks", "[callbacks]")
 
             REQUIRE(connectionManagerCallbacks.getConnectionCount() == expectedConnectedCount);
         }
+
+        SECTION("remove the connection from the notification scheduler")
+        {
+            When(Method(mockNimBLEServer, getConnectedCount)).AlwaysReturn(1);
+
+            connectionManagerCallbacks.onConnect(&mockNimBLEServer.get(), mockConnectionInfo.get());
+            connectionManagerCallbacks.onDisconnect(&mockNimBLEServer.get(), mockConnectionInfo.get(), 0);
+
+            REQUIRE(notificationWorker.getThroughput()[0].connectionHandle == BleNotificationWorker::allClients);
+        }
+
+        SECTION("drop the client settings of the connection")
+        {
+            When(Method(mockNimBLEServer, getConnectedCount)).AlwaysReturn(1);
+
+            connectionManagerCallbacks.onConnect(&mockNimBLEServer.get(), mockConnectionInfo.get());
+            connectionManagerCallbacks.onDisconnect(&mockNimBLEServer.get(), mockConnectionInfo.get(), 0);
+
+            Verify(Method(mockSettingsBleService, removeConnection).Using(0)).Once();
+        }
     }
 }
 // NOLINTEND(readability-magic-numbers, cppcoreguidelines-avoid-do-while)
\ No newline at end of file
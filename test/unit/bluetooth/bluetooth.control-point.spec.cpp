@@ -37,6 +37,9 @@ TEST_CASE("ControlPointCallbacks onWrite method should", "[callbacks]")
     Mock<NimBLECharacteristic> mockControlPointCharacteristic;
     Mock<NimBLEConnInfo> mockConnectionInfo;
 
+    const unsigned short connectionHandle = 1;
+    When(Method(mockConnectionInfo, getConnHandle)).AlwaysReturn(connectionHandle);
+
     Fake(Method(mockControlPointCharacteristic, indicate));
     Fake(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>)));
 
@@ -55,6 +58,8 @@ TEST_CASE("ControlPointCallbacks onWrite method should", "[callbacks]")
 
     Fake(Method(mockSettingsBleService, broadcastSettings));
     Fake(Method(mockSettingsBleService, broadcastStrokeDetectionSettings));
+    Fake(Method(mockSettingsBleService, setDeltaTimeEncoding));
+    Fake(Method(mockSettingsBleService, setHandleForcesEncoding));
 
     ControlPointCallbacks controlPointCallback(mockSettingsBleService.get(), mockEEPROMService.get());
 
@@ -410,11 +415,132 @@ TEST_CASE("ControlPointCallbacks onWrite method should", "[callbacks]")
                 Verify(Method(mockEEPROMService, setLogToBluetooth).Using(expectedDeltaTimeLogging)).Once();
             }
 
+            SECTION("use the raw encoding for the writing client when it does not request one")
+            {
+                Verify(Method(mockSettingsBleService, setDeltaTimeEncoding).Using(connectionHandle, DeltaTimeEncoding::Raw)).Once();
+            }
+
             SECTION("notify new settings")
             {
                 Verify(Method(mockSettingsBleService, broadcastSettings)).Once();
             }
         }
+
+        SECTION("and when the compressed encoding is requested")
+        {
+            std::array<unsigned char, 3U> successResponse = {
+                std::to_underlying(SettingsOpCodes::ResponseCode),
+                std::to_underlying(SettingsOpCodes::SetDeltaTimeLogging),
+                std::to_underlying(ResponseOpCodes::Successful)};
+
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetDeltaTimeLogging), 1, std::to_underlying(DeltaTimeEncoding::Varint)});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>))
+                       .Using(Eq(successResponse)))
+                .Once();
+            Verify(Method(mockEEPROMService, setLogToBluetooth).Using(true)).Once();
+            Verify(Method(mockSettingsBleService, setDeltaTimeEncoding).Using(connectionHandle, DeltaTimeEncoding::Varint)).Once();
+        }
+
+        SECTION("and when the requested encoding is unknown return InvalidParameter response")
+        {
+            std::array<unsigned char, 3U> invalidParameterResponse = {
+                std::to_underlying(SettingsOpCodes::ResponseCode),
+                std::to_underlying(SettingsOpCodes::SetDeltaTimeLogging),
+                std::to_underlying(ResponseOpCodes::InvalidParameter)};
+
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetDeltaTimeLogging), 1, 2});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>))
+                       .Using(Eq(invalidParameterResponse)))
+                .Once();
+            Verify(Method(mockEEPROMService, setLogToBluetooth)).Never();
+            Verify(Method(mockSettingsBleService, setDeltaTimeEncoding)).Never();
+        }
+    }
+
+    SECTION("handle SetHandleForcesEncoding request")
+    {
+        std::array<unsigned char, 3U> successResponse = {
+            std::to_underlying(SettingsOpCodes::ResponseCode),
+            std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding),
+            std::to_underlying(ResponseOpCodes::Successful)};
+        std::array<unsigned char, 3U> invalidParameterResponse = {
+            std::to_underlying(SettingsOpCodes::ResponseCode),
+            std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding),
+            std::to_underlying(ResponseOpCodes::InvalidParameter)};
+
+        SECTION("and when the int16 encoding is requested without max error keep every value")
+        {
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding), std::to_underlying(HandleForcesEncoding::Int16)});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(Method(mockControlPointCharacteristic, indicate)).Once();
+            Verify(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>))
+                       .Using(Eq(successResponse)))
+                .Once();
+            Verify(Method(mockSettingsBleService, setHandleForcesEncoding).Using(connectionHandle, HandleForcesEncoding::Int16, 0)).Once();
+        }
+
+        SECTION("and when the int16 encoding is requested with max error save both for the writing client and broadcast the settings")
+        {
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding), std::to_underlying(HandleForcesEncoding::Int16), 5});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>))
+                       .Using(Eq(successResponse)))
+                .Once();
+            Verify(Method(mockSettingsBleService, setHandleForcesEncoding).Using(connectionHandle, HandleForcesEncoding::Int16, 5)).Once();
+            Verify(Method(mockSettingsBleService, broadcastSettings)).Once();
+        }
+
+        SECTION("and when the float encoding is requested go back to the float format")
+        {
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding), std::to_underlying(HandleForcesEncoding::Float)});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(Method(mockSettingsBleService, setHandleForcesEncoding).Using(connectionHandle, HandleForcesEncoding::Float, 0)).Once();
+        }
+
+        SECTION("and when the encoding is unknown return InvalidParameter response")
+        {
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding), 2});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>))
+                       .Using(Eq(invalidParameterResponse)))
+                .Once();
+            Verify(Method(mockSettingsBleService, setHandleForcesEncoding)).Never();
+        }
+
+        SECTION("and when the max error is too large return InvalidParameter response")
+        {
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding), std::to_underlying(HandleForcesEncoding::Int16), ISettingsBleService::maxHandleForcesError + 1});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(OverloadedMethod(mockControlPointCharacteristic, setValue, void(const std::array<unsigned char, 3U>))
+                       .Using(Eq(invalidParameterResponse)))
+                .Once();
+            Verify(Method(mockSettingsBleService, setHandleForcesEncoding)).Never();
+        }
+
+        SECTION("and when a max error is sent with the float encoding return InvalidParameter response")
+        {
+            When(Method(mockControlPointCharacteristic, getValue)).Return({std::to_underlying(SettingsOpCodes::SetHandleForcesEncoding), std::to_underlying(HandleForcesEncoding::Float), 5});
+
+            controlPointCallback.onWrite(&mockControlPointCharacteristic.get(), mockConnectionInfo.get());
+
+            Verify(Method(mockSettingsBleService, setHandleForcesEncoding)).Never();
+        }
     }
 
     SECTION("handle RestartDevice request")
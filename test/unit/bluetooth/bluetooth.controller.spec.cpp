@@ -48,7 +48,6 @@ TEST_CASE("BluetoothController", "[peripheral]")
     Mock<IConnectionManagerCallbacks> mockConnectionManagerCallbacks;
 
     const auto serviceFlag = BleServiceFlag::CpsService;
-    const auto minimumDeltaTimeMtu = 100;
     const RowingDataModels::RowingMetrics expectedData{
         .distance = 100,
         .lastRevTime = 2'000,
@@ -59,6 +58,7 @@ TEST_CASE("BluetoothController", "[peripheral]")
         .avgStrokePower = 70,
         .dragCoefficient = 0.00001,
         .driveHandleForces = {1.1, 2.2, 100.1},
+        .handleForcesRevision = 1,
     };
     const std::vector<unsigned char> emptyClientIds{};
 
@@ -71,6 +71,7 @@ TEST_CASE("BluetoothController", "[peripheral]")
 
     When(Method(mockBatteryBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
     When(Method(mockSettingsBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
+    When(Method(mockSettingsBleService, getClientSettings)).AlwaysReturn(BleMetricsModel::ClientSettingsList{});
     When(Method(mockDeviceInfoBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
     When(Method(mockOtaBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
     When(Method(mockOtaBleService, getOtaTx)).AlwaysReturn(&mockNimBLECharacteristic.get());
@@ -82,8 +83,9 @@ TEST_CASE("BluetoothController", "[peripheral]")
     When(Method(mockExtendedMetricsBleService, getHandleForcesClientIds)).AlwaysReturn(emptyClientIds);
     When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(emptyClientIds);
     When(Method(mockExtendedMetricsBleService, getExtendedMetricsClientIds)).AlwaysReturn(emptyClientIds);
-    When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(0);
-    Fake(Method(mockExtendedMetricsBleService, broadcastDeltaTimes));
+    When(Method(mockExtendedMetricsBleService, getDiagnosticsClientIds)).AlwaysReturn(emptyClientIds);
+    Fake(Method(mockExtendedMetricsBleService, bufferDeltaTime));
+    Fake(Method(mockExtendedMetricsBleService, flushDeltaTimes));
 
     Fake(Method(mockNimBLEAdvertising, start));
     Fake(Method(mockNimBLEAdvertising, stop));
@@ -100,8 +102,6 @@ TEST_CASE("BluetoothController", "[peripheral]")
 
     SECTION("update method")
     {
-        const auto expectedDeltaTime = 10'000;
-
         When(Method(mockArduino, millis)).Return(0);
         bluetoothController.notifyNewMetrics(expectedData);
         mockBaseMetricsBleService.ClearInvocationHistory();
@@ -158,68 +158,24 @@ TEST_CASE("BluetoothController", "[peripheral]")
             Verify(Method(mockBaseMetricsBleService, broadcastBaseMetrics)).Never();
         }
 
-        SECTION("broadcast deltaTimes when last notification was send more than 1 seconds ago and MTU is above minimum, clear vector and reserve memory based on MTU")
+        SECTION("flush the buffered deltaTimes of the clients with the BLE update interval")
         {
-            const auto blinkInterval = Configurations::ledBlinkFrequency + 1U;
-
-            std::vector<std::vector<unsigned long>> notifiedDeltaTimes{};
-            When(Method(mockArduino, millis)).Return(blinkInterval, blinkInterval);
+            When(Method(mockArduino, millis)).Return(1'001);
             When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturnValCapt({0});
-            When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-            Fake(Method(mockExtendedMetricsBleService, broadcastDeltaTimes).Matching([&notifiedDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                                     {
-                notifiedDeltaTimes.push_back(deltaTimes);
-
-                return true; }));
-            bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
 
             bluetoothController.update();
 
-            REQUIRE_THAT(notifiedDeltaTimes, Catch::Matchers::SizeIs(1));
-            REQUIRE_THAT(notifiedDeltaTimes[0], Catch::Matchers::RangeEquals(std::vector<unsigned long>{expectedDeltaTime}));
-            Verify(Method(mockExtendedMetricsBleService, broadcastDeltaTimes).Matching([](const std::vector<unsigned long> &deltaTimes)
-                                                                                       { return deltaTimes.capacity() == minimumDeltaTimeMtu / sizeof(unsigned long) + 1U && deltaTimes.empty(); }))
-                .Once();
+            Verify(Method(mockExtendedMetricsBleService, flushDeltaTimes).Using(1'000U)).Once();
         }
 
-        SECTION("not broadcast deltaTimes when")
+        SECTION("not flush deltaTimes when no client is subscribed")
         {
-            bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-
-            SECTION("last notification was send less than 1 seconds ago")
-            {
-                When(Method(mockArduino, millis)).AlwaysReturn(999);
-                When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-                When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturnValCapt({0});
-                bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-
-                bluetoothController.update();
-
-                Verify(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).Never();
-            }
-
-            SECTION("no client is connected")
-            {
-                When(Method(mockArduino, millis)).AlwaysReturn(1'001);
-                When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).ReturnValCapt({0}).AlwaysReturn(emptyClientIds);
-                When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-                bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-
-                bluetoothController.update();
-
-                Verify(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).Never();
-            }
-
-            SECTION("deltaTimes vector is empty")
-            {
-                When(Method(mockArduino, millis)).AlwaysReturn(1'001);
-                When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-                When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturnValCapt({0});
+            When(Method(mockArduino, millis)).Return(1'001);
+            When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(emptyClientIds);
 
-                bluetoothController.update();
+            bluetoothController.update();
 
-                Verify(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).Never();
-            }
+            Verify(Method(mockExtendedMetricsBleService, flushDeltaTimes)).Never();
         }
     }
 
@@ -1,4 +1,5 @@
 // NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <span>
 #include <vector>
 
 #include "catch2/catch_test_macros.hpp"
@@ -52,6 +53,7 @@ TEST_CASE("BluetoothController", "[callbacks]")
         .avgStrokePower = 70.1212,
         .dragCoefficient = 110 / 1e6,
         .driveHandleForces = {1.1, 2.2, 100.1},
+        .handleForcesRevision = 1,
     };
     const unsigned int bleUpdateInterval = 1'000 + 1;
     const std::vector<unsigned char> emptyClientIds{};
@@ -72,6 +74,7 @@ TEST_CASE("BluetoothController", "[callbacks]")
     Fake(Method(mockOtaUpdaterService, begin));
 
     When(Method(mockSettingsBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
+    When(Method(mockSettingsBleService, getClientSettings)).AlwaysReturn(BleMetricsModel::ClientSettingsList{});
     When(Method(mockBatteryBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
     When(Method(mockDeviceInfoBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
     When(Method(mockOtaBleService, setup)).AlwaysReturn(&mockNimBLEService.get());
@@ -85,9 +88,11 @@ TEST_CASE("BluetoothController", "[callbacks]")
     When(Method(mockExtendedMetricsBleService, getHandleForcesClientIds)).AlwaysReturnValCapt({0});
     When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(emptyClientIds);
     When(Method(mockExtendedMetricsBleService, getExtendedMetricsClientIds)).AlwaysReturn(emptyClientIds);
+    When(Method(mockExtendedMetricsBleService, getDiagnosticsClientIds)).AlwaysReturn(emptyClientIds);
     Fake(Method(mockExtendedMetricsBleService, broadcastExtendedMetrics));
+    Fake(Method(mockExtendedMetricsBleService, broadcastDiagnostics));
     Fake(Method(mockExtendedMetricsBleService, broadcastHandleForces));
-    When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(0);
+    Fake(Method(mockExtendedMetricsBleService, bufferDeltaTime));
 
     BluetoothController bluetoothController(mockEEPROMService.get(), mockOtaUpdaterService.get(), mockSettingsBleService.get(), mockBatteryBleService.get(), mockDeviceInfoBleService.get(), mockOtaBleService.get(), mockBaseMetricsBleService.get(), mockExtendedMetricsBleService.get(), mockConnectionManagerCallbacks.get());
 
@@ -158,6 +163,7 @@ TEST_CASE("BluetoothController", "[callbacks]")
                     .avgStrokePower = 70,
                     .dragCoefficient = 0.00001,
                     .driveHandleForces = {},
+                    .handleForcesRevision = 0,
                 };
 
                 When(Method(mockExtendedMetricsBleService, getHandleForcesClientIds)).ReturnValCapt({0});
@@ -173,7 +179,41 @@ TEST_CASE("BluetoothController", "[callbacks]")
 
                 bluetoothController.notifyNewMetrics(expectedData);
 
-                Verify(Method(mockExtendedMetricsBleService, broadcastHandleForces).Using(Eq(expectedData.driveHandleForces))).Once();
+                Verify(Method(mockExtendedMetricsBleService, broadcastHandleForces).Using(Eq(expectedData.driveHandleForces), BleMetricsModel::ClientSettingsList{})).Once();
+            }
+
+            SECTION("subscribed should broadcast with the encoding and max error each client requested")
+            {
+                const BleMetricsModel::ClientSettingsList clientSettings = {
+                    BleMetricsModel::ClientSettings{.connectionHandle = 0, .handleForcesEncoding = HandleForcesEncoding::Int16, .handleForcesMaxError = 5U},
+                };
+                When(Method(mockExtendedMetricsBleService, getHandleForcesClientIds)).ReturnValCapt({0});
+                When(Method(mockSettingsBleService, getClientSettings)).AlwaysReturn(clientSettings);
+
+                bluetoothController.notifyNewMetrics(expectedData);
+
+                Verify(Method(mockExtendedMetricsBleService, broadcastHandleForces).Using(Eq(expectedData.driveHandleForces), clientSettings)).Once();
+            }
+        }
+
+        SECTION("when diagnostics is")
+        {
+            SECTION("not subscribed should not broadcast")
+            {
+                bluetoothController.notifyNewMetrics(expectedData);
+
+                Verify(Method(mockExtendedMetricsBleService, broadcastDiagnostics)).Never();
+            }
+
+            SECTION("subscribed should broadcast without the profiler when profiling is disabled")
+            {
+                When(Method(mockExtendedMetricsBleService, getDiagnosticsClientIds)).AlwaysReturnValCapt({0});
+
+                bluetoothController.notifyNewMetrics(expectedData);
+
+                Verify(Method(mockExtendedMetricsBleService, broadcastDiagnostics).Matching([](const PipelineProfiler *const profiler, const RowingDataModels::RowingMetrics &)
+                                                                                           { return profiler == nullptr; }))
+                    .Once();
             }
         }
 
@@ -234,107 +274,28 @@ TEST_CASE("BluetoothController", "[callbacks]")
 
     SECTION("notifyNewDeltaTime method should")
     {
-        std::vector<unsigned long> expectedDeltaTimes{10'000, 11'000, 12'000, 11'000};
         const auto expectedDeltaTime = 10'000UL;
-        const auto minimumDeltaTimeMtu = 100;
-        const std::vector<unsigned char> clientIds{0};
-
-        Fake(Method(mockExtendedMetricsBleService, broadcastDeltaTimes));
 
-        SECTION("ignore new value when no client is connected")
+        SECTION("ignore new value when no client is subscribed")
         {
-            std::vector<std::vector<unsigned long>> resultDeltaTimes;
-
-            When(Method(mockArduino, millis)).AlwaysReturn(bleUpdateInterval);
             When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(emptyClientIds);
-            When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-            When(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).AlwaysDo([&resultDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                                      {
-                            resultDeltaTimes.push_back(deltaTimes);
-
-                            return true; });
 
             bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-            bluetoothController.update();
 
-            Verify(Method(mockExtendedMetricsBleService, calculateMtu)).Never();
-            REQUIRE_THAT(resultDeltaTimes, Catch::Matchers::IsEmpty());
+            Verify(Method(mockExtendedMetricsBleService, bufferDeltaTime)).Never();
         }
 
-        SECTION("ignore new value when client MTU is below 100")
+        SECTION("buffer the new value for the subscribed clients in the encoding they opted in to")
         {
-            std::vector<std::vector<unsigned long>> resultDeltaTimes;
-
-            When(Method(mockArduino, millis)).AlwaysReturn(bleUpdateInterval);
-            When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu - 1);
-            When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(clientIds);
-            When(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).AlwaysDo([&resultDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                                      {
-                            resultDeltaTimes.push_back(deltaTimes);
-
-                            return true; });
+            const BleMetricsModel::ClientSettingsList clientSettings = {
+                BleMetricsModel::ClientSettings{.connectionHandle = 0, .deltaTimeEncoding = DeltaTimeEncoding::Varint},
+            };
+            When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturnValCapt({0});
+            When(Method(mockSettingsBleService, getClientSettings)).AlwaysReturn(clientSettings);
 
             bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-            bluetoothController.update();
-
-            REQUIRE_THAT(resultDeltaTimes, Catch::Matchers::IsEmpty());
-        }
-
-        SECTION("add new value to deltaTimes array when client MTU is at least 100")
-        {
-            std::vector<std::vector<unsigned long>> resultDeltaTimes;
-
-            When(Method(mockArduino, millis)).AlwaysReturn(bleUpdateInterval + 1);
-            When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-            When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(clientIds);
-            When(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).AlwaysDo([&resultDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                                      {
-                            resultDeltaTimes.push_back(deltaTimes);
-
-                            return true; });
-
-            bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-            bluetoothController.update();
-
-            REQUIRE_THAT(resultDeltaTimes, Catch::Matchers::SizeIs(1));
-        }
-
-        SECTION("flush deltaTimes via bluetooth when client MTU capacity is reached")
-        {
-            std::vector<std::vector<unsigned long>> resultDeltaTimes;
-
-            When(Method(mockArduino, millis)).AlwaysReturn(bleUpdateInterval);
-            When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-            When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(clientIds);
-            Fake(Method(mockExtendedMetricsBleService, broadcastDeltaTimes).Matching([&resultDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                                     {
-                                    resultDeltaTimes.push_back(deltaTimes);
-
-                                    return true; }));
-
-            auto i = 0U;
-            while ((i + 1) * sizeof(unsigned long) < minimumDeltaTimeMtu - 3)
-            {
-                bluetoothController.notifyNewDeltaTime(expectedDeltaTime + i);
-                ++i;
-            }
-
-            REQUIRE_THAT(resultDeltaTimes, Catch::Matchers::SizeIs(1));
-            REQUIRE_THAT(resultDeltaTimes[0], Catch::Matchers::SizeIs(i));
-        }
-
-        SECTION("reset lastDeltaTimesBroadcastTime after flushing deltaTimes via bluetooth")
-        {
-            When(Method(mockArduino, millis)).Return(bleUpdateInterval, bleUpdateInterval, (bleUpdateInterval - 1) * 2);
-            When(Method(mockExtendedMetricsBleService, getDeltaTimesClientIds)).AlwaysReturn(clientIds);
-            When(Method(mockExtendedMetricsBleService, calculateMtu)).AlwaysReturn(minimumDeltaTimeMtu);
-
-            bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-            bluetoothController.update();
-            bluetoothController.notifyNewDeltaTime(expectedDeltaTime);
-            bluetoothController.update();
 
-            Verify(Method(mockExtendedMetricsBleService, broadcastDeltaTimes)).Once();
+            Verify(Method(mockExtendedMetricsBleService, bufferDeltaTime).Using(expectedDeltaTime, clientSettings)).Once();
         }
     }
 }
@@ -1,4 +1,6 @@
 // NOLINTBEGIN(readability-magic-numbers, cppcoreguidelines-avoid-do-while)
+#include <algorithm>
+
 #include "catch2/catch_test_macros.hpp"
 #include "fakeit.hpp"
 
@@ -15,7 +17,7 @@ TEST_CASE("SubscriptionManagerCallbacks onSubscribed method", "[callbacks]")
     Mock<NimBLEConnInfo> mockConnectionInfo;
     When(Method(mockConnectionInfo, getConnHandle)).AlwaysReturn(0);
 
-    SubscriptionManagerCallbacks chunkedNotifyMetricCallback;
+    SubscriptionManagerCallbacks<> chunkedNotifyMetricCallback;
 
     SECTION("should add new connection's client ID to client ID list when subscribing")
     {
@@ -30,5 +32,87 @@ TEST_CASE("SubscriptionManagerCallbacks onSubscribed method", "[callbacks]")
 
         REQUIRE(chunkedNotifyMetricCallback.getClientIds().empty());
     }
+
+    SECTION("should not add the same client twice when the subscription changes")
+    {
+        chunkedNotifyMetricCallback.onSubscribe(&mockNimBLECharacteristic.get(), mockConnectionInfo.get(), 1);
+        chunkedNotifyMetricCallback.onSubscribe(&mockNimBLECharacteristic.get(), mockConnectionInfo.get(), 2);
+
+        REQUIRE(chunkedNotifyMetricCallback.getClientIds().size() == 1);
+        REQUIRE(std::ranges::count_if(chunkedNotifyMetricCallback.getClients(), [](const auto &client)
+                                      { return client.isSubscribed; }) == 1);
+    }
+}
+
+TEST_CASE("SubscriptionManagerCallbacks per client state", "[callbacks]")
+{
+    mockNimBLECharacteristic.Reset();
+
+    struct ClientState
+    {
+        unsigned int bufferedCount = 0;
+    };
+
+    Mock<NimBLEConnInfo> mockFirstConnectionInfo;
+    Mock<NimBLEConnInfo> mockSecondConnectionInfo;
+    When(Method(mockFirstConnectionInfo, getConnHandle)).AlwaysReturn(1);
+    When(Method(mockSecondConnectionInfo, getConnHandle)).AlwaysReturn(2);
+
+    SubscriptionManagerCallbacks<ClientState> subscriptionManager;
+
+    subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockFirstConnectionInfo.get(), 1);
+    subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockSecondConnectionInfo.get(), 1);
+
+    SECTION("should give every subscribed client its own slot")
+    {
+        const auto clients = subscriptionManager.getClients();
+
+        REQUIRE(clients[0].isSubscribed);
+        REQUIRE(clients[0].connectionHandle == 1);
+        REQUIRE(clients[1].isSubscribed);
+        REQUIRE(clients[1].connectionHandle == 2);
+    }
+
+    SECTION("should keep the slot of the other client when one unsubscribes")
+    {
+        subscriptionManager.getClients()[1].state.bufferedCount = 5;
+
+        subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockFirstConnectionInfo.get(), 0);
+
+        const auto clients = subscriptionManager.getClients();
+        REQUIRE_FALSE(clients[0].isSubscribed);
+        REQUIRE(clients[1].connectionHandle == 2);
+        REQUIRE(clients[1].state.bufferedCount == 5);
+    }
+
+    SECTION("should reset the state of a freed slot when a client subscribes again")
+    {
+        subscriptionManager.getClients()[0].state.bufferedCount = 5;
+
+        subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockFirstConnectionInfo.get(), 0);
+        subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockFirstConnectionInfo.get(), 1);
+
+        const auto clients = subscriptionManager.getClients();
+        REQUIRE(clients[0].isSubscribed);
+        REQUIRE(clients[0].state.bufferedCount == 0);
+    }
+
+    SECTION("should only apply a subscription to the slots when the clients are requested")
+    {
+        const auto clients = subscriptionManager.getClients();
+        clients[0].state.bufferedCount = 5;
+
+        subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockFirstConnectionInfo.get(), 0);
+        subscriptionManager.onSubscribe(&mockNimBLECharacteristic.get(), mockFirstConnectionInfo.get(), 1);
+
+        REQUIRE(clients[0].isSubscribed);
+        REQUIRE(clients[0].state.bufferedCount == 5);
+
+        const auto appliedClients = subscriptionManager.getClients();
+
+        REQUIRE(appliedClients[0].isSubscribed);
+        REQUIRE(appliedClients[0].connectionHandle == 1);
+        REQUIRE(appliedClients[0].state.bufferedCount == 0);
+    }
 }
 // NOLINTEND(readability-magic-numbers, cppcoreguidelines-avoid-do-while)
\ No newline at end of file
@@ -0,0 +1,147 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/peripherals/bluetooth/handle-forces.encoder.h"
+
+using std::vector;
+
+namespace
+{
+    struct Point
+    {
+        unsigned char index;
+        float force;
+    };
+
+    vector<Point> decode(const std::span<const unsigned char> points, const unsigned char pointSize, const float scale)
+    {
+        vector<Point> decoded;
+        auto position = 0U;
+        while (position < points.size())
+        {
+            const auto index = pointSize == HandleForcesEncoder::indexedValueSize ? points[position++] : static_cast<unsigned char>(decoded.size());
+            const auto value = static_cast<short>(points[position] | (points[position + 1] << 8U));
+            position += 2U;
+            decoded.push_back({.index = index, .force = static_cast<float>(value) * scale});
+        }
+
+        return decoded;
+    }
+
+    // Largest distance between the curve and the straight lines drawn between the decoded points
+    float maxInterpolationError(const vector<float> &handleForces, const vector<Point> &points)
+    {
+        auto maxError = 0.0F;
+        auto i = 0U;
+        while (i + 1U < points.size())
+        {
+            const auto &start = points[i];
+            const auto &end = points[i + 1U];
+            auto index = static_cast<unsigned int>(start.index);
+            while (index <= end.index)
+            {
+                const auto interpolated = start.force + (end.force - start.force) * static_cast<float>(index - start.index) / static_cast<float>(end.index - start.index);
+                maxError = std::max(maxError, std::abs(interpolated - handleForces[index]));
+                ++index;
+            }
+            ++i;
+        }
+
+        return maxError;
+    }
+}
+
+TEST_CASE("HandleForcesEncoder", "[peripheral]")
+{
+    HandleForcesEncoder encoder;
+
+    vector<float> handleForces;
+    auto i = 0U;
+    while (i < 40U)
+    {
+        handleForces.push_back(450.0F * std::sin(static_cast<float>(i) / 39.0F * 3.14159F) + 20.0F * std::sin(static_cast<float>(i)));
+        ++i;
+    }
+    const auto peak = std::ranges::max(handleForces);
+
+    SECTION("encode method should")
+    {
+        SECTION("map the largest force to the largest int16 value")
+        {
+            encoder.encode(handleForces, 0);
+
+            REQUIRE_THAT(encoder.getScale(), Catch::Matchers::WithinRel(peak / SHRT_MAX, 1e-6F));
+        }
+
+        SECTION("keep every value without the sample index when no error is allowed")
+        {
+            const auto points = encoder.encode(handleForces, 0);
+
+            REQUIRE(encoder.getPointSize() == HandleForcesEncoder::valueSize);
+            REQUIRE(points.size() == handleForces.size() * HandleForcesEncoder::valueSize);
+
+            const auto decoded = decode(points, encoder.getPointSize(), encoder.getScale());
+            i = 0U;
+            while (i < handleForces.size())
+            {
+                REQUIRE_THAT(decoded[i].force, Catch::Matchers::WithinAbs(handleForces[i], encoder.getScale()));
+                ++i;
+            }
+        }
+
+        SECTION("keep the first and the last value and stay within the allowed error when simplifying")
+        {
+            const unsigned char maxError = 10U;
+            const auto points = encoder.encode(handleForces, maxError);
+            const auto decoded = decode(points, encoder.getPointSize(), encoder.getScale());
+
+            REQUIRE(encoder.getPointSize() == HandleForcesEncoder::indexedValueSize);
+            REQUIRE(decoded.size() < handleForces.size());
+            REQUIRE(decoded.front().index == 0);
+            REQUIRE(decoded.back().index == handleForces.size() - 1U);
+            REQUIRE(maxInterpolationError(handleForces, decoded) <= peak * maxError / 1'000.0F + encoder.getScale());
+        }
+
+        SECTION("reduce a straight line to its end points")
+        {
+            const vector<float> line{0.0F, 10.0F, 20.0F, 30.0F, 40.0F};
+
+            const auto points = encoder.encode(line, 1U);
+            const auto decoded = decode(points, encoder.getPointSize(), encoder.getScale());
+
+            REQUIRE(decoded.size() == 2);
+            REQUIRE(decoded.back().index == 4);
+        }
+
+        SECTION("handle negative forces")
+        {
+            const vector<float> forces{-100.0F, 50.0F, 25.0F};
+
+            const auto points = encoder.encode(forces, 0);
+            const auto decoded = decode(points, encoder.getPointSize(), encoder.getScale());
+
+            REQUIRE_THAT(decoded[0].force, Catch::Matchers::WithinAbs(-100.0F, encoder.getScale()));
+            REQUIRE_THAT(decoded[1].force, Catch::Matchers::WithinAbs(50.0F, encoder.getScale()));
+        }
+
+        SECTION("not divide by zero when every force is zero")
+        {
+            const vector<float> forces{0.0F, 0.0F, 0.0F};
+
+            const auto points = encoder.encode(forces, 5U);
+            const auto decoded = decode(points, encoder.getPointSize(), encoder.getScale());
+
+            REQUIRE(encoder.getScale() == 1.0F);
+            REQUIRE(decoded.size() == 2);
+            REQUIRE(decoded[0].force == 0.0F);
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,132 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <span>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../src/utils/impulse-log/delta-time-stream.h"
+
+using std::vector;
+
+namespace
+{
+    vector<unsigned long> decode(DeltaTimeStreamDecoder &decoder, const std::span<const unsigned char> packet)
+    {
+        vector<unsigned long> deltaTimes;
+        if (!decoder.open(packet))
+        {
+            return deltaTimes;
+        }
+
+        unsigned long deltaTime = 0;
+        while (decoder.next(deltaTime))
+        {
+            deltaTimes.push_back(deltaTime);
+        }
+
+        return deltaTimes;
+    }
+}
+
+TEST_CASE("DeltaTimeStream")
+{
+    DeltaTimeStreamEncoder encoder;
+    DeltaTimeStreamDecoder decoder;
+
+    SECTION("encoder should")
+    {
+        SECTION("start the packet with the sequence number and the full first delta time")
+        {
+            encoder.push(0x01'02'03'04UL);
+
+            const vector<unsigned char> expectedPacket{0, 0x04, 0x03, 0x02, 0x01};
+
+            REQUIRE(vector<unsigned char>(encoder.data().begin(), encoder.data().end()) == expectedPacket);
+        }
+
+        SECTION("store small differences in one byte")
+        {
+            encoder.push(10'000);
+            encoder.push(10'010);
+            encoder.push(9'990);
+
+            REQUIRE(encoder.data().size() == DeltaTimeStream::headerSize + 2);
+            REQUIRE(encoder.size() == 3);
+        }
+
+        SECTION("increase the sequence number for every packet")
+        {
+            encoder.push(10'000);
+            encoder.next();
+
+            REQUIRE(encoder.empty());
+            REQUIRE(encoder.data().empty());
+
+            encoder.push(10'000);
+
+            REQUIRE(encoder.data()[0] == 1);
+        }
+
+        SECTION("reject delta times once the packet is full")
+        {
+            auto i = 0UL;
+            while (encoder.push(i % 2 == 0 ? 10'000'000UL : 1UL))
+            {
+                ++i;
+            }
+
+            REQUIRE(encoder.data().size() <= DeltaTimeStream::maxPacketSize);
+            REQUIRE(encoder.size() == i);
+        }
+    }
+
+    SECTION("decoder should")
+    {
+        SECTION("return the delta times of the packet")
+        {
+            const vector<unsigned long> deltaTimes{10'000, 10'250, 9'800, 1'000'000, 3'000, 3'000};
+            for (const auto deltaTime : deltaTimes)
+            {
+                encoder.push(deltaTime);
+            }
+
+            REQUIRE(decode(decoder, encoder.data()) == deltaTimes);
+        }
+
+        SECTION("reject packets without a full header")
+        {
+            const vector<unsigned char> packet{0, 1, 2};
+
+            REQUIRE_FALSE(decoder.open(packet));
+        }
+
+        SECTION("count the packets missing from the sequence")
+        {
+            encoder.push(10'000);
+            decode(decoder, encoder.data());
+            encoder.next();
+            encoder.next();
+            encoder.next();
+            encoder.push(10'000);
+            decode(decoder, encoder.data());
+
+            REQUIRE(decoder.getSequenceNumber() == 3);
+            REQUIRE(decoder.getLostPacketCount() == 2);
+        }
+
+        SECTION("not count a lost packet when the sequence number wraps around")
+        {
+            auto i = 0U;
+            while (i < 300)
+            {
+                encoder.push(10'000 + i);
+                REQUIRE(decode(decoder, encoder.data()) == vector<unsigned long>{10'000 + i});
+                encoder.next();
+                ++i;
+            }
+
+            REQUIRE(decoder.getLostPacketCount() == 0);
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
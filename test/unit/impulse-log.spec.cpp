@@ -0,0 +1,190 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../src/utils/impulse-log/impulse-log.h"
+
+using std::vector;
+
+namespace
+{
+    vector<unsigned long> decode(const ImpulseLog::Block &block)
+    {
+        vector<unsigned long> deltaTimes;
+        ImpulseLogDecoder decoder;
+        if (!decoder.open(block))
+        {
+            return deltaTimes;
+        }
+
+        unsigned long deltaTime = 0;
+        while (decoder.next(deltaTime))
+        {
+            deltaTimes.push_back(deltaTime);
+        }
+
+        return deltaTimes;
+    }
+}
+
+TEST_CASE("ImpulseLog")
+{
+    SECTION("crc32 should match the standard check value")
+    {
+        const std::string_view check = "123456789";
+        const std::span data(reinterpret_cast<const unsigned char *>(check.data()), check.size()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        REQUIRE(ImpulseLog::crc32(data) == 0xCBF43926U);
+    }
+
+    SECTION("file header")
+    {
+        ImpulseLog::FileHeader header;
+        header.impulsesPerRevolution = 3;
+        header.expectedStrokeCount = 635;
+        header.setProfile("genericAir");
+        header.logId = 0xCAFE'F00DU;
+
+        ImpulseLog::Block block{};
+        ImpulseLog::writeFileHeader(header, block);
+
+        SECTION("should be read back with the same values")
+        {
+            ImpulseLog::FileHeader readHeader;
+
+            REQUIRE(ImpulseLog::readFileHeader(block, readHeader));
+            REQUIRE(readHeader.version == ImpulseLog::version);
+            REQUIRE(readHeader.impulsesPerRevolution == 3);
+            REQUIRE(readHeader.expectedStrokeCount == 635);
+            REQUIRE(readHeader.profile() == "genericAir");
+            REQUIRE(readHeader.logId == 0xCAFE'F00DU);
+        }
+
+        SECTION("should be rejected when corrupt")
+        {
+            block[9] ^= 0x01U;
+            ImpulseLog::FileHeader readHeader;
+
+            REQUIRE_FALSE(ImpulseLog::readFileHeader(block, readHeader));
+        }
+
+        SECTION("should be rejected without the magic")
+        {
+            block[0] = 'X';
+            ImpulseLog::FileHeader readHeader;
+
+            REQUIRE_FALSE(ImpulseLog::readFileHeader(block, readHeader));
+        }
+
+        SECTION("should truncate long profile names")
+        {
+            header.setProfile("a-rower-profile-name-that-is-longer-than-the-field");
+
+            REQUIRE(header.profile().size() == ImpulseLog::profileNameLength);
+        }
+    }
+
+    SECTION("encoder and decoder")
+    {
+        ImpulseLogEncoder encoder;
+
+        SECTION("should round trip delta times including large jumps")
+        {
+            const vector<unsigned long> deltaTimes{12'345, 12'346, 12'200, 90'000, 8'000, 8'001, 4'000'000'000, 1, 4'294'967'295};
+            for (const auto deltaTime : deltaTimes)
+            {
+                REQUIRE(encoder.push(deltaTime));
+            }
+
+            REQUIRE(encoder.size() == deltaTimes.size());
+            REQUIRE(decode(encoder.seal()) == deltaTimes);
+        }
+
+        SECTION("should store slowly changing delta times in one byte each")
+        {
+            auto deltaTime = 20'000UL;
+            auto count = 0U;
+            while (encoder.push(deltaTime))
+            {
+                deltaTime += count % 2 == 0 ? 30 : -20;
+                ++count;
+            }
+
+            REQUIRE(count == ImpulseLog::blockPayloadCapacity - ImpulseLog::maxVarintLength + 2);
+        }
+
+        SECTION("should reject delta times when full and start over after reset")
+        {
+            auto deltaTime = 1'000UL;
+            while (encoder.push(deltaTime))
+            {
+                deltaTime += 1'000'000;
+            }
+            const auto fullBlock = decode(encoder.seal());
+
+            REQUIRE(fullBlock.size() == encoder.size());
+            REQUIRE(fullBlock.back() == deltaTime - 1'000'000);
+
+            encoder.reset();
+
+            REQUIRE(encoder.empty());
+            REQUIRE(encoder.push(deltaTime));
+            REQUIRE(decode(encoder.seal()) == vector<unsigned long>{deltaTime});
+        }
+
+        SECTION("should allow sealing a partial block again after further pushes")
+        {
+            encoder.push(5'000);
+            encoder.push(5'100);
+            const auto firstSeal = decode(encoder.seal());
+            encoder.push(5'050);
+
+            REQUIRE(firstSeal == vector<unsigned long>{5'000, 5'100});
+            REQUIRE(decode(encoder.seal()) == vector<unsigned long>{5'000, 5'100, 5'050});
+        }
+
+        SECTION("decoder should reject a corrupt block")
+        {
+            encoder.push(5'000);
+            encoder.push(5'100);
+            auto block = encoder.seal();
+            block[ImpulseLog::blockHeaderSize] ^= 0x01U;
+            ImpulseLogDecoder decoder;
+
+            REQUIRE_FALSE(decoder.open(block));
+
+            unsigned long deltaTime = 0;
+            REQUIRE_FALSE(decoder.next(deltaTime));
+        }
+
+        SECTION("impulseCount should return the count of the block header")
+        {
+            encoder.push(5'000);
+            encoder.push(5'100);
+            encoder.push(5'200);
+
+            REQUIRE(ImpulseLogDecoder::impulseCount(encoder.seal()) == 3);
+            REQUIRE(ImpulseLogDecoder::impulseCount(ImpulseLog::Block{}) == 0);
+        }
+
+        SECTION("isPartOf should only accept the next block of the same log")
+        {
+            encoder.begin(42U);
+            encoder.push(5'000);
+            const auto firstBlock = encoder.seal();
+            encoder.reset();
+            encoder.push(5'100);
+            const auto secondBlock = encoder.seal();
+
+            REQUIRE(ImpulseLogDecoder::isPartOf(firstBlock, 42U, 0));
+            REQUIRE(ImpulseLogDecoder::isPartOf(secondBlock, 42U, 1));
+            REQUIRE_FALSE(ImpulseLogDecoder::isPartOf(secondBlock, 42U, 0));
+            REQUIRE_FALSE(ImpulseLogDecoder::isPartOf(firstBlock, 43U, 0));
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
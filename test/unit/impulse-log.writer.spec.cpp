@@ -0,0 +1,314 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <algorithm>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "fakeit.hpp"
+
+#include "./include/SdFat.h"
+
+#include "../../src/peripherals/sd-card/impulse-log.writer.h"
+#include "../../src/utils/configuration.h"
+#include "../../src/utils/impulse-log/impulse-log.h"
+
+using namespace fakeit;
+using std::vector;
+
+namespace
+{
+    // Reads the log the same way as the impulse log reader of the e2e executables
+    vector<unsigned long> decodeLog(const vector<unsigned char> &file)
+    {
+        vector<unsigned long> deltaTimes;
+        ImpulseLog::FileHeader header;
+        if (!ImpulseLog::readFileHeader(file, header))
+        {
+            return deltaTimes;
+        }
+
+        auto offset = ImpulseLog::blockSize;
+        auto sequence = 0U;
+        while (offset + ImpulseLog::blockSize <= file.size())
+        {
+            const auto block = std::span(file).subspan(offset).first<ImpulseLog::blockSize>();
+            ImpulseLogDecoder decoder;
+            if (ImpulseLogDecoder::impulseCount(block) == 0 || !ImpulseLogDecoder::isPartOf(block, header.logId, sequence) || !decoder.open(block))
+            {
+                break;
+            }
+            ++sequence;
+
+            unsigned long deltaTime = 0;
+            while (decoder.next(deltaTime))
+            {
+                deltaTimes.push_back(deltaTime);
+            }
+            offset += ImpulseLog::blockSize;
+        }
+
+        return deltaTimes;
+    }
+
+    bool isEndOfLogBlock(const void *buf, const size_t nbyte)
+    {
+        const auto *const bytes = static_cast<const unsigned char *>(buf);
+
+        return nbyte == ImpulseLog::blockSize && std::all_of(bytes, bytes + nbyte, [](const unsigned char byte)
+                                                             { return byte == 0; });
+    }
+}
+
+TEST_CASE("ImpulseLogWriter", "[peripheral]")
+{
+    mockFile32.Reset();
+
+    // The log file is kept in memory, with the preallocated part filled with garbage as on the SD card
+    vector<unsigned char> file;
+    unsigned long position = 0;
+    When(Method(mockFile32, preAllocate)).AlwaysDo([&file](const unsigned long long length)
+                                                   {
+                                                       file.assign(length, 0xA5);
+
+                                                       return true; });
+    When(Method(mockFile32, seekSet)).AlwaysDo([&position](const unsigned long pos)
+                                               {
+                                                   position = pos;
+
+                                                   return true; });
+    When(Method(mockFile32, write)).AlwaysDo([&file, &position](const void *buf, const size_t nbyte)
+                                             {
+                                                 const auto *const bytes = static_cast<const unsigned char *>(buf);
+                                                 if (position + nbyte > file.size())
+                                                 {
+                                                     file.resize(position + nbyte);
+                                                 }
+                                                 std::copy(bytes, bytes + nbyte, begin(file) + static_cast<long>(position));
+                                                 position += nbyte;
+
+                                                 return nbyte; });
+    Fake(Method(mockFile32, flush));
+
+    File32 logFile;
+    ImpulseLogWriter impulseLogWriter(logFile);
+
+    ImpulseLog::FileHeader header;
+    header.impulsesPerRevolution = 3;
+    header.setProfile("test");
+    header.logId = 0x1234'5678U;
+
+    SECTION("begin method")
+    {
+        SECTION("should preallocate the log file")
+        {
+            impulseLogWriter.begin(header);
+
+            Verify(Method(mockFile32, preAllocate).Using(Configurations::sdCardPreallocatedSize)).Once();
+        }
+
+        SECTION("should write the header followed by an empty log")
+        {
+            REQUIRE(impulseLogWriter.begin(header));
+
+            ImpulseLog::FileHeader readHeader;
+
+            REQUIRE(ImpulseLog::readFileHeader(file, readHeader));
+            REQUIRE(readHeader.profile() == "test");
+            REQUIRE(readHeader.impulsesPerRevolution == 3);
+            REQUIRE(decodeLog(file).empty());
+            Verify(Method(mockFile32, flush)).Once();
+        }
+
+        SECTION("should continue if the log file cannot be preallocated")
+        {
+            When(Method(mockFile32, preAllocate)).AlwaysReturn(false);
+
+            REQUIRE(impulseLogWriter.begin(header));
+        }
+
+        SECTION("should return false if the header cannot be written")
+        {
+            When(Method(mockFile32, write)).AlwaysReturn(0);
+
+            REQUIRE_FALSE(impulseLogWriter.begin(header));
+        }
+    }
+
+    SECTION("writePending method")
+    {
+        impulseLogWriter.begin(header);
+        mockFile32.ClearInvocationHistory();
+
+        SECTION("should not write a partial block before the max flush latency")
+        {
+            impulseLogWriter.push(10'000);
+            impulseLogWriter.push(10'100);
+
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency - 1);
+
+            Verify(Method(mockFile32, write)).Never();
+            Verify(Method(mockFile32, flush)).Never();
+        }
+
+        SECTION("should write and flush the partial block once the max flush latency passed")
+        {
+            impulseLogWriter.push(10'000);
+            impulseLogWriter.push(10'100);
+
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency);
+
+            REQUIRE(decodeLog(file) == vector<unsigned long>{10'000, 10'100});
+            Verify(Method(mockFile32, seekSet).Using(ImpulseLog::blockSize)).Once();
+            Verify(Method(mockFile32, flush)).Once();
+        }
+
+        SECTION("should not flush if nothing was queued since the last flush")
+        {
+            impulseLogWriter.push(10'000);
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency);
+            mockFile32.ClearInvocationHistory();
+
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency * 3);
+
+            Verify(Method(mockFile32, write)).Never();
+            Verify(Method(mockFile32, flush)).Never();
+        }
+
+        SECTION("should rewrite the partial block in place on the next flush")
+        {
+            impulseLogWriter.push(10'000);
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency);
+            impulseLogWriter.push(10'100);
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency * 2);
+
+            REQUIRE(decodeLog(file) == vector<unsigned long>{10'000, 10'100});
+            Verify(Method(mockFile32, seekSet).Using(ImpulseLog::blockSize)).Twice();
+        }
+
+        SECTION("should write full blocks without waiting for the flush and keep the log readable")
+        {
+            vector<unsigned long> deltaTimes;
+            auto deltaTime = 50'000UL;
+            auto i = 0U;
+            while (i < Configurations::sdCardQueueCapacity)
+            {
+                deltaTime = i % 3 == 0 ? deltaTime + 1'000 : deltaTime - 400;
+                deltaTimes.push_back(deltaTime);
+                impulseLogWriter.push(deltaTime);
+                ++i;
+            }
+
+            impulseLogWriter.writePending(0);
+
+            Verify(Method(mockFile32, seekSet).Using(ImpulseLog::blockSize)).Once();
+            Verify(Method(mockFile32, flush)).Never();
+
+            const auto writtenDeltaTimes = decodeLog(file);
+            REQUIRE(!writtenDeltaTimes.empty());
+            REQUIRE(std::ranges::equal(writtenDeltaTimes, std::span(deltaTimes).first(writtenDeltaTimes.size())));
+
+            impulseLogWriter.flush(0);
+
+            REQUIRE(decodeLog(file) == deltaTimes);
+        }
+
+        SECTION("should not read a valid block of another log left after the last written block")
+        {
+            auto i = 0U;
+            while (i < Configurations::sdCardQueueCapacity)
+            {
+                impulseLogWriter.push(i % 2 == 0 ? 50'000 : 60'000);
+                ++i;
+            }
+
+            impulseLogWriter.writePending(0);
+
+            const auto writtenDeltaTimes = decodeLog(file);
+            REQUIRE(!writtenDeltaTimes.empty());
+
+            // Full blocks are written without an end of log marker, so after a power loss the next block is whatever the recycled cluster held
+            auto nextBlockOffset = ImpulseLog::blockSize;
+            while (!std::all_of(begin(file) + static_cast<long>(nextBlockOffset), begin(file) + static_cast<long>(nextBlockOffset + ImpulseLog::blockSize), [](const unsigned char byte)
+                                { return byte == 0xA5; }))
+            {
+                nextBlockOffset += ImpulseLog::blockSize;
+            }
+            const auto nextSequence = nextBlockOffset / ImpulseLog::blockSize - 1U;
+
+            ImpulseLogEncoder staleEncoder;
+
+            SECTION("with another log ID")
+            {
+                staleEncoder.begin(header.logId + 1U);
+                auto sequence = 0U;
+                while (sequence < nextSequence)
+                {
+                    staleEncoder.reset();
+                    ++sequence;
+                }
+            }
+
+            SECTION("out of sequence")
+            {
+                staleEncoder.begin(header.logId);
+            }
+
+            staleEncoder.push(70'000);
+            staleEncoder.push(70'100);
+            std::ranges::copy(staleEncoder.seal(), begin(file) + static_cast<long>(nextBlockOffset));
+
+            REQUIRE(decodeLog(file) == writtenDeltaTimes);
+        }
+
+        SECTION("should only write the end of log marker on flush")
+        {
+            auto i = 0U;
+            while (i < Configurations::sdCardQueueCapacity)
+            {
+                impulseLogWriter.push(i % 2 == 0 ? 50'000 : 60'000);
+                ++i;
+            }
+
+            impulseLogWriter.writePending(0);
+
+            Verify(Method(mockFile32, write).Matching(isEndOfLogBlock)).Never();
+
+            impulseLogWriter.flush(0);
+
+            Verify(Method(mockFile32, write).Matching(isEndOfLogBlock)).Once();
+        }
+
+        SECTION("should count the failed writes")
+        {
+            When(Method(mockFile32, write)).AlwaysReturn(0);
+            impulseLogWriter.push(10'000);
+
+            impulseLogWriter.writePending(Configurations::sdCardMaxFlushLatency);
+
+            REQUIRE(impulseLogWriter.getFailedWriteCount() == 1);
+        }
+    }
+
+    SECTION("flush method should write the end of log marker where the next block goes when nothing is being filled")
+    {
+        impulseLogWriter.begin(header);
+        mockFile32.ClearInvocationHistory();
+
+        impulseLogWriter.flush(0);
+
+        Verify(Method(mockFile32, seekSet).Using(ImpulseLog::blockSize) + Method(mockFile32, write).Matching(isEndOfLogBlock)).Once();
+        REQUIRE(decodeLog(file).empty());
+    }
+
+    SECTION("push method should drop delta times when the queue is full")
+    {
+        auto i = 0U;
+        while (i < Configurations::sdCardQueueCapacity)
+        {
+            REQUIRE(impulseLogWriter.push(10'000));
+            ++i;
+        }
+
+        REQUIRE_FALSE(impulseLogWriter.push(10'000));
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -16,6 +16,7 @@ using BaseType_t = int;
 using UBaseType_t = unsigned int;
 using TaskFunction_t = void (*)(void *);
 using TaskHandle_t = void *;
+using TickType_t = unsigned int;
 using voidFuncPtr = void (*)(void);
 
 struct hw_timer_t;
@@ -29,6 +30,10 @@ struct hw_timer_t;
 #define PI 3.1415926535897932384626433832795
 #define LED_BUILTIN GPIO_NUM_2
 #define IRAM_ATTR
+#define pdTRUE 1
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) (ms)
+#define portMAX_DELAY (TickType_t)0xFFFFFFFFUL
 
 class Print
 {
@@ -71,6 +76,9 @@ public:
                                                TaskHandle_t *const pvCreatedTask,
                                                const BaseType_t xCoreID) = 0;
     virtual void vTaskDelete(TaskHandle_t xTaskToDelete) = 0;
+    virtual uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) = 0;
+    virtual BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) = 0;
+    virtual uint32_t esp_random() = 0;
 };
 
 extern fakeit::Mock<MockArduino> mockArduino;
@@ -137,6 +145,16 @@ inline void vTaskDelete(TaskHandle_t xTaskToDelete)
     mockArduino.get().vTaskDelete(xTaskToDelete);
 }
 
+inline uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    return mockArduino.get().ulTaskNotifyTake(xClearCountOnExit, xTicksToWait);
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+    return mockArduino.get().xTaskNotifyGive(xTaskToNotify);
+}
+
 inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
                                           const char *const pcName,
                                           const uint32_t usStackDepth,
@@ -14,6 +14,8 @@
 
 #include "fakeit.hpp"
 
+#define BLE_HS_CONN_HANDLE_NONE 0xffff
+
 /**
  * @brief Bluetooth TX power level(index), it's just a index corresponding to power(dbm).
  */
@@ -141,6 +143,7 @@ protected:
 
 public:
     virtual uint16_t getConnHandle() = 0;
+    virtual uint16_t getConnInterval() = 0;
 };
 
 class NimBLEService;
@@ -155,6 +158,7 @@ protected:
 public:
     virtual void onConnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo) {};
     virtual void onDisconnect(NimBLEServer *pServer, NimBLEConnInfo &connInfo, int reason) {};
+    virtual void onConnParamsUpdate(NimBLEConnInfo &connInfo) {};
 };
 
 class NimBLECharacteristicCallbacks
@@ -163,6 +167,7 @@ protected:
     ~NimBLECharacteristicCallbacks() = default;
 
 public:
+    virtual void onRead(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo &connInfo) {};
     virtual void onWrite(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo &connInfo) {};
     virtual void onSubscribe(NimBLECharacteristic *pCharacteristic, NimBLEConnInfo &connInfo, unsigned short subValue) {};
 };
@@ -212,12 +217,12 @@ public:
     virtual void setValue(const std::array<unsigned char, 8U> s) = 0;
     virtual void setValue(const std::array<unsigned char, 11U> s) = 0;
     virtual void setValue(const std::array<unsigned char, 14U> s) = 0;
-    virtual void setValue(const std::array<unsigned char, 18U> s) = 0;
+    virtual void setValue(const std::array<unsigned char, 21U> s) = 0;
     virtual void setCallbacks(NimBLECharacteristicCallbacks *pCallbacks)
     {
         callbacks = pCallbacks;
     };
-    virtual void notify() = 0;
+    virtual void notify(unsigned short connHandle = BLE_HS_CONN_HANDLE_NONE) = 0;
     virtual void indicate() = 0;
 
     virtual size_t getSubscribedCount() = 0;
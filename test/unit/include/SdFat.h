@@ -17,6 +17,7 @@ using oflag_t = int;
 #define O_WRITE O_WRONLY
 #define O_AT_END 0x4000
 #define O_CREAT 0x0200
+#define O_EXCL 0x0800
 
 #define SD_SCK_MHZ(maxMhz) (1000000UL * (maxMhz))
 
@@ -45,7 +46,8 @@ public:
     virtual bool open(const std::string path, oflag_t oflag) = 0;
     virtual bool close() = 0;
     virtual size_t write(const void *buf, size_t nbyte) = 0;
-    virtual void println(unsigned long n) = 0;
+    virtual bool seekSet(unsigned long pos) = 0;
+    virtual bool preAllocate(unsigned long long length) = 0;
     virtual void flush() = 0;
 };
 extern fakeit::Mock<MockFile32> mockFile32;
@@ -78,9 +80,13 @@ public:
     {
         return mockFile32.get().write(buf, nbyte);
     };
-    void println(unsigned long n)
+    bool seekSet(unsigned long pos)
     {
-        mockFile32.get().println(n);
+        return mockFile32.get().seekSet(pos);
+    };
+    bool preAllocate(unsigned long long length)
+    {
+        return mockFile32.get().preAllocate(length);
     };
     void flush()
     {
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+#include "./Arduino.h"
+
+inline uint32_t esp_random()
+{
+    return mockArduino.get().esp_random();
+}
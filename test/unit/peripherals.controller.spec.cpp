@@ -1,10 +1,5 @@
 // NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
-#include <vector>
-
 #include "catch2/catch_test_macros.hpp"
-#include "catch2/matchers/catch_matchers.hpp"
-#include "catch2/matchers/catch_matchers_container_properties.hpp"
-#include "catch2/matchers/catch_matchers_range_equals.hpp"
 #include "fakeit.hpp"
 
 #include "../include/Arduino.h"
@@ -44,6 +39,7 @@ TEST_CASE("PeripheralController", "[peripheral]")
         .avgStrokePower = 70,
         .dragCoefficient = 0.00001,
         .driveHandleForces = {1.1, 2.2, 100.1},
+        .handleForcesRevision = 1,
     };
 
     When(Method(mockArduino, millis)).AlwaysReturn(0);
@@ -56,8 +52,7 @@ TEST_CASE("PeripheralController", "[peripheral]")
     When(Method(mockEEPROMService, getBleServiceFlag)).AlwaysReturn(BleServiceFlag::CpsService);
     When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(false);
     When(Method(mockEEPROMService, getLogToBluetooth)).AlwaysReturn(false);
-    When(Method(mockEEPROMService, getSensorSignalSettings)).AlwaysReturn(RowerProfile::SensorSignalSettings{});
-    When(Method(mockEEPROMService, getStrokePhaseDetectionSettings)).AlwaysReturn(RowerProfile::StrokePhaseDetectionSettings{});
+    When(Method(mockEEPROMService, getMachineSettings)).AlwaysReturn(RowerProfile::MachineSettings{});
     When(Method(mockSdCardService, isLogFileOpen)).AlwaysReturn(false);
     Fake(Method(mockSdCardService, saveDeltaTime));
 
@@ -74,27 +69,16 @@ TEST_CASE("PeripheralController", "[peripheral]")
 
         Fake(Method(mockBluetoothController, setup));
 
-#if ENABLE_RUNTIME_SETTINGS
-        SECTION("load runtime settings")
+        SECTION("setup SdCardService with the machine settings")
         {
-            peripheralsController.begin();
+            const RowerProfile::MachineSettings machineSettings{.impulsesPerRevolution = 5};
+            When(Method(mockEEPROMService, getMachineSettings)).AlwaysReturn(machineSettings);
 
-            Verify(Method(mockEEPROMService, getSensorSignalSettings)).Once();
-        }
-#else
-        SECTION("not load runtime settings")
-        {
             peripheralsController.begin();
 
-            Verify(Method(mockEEPROMService, getSensorSignalSettings)).Never();
-        }
-#endif
-
-        SECTION("setup SdCardService")
-        {
-            peripheralsController.begin();
-
-            Verify(Method(mockSdCardService, setup)).Once();
+            Verify(Method(mockSdCardService, setup).Matching([](const RowerProfile::MachineSettings settings)
+                                                             { return settings.impulsesPerRevolution == 5; }))
+                .Once();
         }
 
         SECTION("setup BluetoothController")
@@ -255,56 +239,36 @@ TEST_CASE("PeripheralController", "[peripheral]")
 
         SECTION("to the sdCard data")
         {
-            SECTION("add new deltaTime when logging to sd-card is enabled and log file is open")
+            SECTION("save new deltaTime when logging to sd-card is enabled and log file is open")
             {
-                std::vector<std::vector<unsigned long>> notifiedDeltaTimes{};
-
                 When(Method(mockSdCardService, isLogFileOpen)).AlwaysReturn(true);
-                Fake(Method(mockSdCardService, saveDeltaTime).Matching([&notifiedDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                       {
-                notifiedDeltaTimes.push_back(deltaTimes);
-
-                return true; }));
                 When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(true);
-                When(Method(mockArduino, millis)).Return(blinkInterval, blinkInterval);
 
                 peripheralsController.updateDeltaTime(expectedDeltaTime);
 
-                peripheralsController.updateData({});
-                REQUIRE_THAT(notifiedDeltaTimes, Catch::Matchers::SizeIs(1));
-                REQUIRE_THAT(notifiedDeltaTimes[0], Catch::Matchers::RangeEquals(std::vector<unsigned long>{expectedDeltaTime}));
+                Verify(Method(mockSdCardService, saveDeltaTime).Using(expectedDeltaTime)).Once();
             }
 
-            SECTION("skip adding new deltaTime when")
+            SECTION("skip saving new deltaTime when")
             {
                 SECTION("logging to sd-card is disabled")
                 {
                     When(Method(mockSdCardService, isLogFileOpen)).AlwaysReturn(true);
                     When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(false);
-                    When(Method(mockArduino, millis)).Return(blinkInterval, blinkInterval);
 
                     peripheralsController.updateDeltaTime(expectedDeltaTime);
 
-                    peripheralsController.updateData({});
                     Verify(Method(mockSdCardService, saveDeltaTime)).Never();
                 }
+
                 SECTION("log file is not open")
                 {
-                    std::vector<std::vector<unsigned long>> resultDeltaTimes;
                     When(Method(mockSdCardService, isLogFileOpen)).AlwaysReturn(false);
-                    Fake(Method(mockSdCardService, saveDeltaTime).Matching([&resultDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                           {
-                            resultDeltaTimes.push_back(deltaTimes);
-
-                            return true; }));
                     When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(true);
-                    When(Method(mockArduino, millis)).Return(blinkInterval, blinkInterval);
 
                     peripheralsController.updateDeltaTime(expectedDeltaTime);
 
-                    peripheralsController.updateData({});
-                    REQUIRE_THAT(resultDeltaTimes, Catch::Matchers::SizeIs(1));
-                    REQUIRE_THAT(resultDeltaTimes[0], Catch::Matchers::IsEmpty());
+                    Verify(Method(mockSdCardService, saveDeltaTime)).Never();
                 }
             }
         }
@@ -344,45 +308,14 @@ TEST_CASE("PeripheralController", "[peripheral]")
                 .Once();
         }
 
-        SECTION("when logToSdCard")
+        SECTION("not save delta times to sd-card")
         {
-            SECTION("is disabled not save delta times to sd-card")
-            {
-                When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(false);
-
-                peripheralsController.updateData(expectedData);
-
-                Verify(Method(mockSdCardService, saveDeltaTime)).Never();
-            }
-            SECTION("is enabled save delta times to sd-card")
-            {
-                When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(true);
-
-                peripheralsController.updateData(expectedData);
-
-                Verify(Method(mockSdCardService, saveDeltaTime)).Once();
-            }
-        }
-
-        SECTION("reset sdDeltaTimes vector")
-        {
-            std::vector<std::vector<unsigned long>> savedDeltaTimes;
-
             When(Method(mockEEPROMService, getLogToSdCard)).AlwaysReturn(true);
             When(Method(mockSdCardService, isLogFileOpen)).AlwaysReturn(true);
-            Fake(Method(mockSdCardService, saveDeltaTime).Matching([&savedDeltaTimes](const std::vector<unsigned long> &deltaTimes)
-                                                                   {
-                savedDeltaTimes.push_back(deltaTimes);
-
-                return true; }));
 
-            peripheralsController.updateDeltaTime(expectedDeltaTime);
             peripheralsController.updateData(expectedData);
 
-            REQUIRE_THAT(savedDeltaTimes, Catch::Matchers::SizeIs(1));
-            REQUIRE_THAT(savedDeltaTimes[0], Catch::Matchers::RangeEquals(std::vector<unsigned long>{expectedDeltaTime}));
-            Verify(Method(mockSdCardService, saveDeltaTime).Matching([](const std::vector<unsigned long> &deltaTimes)
-                                                                     { return deltaTimes.capacity() == (RowerProfile::Defaults::minimumRecoveryTime + RowerProfile::Defaults::minimumDriveTime) / RowerProfile::Defaults::rotationDebounceTimeMin && deltaTimes.empty(); }));
+            Verify(Method(mockSdCardService, saveDeltaTime)).Never();
         }
     }
 }
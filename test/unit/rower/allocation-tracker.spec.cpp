@@ -0,0 +1,209 @@
+// NOLINTBEGIN(readability-magic-numbers,readability-function-cognitive-complexity)
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../include/Arduino.h"
+
+#include "../../../src/rower/allocation-tracker.h"
+#include "../../../src/rower/metrics-snapshot.h"
+#include "../../../src/rower/stroke.model.h"
+#include "../../../src/rower/stroke.service.h"
+#include "../../../src/utils/configuration.h"
+#include "../../../src/utils/enums.h"
+#include "../../../src/utils/macros.h"
+
+using std::ifstream;
+using std::string;
+using std::vector;
+
+TEST_CASE("AllocationTracker")
+{
+    const unsigned char warmUpStrokes = 2U;
+    AllocationTracker tracker(warmUpStrokes);
+
+    SECTION("should attribute the allocations since the stage started to the stage")
+    {
+        tracker.startStage();
+        tracker.recordAllocation(100U);
+        tracker.recordAllocation(50U);
+        tracker.endStage(PipelineStage::DeltaTimes);
+
+        REQUIRE(tracker.getStatistics(PipelineStage::DeltaTimes).count == 2U);
+        REQUIRE(tracker.getStatistics(PipelineStage::DeltaTimes).bytes == 150U);
+        REQUIRE(tracker.getStatistics(PipelineStage::CyclicFilter).count == 0U);
+    }
+
+    SECTION("should count allocations between stages as outside of the stages")
+    {
+        tracker.recordAllocation(20U);
+        tracker.startStage();
+        tracker.recordAllocation(10U);
+        tracker.endStage(PipelineStage::StateMachine);
+
+        REQUIRE(tracker.getOutsideStages().count == 1U);
+        REQUIRE(tracker.getOutsideStages().bytes == 20U);
+        REQUIRE(tracker.getStatistics(PipelineStage::StateMachine).bytes == 10U);
+    }
+
+    SECTION("should keep the live bytes and their high water mark")
+    {
+        tracker.recordAllocation(100U);
+        tracker.recordAllocation(200U);
+        tracker.recordDeallocation(100U);
+        tracker.recordAllocation(50U);
+
+        REQUIRE(tracker.getLiveBytes() == 250U);
+        REQUIRE(tracker.getHighWaterMark() == 300U);
+    }
+
+    SECTION("should keep the largest allocations of an impulse and count the impulses that allocated")
+    {
+        tracker.startStage();
+        tracker.recordAllocation(10U);
+        tracker.endStage(PipelineStage::CyclicFilter);
+        tracker.recordAllocation(30U);
+        tracker.endStage(PipelineStage::DeltaTimes);
+        tracker.completeImpulse();
+
+        tracker.startStage();
+        tracker.endStage(PipelineStage::CyclicFilter);
+        tracker.completeImpulse();
+
+        tracker.startStage();
+        tracker.recordAllocation(100U);
+        tracker.endStage(PipelineStage::CyclicFilter);
+        tracker.completeImpulse();
+
+        REQUIRE(tracker.getImpulseCount() == 3U);
+        REQUIRE(tracker.getAllocatingImpulseCount() == 2U);
+        REQUIRE(tracker.getMaxPerImpulse().count == 2U);
+        REQUIRE(tracker.getMaxPerImpulse().bytes == 100U);
+    }
+
+    SECTION("should keep the largest allocations of a stroke")
+    {
+        tracker.startStage();
+        tracker.recordAllocation(10U);
+        tracker.endStage(PipelineStage::CyclicFilter);
+        tracker.completeImpulse();
+        tracker.startStage();
+        tracker.recordAllocation(10U);
+        tracker.endStage(PipelineStage::CyclicFilter);
+        tracker.completeImpulse();
+        tracker.completeStroke();
+
+        tracker.startStage();
+        tracker.recordAllocation(15U);
+        tracker.endStage(PipelineStage::CyclicFilter);
+        tracker.completeStroke();
+
+        REQUIRE(tracker.getStrokeCount() == 2U);
+        REQUIRE(tracker.getMaxPerStroke().count == 2U);
+        REQUIRE(tracker.getMaxPerStroke().bytes == 20U);
+    }
+
+    SECTION("should only count steady state allocations after the warm-up strokes")
+    {
+        tracker.startStage();
+        tracker.recordAllocation(10U);
+        tracker.endStage(PipelineStage::StateMachine);
+        tracker.completeStroke();
+        tracker.completeStroke();
+
+        REQUIRE(tracker.isWarmUpCompleted());
+        REQUIRE(tracker.getSteadyState().count == 0U);
+
+        tracker.startStage();
+        tracker.recordAllocation(40U);
+        tracker.endStage(PipelineStage::PublishData);
+
+        REQUIRE(tracker.getSteadyState().count == 1U);
+        REQUIRE(tracker.getSteadyState().bytes == 40U);
+    }
+
+    SECTION("summary should list the allocations of every stage and the totals")
+    {
+        tracker.startStage();
+        tracker.recordAllocation(64U);
+        tracker.endStage(PipelineStage::AngularDistances);
+        tracker.completeImpulse();
+
+        const string expected = "Allocations over 1 impulses and 0 strokes\n"
+                                "cyclicFilter: 0 allocations, 0 bytes\n"
+                                "deltaTimes: 0 allocations, 0 bytes\n"
+                                "angularDistances: 1 allocations, 64 bytes\n"
+                                "derivativeMatrices: 0 allocations, 0 bytes\n"
+                                "stateMachine: 0 allocations, 0 bytes\n"
+                                "publishData: 0 allocations, 0 bytes\n"
+                                "outsideStages: 0 allocations, 0 bytes\n"
+                                "maxPerImpulse: 1 allocations, 64 bytes\n"
+                                "maxPerStroke: 0 allocations, 0 bytes\n"
+                                "steadyState: 0 allocations, 0 bytes\n"
+                                "allocatingImpulses: 1, liveBytes: 64, highWaterMark: 64\n";
+
+        REQUIRE(tracker.summary() == expected);
+    }
+}
+
+#if ENABLE_ALLOCATION_TRACKING
+// Only runs when the unit tests are compiled with allocation tracking, as the counting operator new is compiled in only then
+TEST_CASE("StrokeService should not allocate once warmed up")
+{
+    ifstream deltaTimesStream("test/unit/rower/test-data/stroke.service.spec.deltaTimes.txt");
+    REQUIRE(deltaTimesStream.good());
+
+    vector<unsigned long> deltaTimes;
+    unsigned long deltaTimeTemp = 0;
+    while (deltaTimesStream >> deltaTimeTemp)
+    {
+        deltaTimes.push_back(deltaTimeTemp);
+    }
+
+    const auto stageAllocations = []()
+    {
+        auto count = 0U;
+        for (const auto stage : {PipelineStage::CyclicFilter, PipelineStage::DeltaTimes, PipelineStage::AngularDistances, PipelineStage::DerivativeMatrices, PipelineStage::StateMachine, PipelineStage::PublishData})
+        {
+            count += allocationTracker.getStatistics(stage).count;
+        }
+
+        return count;
+    };
+
+    const auto angularDisplacementPerImpulse = (2 * PI) / 3;
+    auto rawImpulseCount = 0UL;
+    auto totalTime = 0UL;
+    Configurations::precision totalAngularDisplacement = 0.0;
+    auto warmUpAllocations = 0U;
+
+    StrokeService strokeService;
+    MetricsSnapshot snapshot;
+    for (const auto &deltaTime : deltaTimes)
+    {
+        totalAngularDisplacement += angularDisplacementPerImpulse;
+        totalTime += deltaTime;
+        rawImpulseCount++;
+        strokeService.processData(RowingDataModels::FlywheelData{
+            .rawImpulseCount = rawImpulseCount,
+            .deltaTime = deltaTime,
+            .totalTime = totalTime,
+            .totalAngularDisplacement = totalAngularDisplacement,
+            .cleanImpulseTime = totalTime,
+            .rawImpulseTime = totalTime,
+        });
+        strokeService.publishData(snapshot);
+
+        if (strokeService.getData().strokeCount < AllocationTracker::defaultWarmUpStrokes)
+        {
+            warmUpAllocations = stageAllocations();
+        }
+    }
+
+    REQUIRE(strokeService.getData().strokeCount > AllocationTracker::defaultWarmUpStrokes);
+    REQUIRE(stageAllocations() == warmUpAllocations);
+}
+#endif
+// NOLINTEND(readability-magic-numbers,readability-function-cognitive-complexity)
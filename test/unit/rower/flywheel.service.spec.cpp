@@ -24,6 +24,20 @@ const std::vector<unsigned long> deltaTimes = {
     RowerProfile::Defaults::rotationDebounceTimeMin + 100,
 };
 
+namespace
+{
+    RowingDataModels::FlywheelData drainData(FlywheelService &flywheelService)
+    {
+        auto data = flywheelService.getData();
+        while (flywheelService.hasDataChanged())
+        {
+            data = flywheelService.getData();
+        }
+
+        return data;
+    }
+}
+
 TEST_CASE("FlywheelService", "[rower]")
 {
     mockGlobals.Reset();
@@ -64,14 +78,59 @@ TEST_CASE("FlywheelService", "[rower]")
             REQUIRE(flywheelService.hasDataChanged() == false);
         }
 
-        SECTION("should disable and then reenable interrupts when reading data")
+        SECTION("should not detach the interrupt when reading data")
         {
             FlywheelService flywheelService;
 
+            flywheelService.processRotation(RowerProfile::Defaults::rotationDebounceTimeMin + 1000);
             flywheelService.getData();
 
-            Verify(Method(mockGlobals, detachRotationInterrupt)).Once();
-            Verify(Method(mockGlobals, attachRotationInterrupt)).Once();
+            Verify(Method(mockGlobals, detachRotationInterrupt)).Never();
+            Verify(Method(mockGlobals, attachRotationInterrupt)).Never();
+        }
+
+        SECTION("should return queued impulses one by one without merging them")
+        {
+            FlywheelService flywheelService;
+
+            auto now = 0UL;
+            for (const auto &testCase : deltaTimes)
+            {
+                now += testCase;
+                flywheelService.processRotation(now);
+            }
+
+            auto expectedImpulseCount = 0UL;
+            for (const auto &testCase : deltaTimes)
+            {
+                REQUIRE(flywheelService.hasDataChanged());
+
+                const auto result = flywheelService.getData();
+                ++expectedImpulseCount;
+
+                REQUIRE(result.rawImpulseCount == expectedImpulseCount);
+                REQUIRE(result.deltaTime == testCase);
+            }
+
+            REQUIRE(flywheelService.hasDataChanged() == false);
+        }
+
+        SECTION("should count impulses dropped when the queue is full")
+        {
+            FlywheelService flywheelService;
+            const auto overflow = 5U;
+
+            auto now = 0UL;
+            for (auto i = 0U; i < Configurations::impulseQueueCapacity + overflow; ++i)
+            {
+                now += deltaTimes.front();
+                flywheelService.processRotation(now);
+            }
+
+            const auto result = drainData(flywheelService);
+
+            REQUIRE(result.rawImpulseCount == Configurations::impulseQueueCapacity);
+            REQUIRE(flywheelService.getOverrunCount() == overflow);
         }
 
         SECTION("should update data based on new valid measurement")
@@ -95,7 +154,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 flywheelService.processRotation(now);
             }
 
-            const auto result = flywheelService.getData();
+            const auto result = drainData(flywheelService);
 
             REQUIRE(result.rawImpulseCount == expected.rawImpulseCount);
             REQUIRE(result.deltaTime == expected.deltaTime);
@@ -149,7 +208,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 currentTime += dtLarge2;
                 flywheelService.processRotation(currentTime);
 
-                const auto result = flywheelService.getData();
+                const auto result = drainData(flywheelService);
                 REQUIRE(result.rawImpulseCount == 2);
                 REQUIRE(result.deltaTime == dtLarge2);
             }
@@ -165,7 +224,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 currentTime += dtSmall;
                 flywheelService.processRotation(currentTime);
 
-                const auto result = flywheelService.getData();
+                const auto result = drainData(flywheelService);
                 REQUIRE(result.rawImpulseCount == 1);
                 REQUIRE(result.deltaTime == dtLarge1);
             }
@@ -184,7 +243,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 currentTime += dtMed3;
                 flywheelService.processRotation(currentTime);
 
-                const auto result = flywheelService.getData();
+                const auto result = drainData(flywheelService);
                 REQUIRE(result.rawImpulseCount == 3);
                 REQUIRE(result.deltaTime == dtMed3);
             }
@@ -200,7 +259,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 currentTime += dtLarge2;
                 flywheelService.processRotation(currentTime);
 
-                const auto validResult = flywheelService.getData();
+                const auto validResult = drainData(flywheelService);
                 REQUIRE(validResult.rawImpulseCount == 2);
                 REQUIRE(validResult.deltaTime == dtLarge2);
 
@@ -208,7 +267,7 @@ TEST_CASE("FlywheelService", "[rower]")
                 currentTime += dtSmall;
                 flywheelService.processRotation(currentTime);
 
-                const auto finalResult = flywheelService.getData();
+                const auto finalResult = drainData(flywheelService);
                 REQUIRE(finalResult.rawImpulseCount == 2);
                 REQUIRE(finalResult.deltaTime == dtLarge2);
             }
@@ -0,0 +1,175 @@
+// NOLINTBEGIN(readability-magic-numbers,readability-function-cognitive-complexity)
+#include <climits>
+#include <string>
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/rower/pipeline-profiler.h"
+#include "../../../src/utils/enums.h"
+
+using std::string;
+
+TEST_CASE("StageStatistics")
+{
+    StageStatistics statistics;
+
+    SECTION("bucketIndex and bucketUpperBound should")
+    {
+        SECTION("keep exact buckets for small values")
+        {
+            auto ticks = 0U;
+            while (ticks < StageStatistics::subBucketCount)
+            {
+                REQUIRE(StageStatistics::bucketIndex(ticks) == ticks);
+                REQUIRE(StageStatistics::bucketUpperBound(StageStatistics::bucketIndex(ticks)) == ticks);
+                ++ticks;
+            }
+        }
+
+        SECTION("put every value in a bucket whose upper bound is within 12.5% of the value")
+        {
+            auto ticks = 1U;
+            while (ticks < 1'000'000U)
+            {
+                const auto upperBound = StageStatistics::bucketUpperBound(StageStatistics::bucketIndex(ticks));
+
+                REQUIRE(upperBound >= ticks);
+                REQUIRE(upperBound - ticks <= ticks / StageStatistics::subBucketCount);
+
+                ticks += ticks / 16U + 1U;
+            }
+        }
+
+        SECTION("not overflow the histogram for the largest value")
+        {
+            REQUIRE(StageStatistics::bucketIndex(UINT_MAX) == StageStatistics::bucketCount - 1U);
+            REQUIRE(StageStatistics::bucketUpperBound(StageStatistics::bucketCount - 1U) == UINT_MAX);
+        }
+    }
+
+    SECTION("should return zeros when nothing was recorded")
+    {
+        REQUIRE(statistics.getCount() == 0U);
+        REQUIRE(statistics.getMin() == 0U);
+        REQUIRE(statistics.getMax() == 0U);
+        REQUIRE(statistics.getAverage() == 0U);
+        REQUIRE(statistics.getPercentile(99U) == 0U);
+    }
+
+    SECTION("should keep running min, average and max")
+    {
+        statistics.record(300U);
+        statistics.record(100U);
+        statistics.record(200U);
+
+        REQUIRE(statistics.getCount() == 3U);
+        REQUIRE(statistics.getMin() == 100U);
+        REQUIRE(statistics.getMax() == 300U);
+        REQUIRE(statistics.getAverage() == 200U);
+    }
+
+    SECTION("getPercentile should")
+    {
+        auto i = 0U;
+        while (i < 1'000U)
+        {
+            statistics.record(10U);
+            ++i;
+        }
+
+        SECTION("ignore outliers that are below the percentile")
+        {
+            i = 0U;
+            while (i < 10U)
+            {
+                statistics.record(5'000U);
+                ++i;
+            }
+
+            REQUIRE(statistics.getPercentile(99U) == 10U);
+            REQUIRE(statistics.getMax() == 5'000U);
+        }
+
+        SECTION("return the bucket of the outliers once they exceed the percentile")
+        {
+            i = 0U;
+            while (i < 11U)
+            {
+                statistics.record(5'000U);
+                ++i;
+            }
+
+            REQUIRE(statistics.getPercentile(99U) <= 5'000U);
+            REQUIRE(statistics.getPercentile(99U) >= 5'000U - 5'000U / StageStatistics::subBucketCount);
+        }
+    }
+
+    SECTION("reset should clear all statistics")
+    {
+        statistics.record(100U);
+        statistics.record(200U);
+
+        statistics.reset();
+
+        REQUIRE(statistics.getCount() == 0U);
+        REQUIRE(statistics.getMin() == 0U);
+        REQUIRE(statistics.getMax() == 0U);
+        REQUIRE(statistics.getAverage() == 0U);
+        REQUIRE(statistics.getPercentile(99U) == 0U);
+
+        statistics.record(50U);
+
+        REQUIRE(statistics.getMin() == 50U);
+    }
+}
+
+TEST_CASE("PipelineProfiler")
+{
+    PipelineProfiler profiler;
+
+    SECTION("should record the ticks for the given stage only")
+    {
+        profiler.record(PipelineStage::DerivativeMatrices, 1'500U);
+
+        REQUIRE(profiler.getStatistics(PipelineStage::DerivativeMatrices).getCount() == 1U);
+        REQUIRE(profiler.getStatistics(PipelineStage::DerivativeMatrices).getMax() == 1'500U);
+        REQUIRE(profiler.getStatistics(PipelineStage::CyclicFilter).getCount() == 0U);
+        REQUIRE(profiler.getStatistics(PipelineStage::StateMachine).getCount() == 0U);
+    }
+
+    SECTION("reset should clear every stage")
+    {
+        profiler.record(PipelineStage::CyclicFilter, 1'000U);
+        profiler.record(PipelineStage::PublishData, 1'000U);
+
+        profiler.reset();
+
+        REQUIRE(profiler.getStatistics(PipelineStage::CyclicFilter).getCount() == 0U);
+        REQUIRE(profiler.getStatistics(PipelineStage::PublishData).getCount() == 0U);
+    }
+
+    SECTION("summary should list the statistics of every stage in microseconds")
+    {
+        profiler.record(PipelineStage::CyclicFilter, 1'000U);
+        profiler.record(PipelineStage::CyclicFilter, 2'000U);
+        profiler.record(PipelineStage::CyclicFilter, 3'000U);
+        profiler.record(PipelineStage::PublishData, 2'500U);
+
+        const string expected = "Pipeline profile (us) over 3 impulses\n"
+                                "cyclicFilter: min 1.0, avg 2.0, max 3.0, p99 3.0\n"
+                                "deltaTimes: min 0.0, avg 0.0, max 0.0, p99 0.0\n"
+                                "angularDistances: min 0.0, avg 0.0, max 0.0, p99 0.0\n"
+                                "derivativeMatrices: min 0.0, avg 0.0, max 0.0, p99 0.0\n"
+                                "stateMachine: min 0.0, avg 0.0, max 0.0, p99 0.0\n"
+                                "publishData: min 2.5, avg 2.5, max 2.5, p99 2.5\n";
+
+        REQUIRE(profiler.summary() == expected);
+    }
+
+    SECTION("timer should compile to an empty object when profiling is disabled")
+    {
+        STATIC_REQUIRE(std::is_empty_v<BasicPipelineStageTimer<false>>);
+    }
+}
+// NOLINTEND(readability-magic-numbers,readability-function-cognitive-complexity)
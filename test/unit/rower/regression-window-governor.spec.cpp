@@ -0,0 +1,134 @@
+// NOLINTBEGIN(readability-magic-numbers,readability-function-cognitive-complexity)
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/rower/regression-window-governor.h"
+#include "../../../src/utils/enums.h"
+
+TEST_CASE("RegressionWindowGovernor")
+{
+    const unsigned char warmUpLength = 5U;
+    RegressionWindowGovernor governor(warmUpLength);
+
+    const auto overload = [&governor]()
+    {
+        auto updates = 0U;
+        while (!governor.update(800, 1'000))
+        {
+            ++updates;
+        }
+
+        return updates;
+    };
+
+    const auto warmUp = [&governor](const Configurations::precision processingTime, const Configurations::precision deltaTime)
+    {
+        auto i = 1U;
+        while (i < warmUpLength)
+        {
+            REQUIRE_FALSE(governor.update(processingTime, deltaTime));
+            ++i;
+        }
+        REQUIRE(governor.update(processingTime, deltaTime));
+    };
+
+    SECTION("should keep the full window while there is sufficient headroom")
+    {
+        auto i = 0U;
+        while (i < 1'000U)
+        {
+            REQUIRE_FALSE(governor.update(500, 1'000));
+            ++i;
+        }
+
+        REQUIRE(governor.getWindow() == RegressionWindow::Full);
+        REQUIRE_FALSE(governor.isReducedWindowActive());
+    }
+
+    SECTION("should start shrinking once the average processing time exceeds the shrink load")
+    {
+        // The average needs 11 impulses of 80% load to get above the 60% limit
+        REQUIRE(overload() == 10U);
+        REQUIRE(governor.getWindow() == RegressionWindow::Shrinking);
+        REQUIRE_FALSE(governor.isReducedWindowActive());
+        REQUIRE(governor.getSwitchCount() == 0U);
+    }
+
+    SECTION("should switch to the reduced window after the warm-up")
+    {
+        overload();
+
+        warmUp(800, 1'000);
+
+        REQUIRE(governor.getWindow() == RegressionWindow::Reduced);
+        REQUIRE(governor.isReducedWindowActive());
+        REQUIRE(governor.getSwitchCount() == 1U);
+    }
+
+    SECTION("when reduced")
+    {
+        overload();
+        warmUp(800, 1'000);
+
+        SECTION("should stay reduced while the full window would not fit in the restore load")
+        {
+            auto i = 0U;
+            while (i < 1'000U)
+            {
+                REQUIRE_FALSE(governor.update(100, 1'500));
+                ++i;
+            }
+
+            REQUIRE(governor.getWindow() == RegressionWindow::Reduced);
+        }
+
+        SECTION("should start restoring only after the restore delay of consecutive impulses with slack")
+        {
+            auto i = 1U;
+            while (i < RegressionWindowGovernor::restoreDelay)
+            {
+                REQUIRE_FALSE(governor.update(100, 5'000));
+                ++i;
+            }
+            REQUIRE_FALSE(governor.update(100, 1'000));
+
+            i = 1U;
+            while (i < RegressionWindowGovernor::restoreDelay)
+            {
+                REQUIRE_FALSE(governor.update(100, 5'000));
+                ++i;
+            }
+            REQUIRE(governor.update(100, 5'000));
+
+            REQUIRE(governor.getWindow() == RegressionWindow::Restoring);
+            REQUIRE(governor.isReducedWindowActive());
+        }
+
+        SECTION("and restoring")
+        {
+            auto i = 0U;
+            while (i < RegressionWindowGovernor::restoreDelay)
+            {
+                governor.update(100, 5'000);
+                ++i;
+            }
+
+            SECTION("should switch back to the full window after the warm-up")
+            {
+                warmUp(200, 5'000);
+
+                REQUIRE(governor.getWindow() == RegressionWindow::Full);
+                REQUIRE_FALSE(governor.isReducedWindowActive());
+                REQUIRE(governor.getSwitchCount() == 2U);
+            }
+
+            SECTION("should abandon the restore and keep the reduced window when overloaded")
+            {
+                REQUIRE(governor.update(5'000, 1'000));
+
+                REQUIRE(governor.getWindow() == RegressionWindow::Reduced);
+                REQUIRE(governor.getSwitchCount() == 1U);
+            }
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers,readability-function-cognitive-complexity)
@@ -1,8 +1,10 @@
+#include <span>
 #include <vector>
 
 #include "catch2/catch_test_macros.hpp"
 #include "fakeit.hpp"
 
+#include "../../../src/peripherals/peripherals.controller.interface.h"
 #include "../../../src/rower/flywheel.service.interface.h"
 #include "../../../src/rower/stroke.controller.h"
 #include "../../../src/rower/stroke.model.h"
@@ -75,17 +77,17 @@ TEST_CASE("StrokeController", "[rower]")
             Mock<IFlywheelService> mockFlywheelService;
             Mock<IEEPROMService> mockEEPROMService;
             Fake(Method(mockStrokeService, processFilterBuffer));
-            When(Method(mockFlywheelService, hasDataChanged)).Return(true);
+            When(Method(mockFlywheelService, hasDataChanged)).Return(true, false);
             When(Method(mockFlywheelService, getData)).Return({});
 
             StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
             strokeController.update();
 
             Verify(Method(mockStrokeService, processFilterBuffer)).Once();
-            Verify(Method(mockFlywheelService, hasDataChanged)).Once();
+            Verify(Method(mockFlywheelService, hasDataChanged)).Exactly(2);
             Verify(Method(mockFlywheelService, getData)).Once();
-            Verify(Method(mockStrokeService, processData)).Exactly(0);
-            Verify(Method(mockStrokeService, getData)).Exactly(0);
+            Verify(Method(mockStrokeService, processBatch)).Exactly(0);
+            Verify(Method(mockStrokeService, publishData)).Exactly(0);
             VerifyNoOtherInvocations(mockFlywheelService);
             VerifyNoOtherInvocations(mockStrokeService);
         }
@@ -96,7 +98,7 @@ TEST_CASE("StrokeController", "[rower]")
             Mock<IFlywheelService> mockFlywheelService;
             Mock<IEEPROMService> mockEEPROMService;
             Fake(Method(mockStrokeService, processFilterBuffer));
-            When(Method(mockFlywheelService, hasDataChanged)).Return(true);
+            When(Method(mockFlywheelService, hasDataChanged)).Return(true, false);
             When(Method(mockFlywheelService, getData)).Return({
                 .rawImpulseCount = 1,
                 .deltaTime = 0,
@@ -105,14 +107,14 @@ TEST_CASE("StrokeController", "[rower]")
                 .cleanImpulseTime = 0,
                 .rawImpulseTime = 0,
             });
-            Fake(Method(mockStrokeService, processData));
-            When(Method(mockStrokeService, getData)).Return({});
+            Fake(Method(mockStrokeService, processBatch));
+            Fake(Method(mockStrokeService, publishData));
 
             StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
             strokeController.update();
 
             Verify(Method(mockStrokeService, processFilterBuffer)).Once();
-            Verify(Method(mockFlywheelService, hasDataChanged)).Once();
+            Verify(Method(mockFlywheelService, hasDataChanged)).Exactly(2);
 
             SECTION("should get flywheel data")
             {
@@ -121,13 +123,92 @@ TEST_CASE("StrokeController", "[rower]")
 
             SECTION("should process new flywheel data")
             {
-                Verify(Method(mockStrokeService, processData)).Once();
+                Verify(Method(mockStrokeService, processBatch)).Once();
             }
 
-            SECTION("should get new process metrics")
+            SECTION("should publish the new metrics")
             {
-                Verify(Method(mockStrokeService, getData)).Once();
+                Verify(Method(mockStrokeService, publishData)).Once();
             }
         }
+
+        SECTION("should process every queued impulse in one batch")
+        {
+            Mock<IStrokeService> mockStrokeService;
+            Mock<IFlywheelService> mockFlywheelService;
+            Mock<IEEPROMService> mockEEPROMService;
+            Fake(Method(mockStrokeService, processFilterBuffer));
+            When(Method(mockFlywheelService, hasDataChanged)).Return(true, true, true, true, false);
+            When(Method(mockFlywheelService, getData))
+                .Return({.rawImpulseCount = 1, .deltaTime = 0, .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0})
+                .Return({.rawImpulseCount = 1, .deltaTime = 0, .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0})
+                .Return({.rawImpulseCount = 2, .deltaTime = 0, .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0})
+                .Return({.rawImpulseCount = 3, .deltaTime = 0, .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0});
+            std::vector<unsigned long> batchImpulseCounts;
+            When(Method(mockStrokeService, processBatch)).Do([&batchImpulseCounts](const std::span<const RowingDataModels::FlywheelData> batch)
+                                                             {
+                                                                 for (const auto &data : batch)
+                                                                 {
+                                                                     batchImpulseCounts.push_back(data.rawImpulseCount);
+                                                                 } });
+            Fake(Method(mockStrokeService, publishData));
+
+            StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+            strokeController.update();
+
+            Verify(Method(mockFlywheelService, getData)).Exactly(4);
+            Verify(Method(mockStrokeService, processBatch)).Once();
+            Verify(Method(mockStrokeService, publishData)).Once();
+            REQUIRE(batchImpulseCounts == std::vector<unsigned long>{1, 2, 3});
+            REQUIRE(strokeController.getRawImpulseCount() == 3);
+        }
+
+        SECTION("should keep every impulse of the batch for the delta time logging")
+        {
+            Mock<IStrokeService> mockStrokeService;
+            Mock<IFlywheelService> mockFlywheelService;
+            Mock<IEEPROMService> mockEEPROMService;
+            Fake(Method(mockStrokeService, processFilterBuffer));
+            When(Method(mockFlywheelService, hasDataChanged)).Return(true, true, true, false, false);
+            When(Method(mockFlywheelService, getData))
+                .Return({.rawImpulseCount = 1, .deltaTime = deltaTimes[0], .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0})
+                .Return({.rawImpulseCount = 2, .deltaTime = deltaTimes[1], .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0})
+                .Return({.rawImpulseCount = 3, .deltaTime = deltaTimes[2], .totalTime = 0, .totalAngularDisplacement = 0, .cleanImpulseTime = 0, .rawImpulseTime = 0});
+            Fake(Method(mockStrokeService, processBatch));
+            Fake(Method(mockStrokeService, publishData));
+            Mock<IPeripheralsController> mockPeripheralsController;
+            Fake(Method(mockPeripheralsController, updateDeltaTime));
+
+            StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+            strokeController.update();
+
+            // Same as the main loop
+            for (const auto &impulse : strokeController.getLastBatch())
+            {
+                mockPeripheralsController.get().updateDeltaTime(impulse.deltaTime);
+            }
+
+            Verify(Method(mockPeripheralsController, updateDeltaTime).Using(deltaTimes[0]), Method(mockPeripheralsController, updateDeltaTime).Using(deltaTimes[1]), Method(mockPeripheralsController, updateDeltaTime).Using(deltaTimes[2])).Once();
+            Verify(Method(mockPeripheralsController, updateDeltaTime)).Exactly(3);
+
+            strokeController.update();
+
+            REQUIRE(strokeController.getLastBatch().empty());
+        }
+
+        SECTION("should stop catching up after a full queue worth of impulses")
+        {
+            Mock<IStrokeService> mockStrokeService;
+            Mock<IFlywheelService> mockFlywheelService;
+            Mock<IEEPROMService> mockEEPROMService;
+            Fake(Method(mockStrokeService, processFilterBuffer));
+            When(Method(mockFlywheelService, hasDataChanged)).AlwaysReturn(true);
+            When(Method(mockFlywheelService, getData)).AlwaysReturn({});
+
+            StrokeController strokeController(mockStrokeService.get(), mockFlywheelService.get(), mockEEPROMService.get());
+            strokeController.update();
+
+            Verify(Method(mockFlywheelService, getData)).Exactly(Configurations::impulseQueueCapacity);
+        }
     }
-}
+}
\ No newline at end of file
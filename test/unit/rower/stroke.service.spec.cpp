@@ -13,6 +13,7 @@
 
 #include "../include/Arduino.h"
 
+#include "../../../src/rower/metrics-snapshot.h"
 #include "../../../src/rower/stroke.model.h"
 #include "../../../src/rower/stroke.service.h"
 #include "../../../src/utils/configuration.h"
@@ -90,6 +91,8 @@ TEST_CASE("StrokeService")
             CHECK(rowingMetrics.lastStrokeTime == 26'217'932);
             CHECK_THAT(rowingMetrics.distance, Catch::Matchers::WithinRel(9'230.74789692319063761, 0.0000001));
             CHECK(rowingMetrics.lastRevTime == 33'241'257);
+            CHECK(rowingMetrics.regressionWindowLength == 5);
+            CHECK(rowingMetrics.regressionWindowSwitchCount == 0);
         }
 
         SECTION("change sensor signal related settings")
@@ -346,5 +349,96 @@ TEST_CASE("StrokeService")
             REQUIRE(rowingMetrics.lastRevTime == 33'925'253);
         }
     }
+
+    SECTION("processBatch method should give the same metrics as processing impulses one by one")
+    {
+        StrokeService strokeServiceSingle;
+        StrokeService strokeServiceBatch;
+        const auto batchLength = 5U;
+        vector<RowingDataModels::FlywheelData> batch;
+        batch.reserve(batchLength);
+
+        auto rawImpulseCount = 0UL;
+        auto totalTime = 0UL;
+        Configurations::precision totalAngularDisplacement = 0.0;
+        for (const auto &deltaTime : deltaTimes)
+        {
+            totalAngularDisplacement += angularDisplacementPerImpulse;
+            totalTime += deltaTime;
+            rawImpulseCount++;
+            const RowingDataModels::FlywheelData data{
+                .rawImpulseCount = rawImpulseCount,
+                .deltaTime = deltaTime,
+                .totalTime = totalTime,
+                .totalAngularDisplacement = totalAngularDisplacement,
+                .cleanImpulseTime = totalTime,
+                .rawImpulseTime = totalTime,
+            };
+
+            strokeServiceSingle.processData(data);
+
+            batch.push_back(data);
+            if (batch.size() == batchLength)
+            {
+                strokeServiceBatch.processBatch(batch);
+                batch.clear();
+            }
+        }
+        strokeServiceBatch.processBatch(batch);
+
+        const auto singleMetrics = strokeServiceSingle.getData();
+        const auto batchMetrics = strokeServiceBatch.getData();
+
+        REQUIRE(batchMetrics.strokeCount == singleMetrics.strokeCount);
+        REQUIRE(batchMetrics.lastStrokeTime == singleMetrics.lastStrokeTime);
+        REQUIRE(batchMetrics.lastRevTime == singleMetrics.lastRevTime);
+        REQUIRE(batchMetrics.distance == singleMetrics.distance);
+        REQUIRE(batchMetrics.dragCoefficient == singleMetrics.dragCoefficient);
+        REQUIRE(batchMetrics.driveHandleForces == singleMetrics.driveHandleForces);
+    }
+
+    SECTION("publishData method should publish the metrics and the force curve of the last completed drive")
+    {
+        StrokeService strokeService;
+        MetricsSnapshot snapshot;
+        auto rawImpulseCount = 0UL;
+        auto totalTime = 0UL;
+        Configurations::precision totalAngularDisplacement = 0.0;
+        for (const auto &deltaTime : deltaTimes)
+        {
+            totalAngularDisplacement += angularDisplacementPerImpulse;
+            totalTime += deltaTime;
+            rawImpulseCount++;
+            const RowingDataModels::FlywheelData data{
+                .rawImpulseCount = rawImpulseCount,
+                .deltaTime = deltaTime,
+                .totalTime = totalTime,
+                .totalAngularDisplacement = totalAngularDisplacement,
+                .cleanImpulseTime = totalTime,
+                .rawImpulseTime = totalTime,
+            };
+
+            const auto *const previousBuffer = &snapshot.read();
+            const auto previousStrokeCount = snapshot.read().strokeCount;
+            strokeService.processData(data);
+            strokeService.publishData(snapshot);
+
+            REQUIRE(&snapshot.read() != previousBuffer);
+
+            const auto &published = snapshot.read();
+            const auto rowingMetrics = strokeService.getData();
+            REQUIRE(published.strokeCount == rowingMetrics.strokeCount);
+            REQUIRE(published.lastRevTime == rowingMetrics.lastRevTime);
+            REQUIRE(published.distance == rowingMetrics.distance);
+            REQUIRE(published.handleForcesRevision == rowingMetrics.handleForcesRevision);
+
+            if (published.strokeCount > previousStrokeCount)
+            {
+                REQUIRE(published.driveHandleForces == rowingMetrics.driveHandleForces);
+            }
+        }
+
+        REQUIRE(snapshot.read().strokeCount == 10);
+    }
 }
 // NOLINTEND(readability-magic-numbers,readability-function-cognitive-complexity,cppcoreguidelines-avoid-do-while)
\ No newline at end of file
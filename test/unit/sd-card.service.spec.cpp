@@ -1,5 +1,7 @@
 // NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while, clang-analyzer-cplusplus.NewDeleteLeaks, clang-analyzer-cplusplus.NewDelete)
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "catch2/catch_test_macros.hpp"
 #include "fakeit.hpp"
@@ -9,6 +11,7 @@
 
 #include "../../src/peripherals/sd-card/sd-card.service.h"
 #include "../../src/utils/configuration.h"
+#include "../../src/utils/impulse-log/impulse-log.h"
 
 using namespace fakeit;
 
@@ -22,6 +25,7 @@ TEST_CASE("SdCardService", "[peripheral]")
     {
         File32 root;
         SdCardService sdCardService;
+        const RowerProfile::MachineSettings machineSettings{.impulsesPerRevolution = 5};
 
         When(Method(mockSdFat32, begin)).AlwaysReturn(true);
         When(Method(mockSdFat32, open)).AlwaysReturn(root);
@@ -30,10 +34,20 @@ TEST_CASE("SdCardService", "[peripheral]")
         When(Method(mockFile32, openNext)).AlwaysReturn(false);
         When(Method(mockFile32, open)).AlwaysReturn(true);
         When(Method(mockFile32, close)).AlwaysReturn(true);
+        When(Method(mockFile32, preAllocate)).AlwaysReturn(true);
+        When(Method(mockFile32, seekSet)).AlwaysReturn(true);
+        When(Method(mockFile32, write)).AlwaysDo([](const void *, const size_t nbyte)
+                                                 { return nbyte; });
+        Fake(Method(mockFile32, flush));
+        When(Method(mockArduino, millis)).AlwaysReturn(0);
+        When(Method(mockArduino, esp_random)).AlwaysReturn(0x12'34'56'78U);
+        When(Method(mockArduino, xTaskCreatePinnedToCore)).AlwaysReturn(1);
+        When(Method(mockArduino, ulTaskNotifyTake)).AlwaysReturn(1);
+        Fake(Method(mockArduino, vTaskDelete));
 
         SECTION("should initialize SD card with correct parameters")
         {
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             Verify(Method(mockSdFat32, begin).Matching([](SdSpiConfig config)
                                                        { return config.csPin == Configurations::sdCardChipSelectPin && config.options == SHARED_SPI && config.maxSck == SD_SCK_MHZ(26); }))
@@ -44,7 +58,7 @@ TEST_CASE("SdCardService", "[peripheral]")
         {
             When(Method(mockSdFat32, begin)).AlwaysReturn(false);
 
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             Verify(Method(mockSdFat32, begin).Matching([](SdSpiConfig config)
                                                        { return config.csPin == Configurations::sdCardChipSelectPin && config.options == SHARED_SPI && config.maxSck == SD_SCK_MHZ(26); }))
@@ -55,7 +69,7 @@ TEST_CASE("SdCardService", "[peripheral]")
 
         SECTION("should open root directory on SD card")
         {
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             Verify(Method(mockSdFat32, open).Using(StrEq("/"), O_RDONLY)).Once();
             Verify(Method(mockFile32, isOpen)).Once();
@@ -65,7 +79,7 @@ TEST_CASE("SdCardService", "[peripheral]")
         {
             When(Method(mockFile32, isOpen)).AlwaysReturn(false);
 
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             Verify(Method(mockSdFat32, open).Using(StrEq("/"), O_RDONLY)).Once();
             Verify(Method(mockFile32, isOpen)).Once();
@@ -77,103 +91,187 @@ TEST_CASE("SdCardService", "[peripheral]")
         {
             When(Method(mockFile32, openNext)).Return(true, true, false);
 
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             // TODO: Need to find a way to match to the root variable instance as that should be used exactly
             Verify(Method(mockFile32, openNext).Using(root, O_RDONLY)).Exactly(3);
             Verify(Method(mockFile32, close)).Exactly(3);
-            Verify(Method(mockFile32, open).Using("2.txt", Eq(O_WRITE | O_CREAT | O_AT_END))).Once();
+            Verify(Method(mockFile32, open).Using("2.ilog", Eq(O_WRITE | O_CREAT | O_EXCL))).Once();
         }
 
         SECTION("should open the log file")
         {
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             // TODO: Need to find a way to match to the root variable instance as that should be used exactly
-            Verify(Method(mockFile32, open).Using("0.txt", Eq(O_WRITE | O_CREAT | O_AT_END))).Once();
+            Verify(Method(mockFile32, open).Using("0.ilog", Eq(O_WRITE | O_CREAT | O_EXCL))).Once();
         }
 
         SECTION("should handle log file opening failure")
         {
             When(Method(mockFile32, open)).AlwaysReturn(false);
 
-            sdCardService.setup();
+            sdCardService.setup(machineSettings);
 
             // TODO: Need to find a way to match to the root variable instance as that should be used exactly
             Verify(Method(mockSdFat32, end)).Once();
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
+        }
+
+        SECTION("should preallocate the log file and write the impulse log header to its start")
+        {
+            sdCardService.setup(machineSettings);
+
+            Verify(Method(mockFile32, preAllocate).Using(Configurations::sdCardPreallocatedSize)).Once();
+            Verify(Method(mockFile32, seekSet).Using(0UL)).Once();
+            Verify(Method(mockFile32, write).Using(Any(), ImpulseLog::blockSize)).AtLeast(2);
+        }
+
+        SECTION("should write the machine settings and the rower profile to the impulse log header")
+        {
+            std::vector<unsigned char> headerBlock;
+            When(Method(mockFile32, write)).AlwaysDo([&headerBlock](const void *buf, const size_t nbyte)
+                                                     {
+                                                         if (headerBlock.empty())
+                                                         {
+                                                             const auto *const bytes = static_cast<const unsigned char *>(buf);
+                                                             headerBlock.assign(bytes, bytes + nbyte);
+                                                         }
+
+                                                         return nbyte; });
+
+            sdCardService.setup(machineSettings);
+
+            ImpulseLog::FileHeader header;
+
+            REQUIRE(ImpulseLog::readFileHeader(headerBlock, header));
+            REQUIRE(header.impulsesPerRevolution == 5);
+            REQUIRE(header.profile() == Configurations::rowerProfileName);
+            REQUIRE(header.logId == 0x12'34'56'78U);
+        }
+
+        SECTION("should handle log file header writing failure")
+        {
+            When(Method(mockFile32, write)).AlwaysReturn(0);
+
+            sdCardService.setup(machineSettings);
+
+            // Root directory and the log file
+            Verify(Method(mockFile32, close)).Exactly(2);
+            Verify(Method(mockSdFat32, end)).Once();
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
+        }
+
+        SECTION("should start a single writer task")
+        {
+            const auto expectedStackSize = 3'072U;
+
+            sdCardService.setup(machineSettings);
+
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore).Using(Ne(nullptr), StrEq("sdCardWriterTask"), Eq(expectedStackSize), Ne(nullptr), Eq(1U), Ne(nullptr), Eq(0))).Once();
+        }
+
+        SECTION("should not start the writer task if SD card initialization failed")
+        {
+            When(Method(mockSdFat32, begin)).AlwaysReturn(false);
+
+            sdCardService.setup(machineSettings);
+
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
         }
     }
 
     SECTION("saveDeltaTime method")
     {
-        const auto safeFlushPeriod = 30'000U;
-        const auto expectedStackSize = 2'048U;
-
         SdCardService sdCardService;
+        const RowerProfile::MachineSettings machineSettings;
 
+        std::vector<std::vector<unsigned char>> writes;
+        File32 root;
         mockSdFat32.Reset();
         mockFile32.Reset();
         mockArduino.Reset();
+        When(Method(mockSdFat32, begin)).AlwaysReturn(true);
+        When(Method(mockSdFat32, open)).AlwaysReturn(root);
         Fake(Method(mockSdFat32, end));
         When(Method(mockFile32, isOpen)).AlwaysReturn(true);
+        When(Method(mockFile32, openNext)).AlwaysReturn(false);
+        When(Method(mockFile32, open)).AlwaysReturn(true);
         When(Method(mockFile32, close)).AlwaysReturn(true);
-        Fake(Method(mockFile32, println));
+        When(Method(mockFile32, preAllocate)).AlwaysReturn(true);
+        When(Method(mockFile32, seekSet)).AlwaysReturn(true);
+        When(Method(mockFile32, write)).AlwaysDo([&writes](const void *buf, const size_t nbyte)
+                                                 {
+                                                     const auto *const bytes = static_cast<const unsigned char *>(buf);
+                                                     writes.emplace_back(bytes, bytes + nbyte);
+
+                                                     return nbyte; });
         Fake(Method(mockFile32, flush));
+        When(Method(mockArduino, millis)).AlwaysReturn(0);
+        When(Method(mockArduino, esp_random)).AlwaysReturn(0x12'34'56'78U);
         When(Method(mockArduino, xTaskCreatePinnedToCore)).AlwaysReturn(1);
         Fake(Method(mockArduino, vTaskDelete));
 
-        SECTION("should write delta times to the log file")
-        {
-            std::vector<unsigned long> deltaTimesNoFlush = {10000, 20000, safeFlushPeriod + 1000, 30000};
-
-            sdCardService.saveDeltaTime(deltaTimesNoFlush);
-
-            Verify(Method(mockFile32, println)).Exactly(4_Times);
-            Verify(Method(mockArduino, xTaskCreatePinnedToCore).Using(Ne(nullptr), StrEq("saveDeltaTimeTask"), Eq(expectedStackSize), Ne(nullptr), Eq(1U), Any(), Eq(0))).Once();
-
-            SECTION("without flushing if last delta time does not exceed safeFlushPeriod")
-            {
-                sdCardService.saveDeltaTime(deltaTimesNoFlush);
+        const std::vector<unsigned long> deltaTimes{10'000, 20'000, 30'000, 31'000};
 
-                VerifyNoOtherInvocations(Method(mockFile32, flush));
-            }
-
-            SECTION("with flush if last delta time exceeds safeFlushPeriod")
+        SECTION("should queue delta times that the writer task writes to the log file")
+        {
+            // The writer task runs synchronously on task creation in the unit tests, so the delta times are saved while it waits for the first time
+            auto waitCount = 0U;
+            When(Method(mockArduino, ulTaskNotifyTake)).AlwaysDo([&sdCardService, &deltaTimes, &waitCount](BaseType_t, TickType_t)
+                                                                  {
+                                                                      ++waitCount;
+                                                                      if (waitCount == 1U)
+                                                                      {
+                                                                          for (const auto deltaTime : deltaTimes)
+                                                                          {
+                                                                              sdCardService.saveDeltaTime(deltaTime);
+                                                                          }
+
+                                                                          return 0U;
+                                                                      }
+
+                                                                      return 1U; });
+
+            sdCardService.setup(machineSettings);
+
+            REQUIRE(writes.size() >= 2);
+
+            ImpulseLog::Block block{};
+            std::ranges::copy(writes[writes.size() - 2], begin(block));
+            ImpulseLogDecoder decoder;
+            std::vector<unsigned long> writtenDeltaTimes;
+            unsigned long deltaTime = 0;
+
+            REQUIRE(decoder.open(block));
+            while (decoder.next(deltaTime))
             {
-                std::vector<unsigned long> deltaTimesFlush = {10000, 20000, 30000, safeFlushPeriod + 1};
-
-                sdCardService.saveDeltaTime(deltaTimesFlush);
-
-                Verify(Method(mockFile32, flush)).Once();
+                writtenDeltaTimes.push_back(deltaTime);
             }
-        }
 
-        SECTION("should handle empty delta times vector")
-        {
-            std::vector<unsigned long> emptyDeltaTimes;
-
-            sdCardService.saveDeltaTime(emptyDeltaTimes);
-
-            VerifyNoOtherInvocations(Method(mockFile32, println));
-            VerifyNoOtherInvocations(Method(mockArduino, xTaskCreatePinnedToCore));
+            REQUIRE(writtenDeltaTimes == deltaTimes);
+            REQUIRE(writes.back() == std::vector<unsigned char>(ImpulseLog::blockSize, 0));
+            Verify(Method(mockArduino, ulTaskNotifyTake).Using(pdTRUE, pdMS_TO_TICKS(Configurations::sdCardWriterPeriod))).Twice();
         }
 
-        SECTION("should handle log file not open")
+        SECTION("should delete the writer task once it is notified to stop")
         {
-            When(Method(mockFile32, isOpen)).Return(false);
+            When(Method(mockArduino, ulTaskNotifyTake)).AlwaysReturn(1);
 
-            sdCardService.saveDeltaTime({10000});
+            sdCardService.setup(machineSettings);
 
-            // No methods should be called since the log file is not open
-            VerifyNoOtherInvocations(Method(mockFile32, println));
-            VerifyNoOtherInvocations(Method(mockArduino, xTaskCreatePinnedToCore));
+            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
         }
 
-        SECTION("should delete the task after saving delta times")
+        SECTION("should not queue delta times if the writer task is not running")
         {
-            sdCardService.saveDeltaTime({10000});
+            for (const auto deltaTime : deltaTimes)
+            {
+                sdCardService.saveDeltaTime(deltaTime);
+            }
 
-            Verify(Method(mockArduino, vTaskDelete).Using(nullptr)).Once();
+            Verify(Method(mockFile32, write)).Never();
+            Verify(Method(mockArduino, xTaskCreatePinnedToCore)).Never();
         }
     }
 
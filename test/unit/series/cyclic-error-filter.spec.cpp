@@ -210,6 +210,43 @@ TEST_CASE("CyclicErrorFilter")
             REQUIRE(filter.isStabilized());
         }
 
+        SECTION("should drop datapoints beyond the recording capacity")
+        {
+            const unsigned short maxRecordedDatapoints = 3;
+            CyclicErrorFilter filter(4, 5, 1.0, 10, maxRecordedDatapoints);
+
+            filter.updateRegressionCoefficients(0.0, 100.0, 0.99);
+
+            for (int i = 0; i < 5; ++i)
+            {
+                filter.recordRawDatapoint(i, static_cast<Configurations::precision>(i), 100.0);
+            }
+
+            REQUIRE(filter.getDroppedDatapointCount() == 2);
+
+            auto replayedCount = 0U;
+            while (filter.processNextRawDatapoint())
+            {
+                ++replayedCount;
+            }
+
+            REQUIRE(replayedCount == maxRecordedDatapoints);
+        }
+
+        SECTION("should clear the dropped datapoint count on restart")
+        {
+            CyclicErrorFilter filter(4, 5, 1.0, 10, 0);
+
+            filter.recordRawDatapoint(0, 0.0, 100.0);
+            filter.recordRawDatapoint(1, 1.0, 100.0);
+
+            REQUIRE(filter.getDroppedDatapointCount() == 2);
+
+            filter.restart();
+
+            REQUIRE(filter.getDroppedDatapointCount() == 0);
+        }
+
         SECTION("should not record data when aggressiveness is 0")
         {
             CyclicErrorFilter filter(4, 5, 0.0, 5);
@@ -251,6 +288,26 @@ TEST_CASE("CyclicErrorFilter")
             REQUIRE(filter.isStabilized());
         }
 
+        SECTION("should return true for every replayed datapoint and false once the recording is exhausted")
+        {
+            CyclicErrorFilter filter(4, 5, 1.0, 10);
+
+            filter.updateRegressionCoefficients(0.001, 100.0, 0.99);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                filter.recordRawDatapoint(i, static_cast<Configurations::precision>(i), 100.0);
+            }
+
+            for (int i = 0; i < 4; ++i)
+            {
+                REQUIRE(filter.processNextRawDatapoint());
+            }
+
+            REQUIRE_FALSE(filter.processNextRawDatapoint());
+            REQUIRE_FALSE(filter.processNextRawDatapoint());
+        }
+
         SECTION("should do nothing when buffer is empty")
         {
             CyclicErrorFilter filter(4, 5, 1.0, 10);
@@ -345,6 +402,34 @@ TEST_CASE("CyclicErrorFilter")
             CHECK_FALSE(filter.isStabilized());
         }
 
+        SECTION("should reuse the recording storage for the next recovery")
+        {
+            const unsigned short maxRecordedDatapoints = 3;
+            CyclicErrorFilter filter(4, 5, 1.0, 10, maxRecordedDatapoints);
+
+            filter.updateRegressionCoefficients(0.0, 100.0, 0.99);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                filter.recordRawDatapoint(i, static_cast<Configurations::precision>(i), 100.0);
+            }
+
+            filter.restart();
+
+            for (int i = 0; i < 3; ++i)
+            {
+                filter.recordRawDatapoint(i, static_cast<Configurations::precision>(i), 100.0);
+            }
+
+            auto replayedCount = 0U;
+            while (filter.processNextRawDatapoint())
+            {
+                ++replayedCount;
+            }
+
+            REQUIRE(replayedCount == maxRecordedDatapoints);
+        }
+
         SECTION("should preserve filter state")
         {
             CyclicErrorFilter filter(4, 5, 1.0, 5);
@@ -108,5 +108,46 @@ TEST_CASE("Ordinary Least Square Linear Regression", "[regression]")
             REQUIRE(olsRegRolling.yAtSeriesBegin() == 2.0);
         }
     }
+
+    SECTION("when maxSeriesLength is 0")
+    {
+        OLSLinearSeries olsRegUnbounded;
+        OLSLinearSeries olsRegReference(testCases.size());
+
+        for (const auto &testCase : testCases)
+        {
+            olsRegUnbounded.push(testCase[0], testCase[1]);
+            olsRegReference.push(testCase[0], testCase[1]);
+        }
+
+        SECTION("should keep every data point in the sums")
+        {
+            REQUIRE(olsRegUnbounded.size() == testCases.size());
+            REQUIRE(olsRegUnbounded.slope() == olsRegReference.slope());
+            REQUIRE(olsRegUnbounded.intercept() == olsRegReference.intercept());
+            REQUIRE(olsRegUnbounded.goodnessOfFit() == olsRegReference.goodnessOfFit());
+        }
+
+        SECTION("should return the first and last points")
+        {
+            REQUIRE(olsRegUnbounded.xAtSeriesBegin() == 5'331'447.0);
+            REQUIRE(olsRegUnbounded.yAtSeriesBegin() == 5'331'447.0);
+            REQUIRE(olsRegUnbounded.xAtSeriesEnd() == 6'825'842.0);
+        }
+
+        SECTION("reset should start a new series from the next point")
+        {
+            olsRegUnbounded.reset();
+
+            REQUIRE(olsRegUnbounded.size() == 0);
+            REQUIRE(olsRegUnbounded.slope() == 0.0);
+
+            olsRegUnbounded.push(3.0, 4.0);
+
+            REQUIRE(olsRegUnbounded.xAtSeriesBegin() == 3.0);
+            REQUIRE(olsRegUnbounded.yAtSeriesBegin() == 4.0);
+            REQUIRE(olsRegUnbounded.xAtSeriesEnd() == 3.0);
+        }
+    }
 }
 // NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
\ No newline at end of file
@@ -0,0 +1,195 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <array>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/configuration.h"
+#include "../../../src/utils/series/quadratic-fit-moments.h"
+#include "../../../src/utils/series/series.h"
+
+using std::array;
+using std::vector;
+
+namespace
+{
+    double bruteForceGoodnessOfFit(const vector<array<double, 2U>> &points, const double a, const double b, const double c)
+    {
+        auto averageY = 0.0;
+        for (const auto &[x, y] : points)
+        {
+            averageY += y;
+        }
+        averageY /= static_cast<double>(points.size());
+
+        auto sse = 0.0;
+        auto sst = 0.0;
+        for (const auto &[x, y] : points)
+        {
+            const auto error = y - (a * x * x + b * x + c);
+            sse += error * error;
+            sst += (y - averageY) * (y - averageY);
+        }
+
+        return 1 - (sse / sst);
+    }
+}
+
+TEST_CASE("QuadraticFitMoments")
+{
+    const auto a = 17.5;
+    const auto b = 3.25;
+    const auto c = -1.5;
+    const array<double, 10U> noise{0.02, -0.01, 0.015, -0.03, 0.0, 0.01, -0.02, 0.025, -0.005, 0.01};
+
+    SECTION("goodnessOfFit should return 0 when empty")
+    {
+        const QuadraticFitMoments moments;
+
+        REQUIRE(moments.goodnessOfFit(a, b, c) == 0.0);
+    }
+
+    SECTION("goodnessOfFit should return 1 for points on the curve")
+    {
+        QuadraticFitMoments moments;
+        for (auto i = 0U; i < 5U; ++i)
+        {
+            const auto x = 0.25 * i;
+            moments.push(x, a * x * x + b * x + c);
+        }
+
+        CHECK_THAT(moments.goodnessOfFit(a, b, c), Catch::Matchers::WithinAbs(1.0, 1e-12));
+    }
+
+    SECTION("goodnessOfFit should return 0 when Y is constant")
+    {
+        QuadraticFitMoments moments;
+        moments.push(1.0, 5.0);
+        moments.push(2.0, 5.0);
+        moments.push(3.0, 5.0);
+
+        REQUIRE(moments.goodnessOfFit(a, b, c) == 0.0);
+    }
+
+    SECTION("goodnessOfFit should match the R^2 calculated from the points when they are far from zero")
+    {
+        QuadraticFitMoments moments;
+        vector<array<double, 2U>> points;
+        for (auto i = 0U; i < noise.size(); ++i)
+        {
+            const auto x = 1'000.0 + 0.05 * i;
+            const auto y = a * x * x + b * x + c + noise[i];
+            moments.push(x, y);
+            points.push_back({x, y});
+        }
+
+        CHECK_THAT(moments.goodnessOfFit(a, b, c), Catch::Matchers::WithinRel(bruteForceGoodnessOfFit(points, a, b, c), 1e-9));
+    }
+
+    SECTION("remove should drop the point from the sums")
+    {
+        QuadraticFitMoments moments;
+        vector<array<double, 2U>> points;
+        for (auto i = 0U; i < noise.size(); ++i)
+        {
+            const auto x = 0.1 * i;
+            const auto y = a * x * x + b * x + c + noise[i];
+            moments.push(x, y);
+            points.push_back({x, y});
+        }
+
+        moments.remove(points[0][0], points[0][1]);
+        moments.remove(points[1][0], points[1][1]);
+        points.erase(points.begin(), points.begin() + 2);
+
+        CHECK_THAT(moments.goodnessOfFit(a, b, c), Catch::Matchers::WithinRel(bruteForceGoodnessOfFit(points, a, b, c), 1e-9));
+    }
+
+    SECTION("recalculate should rebuild the sums from the window")
+    {
+        const auto maxSeriesLength = 4U;
+        Series seriesX(maxSeriesLength);
+        Series seriesY(maxSeriesLength);
+        QuadraticFitMoments incremental;
+        QuadraticFitMoments recalculated;
+
+        for (auto i = 0U; i < noise.size(); ++i)
+        {
+            const auto x = 50.0 + 0.1 * i;
+            const auto y = a * x * x + b * x + c + noise[i];
+            if (seriesX.size() == maxSeriesLength)
+            {
+                incremental.remove(seriesX.front(), seriesY.front());
+            }
+            seriesX.push(x);
+            seriesY.push(y);
+            incremental.push(x, y);
+        }
+        recalculated.recalculate(seriesX, seriesY);
+
+        CHECK_THAT(recalculated.goodnessOfFit(a, b, c), Catch::Matchers::WithinRel(incremental.goodnessOfFit(a, b, c), 1e-9));
+    }
+
+    SECTION("goodnessOfFit should stay close to the R^2 of the points with float precision when the fit is nearly perfect")
+    {
+        const auto maxSeriesLength = 6U;
+        BasicQuadraticFitMoments<float> moments;
+        vector<array<double, 2U>> points;
+        vector<array<float, 2U>> window;
+        auto pushesSinceRecalculation = 0U;
+
+        for (auto i = 0U; i < 400U; ++i)
+        {
+            const auto x = 0.5 + 0.01 * i;
+            const auto y = a * x * x + b * x + c + noise[i % noise.size()] * 0.01;
+            if (window.size() == maxSeriesLength)
+            {
+                moments.remove(window.front()[0], window.front()[1]);
+                window.erase(window.begin());
+                points.erase(points.begin());
+            }
+            window.push_back({static_cast<float>(x), static_cast<float>(y)});
+            points.push_back({x, y});
+
+            ++pushesSinceRecalculation;
+            if (pushesSinceRecalculation < Configurations::quadraticFitMomentsRecalculationInterval)
+            {
+                moments.push(window.back()[0], window.back()[1]);
+            }
+            else
+            {
+                Series seriesX(maxSeriesLength);
+                Series seriesY(maxSeriesLength);
+                for (const auto &[pointX, pointY] : window)
+                {
+                    seriesX.push(pointX);
+                    seriesY.push(pointY);
+                }
+                moments.recalculate(seriesX, seriesY);
+                pushesSinceRecalculation = 0U;
+            }
+
+            if (window.size() == maxSeriesLength)
+            {
+                const auto goodnessOfFit = moments.goodnessOfFit(a, b, c);
+
+                REQUIRE(goodnessOfFit <= 1.0F);
+                REQUIRE_THAT(goodnessOfFit, Catch::Matchers::WithinAbs(bruteForceGoodnessOfFit(points, a, b, c), 1e-5));
+            }
+        }
+    }
+
+    SECTION("reset should clear the sums")
+    {
+        QuadraticFitMoments moments;
+        moments.push(1.0, 2.0);
+        moments.push(2.0, 3.0);
+
+        moments.reset();
+
+        REQUIRE(moments.goodnessOfFit(a, b, c) == 0.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -136,6 +136,22 @@ TEST_CASE("Series")
         REQUIRE(series.average() == 0.0);
     }
 
+    SECTION("rebase method should shift every value and the sum by the offset")
+    {
+        Series series(3);
+        series.push(10.0);
+        series.push(20.0);
+        series.push(30.0);
+        series.push(40.0);
+
+        series.rebase(15.0);
+
+        REQUIRE(series.front() == 5.0);
+        REQUIRE(series.back() == 25.0);
+        REQUIRE(series.sum() == 45.0);
+        REQUIRE(series.median() == 15.0);
+    }
+
     SECTION("when maxSeriesLength is")
     {
         SECTION("exceeded should roll window")
@@ -166,6 +182,26 @@ TEST_CASE("Series")
             REQUIRE(series.back() == 5.0);
         }
 
+        SECTION("exceeded should keep logical index order and median after the window rolls")
+        {
+            const auto maxSeriesLength = 4;
+            Series series(maxSeriesLength);
+
+            series.push(9.0);
+            series.push(1.0);
+            series.push(7.0);
+            series.push(3.0);
+            series.push(5.0);
+            series.push(2.0);
+
+            REQUIRE(series[0] == 7.0);
+            REQUIRE(series[1] == 3.0);
+            REQUIRE(series[2] == 5.0);
+            REQUIRE(series[3] == 2.0);
+            CHECK_THAT(series.median(), Catch::Matchers::WithinRel(4.0, 0.00001));
+            CHECK_THAT(series.average(), Catch::Matchers::WithinRel(4.25, 0.00001));
+        }
+
         SECTION("provided should initialize with capacity of maxSeriesLength")
         {
             const auto maxSeriesLength = 10;
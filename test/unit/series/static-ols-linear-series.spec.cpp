@@ -0,0 +1,43 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <initializer_list>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/ols-linear-series.h"
+#include "../../../src/utils/series/static-ols-linear-series.h"
+#include "./regression.test-cases.spec.h"
+
+TEST_CASE("Static Ordinary Least Square Linear Regression", "[regression]")
+{
+    SECTION("should match OLSLinearSeries after every push")
+    {
+        StaticOLSLinearSeries<testMaxSize> olsStatic;
+        OLSLinearSeries olsRuntime(testMaxSize);
+
+        for (const auto &testCase : testCases)
+        {
+            olsStatic.push(testCase[1] / 1e6, testCase[0] / 1e6);
+            olsRuntime.push(testCase[1] / 1e6, testCase[0] / 1e6);
+
+            REQUIRE(olsStatic.size() == olsRuntime.size());
+            REQUIRE(olsStatic.slope() == olsRuntime.slope());
+            REQUIRE(olsStatic.intercept() == olsRuntime.intercept());
+            REQUIRE(olsStatic.goodnessOfFit() == olsRuntime.goodnessOfFit());
+            REQUIRE(olsStatic.xAtSeriesBegin() == olsRuntime.xAtSeriesBegin());
+            REQUIRE(olsStatic.xAtSeriesEnd() == olsRuntime.xAtSeriesEnd());
+        }
+    }
+
+    SECTION("reset method should clear all internal series")
+    {
+        StaticOLSLinearSeries<testMaxSize> ols;
+        ols.push(1, 2);
+        ols.push(2, 4);
+
+        ols.reset();
+
+        REQUIRE(ols.size() == 0);
+        REQUIRE(ols.slope() == 0.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,155 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/configuration.h"
+#include "../../../src/utils/series/static-series.h"
+
+TEST_CASE("StaticSeries")
+{
+    SECTION("operator[] should return value at given index")
+    {
+        StaticSeries<5> series;
+        series.push(1.5);
+        series.push(2.5);
+        series.push(3.5);
+
+        REQUIRE(series[0] == 1.5);
+        REQUIRE(series[1] == 2.5);
+        REQUIRE(series[2] == 3.5);
+    }
+
+    SECTION("size method should return number of elements")
+    {
+        StaticSeries<10> series;
+
+        REQUIRE(series.size() == 0);
+
+        series.push(1.0);
+        REQUIRE(series.size() == 1);
+
+        series.push(2.0);
+        series.push(3.0);
+        REQUIRE(series.size() == 3);
+    }
+
+    SECTION("average method")
+    {
+        SECTION("should return 0 for empty series")
+        {
+            StaticSeries<5> series;
+            REQUIRE(series.average() == 0.0);
+        }
+
+        SECTION("should return correct average for populated series")
+        {
+            StaticSeries<5> series;
+            series.push(10.0);
+            series.push(20.0);
+            series.push(30.0);
+
+            CHECK_THAT(series.average(), Catch::Matchers::WithinRel(20.0, 0.00001));
+        }
+    }
+
+    SECTION("median method")
+    {
+        SECTION("should return 0 for empty series")
+        {
+            StaticSeries<5> series;
+            REQUIRE(series.median() == 0.0);
+        }
+
+        SECTION("should return correct median for odd number of elements")
+        {
+            StaticSeries<5> series;
+            series.push(3.0);
+            series.push(1.0);
+            series.push(2.0);
+
+            REQUIRE(series.median() == 2.0);
+        }
+
+        SECTION("should return correct median for even number of elements")
+        {
+            StaticSeries<5> series;
+            series.push(4.0);
+            series.push(1.0);
+            series.push(3.0);
+            series.push(2.0);
+
+            CHECK_THAT(series.median(), Catch::Matchers::WithinRel(2.5, 0.00001));
+        }
+    }
+
+    SECTION("reset method should clear the series")
+    {
+        StaticSeries<5> series;
+        series.push(10.0);
+        series.push(20.0);
+        series.push(30.0);
+        series.push(40.0);
+        series.push(50.0);
+        series.push(60.0);
+
+        series.reset();
+
+        REQUIRE(series.size() == 0);
+        REQUIRE(series.sum() == 0.0);
+        REQUIRE(series.average() == 0.0);
+
+        series.push(70.0);
+
+        REQUIRE(series.front() == 70.0);
+        REQUIRE(series.back() == 70.0);
+    }
+
+    SECTION("when capacity is exceeded should roll window")
+    {
+        StaticSeries<3> series;
+
+        series.push(1.0);
+        series.push(2.0);
+        series.push(3.0);
+
+        REQUIRE(series.size() == 3);
+        REQUIRE(series.sum() == 6.0);
+        REQUIRE(series.front() == 1.0);
+        REQUIRE(series.back() == 3.0);
+
+        series.push(4.0);
+
+        REQUIRE(series.size() == 3);
+        REQUIRE(series.sum() == 9.0);
+        REQUIRE(series.front() == 2.0);
+        REQUIRE(series.back() == 4.0);
+        REQUIRE(series[0] == 2.0);
+        REQUIRE(series[1] == 3.0);
+        REQUIRE(series[2] == 4.0);
+
+        series.push(5.0);
+        series.push(6.0);
+
+        REQUIRE(series.size() == 3);
+        REQUIRE(series.sum() == 15.0);
+        REQUIRE(series.front() == 4.0);
+        REQUIRE(series.back() == 6.0);
+        REQUIRE(series.median() == 5.0);
+    }
+
+    SECTION("when maxSeriesLength is below capacity should roll window at maxSeriesLength")
+    {
+        StaticSeries<10> series(2);
+
+        series.push(1.0);
+        series.push(2.0);
+        series.push(3.0);
+
+        REQUIRE(series.capacity() == 2);
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.front() == 2.0);
+        REQUIRE(series.back() == 3.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,56 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <initializer_list>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../../../src/utils/series/static-ts-linear-series.h"
+#include "../../../src/utils/series/ts-linear-series.h"
+#include "./regression.test-cases.spec.h"
+
+TEST_CASE("Static Theil Sen Linear Regression", "[regression]")
+{
+    StaticTSLinearSeries<testMaxSize> tsReg;
+
+    for (const auto &testCase : testCases)
+    {
+        tsReg.push(testCase[1] / 1e6, testCase[0] / 1e6);
+    }
+
+    SECTION("median method should correctly calculate Median")
+    {
+        REQUIRE(tsReg.median() == -39.37665713543009);
+    }
+
+    SECTION("size method should return number of data points")
+    {
+        REQUIRE(tsReg.size() == testMaxSize);
+    }
+
+    SECTION("reset method should clear the series")
+    {
+        tsReg.reset();
+
+        REQUIRE(tsReg.size() == 0);
+        REQUIRE(tsReg.median() == 0.0);
+        REQUIRE(tsReg.coefficientB() == 0.0);
+    }
+
+    SECTION("should match TSLinearSeries after every push")
+    {
+        StaticTSLinearSeries<testMaxSize> tsRegStatic;
+        TSLinearSeries tsRegRuntime(testMaxSize);
+
+        for (const auto &testCase : testCases)
+        {
+            tsRegStatic.push(testCase[1] / 1e6, testCase[0] / 1e6);
+            tsRegRuntime.push(testCase[1] / 1e6, testCase[0] / 1e6);
+
+            REQUIRE(tsRegStatic.coefficientA() == tsRegRuntime.coefficientA());
+            REQUIRE(tsRegStatic.coefficientB() == tsRegRuntime.coefficientB());
+            REQUIRE(tsRegStatic.xAtSeriesBegin() == tsRegRuntime.xAtSeriesBegin());
+            REQUIRE(tsRegStatic.xAtSeriesEnd() == tsRegRuntime.xAtSeriesEnd());
+            REQUIRE(tsRegStatic.yAtSeriesBegin() == tsRegRuntime.yAtSeriesBegin());
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
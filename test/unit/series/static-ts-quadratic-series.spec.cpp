@@ -0,0 +1,86 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <initializer_list>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/static-ts-quadratic-series.h"
+#include "../../../src/utils/series/ts-quadratic-series.h"
+#include "./regression.test-cases.spec.h"
+
+TEST_CASE("Static Theil Sen Quadratic Regression", "[regression]")
+{
+    StaticTSQuadraticSeries<testMaxSize> tsQuad;
+
+    for (const auto &testCase : testCases)
+    {
+        tsQuad.push(testCase[0] / 1e6, testCase[2]);
+    }
+
+    SECTION("firstDerivativeAtPosition should return correct values")
+    {
+        CHECK(tsQuad.firstDerivativeAtPosition(0) == 51.21269541835392);
+        CHECK(tsQuad.firstDerivativeAtPosition(3) == 55.36640827543397);
+        CHECK(tsQuad.firstDerivativeAtPosition(6) == 59.2248456690337);
+        CHECK(tsQuad.firstDerivativeAtPosition(7) == 0);
+    }
+
+    SECTION("secondDerivativeAtPosition should return correct values")
+    {
+        CHECK(tsQuad.secondDerivativeAtPosition(0) == 35.20632687257407);
+        CHECK(tsQuad.secondDerivativeAtPosition(6) == 35.20632687257407);
+        CHECK(tsQuad.secondDerivativeAtPosition(7) == 0);
+    }
+
+    SECTION("reset should clear the series so it behaves as a new one when refilled")
+    {
+        tsQuad.reset();
+
+        CHECK(tsQuad.firstDerivativeAtPosition(0) == 0);
+        CHECK(tsQuad.secondDerivativeAtPosition(0) == 0);
+        CHECK(tsQuad.goodnessOfFit() == 0);
+
+        StaticTSQuadraticSeries<testMaxSize> tsQuadNew;
+        for (const auto &testCase : testCases)
+        {
+            tsQuad.push(testCase[0] / 1e6, testCase[2]);
+            tsQuadNew.push(testCase[0] / 1e6, testCase[2]);
+
+            REQUIRE(tsQuad.goodnessOfFit() == tsQuadNew.goodnessOfFit());
+            REQUIRE(tsQuad.secondDerivativeAtPosition(0) == tsQuadNew.secondDerivativeAtPosition(0));
+            REQUIRE(tsQuad.firstDerivativeAtPosition(0) == tsQuadNew.firstDerivativeAtPosition(0));
+        }
+    }
+
+    SECTION("should calculate correct goodness of fit")
+    {
+        StaticTSQuadraticSeries<testMaxSize> tsQuadGoodness;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadGoodness.push(testCase[0] / 1e6, testCase[2]);
+            REQUIRE_THAT(tsQuadGoodness.goodnessOfFit(), Catch::Matchers::WithinRel(testCase[4], 1e-9));
+        }
+    }
+
+    SECTION("should match TSQuadraticSeries after every push")
+    {
+        StaticTSQuadraticSeries<testMaxSize> tsQuadStatic;
+        TSQuadraticSeries tsQuadRuntime(testMaxSize);
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadStatic.push(testCase[0] / 1e6, testCase[2]);
+            tsQuadRuntime.push(testCase[0] / 1e6, testCase[2]);
+
+            REQUIRE(tsQuadStatic.goodnessOfFit() == tsQuadRuntime.goodnessOfFit());
+            REQUIRE(tsQuadStatic.secondDerivativeAtPosition(0) == tsQuadRuntime.secondDerivativeAtPosition(0));
+            for (unsigned char i = 0; i < testMaxSize; ++i)
+            {
+                REQUIRE(tsQuadStatic.firstDerivativeAtPosition(i) == tsQuadRuntime.firstDerivativeAtPosition(i));
+            }
+        }
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
@@ -1,12 +1,18 @@
 // NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
+#include <vector>
 
 #include "catch2/catch_test_macros.hpp"
 
 #include "../../../src/utils/series/ts-linear-series.h"
 #include "./regression.test-cases.spec.h"
 
+using std::vector;
+
 TEST_CASE("Theil Sen Linear Regression", "[regression]")
 {
     const auto tsLinearTestMaxSize = 7U;
@@ -23,6 +29,43 @@ TEST_CASE("Theil Sen Linear Regression", "[regression]")
         REQUIRE(tsReg.median() == expectedMedian);
     }
 
+    SECTION("median method should follow the rolling window when old points are evicted")
+    {
+        TSLinearSeries tsRegRolling(tsLinearTestMaxSize);
+        vector<array<double, 2U>> window;
+
+        for (const auto &testCase : testCases)
+        {
+            tsRegRolling.push(testCase[1] / 1e6, testCase[0] / 1e6);
+
+            window.push_back({testCase[1] / 1e6, testCase[0] / 1e6});
+            if (window.size() > tsLinearTestMaxSize)
+            {
+                window.erase(begin(window));
+            }
+
+            vector<double> expectedSlopes;
+            for (size_t i = 0; i < window.size(); ++i)
+            {
+                for (size_t j = i + 1; j < window.size(); ++j)
+                {
+                    expectedSlopes.push_back((window[j][1] - window[i][1]) / (window[j][0] - window[i][0]));
+                }
+            }
+
+            if (expectedSlopes.empty())
+            {
+                continue;
+            }
+
+            std::ranges::sort(expectedSlopes);
+            const auto mid = expectedSlopes.size() / 2;
+            const auto expectedMedian = (expectedSlopes.size() & 1) != 0 ? expectedSlopes[mid] : (expectedSlopes[mid] + expectedSlopes[mid - 1]) / 2;
+
+            REQUIRE(tsRegRolling.median() == expectedMedian);
+        }
+    }
+
     SECTION("coefficientA method should assign the median to coefficientA")
     {
         REQUIRE(tsReg.median() == tsReg.coefficientA());
@@ -53,6 +96,22 @@ TEST_CASE("Theil Sen Linear Regression", "[regression]")
         REQUIRE(tsReg.coefficientA() == 0);
     }
 
+    SECTION("reset method should let the series behave as a new one when refilled")
+    {
+        tsReg.reset();
+
+        TSLinearSeries tsRegNew(tsLinearTestMaxSize);
+        for (const auto &testCase : testCases)
+        {
+            tsReg.push(testCase[1] / 1e6, testCase[0] / 1e6);
+            tsRegNew.push(testCase[1] / 1e6, testCase[0] / 1e6);
+
+            REQUIRE(tsReg.size() == tsRegNew.size());
+            REQUIRE(tsReg.coefficientA() == tsRegNew.coefficientA());
+            REQUIRE(tsReg.coefficientB() == tsRegNew.coefficientB());
+        }
+    }
+
     SECTION("yAtSeriesBegin method should return first Y value")
     {
         TSLinearSeries tsRegAccessor(10);
@@ -86,6 +145,23 @@ TEST_CASE("Theil Sen Linear Regression", "[regression]")
         REQUIRE(tsRegAccessor.xAtSeriesEnd() == 3.0);
     }
 
+    SECTION("rebase method should keep the slope and move the intercept with the new X origin")
+    {
+        TSLinearSeries tsRegRebase(10);
+
+        tsRegRebase.push(101.0, 100.0);
+        tsRegRebase.push(102.0, 200.0);
+        tsRegRebase.push(103.0, 300.0);
+        const auto coefficientBBefore = tsRegRebase.coefficientB();
+
+        tsRegRebase.rebase(100.0);
+
+        REQUIRE(tsRegRebase.xAtSeriesBegin() == 1.0);
+        REQUIRE(tsRegRebase.xAtSeriesEnd() == 3.0);
+        REQUIRE(tsRegRebase.coefficientA() == 100.0);
+        REQUIRE(tsRegRebase.coefficientB() == coefficientBBefore + 100.0 * 100.0);
+    }
+
     SECTION("with edge cases")
     {
         SECTION("median should return 0 for empty series")
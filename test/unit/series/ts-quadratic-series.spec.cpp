@@ -1,12 +1,20 @@
 // NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
+#include <vector>
 
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include "../../../src/utils/series/ts-quadratic-series.h"
 #include "./regression.test-cases.spec.h"
 
+using std::vector;
+
 TEST_CASE("Theil Sen Quadratic Regression", "[regression]")
 {
     TSQuadraticSeries tsQuad(testMaxSize);
@@ -43,6 +51,88 @@ TEST_CASE("Theil Sen Quadratic Regression", "[regression]")
         CHECK(tsQuad.secondDerivativeAtPosition(8) == 0);
     }
 
+    SECTION("secondDerivativeAtPosition should follow the median of the rolling window")
+    {
+        TSQuadraticSeries tsQuadRolling(testMaxSize);
+        vector<array<double, 2U>> window;
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadRolling.push(testCase[0] / 1e6, testCase[2]);
+
+            window.push_back({testCase[0] / 1e6, testCase[2]});
+            if (window.size() > testMaxSize)
+            {
+                window.erase(begin(window));
+            }
+
+            if (window.size() < 3)
+            {
+                continue;
+            }
+
+            vector<double> expectedA;
+            for (size_t i = 0; i < window.size(); ++i)
+            {
+                for (size_t j = i + 1; j < window.size(); ++j)
+                {
+                    for (size_t k = j + 1; k < window.size(); ++k)
+                    {
+                        const auto &[xOne, yOne] = window[i];
+                        const auto &[xTwo, yTwo] = window[j];
+                        const auto &[xThree, yThree] = window[k];
+
+                        expectedA.push_back((xOne * (yThree - yTwo) + yOne * (xTwo - xThree) + (xThree * yTwo - xTwo * yThree)) / ((xOne - xTwo) * (xOne - xThree) * (xTwo - xThree)));
+                    }
+                }
+            }
+
+            std::ranges::sort(expectedA);
+            const auto mid = expectedA.size() / 2;
+            const auto expectedMedian = (expectedA.size() & 1) != 0 ? expectedA[mid] : (expectedA[mid] + expectedA[mid - 1]) / 2;
+
+            REQUIRE(tsQuadRolling.secondDerivativeAtPosition(0) == expectedMedian * 2);
+        }
+    }
+
+    SECTION("rebase should keep the derivatives when the origin of X and Y is moved")
+    {
+        TSQuadraticSeries tsQuadRebase(testMaxSize);
+
+        for (const auto &testCase : testCases)
+        {
+            tsQuadRebase.push(testCase[0] / 1e6, testCase[2]);
+        }
+
+        tsQuadRebase.rebase(5.0, 200.0);
+
+        REQUIRE(tsQuadRebase.secondDerivativeAtPosition(0) == tsQuad.secondDerivativeAtPosition(0));
+        for (auto i = 0U; i < testMaxSize; ++i)
+        {
+            CHECK_THAT(tsQuadRebase.firstDerivativeAtPosition(i), Catch::Matchers::WithinRel(tsQuad.firstDerivativeAtPosition(i), 0.00001));
+        }
+    }
+
+    SECTION("reset should clear the series so it behaves as a new one when refilled")
+    {
+        tsQuad.reset();
+
+        CHECK(tsQuad.firstDerivativeAtPosition(0) == 0);
+        CHECK(tsQuad.secondDerivativeAtPosition(0) == 0);
+        CHECK(tsQuad.goodnessOfFit() == 0);
+
+        TSQuadraticSeries tsQuadNew(testMaxSize);
+        for (const auto &testCase : testCases)
+        {
+            tsQuad.push(testCase[0] / 1e6, testCase[2]);
+            tsQuadNew.push(testCase[0] / 1e6, testCase[2]);
+
+            REQUIRE(tsQuad.goodnessOfFit() == tsQuadNew.goodnessOfFit());
+            REQUIRE(tsQuad.secondDerivativeAtPosition(0) == tsQuadNew.secondDerivativeAtPosition(0));
+            REQUIRE(tsQuad.firstDerivativeAtPosition(0) == tsQuadNew.firstDerivativeAtPosition(0));
+        }
+    }
+
     SECTION("should calculate correct goodness of fit")
     {
         TSQuadraticSeries tsQuadGoodness(testMaxSize);
@@ -50,7 +140,7 @@ TEST_CASE("Theil Sen Quadratic Regression", "[regression]")
         for (const auto &testCase : testCases)
         {
             tsQuadGoodness.push(testCase[0] / 1e6, testCase[2]);
-            REQUIRE(tsQuadGoodness.goodnessOfFit() == testCase[4]);
+            REQUIRE_THAT(tsQuadGoodness.goodnessOfFit(), Catch::Matchers::WithinRel(testCase[4], 1e-9));
         }
     }
 }
@@ -0,0 +1,103 @@
+// NOLINTBEGIN(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "../../../src/utils/series/weighted-average-matrix.h"
+#include "../../../src/utils/series/weighted-average-series.h"
+
+using std::vector;
+
+TEST_CASE("WeightedAverageMatrix")
+{
+    SECTION("average should return 0 when no row has been added")
+    {
+        WeightedAverageMatrix matrix(3);
+
+        REQUIRE(matrix.size() == 0);
+        REQUIRE(matrix.average() == 0.0);
+    }
+
+    SECTION("average should return 0 when the weights of the oldest row sum to 0")
+    {
+        WeightedAverageMatrix matrix(3);
+        matrix.addRow();
+        matrix.push(0, 10.0, 0.0);
+
+        REQUIRE(matrix.average() == 0.0);
+    }
+
+    SECTION("average should return the weighted average of the oldest row")
+    {
+        WeightedAverageMatrix matrix(3);
+
+        matrix.addRow();
+        matrix.push(0, 10.0, 1.0);
+        matrix.addRow();
+        matrix.push(0, 20.0, 3.0);
+        matrix.push(1, 100.0, 3.0);
+
+        REQUIRE(matrix.size() == 2);
+        CHECK_THAT(matrix.average(), Catch::Matchers::WithinRel(17.5, 0.00001));
+    }
+
+    SECTION("should roll the window once maxSeriesLength rows have been added")
+    {
+        WeightedAverageMatrix matrix(2);
+
+        matrix.addRow();
+        matrix.push(0, 1.0, 1.0);
+        matrix.addRow();
+        matrix.push(0, 2.0, 1.0);
+        matrix.push(1, 5.0, 1.0);
+        matrix.addRow();
+        matrix.push(0, 7.0, 1.0);
+        matrix.push(1, 9.0, 1.0);
+
+        REQUIRE(matrix.size() == 2);
+        CHECK_THAT(matrix.average(), Catch::Matchers::WithinRel(6.0, 0.00001));
+    }
+
+    SECTION("should match a diagonal of WeightedAverageSeries")
+    {
+        const auto maxSeriesLength = 4U;
+        WeightedAverageMatrix matrix(maxSeriesLength);
+        vector<WeightedAverageSeries> reference;
+
+        for (auto step = 0U; step < 12U; ++step)
+        {
+            if (reference.size() >= maxSeriesLength)
+            {
+                reference.erase(begin(reference));
+            }
+            reference.emplace_back(maxSeriesLength);
+            matrix.addRow();
+
+            const auto weight = 0.5 + step * 0.05;
+            for (unsigned char i = 0; i < reference.size(); ++i)
+            {
+                const auto value = step * 1.3 + i * 0.7;
+                reference[i].push(value, weight);
+                matrix.push(i, value, weight);
+            }
+
+            REQUIRE(matrix.size() == reference.size());
+            REQUIRE(matrix.average() == reference[0].average());
+        }
+    }
+
+    SECTION("reset should clear all rows")
+    {
+        WeightedAverageMatrix matrix(3);
+        matrix.addRow();
+        matrix.push(0, 10.0, 1.0);
+
+        matrix.reset();
+
+        REQUIRE(matrix.size() == 0);
+        REQUIRE(matrix.average() == 0.0);
+    }
+}
+// NOLINTEND(readability-magic-numbers, readability-function-cognitive-complexity, cppcoreguidelines-avoid-do-while)